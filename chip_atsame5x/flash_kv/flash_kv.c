@@ -0,0 +1,697 @@
+/**
+ * \file
+ *
+ * \brief Log-structured key-value store on internal flash implementation.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+/*
+ * Support and FAQ: visit <a href="https://www.microchip.com/support/">Microchip Support</a>
+ */
+
+#include <flash_kv.h>
+#include <flash_kv_config.h>
+#include <string.h>
+#include <utils.h>
+#include <utils_assert.h>
+#include <utils_crc.h>
+
+/**
+ * Every block starts with a header quad word, followed by records appended
+ * one after the other. A record is an 8 byte header, holding the key, the
+ * value length and a CRC-32 of both, followed by the value and padded to a
+ * quad word. A record never spans two pages, so it is programmed at once; a
+ * record which does not fit in the rest of a page starts on the next page.
+ *
+ * A zero length record deletes the key. The block with the highest sequence
+ * receives the records, the latest record of a key wins. One block is kept
+ * erased, garbage collection copies the live records of the oldest block into
+ * it and erases the oldest block.
+ */
+
+/** Block header magic, "FLKV" */
+#define FLASH_KV_MAGIC 0x564B4C46u
+/** Erased flash word */
+#define FLASH_KV_ERASED 0xFFFFFFFFu
+/** Record and block header alignment, the flash programming unit */
+#define FLASH_KV_ALIGN 16
+/** Size of the block header */
+#define FLASH_KV_BLOCK_HEADER_SIZE 16
+/** Size of the record header */
+#define FLASH_KV_RECORD_HEADER_SIZE 8
+/** Largest record */
+#define FLASH_KV_MAX_RECORD_SIZE                                                                                       \
+	((FLASH_KV_RECORD_HEADER_SIZE + CONF_FLASH_KV_MAX_VALUE_SIZE + FLASH_KV_ALIGN - 1) & ~(FLASH_KV_ALIGN - 1))
+/** No block */
+#define FLASH_KV_NO_BLOCK 0xFFFF
+
+/**
+ * \brief Block header states
+ */
+enum flash_kv_block_state { FLASH_KV_BLOCK_ERASED, FLASH_KV_BLOCK_USED, FLASH_KV_BLOCK_INVALID };
+
+/**
+ * \brief Record header
+ */
+struct flash_kv_record {
+	/** Key */
+	uint16_t key;
+	/** Value length, 0 for a deleted key */
+	uint16_t length;
+	/** CRC-32 of key, length and value */
+	uint32_t crc;
+};
+
+/**
+ * \brief Get the CRC of a record
+ */
+static uint32_t flash_kv_record_crc(const struct flash_kv_record *const rec, const uint8_t *const value)
+{
+	uint32_t crc = utils_crc32(FLASH_KV_ERASED, rec, offsetof(struct flash_kv_record, crc));
+
+	return ~utils_crc32(crc, value, rec->length);
+}
+
+/**
+ * \brief Get the flash size of a record
+ */
+static uint32_t flash_kv_record_size(const uint16_t length)
+{
+	return (FLASH_KV_RECORD_HEADER_SIZE + length + FLASH_KV_ALIGN - 1) & ~(FLASH_KV_ALIGN - 1);
+}
+
+/**
+ * \brief Get the address of a block
+ */
+static uint32_t flash_kv_block_addr(struct flash_kv *const kv, const uint16_t block)
+{
+	return kv->cfg.base + block * kv->block_size;
+}
+
+/**
+ * \brief Get the block of an address
+ */
+static uint16_t flash_kv_addr_block(struct flash_kv *const kv, const uint32_t addr)
+{
+	return (addr - kv->cfg.base) / kv->block_size;
+}
+
+/**
+ * \brief Get a pointer to flash content
+ */
+static const uint8_t *flash_kv_ptr(struct flash_kv *const kv, const uint32_t addr, const uint32_t length)
+{
+	return flash_get_pointer(kv->flash, addr, length);
+}
+
+/**
+ * \brief Check whether flash content is erased
+ */
+static bool flash_kv_is_erased(struct flash_kv *const kv, const uint32_t addr, const uint32_t length)
+{
+	const uint32_t *ptr = (const uint32_t *)flash_kv_ptr(kv, addr, length);
+	uint32_t        i;
+
+	for (i = 0; i < length / 4; i++) {
+		if (FLASH_KV_ERASED != ptr[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * \brief Read the header of a block
+ */
+static enum flash_kv_block_state flash_kv_read_block(struct flash_kv *const kv, const uint16_t block,
+                                                     uint32_t *const sequence)
+{
+	uint32_t        addr = flash_kv_block_addr(kv, block);
+	const uint32_t *hdr  = (const uint32_t *)flash_kv_ptr(kv, addr, FLASH_KV_BLOCK_HEADER_SIZE);
+
+	if (flash_kv_is_erased(kv, addr, FLASH_KV_BLOCK_HEADER_SIZE)) {
+		return FLASH_KV_BLOCK_ERASED;
+	}
+
+	if ((FLASH_KV_MAGIC != hdr[0]) || (hdr[1] != ~hdr[2])) {
+		return FLASH_KV_BLOCK_INVALID;
+	}
+
+	*sequence = hdr[1];
+
+	return FLASH_KV_BLOCK_USED;
+}
+
+/**
+ * \brief Erase a block
+ */
+static int32_t flash_kv_erase_block(struct flash_kv *const kv, const uint16_t block)
+{
+	return flash_erase(kv->flash, flash_kv_block_addr(kv, block), kv->block_size / kv->page_size);
+}
+
+/**
+ * \brief Find the used block with the lowest sequence above a bound
+ *
+ * \return The block, FLASH_KV_NO_BLOCK if none
+ */
+static uint16_t flash_kv_next_block(struct flash_kv *const kv, const uint32_t above, uint32_t *const sequence)
+{
+	uint16_t found = FLASH_KV_NO_BLOCK;
+	uint16_t i;
+	uint32_t seq;
+
+	for (i = 0; i < kv->cfg.block_count; i++) {
+		if ((FLASH_KV_BLOCK_USED == flash_kv_read_block(kv, i, &seq)) && (seq > above)
+		    && ((FLASH_KV_NO_BLOCK == found) || (seq < *sequence))) {
+			found     = i;
+			*sequence = seq;
+		}
+	}
+
+	return found;
+}
+
+/**
+ * \brief Get the home slot of a key in the index
+ */
+static uint16_t flash_kv_hash(struct flash_kv *const kv, const uint16_t key)
+{
+	return (uint16_t)(key * 40503u) & (kv->cfg.index_size - 1);
+}
+
+/**
+ * \brief Find the index slot of a key
+ *
+ * \return The slot, index_size if the key is not indexed
+ */
+static uint16_t flash_kv_index_find(struct flash_kv *const kv, const uint16_t key)
+{
+	uint16_t slot = flash_kv_hash(kv, key);
+
+	while (FLASH_KV_NO_KEY != kv->cfg.index[slot].key) {
+		if (key == kv->cfg.index[slot].key) {
+			return slot;
+		}
+		slot = (slot + 1) & (kv->cfg.index_size - 1);
+	}
+
+	return kv->cfg.index_size;
+}
+
+/**
+ * \brief Index the record of a key
+ */
+static int32_t flash_kv_index_put(struct flash_kv *const kv, const uint16_t key, const uint32_t addr)
+{
+	uint16_t slot = flash_kv_hash(kv, key);
+
+	while ((FLASH_KV_NO_KEY != kv->cfg.index[slot].key) && (key != kv->cfg.index[slot].key)) {
+		slot = (slot + 1) & (kv->cfg.index_size - 1);
+	}
+
+	if (FLASH_KV_NO_KEY == kv->cfg.index[slot].key) {
+		/* Keep one slot empty so that lookups terminate */
+		if (kv->keys + 1 >= kv->cfg.index_size) {
+			return ERR_NO_MEMORY;
+		}
+		kv->keys++;
+	}
+
+	kv->cfg.index[slot].key  = key;
+	kv->cfg.index[slot].addr = addr;
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Remove an index slot, moving back the entries probed past it
+ */
+static void flash_kv_index_remove(struct flash_kv *const kv, uint16_t slot)
+{
+	uint16_t mask = kv->cfg.index_size - 1;
+	uint16_t next = slot;
+	uint16_t home;
+
+	while (1) {
+		next = (next + 1) & mask;
+		if (FLASH_KV_NO_KEY == kv->cfg.index[next].key) {
+			break;
+		}
+
+		/* Move the entry unless its home lies cyclically in (slot, next] */
+		home = flash_kv_hash(kv, kv->cfg.index[next].key);
+		if (((next - home) & mask) >= ((next - slot) & mask)) {
+			kv->cfg.index[slot] = kv->cfg.index[next];
+			slot                = next;
+		}
+	}
+
+	kv->cfg.index[slot].key = FLASH_KV_NO_KEY;
+	kv->keys--;
+}
+
+/**
+ * \brief Check a record
+ *
+ * \return The record header, NULL if no complete record is at the address
+ */
+static const struct flash_kv_record *flash_kv_check_record(struct flash_kv *const kv, const uint32_t addr,
+                                                           const uint32_t limit)
+{
+	const struct flash_kv_record *rec
+	    = (const struct flash_kv_record *)flash_kv_ptr(kv, addr, FLASH_KV_RECORD_HEADER_SIZE);
+
+	if ((FLASH_KV_NO_KEY == rec->key) || (rec->length > CONF_FLASH_KV_MAX_VALUE_SIZE)
+	    || (addr + flash_kv_record_size(rec->length) > limit)) {
+		return NULL;
+	}
+
+	if (rec->crc != flash_kv_record_crc(rec, flash_kv_ptr(kv, addr + FLASH_KV_RECORD_HEADER_SIZE, rec->length))) {
+		return NULL;
+	}
+
+	return rec;
+}
+
+/**
+ * \brief Index the records of a block
+ *
+ * \return The address following the last record
+ */
+static uint32_t flash_kv_scan_block(struct flash_kv *const kv, const uint16_t block)
+{
+	uint32_t                      addr  = flash_kv_block_addr(kv, block) + FLASH_KV_BLOCK_HEADER_SIZE;
+	uint32_t                      limit = flash_kv_block_addr(kv, block) + kv->block_size;
+	const struct flash_kv_record *rec;
+	uint32_t                      next;
+
+	while (addr < limit) {
+		next = (addr + kv->page_size) & ~(kv->page_size - 1);
+		if (flash_kv_is_erased(kv, addr, FLASH_KV_RECORD_HEADER_SIZE)) {
+			/* A record which did not fit in the page starts on the next one */
+			if (!(addr & (kv->page_size - 1)) || (next >= limit)
+			    || flash_kv_is_erased(kv, next, FLASH_KV_RECORD_HEADER_SIZE)) {
+				break;
+			}
+			addr = next;
+			continue;
+		}
+
+		rec = flash_kv_check_record(kv, addr, limit);
+		if (!rec) {
+			/* Torn by a power failure, nothing follows it in its page. Records
+			 * written after the next mount start on the next page. */
+			addr = next;
+			continue;
+		}
+
+		if (flash_kv_index_put(kv, rec->key, addr)) {
+			return limit;
+		}
+		addr += flash_kv_record_size(rec->length);
+	}
+
+	return addr;
+}
+
+/**
+ * \brief Take an erased block to receive the records
+ */
+static int32_t flash_kv_open_block(struct flash_kv *const kv)
+{
+	uint32_t hdr[FLASH_KV_BLOCK_HEADER_SIZE / 4];
+	uint32_t seq;
+	uint16_t i;
+	int32_t  rc;
+
+	for (i = 0; i < kv->cfg.block_count; i++) {
+		if (FLASH_KV_BLOCK_ERASED == flash_kv_read_block(kv, i, &seq)) {
+			break;
+		}
+	}
+
+	if (i == kv->cfg.block_count) {
+		return ERR_NO_MEMORY;
+	}
+
+	hdr[0] = FLASH_KV_MAGIC;
+	hdr[1] = kv->sequence + 1;
+	hdr[2] = ~hdr[1];
+	hdr[3] = FLASH_KV_ERASED;
+
+	rc = flash_append(kv->flash, flash_kv_block_addr(kv, i), (uint8_t *)hdr, sizeof(hdr));
+	if (rc) {
+		return rc;
+	}
+
+	kv->sequence++;
+	kv->active     = i;
+	kv->write_addr = flash_kv_block_addr(kv, i) + FLASH_KV_BLOCK_HEADER_SIZE;
+	kv->free_blocks--;
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Append a record to the active block
+ *
+ * \return Operation status.
+ * \retval ERR_NO_MEMORY The record does not fit in the active block
+ */
+static int32_t flash_kv_append(struct flash_kv *const kv, const uint8_t *const record, const uint32_t size,
+                               uint32_t *const addr)
+{
+	uint32_t limit = flash_kv_block_addr(kv, kv->active) + kv->block_size;
+	uint32_t start = kv->write_addr;
+	int32_t  rc;
+
+	/* Start on the next page if the record does not fit in this one */
+	if ((start & (kv->page_size - 1)) + size > kv->page_size) {
+		start = (start + kv->page_size) & ~(kv->page_size - 1);
+	}
+
+	if (start + size > limit) {
+		return ERR_NO_MEMORY;
+	}
+
+	rc = flash_append(kv->flash, start, (uint8_t *)record, size);
+	if (rc) {
+		return rc;
+	}
+
+	kv->write_addr = start + size;
+	*addr          = start;
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Move the live records of the oldest block and erase it
+ *
+ * The spare block is opened first, so the block that was active can be the
+ * oldest one, as with two blocks. When resuming an interrupted collection no
+ * spare is left and the records go to the active block.
+ */
+static int32_t flash_kv_collect(struct flash_kv *const kv)
+{
+	uint32_t                      record[FLASH_KV_MAX_RECORD_SIZE / 4];
+	const struct flash_kv_record *rec;
+	uint32_t                      seq, addr, size;
+	uint16_t                      oldest, slot;
+	int32_t                       rc;
+
+	if (kv->free_blocks) {
+		rc = flash_kv_open_block(kv);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	oldest = flash_kv_next_block(kv, 0, &seq);
+	if ((FLASH_KV_NO_BLOCK == oldest) || (oldest == kv->active)) {
+		return ERR_NO_MEMORY;
+	}
+
+	for (slot = 0; slot < kv->cfg.index_size;) {
+		addr = kv->cfg.index[slot].addr;
+		if ((FLASH_KV_NO_KEY == kv->cfg.index[slot].key) || (flash_kv_addr_block(kv, addr) != oldest)) {
+			slot++;
+			continue;
+		}
+
+		rec = (const struct flash_kv_record *)flash_kv_ptr(kv, addr, FLASH_KV_RECORD_HEADER_SIZE);
+		if (!rec->length) {
+			/* Nothing older than the oldest block, the deletion is complete */
+			flash_kv_index_remove(kv, slot);
+			continue;
+		}
+
+		size = flash_kv_record_size(rec->length);
+		memcpy(record, rec, size);
+		rc = flash_kv_append(kv, (const uint8_t *)record, size, &kv->cfg.index[slot].addr);
+		if (rc) {
+			return rc;
+		}
+		slot++;
+	}
+
+	rc = flash_kv_erase_block(kv, oldest);
+	if (rc) {
+		return rc;
+	}
+	kv->free_blocks++;
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Write a record and index it
+ */
+static int32_t flash_kv_write(struct flash_kv *const kv, const uint16_t key, const void *const data,
+                              const uint16_t length)
+{
+	uint32_t               record[FLASH_KV_MAX_RECORD_SIZE / 4];
+	struct flash_kv_record rec;
+	uint32_t               size = flash_kv_record_size(length);
+	uint32_t               addr;
+	uint16_t               i;
+	int32_t                rc;
+
+	rec.key    = key;
+	rec.length = length;
+	rec.crc    = flash_kv_record_crc(&rec, (const uint8_t *)data);
+
+	memset(record, 0xFF, size);
+	memcpy(record, &rec, sizeof(rec));
+	memcpy((uint8_t *)record + FLASH_KV_RECORD_HEADER_SIZE, data, length);
+
+	/* Bounded, each collection erases a block or fails */
+	for (i = 0; i <= kv->cfg.block_count; i++) {
+		rc = flash_kv_append(kv, (const uint8_t *)record, size, &addr);
+		if (ERR_NO_MEMORY != rc) {
+			break;
+		}
+
+		/* The active block is full */
+		if (kv->free_blocks > 1) {
+			rc = flash_kv_open_block(kv);
+		} else {
+			rc = flash_kv_collect(kv);
+		}
+		if (rc) {
+			return rc;
+		}
+	}
+
+	if (rc) {
+		return rc;
+	}
+
+	return flash_kv_index_put(kv, key, addr);
+}
+
+/**
+ * \brief Initialize the key-value store
+ */
+int32_t flash_kv_init(struct flash_kv *const kv, struct flash_descriptor *const flash,
+                      const struct flash_kv_config *const cfg)
+{
+	ASSERT(kv && flash && cfg && cfg->index);
+
+	kv->flash      = flash;
+	kv->cfg        = *cfg;
+	kv->block_size = flash_get_block_size(flash);
+	kv->page_size  = flash_get_page_size(flash);
+	kv->active     = FLASH_KV_NO_BLOCK;
+
+	if ((cfg->block_count < 2) || (cfg->base & (kv->block_size - 1)) || (cfg->index_size < 2)
+	    || (cfg->index_size & (cfg->index_size - 1)) || (FLASH_KV_MAX_RECORD_SIZE > kv->page_size)) {
+		return ERR_INVALID_ARG;
+	}
+
+	if (!flash_get_pointer(flash, cfg->base, cfg->block_count * kv->block_size)) {
+		return ERR_BAD_ADDRESS;
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Erase all blocks and mount the empty store
+ */
+int32_t flash_kv_format(struct flash_kv *const kv)
+{
+	uint16_t i;
+	int32_t  rc;
+
+	ASSERT(kv);
+
+	for (i = 0; i < kv->cfg.block_count; i++) {
+		if (!flash_kv_is_erased(kv, flash_kv_block_addr(kv, i), kv->block_size)) {
+			rc = flash_kv_erase_block(kv, i);
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+
+	return flash_kv_mount(kv);
+}
+
+/**
+ * \brief Rebuild the RAM index from flash
+ */
+int32_t flash_kv_mount(struct flash_kv *const kv)
+{
+	enum flash_kv_block_state state;
+	uint32_t                  seq = 0;
+	uint32_t                  end = 0;
+	uint16_t                  i;
+	int32_t                   rc;
+
+	ASSERT(kv);
+
+	for (i = 0; i < kv->cfg.index_size; i++) {
+		kv->cfg.index[i].key = FLASH_KV_NO_KEY;
+	}
+	kv->keys        = 0;
+	kv->free_blocks = 0;
+	kv->sequence    = 0;
+	kv->active      = FLASH_KV_NO_BLOCK;
+
+	/* Erase the blocks left half erased or half opened */
+	for (i = 0; i < kv->cfg.block_count; i++) {
+		state = flash_kv_read_block(kv, i, &seq);
+		if ((FLASH_KV_BLOCK_INVALID == state)
+		    || ((FLASH_KV_BLOCK_ERASED == state)
+		        && !flash_kv_is_erased(kv, flash_kv_block_addr(kv, i), kv->block_size))) {
+			rc = flash_kv_erase_block(kv, i);
+			if (rc) {
+				return rc;
+			}
+			state = FLASH_KV_BLOCK_ERASED;
+		}
+		if (FLASH_KV_BLOCK_ERASED == state) {
+			kv->free_blocks++;
+		}
+	}
+
+	/* Replay the blocks from the oldest one, the newest one is active */
+	seq = 0;
+	while (FLASH_KV_NO_BLOCK != (i = flash_kv_next_block(kv, kv->sequence, &seq))) {
+		end            = flash_kv_scan_block(kv, i);
+		kv->active     = i;
+		kv->sequence   = seq;
+		kv->write_addr = end;
+	}
+
+	if (FLASH_KV_NO_BLOCK == kv->active) {
+		return flash_kv_open_block(kv);
+	}
+
+	/* A collection was interrupted before the oldest block was erased */
+	if (!kv->free_blocks) {
+		return flash_kv_collect(kv);
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Read the value of a key
+ */
+int32_t flash_kv_get(struct flash_kv *const kv, const uint16_t key, void *const buf, const uint16_t size)
+{
+	const struct flash_kv_record *rec;
+	uint16_t                      slot;
+
+	ASSERT(kv && (buf || !size));
+
+	slot = flash_kv_index_find(kv, key);
+	if (slot == kv->cfg.index_size) {
+		return ERR_NOT_FOUND;
+	}
+
+	rec = (const struct flash_kv_record *)flash_kv_ptr(kv, kv->cfg.index[slot].addr, FLASH_KV_RECORD_HEADER_SIZE);
+	if (!rec->length) {
+		return ERR_NOT_FOUND;
+	}
+
+	memcpy(buf, (const uint8_t *)rec + FLASH_KV_RECORD_HEADER_SIZE, min(size, rec->length));
+
+	return rec->length;
+}
+
+/**
+ * \brief Store the value of a key
+ */
+int32_t flash_kv_set(struct flash_kv *const kv, const uint16_t key, const void *const data, const uint16_t length)
+{
+	const struct flash_kv_record *rec;
+	uint16_t                      slot;
+
+	ASSERT(kv && data);
+
+	if ((FLASH_KV_NO_KEY == key) || !length || (length > CONF_FLASH_KV_MAX_VALUE_SIZE)) {
+		return ERR_INVALID_ARG;
+	}
+
+	/* Skip the write if the value does not change */
+	slot = flash_kv_index_find(kv, key);
+	if (slot != kv->cfg.index_size) {
+		rec = (const struct flash_kv_record *)flash_kv_ptr(
+		    kv, kv->cfg.index[slot].addr, FLASH_KV_RECORD_HEADER_SIZE);
+		if ((rec->length == length) && !memcmp((const uint8_t *)rec + FLASH_KV_RECORD_HEADER_SIZE, data, length)) {
+			return ERR_NONE;
+		}
+	} else if (kv->keys + 1 >= kv->cfg.index_size) {
+		return ERR_NO_MEMORY;
+	}
+
+	return flash_kv_write(kv, key, data, length);
+}
+
+/**
+ * \brief Remove the value of a key
+ */
+int32_t flash_kv_delete(struct flash_kv *const kv, const uint16_t key)
+{
+	uint8_t  none = 0;
+	uint16_t slot;
+
+	ASSERT(kv);
+
+	slot = flash_kv_index_find(kv, key);
+	if ((slot == kv->cfg.index_size) || (flash_kv_get(kv, key, &none, 0) < 0)) {
+		return ERR_NOT_FOUND;
+	}
+
+	return flash_kv_write(kv, key, &none, 0);
+}
@@ -0,0 +1,177 @@
+/**
+ * \file
+ *
+ * \brief Log-structured key-value store on internal flash declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+/*
+ * Support and FAQ: visit <a href="https://www.microchip.com/support/">Microchip Support</a>
+ */
+
+#ifndef _FLASH_KV_H_INCLUDED
+#define _FLASH_KV_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <hal_flash.h>
+
+/** Key value reserved for empty index slots and erased flash */
+#define FLASH_KV_NO_KEY 0xFFFF
+
+/**
+ * \brief Index entry, locating the latest record of a key
+ */
+struct flash_kv_entry {
+	/** Flash address of the record */
+	uint32_t addr;
+	/** Key, FLASH_KV_NO_KEY if the slot is empty */
+	uint16_t key;
+};
+
+/**
+ * \brief Key-value store geometry and work memory
+ */
+struct flash_kv_config {
+	/** Flash address of the first block, aligned to the erase block size */
+	uint32_t base;
+	/** Number of erase blocks, at least 2, one is kept erased as spare */
+	uint16_t block_count;
+	/** Number of index slots, a power of two larger than the number of keys */
+	uint16_t index_size;
+	/** RAM hash index, index_size entries */
+	struct flash_kv_entry *index;
+};
+
+/**
+ * \brief Log-structured key-value store
+ */
+struct flash_kv {
+	/** The internal flash */
+	struct flash_descriptor *flash;
+	/** Geometry and work memory */
+	struct flash_kv_config cfg;
+	/** Erase block size */
+	uint32_t block_size;
+	/** Flash page size */
+	uint32_t page_size;
+	/** Sequence number of the active block */
+	uint32_t sequence;
+	/** Flash address of the next record */
+	uint32_t write_addr;
+	/** Block receiving records */
+	uint16_t active;
+	/** Number of erased blocks */
+	uint16_t free_blocks;
+	/** Number of used index slots */
+	uint16_t keys;
+};
+
+/**
+ * \brief Initialize the key-value store
+ *
+ * \param[in] kv The store to initialize
+ * \param[in] flash The initialized internal flash
+ * \param[in] cfg Geometry and work memory, copied
+ *
+ * \return Initialization status.
+ * \retval ERR_INVALID_ARG The geometry is not supported
+ */
+int32_t flash_kv_init(struct flash_kv *const kv, struct flash_descriptor *const flash,
+                      const struct flash_kv_config *const cfg);
+
+/**
+ * \brief Erase all blocks and mount the empty store
+ *
+ * \param[in] kv The store
+ *
+ * \return Operation status.
+ */
+int32_t flash_kv_format(struct flash_kv *const kv);
+
+/**
+ * \brief Rebuild the RAM index from flash
+ *
+ * Records are replayed from the oldest block to the newest one. Records torn
+ * by a power failure are ignored with the rest of their page, blocks
+ * interrupted while being erased or opened are erased again, and an
+ * interrupted garbage collection is resumed.
+ *
+ * \param[in] kv The store
+ *
+ * \return Operation status.
+ */
+int32_t flash_kv_mount(struct flash_kv *const kv);
+
+/**
+ * \brief Read the value of a key
+ *
+ * \param[in] kv The store
+ * \param[in] key The key
+ * \param[out] buf The buffer to read to
+ * \param[in] size Size of the buffer, longer values are truncated
+ *
+ * \return Length of the value or error code.
+ * \retval ERR_NOT_FOUND The key has no value
+ */
+int32_t flash_kv_get(struct flash_kv *const kv, const uint16_t key, void *const buf, const uint16_t size);
+
+/**
+ * \brief Store the value of a key
+ *
+ * The value is appended to the active block with a single page program, an
+ * unchanged value is not written again.
+ *
+ * \param[in] kv The store
+ * \param[in] key The key
+ * \param[in] data The value
+ * \param[in] length Length of the value, 1 to CONF_FLASH_KV_MAX_VALUE_SIZE
+ *
+ * \return Operation status.
+ * \retval ERR_NO_MEMORY The index or the flash is full
+ */
+int32_t flash_kv_set(struct flash_kv *const kv, const uint16_t key, const void *const data, const uint16_t length);
+
+/**
+ * \brief Remove the value of a key
+ *
+ * \param[in] kv The store
+ * \param[in] key The key
+ *
+ * \return Operation status.
+ * \retval ERR_NOT_FOUND The key has no value
+ */
+int32_t flash_kv_delete(struct flash_kv *const kv, const uint16_t key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _FLASH_KV_H_INCLUDED */
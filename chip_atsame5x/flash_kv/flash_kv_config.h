@@ -0,0 +1,17 @@
+/* Auto-generated config file flash_kv_config.h */
+#ifndef FLASH_KV_CONFIG_H
+#define FLASH_KV_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+//<o>Maximum value size <1-496>
+//<i>Largest value stored under one key, in bytes. A record holds an 8 byte
+//<i>header and the value, padded to 16 bytes, and never spans flash pages
+//<id>conf_max_value_size
+#ifndef CONF_FLASH_KV_MAX_VALUE_SIZE
+#define CONF_FLASH_KV_MAX_VALUE_SIZE 120
+#endif
+
+// <<< end of configuration section >>>
+
+#endif // FLASH_KV_CONFIG_H
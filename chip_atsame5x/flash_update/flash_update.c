@@ -0,0 +1,428 @@
+/**
+ * \file
+ *
+ * \brief Dual bank firmware update implementation.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+/*
+ * Support and FAQ: visit <a href="https://www.microchip.com/support/">Microchip Support</a>
+ */
+
+#include <flash_update.h>
+#include <string.h>
+#include <utils.h>
+#include <utils_assert.h>
+
+/**
+ * The running image is always mapped in the first half of the flash, the
+ * inactive bank in the second half. The last block of each bank holds a
+ * struct flash_update_record, the image may use the rest of the bank.
+ *
+ * An image is streamed into the inactive bank, verified and recorded. The
+ * swap marks it as swapped, the first boot marks it on trial and the
+ * application marks it confirmed. A boot with an image still on trial swaps
+ * back to the previous image.
+ */
+
+/** Image record magic, "UPDT" */
+#define FLASH_UPDATE_MAGIC 0x54445055u
+/** Value of a programmed record marker */
+#define FLASH_UPDATE_MARK 0x4B52414Du
+/** Erased flash word */
+#define FLASH_UPDATE_ERASED 0xFFFFFFFFu
+
+/**
+ * \brief Get the address of the record of a bank
+ */
+static uint32_t flash_update_record_addr(struct flash_update *const upd, const uint32_t bank)
+{
+	return bank + upd->bank_size - flash_get_block_size(upd->flash);
+}
+
+/**
+ * \brief Read the record of a bank
+ */
+static int32_t flash_update_read_record(struct flash_update *const upd, const uint32_t bank,
+                                        struct flash_update_record *const rec)
+{
+	return flash_read(upd->flash, flash_update_record_addr(upd, bank), (uint8_t *)rec, sizeof(*rec));
+}
+
+/**
+ * \brief Check whether a record marker is programmed
+ */
+static bool flash_update_is_marked(const uint32_t *const marker)
+{
+	return FLASH_UPDATE_MARK == marker[0];
+}
+
+/**
+ * \brief Program a record marker of a bank
+ */
+static int32_t flash_update_mark(struct flash_update *const upd, const uint32_t bank, const uint32_t offset)
+{
+	uint32_t marker[4] = {FLASH_UPDATE_MARK, FLASH_UPDATE_MARK, FLASH_UPDATE_MARK, FLASH_UPDATE_MARK};
+
+	return flash_write(upd->flash, flash_update_record_addr(upd, bank) + offset, (uint8_t *)marker, sizeof(marker));
+}
+
+/**
+ * \brief Compute the CRC-32 of flash contents with the DSU
+ *
+ * One streaming computation over the whole range, so the DSU is set up once.
+ * crc_sync_update splits the DSU runs, which bounds the time interrupts are
+ * blocked.
+ */
+static int32_t flash_update_crc(struct flash_update *const upd, const uint32_t addr, const uint32_t length,
+                                uint32_t *const crc)
+{
+	struct crc_sync_context ctx;
+	int32_t                 rc;
+
+	rc = crc_sync_begin(upd->crc, &ctx, CRC_SYNC_CRC32);
+	if (rc) {
+		return rc;
+	}
+
+	rc = crc_sync_update(&ctx, (const void *)(FLASH_ADDR + addr), length);
+	if (!rc) {
+		rc = crc_sync_finish(&ctx, crc);
+	} else {
+		crc_sync_finish(&ctx, NULL);
+	}
+
+	return rc;
+}
+
+/**
+ * \brief Check whether a bank holds an image which can be booted
+ *
+ * Recorded images are checked against their CRC, images on trial which never
+ * confirmed are refused. Images programmed without record, like the factory
+ * image, only need an initial stack pointer.
+ */
+static bool flash_update_bank_is_valid(struct flash_update *const upd, const uint32_t bank)
+{
+	struct flash_update_record rec;
+	uint32_t                   crc;
+
+	if (flash_update_read_record(upd, bank, &rec)) {
+		return false;
+	}
+
+	if (FLASH_UPDATE_MAGIC != rec.image[0]) {
+		if (flash_read(upd->flash, bank, (uint8_t *)&crc, sizeof(crc))) {
+			return false;
+		}
+		return FLASH_UPDATE_ERASED != crc;
+	}
+
+	if (flash_update_is_marked(rec.trial) && !flash_update_is_marked(rec.confirmed)) {
+		return false;
+	}
+
+	if ((rec.image[2] != ~rec.image[3]) || (rec.image[1] > flash_update_record_addr(upd, 0))) {
+		return false;
+	}
+
+	if (flash_update_crc(upd, bank, rec.image[1], &crc)) {
+		return false;
+	}
+
+	return crc == rec.image[2];
+}
+
+/**
+ * \brief Initialize the firmware update
+ */
+int32_t flash_update_init(struct flash_update *const upd, struct flash_descriptor *const flash,
+                          struct crc_sync_descriptor *const crc)
+{
+	ASSERT(upd && flash && crc);
+
+	memset(upd, 0, sizeof(*upd));
+	upd->flash          = flash;
+	upd->crc            = crc;
+	upd->bank_size      = flash_get_page_size(flash) * flash_get_total_pages(flash) / 2;
+	upd->jobs[0].status = ERR_NONE;
+	upd->jobs[1].status = ERR_NONE;
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Check the running image at boot, roll back a failed update
+ */
+int32_t flash_update_boot_check(struct flash_update *const upd)
+{
+	struct flash_update_record rec;
+	int32_t                    rc;
+
+	ASSERT(upd);
+
+	rc = flash_update_read_record(upd, 0, &rec);
+	if (rc) {
+		return rc;
+	}
+
+	/* Not swapped to by an update, or already accepted */
+	if ((FLASH_UPDATE_MAGIC != rec.image[0]) || !flash_update_is_marked(rec.swapped)
+	    || flash_update_is_marked(rec.confirmed)) {
+		return ERR_NONE;
+	}
+
+	if (!flash_update_is_marked(rec.trial)) {
+		return flash_update_mark(upd, 0, offsetof(struct flash_update_record, trial));
+	}
+
+	/* Still on trial, the image did not confirm before this reset */
+	if (flash_update_bank_is_valid(upd, upd->bank_size)) {
+		return flash_swap_banks(upd->flash);
+	}
+
+	return ERR_FAILURE;
+}
+
+/**
+ * \brief Start receiving a new image into the inactive bank
+ */
+int32_t flash_update_begin(struct flash_update *const upd, const uint32_t image_size)
+{
+	uint32_t block_size;
+	int32_t  rc;
+
+	ASSERT(upd);
+
+	block_size = flash_get_block_size(upd->flash);
+
+	if (!image_size || (image_size & 3) || (image_size > upd->bank_size - block_size)) {
+		return ERR_INVALID_ARG;
+	}
+
+	if (flash_update_is_busy(upd)) {
+		return ERR_BUSY;
+	}
+
+	upd->image_size = image_size;
+	upd->offset     = 0;
+	upd->fill       = 0;
+	upd->current    = 0;
+
+	/* Erase the record first, an interrupted update never looks valid */
+	upd->jobs[0].type   = FLASH_JOB_ERASE;
+	upd->jobs[0].addr   = flash_update_record_addr(upd, upd->bank_size);
+	upd->jobs[0].length = block_size;
+	upd->jobs[0].cb     = NULL;
+
+	upd->jobs[1].type   = FLASH_JOB_ERASE;
+	upd->jobs[1].addr   = upd->bank_size;
+	upd->jobs[1].length = (image_size + block_size - 1) & ~(block_size - 1);
+	upd->jobs[1].cb     = NULL;
+
+	rc = flash_submit_job(upd->flash, &upd->jobs[0]);
+	if (rc) {
+		return rc;
+	}
+
+	return flash_submit_job(upd->flash, &upd->jobs[1]);
+}
+
+/**
+ * \brief Stream image data into the inactive bank
+ */
+int32_t flash_update_write(struct flash_update *const upd, const uint8_t *const data, const uint32_t length)
+{
+	struct flash_job *job;
+	uint32_t          done = 0;
+	uint32_t          size;
+	int32_t           rc;
+
+	ASSERT(upd && data);
+
+	if (upd->offset + upd->fill + length > upd->image_size) {
+		return ERR_WRONG_LENGTH;
+	}
+
+	while (done < length) {
+		job = &upd->jobs[upd->current];
+
+		/* The page buffer is still being programmed */
+		if (ERR_BUSY == job->status) {
+			break;
+		}
+		if (ERR_NONE != job->status) {
+			return job->status;
+		}
+
+		size = min(length - done, sizeof(upd->page[0]) - upd->fill);
+		memcpy((uint8_t *)upd->page[upd->current] + upd->fill, data + done, size);
+		upd->fill += size;
+		done += size;
+
+		if ((sizeof(upd->page[0]) == upd->fill) || (upd->offset + upd->fill == upd->image_size)) {
+			job->type   = FLASH_JOB_PROGRAM;
+			job->addr   = upd->bank_size + upd->offset;
+			job->buffer = (const uint8_t *)upd->page[upd->current];
+			job->length = upd->fill;
+			job->cb     = NULL;
+
+			rc = flash_submit_job(upd->flash, job);
+			if (rc) {
+				return rc;
+			}
+
+			upd->offset += upd->fill;
+			upd->fill    = 0;
+			upd->current = !upd->current;
+		}
+	}
+
+	return (int32_t)done;
+}
+
+/**
+ * \brief Check whether the image is still being erased or programmed
+ */
+bool flash_update_is_busy(struct flash_update *const upd)
+{
+	ASSERT(upd);
+
+	return (ERR_BUSY == upd->jobs[0].status) || (ERR_BUSY == upd->jobs[1].status);
+}
+
+/**
+ * \brief Verify the received image and record it
+ */
+int32_t flash_update_finish(struct flash_update *const upd, const uint32_t crc)
+{
+	uint32_t image[4];
+	uint32_t value;
+	uint8_t  i;
+	int32_t  rc;
+
+	ASSERT(upd);
+
+	if (flash_update_is_busy(upd)) {
+		return ERR_BUSY;
+	}
+
+	for (i = 0; i < 2; i++) {
+		if (ERR_NONE != upd->jobs[i].status) {
+			return upd->jobs[i].status;
+		}
+	}
+
+	if (!upd->image_size || (upd->offset != upd->image_size)) {
+		return ERR_WRONG_LENGTH;
+	}
+
+	rc = flash_update_crc(upd, upd->bank_size, upd->image_size, &value);
+	if (rc) {
+		return rc;
+	}
+
+	if (value != crc) {
+		return ERR_BAD_DATA;
+	}
+
+	image[0] = FLASH_UPDATE_MAGIC;
+	image[1] = upd->image_size;
+	image[2] = crc;
+	image[3] = ~crc;
+
+	return flash_write(upd->flash, flash_update_record_addr(upd, upd->bank_size), (uint8_t *)image, sizeof(image));
+}
+
+/**
+ * \brief Swap to the recorded image in the inactive bank
+ */
+int32_t flash_update_swap(struct flash_update *const upd)
+{
+	struct flash_update_record rec;
+	int32_t                    rc;
+
+	ASSERT(upd);
+
+	rc = flash_update_read_record(upd, upd->bank_size, &rec);
+	if (rc) {
+		return rc;
+	}
+
+	if ((FLASH_UPDATE_MAGIC != rec.image[0]) || flash_update_is_marked(rec.swapped)) {
+		return ERR_NOT_FOUND;
+	}
+
+	rc = flash_update_mark(upd, upd->bank_size, offsetof(struct flash_update_record, swapped));
+	if (rc) {
+		return rc;
+	}
+
+	return flash_swap_banks(upd->flash);
+}
+
+/**
+ * \brief Accept the running image
+ */
+int32_t flash_update_confirm(struct flash_update *const upd)
+{
+	struct flash_update_record rec;
+	int32_t                    rc;
+
+	ASSERT(upd);
+
+	rc = flash_update_read_record(upd, 0, &rec);
+	if (rc) {
+		return rc;
+	}
+
+	if ((FLASH_UPDATE_MAGIC != rec.image[0]) || !flash_update_is_marked(rec.swapped)
+	    || flash_update_is_marked(rec.confirmed)) {
+		return ERR_NONE;
+	}
+
+	return flash_update_mark(upd, 0, offsetof(struct flash_update_record, confirmed));
+}
+
+/**
+ * \brief Swap back to the image in the inactive bank
+ */
+int32_t flash_update_rollback(struct flash_update *const upd)
+{
+	ASSERT(upd);
+
+	if (flash_update_is_busy(upd)) {
+		return ERR_BUSY;
+	}
+
+	if (!flash_update_bank_is_valid(upd, upd->bank_size)) {
+		return ERR_NOT_FOUND;
+	}
+
+	return flash_swap_banks(upd->flash);
+}
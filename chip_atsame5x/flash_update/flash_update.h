@@ -0,0 +1,205 @@
+/**
+ * \file
+ *
+ * \brief Dual bank firmware update declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+/*
+ * Support and FAQ: visit <a href="https://www.microchip.com/support/">Microchip Support</a>
+ */
+
+#ifndef _FLASH_UPDATE_H_INCLUDED
+#define _FLASH_UPDATE_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <hal_flash.h>
+#include <hal_crc_sync.h>
+
+/**
+ * \brief Update state stored in the last block of each bank
+ *
+ * Every field is one quad word, programmed once after the block erase.
+ */
+struct flash_update_record {
+	/** Image magic, size in bytes, CRC-32 and inverted CRC-32 */
+	uint32_t image[4];
+	/** Marked before the swap to this bank */
+	uint32_t swapped[4];
+	/** Marked on the first boot after the swap */
+	uint32_t trial[4];
+	/** Marked once the application accepts the image */
+	uint32_t confirmed[4];
+};
+
+/**
+ * \brief Dual bank firmware update
+ */
+struct flash_update {
+	/** The internal flash */
+	struct flash_descriptor *flash;
+	/** The DSU CRC, used to verify images */
+	struct crc_sync_descriptor *crc;
+	/** Size of a bank in bytes */
+	uint32_t bank_size;
+	/** Size of the image being received */
+	uint32_t image_size;
+	/** Number of image bytes queued for programming */
+	uint32_t offset;
+	/** Number of bytes in the page buffer being filled */
+	uint32_t fill;
+	/** Index of the page buffer being filled */
+	uint8_t current;
+	/** One job per page buffer, the first ones also erase the bank */
+	struct flash_job jobs[2];
+	/** Page buffers, programmed while the other one is filled */
+	uint32_t page[2][NVMCTRL_PAGE_SIZE / 4];
+};
+
+/**
+ * \brief Initialize the firmware update
+ *
+ * \param[in] upd The update to initialize
+ * \param[in] flash The initialized internal flash
+ * \param[in] crc The initialized and enabled DSU CRC
+ *
+ * \return Initialization status.
+ */
+int32_t flash_update_init(struct flash_update *const upd, struct flash_descriptor *const flash,
+                          struct crc_sync_descriptor *const crc);
+
+/**
+ * \brief Check the running image at boot, roll back a failed update
+ *
+ * Must be called early at every boot. The first boot after a swap marks the
+ * running image as on trial. Booting again while the image is still on trial
+ * means it never confirmed, the banks are then swapped back if the other bank
+ * holds a valid image. In that case the function does not return.
+ *
+ * \param[in] upd The update
+ *
+ * \return Operation status.
+ * \retval ERR_NONE The running image is confirmed, on trial or not managed
+ * \retval ERR_FAILURE The running image failed but no valid image to roll back
+ */
+int32_t flash_update_boot_check(struct flash_update *const upd);
+
+/**
+ * \brief Start receiving a new image into the inactive bank
+ *
+ * Queues the erase of the inactive bank, the application keeps running.
+ *
+ * \param[in] upd The update
+ * \param[in] image_size Size of the image in bytes, a multiple of 4
+ *
+ * \return Operation status.
+ * \retval ERR_INVALID_ARG The image does not fit in a bank
+ * \retval ERR_BUSY The flash is busy
+ */
+int32_t flash_update_begin(struct flash_update *const upd, const uint32_t image_size);
+
+/**
+ * \brief Stream image data into the inactive bank
+ *
+ * Data is copied into a page buffer, full pages are programmed in the
+ * background. Fewer bytes than requested are taken while both page buffers
+ * wait for the flash, the remaining bytes have to be passed again later.
+ *
+ * \param[in] upd The update
+ * \param[in] data The image data
+ * \param[in] length Number of bytes to write
+ *
+ * \return Number of bytes taken or error code.
+ */
+int32_t flash_update_write(struct flash_update *const upd, const uint8_t *const data, const uint32_t length);
+
+/**
+ * \brief Check whether the image is still being erased or programmed
+ *
+ * \param[in] upd The update
+ *
+ * \return true if flash jobs of the update are pending
+ */
+bool flash_update_is_busy(struct flash_update *const upd);
+
+/**
+ * \brief Verify the received image and record it
+ *
+ * \param[in] upd The update
+ * \param[in] crc Expected CRC-32 (IEEE 802.3) of the image
+ *
+ * \return Operation status.
+ * \retval ERR_BUSY The image is still being programmed
+ * \retval ERR_WRONG_LENGTH The image was not received completely
+ * \retval ERR_BAD_DATA The CRC does not match
+ */
+int32_t flash_update_finish(struct flash_update *const upd, const uint32_t crc);
+
+/**
+ * \brief Swap to the recorded image in the inactive bank
+ *
+ * Resets the device, the function only returns on error.
+ *
+ * \param[in] upd The update
+ *
+ * \return Operation status.
+ * \retval ERR_NOT_FOUND The inactive bank holds no valid image
+ */
+int32_t flash_update_swap(struct flash_update *const upd);
+
+/**
+ * \brief Accept the running image
+ *
+ * The image is no longer rolled back on the next boot.
+ *
+ * \param[in] upd The update
+ *
+ * \return Operation status.
+ */
+int32_t flash_update_confirm(struct flash_update *const upd);
+
+/**
+ * \brief Swap back to the image in the inactive bank
+ *
+ * Resets the device, the function only returns on error.
+ *
+ * \param[in] upd The update
+ *
+ * \return Operation status.
+ * \retval ERR_NOT_FOUND The inactive bank holds no valid image
+ */
+int32_t flash_update_rollback(struct flash_update *const upd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _FLASH_UPDATE_H_INCLUDED */
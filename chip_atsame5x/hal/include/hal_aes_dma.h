@@ -0,0 +1,285 @@
+/**
+ * \file
+ *
+ * \brief AES DMA related functionality declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#ifndef _HAL_AES_DMA_INCLUDED
+#define _HAL_AES_DMA_INCLUDED
+
+#include <hpl_aes_dma.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup doc_driver_hal_aes_dma
+ *
+ *@{
+ */
+
+struct aes_dma_descriptor;
+
+/**
+ * \brief AES completion callback type
+ */
+typedef void (*aes_dma_cb_t)(struct aes_dma_descriptor *const descr);
+
+/**
+ * \brief AES callbacks
+ */
+struct aes_dma_callbacks {
+	/** Operation completed */
+	aes_dma_cb_t done;
+	/** DMA error during the operation */
+	aes_dma_cb_t error;
+};
+
+/**
+ * \brief AES descriptor structure
+ */
+struct aes_dma_descriptor {
+	struct _aes_dma_device   dev;
+	struct aes_dma_callbacks cb;
+	/** An operation is in progress */
+	volatile bool busy;
+};
+
+/**
+ * \brief Initialize AES
+ *
+ * The DMA channel CONF_AES_DMA_TX_CHANNEL must be configured for word beats
+ * triggered by the AES write trigger (AES_DMAC_ID_WR), and the channel
+ * CONF_AES_DMA_RX_CHANNEL by the AES read trigger (AES_DMAC_ID_RD).
+ *
+ * \param[out] descr The AES descriptor to initialize
+ * \param[in] hw The pointer to hardware instance
+ *
+ * \return Initialization status.
+ */
+int32_t aes_dma_init(struct aes_dma_descriptor *descr, void *const hw);
+
+/**
+ * \brief Deinitialize AES
+ *
+ * \param[in] descr The AES descriptor to deinitialize
+ *
+ * \return De-initialization status.
+ */
+int32_t aes_dma_deinit(struct aes_dma_descriptor *descr);
+
+/**
+ * \brief Enable AES
+ *
+ * \param[in] descr The AES descriptor
+ *
+ * \return Enabling status.
+ */
+int32_t aes_dma_enable(struct aes_dma_descriptor *descr);
+
+/**
+ * \brief Disable AES
+ *
+ * \param[in] descr The AES descriptor
+ *
+ * \return Disabling status.
+ */
+int32_t aes_dma_disable(struct aes_dma_descriptor *descr);
+
+/**
+ * \brief Set AES Key (encryption)
+ *
+ * \param[in] descr The AES descriptor
+ * \param[in] key Encryption key
+ * \param[in] size Bit length of key
+ *
+ * \return Operation status.
+ * \retval ERR_BUSY An operation is in progress
+ */
+int32_t aes_dma_set_encrypt_key(struct aes_dma_descriptor *descr, const uint8_t *key, const enum aes_keysize size);
+
+/**
+ * \brief Set AES Key (decryption)
+ *
+ * \param[in] descr The AES descriptor
+ * \param[in] key Decryption key
+ * \param[in] size Bit length of key
+ *
+ * \return Operation status.
+ * \retval ERR_BUSY An operation is in progress
+ */
+int32_t aes_dma_set_decrypt_key(struct aes_dma_descriptor *descr, const uint8_t *key, const enum aes_keysize size);
+
+/**
+ * \brief Register an AES callback
+ *
+ * \param[in] descr The AES descriptor
+ * \param[in] type The callback type
+ * \param[in] cb The callback function, NULL to unregister
+ *
+ * \return Operation status.
+ */
+int32_t aes_dma_register_callback(struct aes_dma_descriptor *descr, const enum _aes_dma_cb_type type,
+                                  aes_dma_cb_t cb);
+
+/**
+ * \brief Start AES-ECB encryption/decryption of blocks
+ *
+ * The function returns as soon as the DMA has started, the done callback is
+ * invoked from the DMA interrupt. The buffers must stay valid until then.
+ *
+ * \param[in] descr The AES descriptor
+ * \param[in] enc AES_ENCRYPT or AES_DECRYPT
+ * \param[in] input Input data, word aligned
+ * \param[out] output Output data, word aligned, may be the input
+ * \param[in] length Byte length of the input, a multiple of 16
+ *
+ * \return Operation status.
+ * \retval ERR_BUSY An operation is in progress
+ * \retval ERR_INVALID_ARG The buffers are not aligned or the length not a
+ *         multiple of 16
+ */
+int32_t aes_dma_ecb_crypt(struct aes_dma_descriptor *descr, const enum aes_action enc, const uint8_t *input,
+                          uint8_t *output, uint32_t length);
+
+/**
+ * \brief Start AES-CBC encryption/decryption
+ *
+ * See aes_dma_ecb_crypt. The IV is updated for the next call when the done
+ * callback is invoked.
+ *
+ * \param[in] descr The AES descriptor
+ * \param[in] enc AES_ENCRYPT or AES_DECRYPT
+ * \param[in] input Input data, word aligned
+ * \param[out] output Output data, word aligned, may be the input
+ * \param[in] length Byte length of the input, a multiple of 16
+ * \param[in,out] iv Initialization Vector
+ *
+ * \return Operation status.
+ * \retval ERR_BUSY An operation is in progress
+ * \retval ERR_INVALID_ARG The buffers are not aligned or the length not a
+ *         multiple of 16
+ */
+int32_t aes_dma_cbc_crypt(struct aes_dma_descriptor *descr, const enum aes_action enc, const uint8_t *input,
+                          uint8_t *output, uint32_t length, uint8_t iv[16]);
+
+/**
+ * \brief Start AES-CTR encryption/decryption
+ *
+ * See aes_dma_ecb_crypt. The counter is updated for the next call when the
+ * done callback is invoked.
+ *
+ * \param[in] descr The AES descriptor
+ * \param[in] input Input data, word aligned
+ * \param[out] output Output data, word aligned, may be the input
+ * \param[in] length Byte length of the input, a multiple of 16
+ * \param[in,out] nc The 128-bit nonce and counter
+ *
+ * \return Operation status.
+ * \retval ERR_BUSY An operation is in progress
+ * \retval ERR_INVALID_ARG The buffers are not aligned or the length not a
+ *         multiple of 16
+ */
+int32_t aes_dma_ctr_crypt(struct aes_dma_descriptor *descr, const uint8_t *input, uint8_t *output, uint32_t length,
+                          uint8_t nc[16]);
+
+/**
+ * \brief Start GCM message, processing the IV and the additional data
+ *
+ * Runs on the CPU and returns when done.
+ *
+ * \param[in] descr The AES descriptor
+ * \param[in] enc AES_ENCRYPT or AES_DECRYPT
+ * \param[in] iv Initialization Vector
+ * \param[in] iv_len Length of the IV
+ * \param[in] aad Additional data
+ * \param[in] aad_len Length of the additional data
+ *
+ * \return Operation status.
+ * \retval ERR_BUSY An operation is in progress
+ */
+int32_t aes_dma_gcm_start(struct aes_dma_descriptor *const descr, const enum aes_action enc, const uint8_t *iv,
+                          uint32_t iv_len, const uint8_t *aad, uint32_t aad_len);
+
+/**
+ * \brief Start GCM encryption/decryption of the whole message
+ *
+ * All blocks but the last one are moved by the DMA, the last one is
+ * processed in the DMA interrupt before the done callback. A message of at
+ * most one block completes before the function returns.
+ *
+ * \param[in] descr The AES descriptor
+ * \param[in] input Input data, word aligned
+ * \param[out] output Output data, word aligned, may be the input
+ * \param[in] length Byte length of the input
+ *
+ * \return Operation status.
+ * \retval ERR_BUSY An operation is in progress
+ * \retval ERR_INVALID_ARG The buffers are not aligned
+ */
+int32_t aes_dma_gcm_update(struct aes_dma_descriptor *const descr, const uint8_t *input, uint8_t *output,
+                           uint32_t length);
+
+/**
+ * \brief Generate the GCM tag, after the done callback of the update
+ *
+ * \param[in] descr The AES descriptor
+ * \param[out] tag Authentication tag
+ * \param[in] tag_len Length of the tag
+ *
+ * \return Operation status.
+ * \retval ERR_BUSY An operation is in progress
+ */
+int32_t aes_dma_gcm_finish(struct aes_dma_descriptor *const descr, uint8_t *tag, uint32_t tag_len);
+
+/**
+ * \brief Check if an operation is in progress
+ *
+ * \param[in] descr The AES descriptor
+ *
+ * \return true if an operation is in progress
+ */
+bool aes_dma_is_busy(const struct aes_dma_descriptor *descr);
+
+/**
+ * \brief Retrieve the current driver version
+ *
+ * \return Current driver version.
+ */
+uint32_t aes_dma_get_version(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HAL_AES_DMA_INCLUDED */
@@ -98,6 +98,49 @@ int32_t aes_sync_set_encrypt_key(struct aes_sync_descriptor *descr, const uint8_
  */
 int32_t aes_sync_set_decrypt_key(struct aes_sync_descriptor *descr, const uint8_t *key, const enum aes_keysize size);
 
+/**
+ * \brief              Store a key in a key slot and select it
+ *
+ * Keys in slots are written to the hardware only when a different key was
+ * used last, and the GCM hash subkey is computed once per slot. Other
+ * descriptors that selected the slot use the new key from their next operation.
+ *
+ * \param[in] desc     The AES descriptor
+ * \param[in] slot     Key slot, less than CONF_AES_KEY_SLOTS
+ * \param[in] key      Encryption/decryption key
+ * \param[in] size     Bit length of key
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_ARG if the slot
+ *                     does not exist
+ */
+int32_t aes_sync_set_slot_key(struct aes_sync_descriptor *descr, const uint8_t slot, const uint8_t *key,
+                              const enum aes_keysize size);
+
+/**
+ * \brief              Use the key stored in a key slot
+ *
+ * The key stays selected until another slot is selected or a key is set
+ * with aes_sync_set_encrypt_key/aes_sync_set_decrypt_key.
+ *
+ * \param[in] desc     The AES descriptor
+ * \param[in] slot     Key slot, less than CONF_AES_KEY_SLOTS
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_ARG if the slot
+ *                     does not exist, ERR_NOT_FOUND if it holds no key
+ */
+int32_t aes_sync_select_key_slot(struct aes_sync_descriptor *descr, const uint8_t slot);
+
+/**
+ * \brief              Erase a key slot and the material derived from it
+ *
+ * \param[in] desc     The AES descriptor
+ * \param[in] slot     Key slot, less than CONF_AES_KEY_SLOTS
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_ARG if the slot
+ *                     does not exist
+ */
+int32_t aes_sync_clear_key_slot(struct aes_sync_descriptor *descr, const uint8_t slot);
+
 /**
  * \brief              AES-ECB block encryption/decryption
  *
@@ -318,6 +361,43 @@ int32_t aes_sync_gcm_update(struct aes_sync_descriptor *const descr, const uint8
  */
 int32_t aes_sync_gcm_finish(struct aes_sync_descriptor *const descr, uint8_t *tag, uint32_t tag_len);
 
+/**
+ * \brief              AES-GCM encryption/decryption of a batch of messages
+ *
+ * All messages use the key currently set. The key and the GHASH subkey are
+ * loaded once for the whole batch instead of once per message. On encrypt
+ * the tag of each job is written, on decrypt it is compared and the job
+ * status is set to ERR_INVALID_DATA if it does not match.
+ *
+ * \param[in]  descr   The AES descriptor
+ * \param[in]  enc     AES_SYNC_ENCRYPT or AES_SYNC_DECRYPT
+ * \param[in]  jobs    Array of messages
+ * \param[in]  count   Number of messages
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_DATA if a tag
+ *                     did not match on decrypt
+ */
+int32_t aes_sync_gcm_crypt_and_tag_batch(struct aes_sync_descriptor *const descr, const enum aes_action enc,
+                                         struct aes_gcm_job *const jobs, const uint32_t count);
+
+/**
+ * \brief              Measure per message cycles of single and batched AES-GCM
+ *
+ * Encrypts the jobs once with aes_sync_gcm_crypt_and_tag per message and
+ * once with aes_sync_gcm_crypt_and_tag_batch, counting CPU cycles with the
+ * DWT. Outputs and tags of the jobs are overwritten.
+ *
+ * \param[in]  descr         The AES descriptor
+ * \param[in]  jobs          Array of messages
+ * \param[in]  count         Number of messages
+ * \param[out] single_cycles Average cycles per message, one call per message
+ * \param[out] batch_cycles  Average cycles per message, batched
+ *
+ * \return             ERR_NONE if successful
+ */
+int32_t aes_sync_gcm_benchmark(struct aes_sync_descriptor *const descr, struct aes_gcm_job *const jobs,
+                               const uint32_t count, uint32_t *const single_cycles, uint32_t *const batch_cycles);
+
 /**
  * \brief              AES-CCM block encryption/decryption
  *
@@ -360,6 +440,73 @@ int32_t aes_sync_ccm_auth_decrypt(struct aes_sync_descriptor *const descr, const
                                   uint32_t length, const uint8_t *iv, uint32_t iv_len, const uint8_t *aad,
                                   uint32_t aad_len, const uint8_t *tag, uint32_t tag_len);
 
+/**
+ * \brief              AES-CMAC message authentication (NIST SP 800-38B)
+ *
+ * \param[in]  descr   The AES descriptor
+ * \param[in]  input   Buffer holding the message
+ * \param[in]  length  Byte length of the message
+ * \param[out] mac     Buffer holding the MAC
+ * \param[in]  mac_len Length of MAC, at most 16
+ *
+ * \return             ERR_NONE if successful
+ */
+int32_t aes_sync_cmac(struct aes_sync_descriptor *const descr, const uint8_t *input, uint32_t length, uint8_t *mac,
+                      uint32_t mac_len);
+
+/**
+ * \brief              AES-XTS data unit encryption/decryption (IEEE 1619)
+ *
+ * The descriptor key is the data key. A data unit that is not a multiple of
+ * 16 bytes is handled with ciphertext stealing. Input and output may be the
+ * same buffer.
+ *
+ * \param[in]  descr     The AES descriptor
+ * \param[in]  enc       AES_SYNC_ENCRYPT or AES_SYNC_DECRYPT
+ * \param[in]  tweak_key Tweak key, same size as the data key
+ * \param[in]  input     Buffer holding the input data
+ * \param[out] output    Buffer holding the output data
+ * \param[in]  length    Byte length of the data unit, at least 16
+ * \param[in]  tweak     128-bit tweak, the data unit number
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_ARG if length is
+ *                     less than 16
+ */
+int32_t aes_sync_xts_crypt(struct aes_sync_descriptor *const descr, const enum aes_action enc,
+                           const uint8_t *tweak_key, const uint8_t *input, uint8_t *output, uint32_t length,
+                           const uint8_t tweak[16]);
+
+/**
+ * \brief              AES key wrap (RFC 3394)
+ *
+ * The descriptor key is the key encryption key. Input and output may be
+ * the same buffer.
+ *
+ * \param[in]  descr   The AES descriptor
+ * \param[in]  input   Key data to wrap
+ * \param[out] output  Wrapped key, length + 8 bytes
+ * \param[in]  length  Byte length of the key data, a multiple of 8, at least 16
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_ARG if the length
+ *                     is not supported
+ */
+int32_t aes_sync_kw_wrap(struct aes_sync_descriptor *const descr, const uint8_t *input, uint8_t *output,
+                         uint32_t length);
+
+/**
+ * \brief              AES key unwrap (RFC 3394)
+ *
+ * \param[in]  descr   The AES descriptor
+ * \param[in]  input   Wrapped key
+ * \param[out] output  Key data, length - 8 bytes, cleared if the check fails
+ * \param[in]  length  Byte length of the wrapped key, a multiple of 8, at least 24
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_DATA if the
+ *                     integrity check failed
+ */
+int32_t aes_sync_kw_unwrap(struct aes_sync_descriptor *const descr, const uint8_t *input, uint8_t *output,
+                           uint32_t length);
+
 /**
  * \brief Retrieve the current driver version
  *
@@ -36,6 +36,7 @@
 
 #include <hpl_crc_sync.h>
 #include <utils_assert.h>
+#include <utils_crc.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,11 +48,41 @@ extern "C" {
  *@{
  */
 
+/**
+ * \brief CRC polynomials
+ */
+enum crc_sync_polynomial {
+	CRC_SYNC_CRC32,      /*!< CRC-32 (IEEE 802.3), reflected */
+	CRC_SYNC_CRC32C,     /*!< CRC-32C (Castagnoli), reflected */
+	CRC_SYNC_CRC16_CCITT /*!< CRC-16 (CCITT), not reflected */
+};
+
+/**
+ * \brief CRC engines
+ */
+enum crc_sync_engine {
+	CRC_SYNC_ENGINE_AUTO,     /*!< Select by polynomial and length */
+	CRC_SYNC_ENGINE_SOFTWARE, /*!< Slice-by-8 tables, all polynomials */
+	CRC_SYNC_ENGINE_DSU,      /*!< DSU, CRC-32 only */
+	CRC_SYNC_ENGINE_DMAC      /*!< DMAC CRC through the I/O interface, CRC-16 only */
+};
+
 /**
  * \brief CRC descriptor
  */
 struct crc_sync_descriptor {
-	struct _crc_sync_device dev; /*!< CRC HPL device descriptor */
+	struct _crc_sync_device dev;            /*!< CRC HPL device descriptor */
+	uint32_t                dsu_threshold;  /*!< Shortest length computed by the DSU */
+	uint32_t                dmac_threshold; /*!< Shortest length computed by the DMAC */
+};
+
+/**
+ * \brief Streaming CRC context
+ */
+struct crc_sync_context {
+	struct crc_sync_descriptor *descr; /*!< CRC descriptor */
+	enum crc_sync_polynomial    poly;  /*!< The polynomial */
+	uint32_t                    crc;   /*!< Running CRC value */
 };
 
 /**
@@ -106,10 +137,10 @@ int32_t crc_sync_disable(struct crc_sync_descriptor *const descr);
 /**
  * \brief Calculate CRC32 value of the buffer
  *
- * This function calculates the standard CRC-32 (IEEE 802.3).
+ * This function calculates the standard CRC-32 (IEEE 802.3) with the DSU.
  *
- * \param[in] data Pointer to the input data buffer
- * \param[in] len Length of the input data buffer
+ * \param[in] data Pointer to the input data buffer, word aligned
+ * \param[in] len Length of the input data buffer in words
  * \param[in,out] pcrc Pointer to the CRC value
  *
  * \return Calculated result.
@@ -120,10 +151,10 @@ int32_t crc_sync_crc32(struct crc_sync_descriptor *const descr, uint32_t *const
 /**
  * \brief Calculate the CRC16 value of the buffer
  *
- * This function calculates CRC-16 (CCITT).
+ * This function calculates CRC-16 (CCITT), with the DMAC CRC or in software.
  *
  * \param[in] data Pointer to the input data buffer
- * \param[in] len Length of the input data buffer
+ * \param[in] len Length of the input data buffer in half words
  * \param[in,out] pcrc Pointer to the CRC value
  *
  * \return Calculated result.
@@ -131,6 +162,115 @@ int32_t crc_sync_crc32(struct crc_sync_descriptor *const descr, uint32_t *const
 int32_t crc_sync_crc16(struct crc_sync_descriptor *const descr, uint16_t *const data, const uint32_t len,
                        uint16_t *pcrc);
 
+/**
+ * \brief Calculate the CRC of a buffer with the fastest engine
+ *
+ * The DSU or the DMAC compute the buffer when it is at least as long as their
+ * threshold, and the polynomial is supported by them. Bytes before and after
+ * the aligned part are computed in software, so any alignment is accepted.
+ * The software computes the buffer when the DMAC CRC is used by a DMA
+ * channel.
+ *
+ * \param[in] descr A CRC descriptor
+ * \param[in] poly The polynomial
+ * \param[in] data Pointer to the input data buffer
+ * \param[in] length Length of the input data buffer in bytes
+ * \param[in,out] pcrc Pointer to the running CRC value, without final XOR
+ *
+ * \return Calculated result.
+ */
+int32_t crc_sync_compute(struct crc_sync_descriptor *const descr, const enum crc_sync_polynomial poly,
+                         const void *const data, const uint32_t length, uint32_t *pcrc);
+
+/**
+ * \brief Start a streaming CRC
+ *
+ * The CRC is started with the standard initial value, 0xFFFFFFFF for CRC32
+ * and CRC32C and 0xFFFF for CRC16. For CRC32, the DSU is kept writable until
+ * crc_sync_finish, so that updates skip the PAC unlock and lock.
+ *
+ * \param[in] descr A CRC descriptor
+ * \param[out] ctx The context to start
+ * \param[in] poly The polynomial
+ *
+ * \return Operation status.
+ */
+int32_t crc_sync_begin(struct crc_sync_descriptor *const descr, struct crc_sync_context *const ctx,
+                       const enum crc_sync_polynomial poly);
+
+/**
+ * \brief Add a chunk of data to a streaming CRC
+ *
+ * Chunks need not be contiguous nor aligned. The engine is selected for
+ * each chunk as by crc_sync_compute, long DSU runs are split so that
+ * interrupts are not disabled for more than CONF_DSU_CRC_RUN_LENGTH words.
+ *
+ * \param[in] ctx The started context
+ * \param[in] data Pointer to the chunk
+ * \param[in] length Length of the chunk in bytes
+ *
+ * \return Operation status.
+ */
+int32_t crc_sync_update(struct crc_sync_context *const ctx, const void *const data, const uint32_t length);
+
+/**
+ * \brief Finish a streaming CRC
+ *
+ * Applies the final XOR of the polynomial and releases the DSU. Must be
+ * called for each started context, also after a failed update.
+ *
+ * \param[in] ctx The started context
+ * \param[out] crc The CRC, NULL if not needed
+ *
+ * \return Operation status.
+ */
+int32_t crc_sync_finish(struct crc_sync_context *const ctx, uint32_t *const crc);
+
+/**
+ * \brief Set the shortest length computed by a hardware engine
+ *
+ * \param[in] descr A CRC descriptor
+ * \param[in] engine CRC_SYNC_ENGINE_DSU or CRC_SYNC_ENGINE_DMAC
+ * \param[in] length The length in bytes, UINT32_MAX to never use the engine
+ *
+ * \return Operation status.
+ */
+int32_t crc_sync_set_threshold(struct crc_sync_descriptor *const descr, const enum crc_sync_engine engine,
+                               const uint32_t length);
+
+/**
+ * \brief Measure the time an engine takes to calculate a CRC
+ *
+ * \param[in] descr A CRC descriptor
+ * \param[in] poly The polynomial
+ * \param[in] engine The engine to measure
+ * \param[in] data Pointer to the input data buffer
+ * \param[in] length Length of the input data buffer in bytes
+ * \param[out] cycles The number of CPU cycles spent
+ *
+ * \return Operation status.
+ * \retval ERR_UNSUPPORTED_OP The engine does not support the polynomial
+ */
+int32_t crc_sync_benchmark(struct crc_sync_descriptor *const descr, const enum crc_sync_polynomial poly,
+                           const enum crc_sync_engine engine, const void *const data, const uint32_t length,
+                           uint32_t *const cycles);
+
+/**
+ * \brief Find the lengths above which the hardware engines are faster
+ *
+ * Benchmarks each hardware engine against the software, on doubling lengths
+ * and then by bisection, and sets the thresholds to the crossover lengths.
+ * The buffer should be in the memory holding the data usually checked, as
+ * flash wait states and bus contention move the crossovers.
+ *
+ * \param[in] descr A CRC descriptor
+ * \param[in] buffer The data to benchmark with, word aligned
+ * \param[in] size Size of the buffer in bytes, the longest length tried
+ *
+ * \return Operation status.
+ */
+int32_t crc_sync_calibrate(struct crc_sync_descriptor *const descr, const void *const buffer, const uint32_t size);
+
 /**
  * \brief Retrieve the current driver version
  *
@@ -35,6 +35,7 @@
 #define _HAL_FLASH_H_INCLUDED
 
 #include <hpl_flash.h>
+#include <utils_list.h>
 
 /**
  * \addtogroup doc_driver_hal_flash
@@ -73,6 +74,44 @@ struct flash_callbacks {
 	flash_cb_t cb_error;
 };
 
+/** The flash job types */
+enum flash_job_type {
+	/** Erase whole blocks */
+	FLASH_JOB_ERASE,
+	/** Program erased flash, like \ref flash_append */
+	FLASH_JOB_PROGRAM
+};
+
+struct flash_job;
+
+/** \brief Prototype of callback on flash job completion
+ *
+ */
+typedef void (*flash_job_cb_t)(struct flash_descriptor *const descr, struct flash_job *const job);
+
+/** \brief Flash job, queued with \ref flash_submit_job
+ *
+ *  The job and its buffer must stay valid until the job completes.
+ */
+struct flash_job {
+	/** List element, used by the driver */
+	struct list_element elem;
+	/** Job type */
+	enum flash_job_type type;
+	/** Destination bytes address, block aligned for erase */
+	uint32_t addr;
+	/** Pointer to the data to program, unused for erase */
+	const uint8_t *buffer;
+	/** Number of bytes to program or to erase */
+	uint32_t length;
+	/** Callback invoked when the job completes, can be NULL */
+	flash_job_cb_t cb;
+	/** Number of bytes already handled, used by the driver */
+	uint32_t offset;
+	/** ERR_BUSY while queued, then the job status */
+	volatile int32_t status;
+};
+
 /** \brief FLASH HAL driver struct for asynchronous access
  */
 struct flash_descriptor {
@@ -80,6 +119,8 @@ struct flash_descriptor {
 	struct _flash_device dev;
 	/** Callbacks for asynchronous transfer */
 	struct flash_callbacks callbacks;
+	/** Queue of pending jobs, the head is in progress */
+	struct list_descriptor jobs;
 };
 
 /** \brief Initialize the FLASH HAL instance and hardware for callback mode
@@ -135,6 +176,35 @@ int32_t flash_append(struct flash_descriptor *flash, uint32_t dst_addr, uint8_t
  */
 int32_t flash_read(struct flash_descriptor *flash, uint32_t src_addr, uint8_t *buffer, uint32_t length);
 
+/** \brief Set the scratch buffer used to rewrite a flash block
+ *
+ *  A write that has to change already programmed data erases the enclosing
+ *  block and writes it back. The block content is kept in this buffer in the
+ *  meantime, instead of in the static buffer of the driver, or in a temporary
+ *  buffer in stack when CONF_NVM_STATIC_BLOCK_BUFFER is 0.
+ *
+ *  \param[in, out] flash Pointer to the HAL FLASH instance.
+ *  \param[in]  buffer    Pointer to a word aligned buffer which can hold a
+ *                        whole erase block, NULL to fall back to the driver
+ *                        managed buffer
+ *  \return Operation status.
+ */
+int32_t flash_set_block_buffer(struct flash_descriptor *flash, uint32_t *buffer);
+
+/** \brief Get read-only access to the flash content without copy
+ *
+ *  The flash is memory mapped, the returned pointer can be used for table
+ *  lookups or verification in place. Reading the bank being erased or
+ *  written stalls until the flash command ends, and the content changes
+ *  with later writes to the area.
+ *
+ *  \param[in, out] flash Pointer to the HAL FLASH instance.
+ *  \param[in]  src_addr  Source bytes address in flash
+ *  \param[in]  length    Number of bytes which will be accessed
+ *  \return Pointer to the flash content, NULL if the area exceeds the flash
+ */
+const uint8_t *flash_get_pointer(struct flash_descriptor *flash, const uint32_t src_addr, const uint32_t length);
+
 /** \brief Register a function as FLASH transfer completion callback
  *
  *  \param[in, out] flash Pointer to the HAL FLASH instance.
@@ -145,6 +215,74 @@ int32_t flash_read(struct flash_descriptor *flash, uint32_t src_addr, uint8_t *b
  */
 int32_t flash_register_callback(struct flash_descriptor *flash, const enum flash_cb_type type, flash_cb_t func);
 
+/** \brief Queue a flash job
+ *
+ *  The job is run in the background, each erase or program step is started
+ *  from the flash ready interrupt. The job callback is invoked from the
+ *  interrupt once the job is done or failed.
+ *
+ *  While jobs are pending, \ref flash_write, \ref flash_append and
+ *  \ref flash_erase return ERR_BUSY.
+ *
+ *  \param[in, out] flash Pointer to the HAL FLASH instance.
+ *  \param[in, out] job  Pointer to the job to queue
+ *  \return Operation status.
+ *  \retval ERR_NONE The job is queued
+ *  \retval ERR_BAD_ADDRESS The job is out of the flash
+ *  \retval ERR_INVALID_ARG The erase job is not block aligned
+ *  \retval ERR_DENIED The destination region is locked
+ *  \retval ERR_BUSY The job is already queued
+ */
+int32_t flash_submit_job(struct flash_descriptor *flash, struct flash_job *job);
+
+/** \brief Check whether flash jobs are pending
+ *
+ *  \param[in, out] flash Pointer to the HAL FLASH instance.
+ *  \return true if jobs are pending, false otherwise
+ */
+bool flash_is_busy(struct flash_descriptor *flash);
+
+/** \brief Check whether a flash job on given address uses read-while-write
+ *
+ *  The flash bank holding the driver is stalled while it is erased or
+ *  written, including its interrupt handlers. Jobs on the other bank let
+ *  the application keep running from flash.
+ *
+ *  \param[in, out] flash Pointer to the HAL FLASH instance.
+ *  \param[in]  dst_addr  Destination bytes address
+ *  \return true if the application can keep running during the job
+ */
+bool flash_is_read_while_write(struct flash_descriptor *flash, const uint32_t dst_addr);
+
+/** \brief Get the physical bank mapped at the flash start
+ *
+ *  The running application is always in the first half of the flash, this
+ *  tells which physical bank it is.
+ *
+ *  \param[in, out] flash Pointer to the HAL FLASH instance.
+ *  \return 0 for bank A, 1 for bank B
+ */
+uint8_t flash_get_active_bank(struct flash_descriptor *flash);
+
+/** \brief Swap the flash banks and reset the device
+ *
+ *  The bank in the second half of the flash is mapped at the flash start
+ *  after the reset. The function only returns on error.
+ *
+ *  \param[in, out] flash Pointer to the HAL FLASH instance.
+ *  \return Operation status.
+ *  \retval ERR_BUSY Flash jobs are pending
+ */
+int32_t flash_swap_banks(struct flash_descriptor *flash);
+
+/** \brief Get the flash erase block size
+ *
+ *  \param[in, out] flash Pointer to the HAL FLASH instance.
+ *
+ *  \return The flash erase block size
+ */
+uint32_t flash_get_block_size(struct flash_descriptor *flash);
+
 /** \brief Execute lock in the internal flash
  *
  *  \param[in, out] flash Pointer to the HAL FLASH instance.
@@ -196,6 +334,88 @@ uint32_t flash_get_page_size(struct flash_descriptor *flash);
  */
 uint32_t flash_get_total_pages(struct flash_descriptor *flash);
 
+/**
+ * \brief Get the number of flash read wait states
+ *
+ * \param[in, out] flash Pointer to the HAL FLASH instance
+ *
+ * \return The number of wait states, ignored while automatic wait states
+ *         are enabled
+ */
+uint8_t flash_get_wait_state(struct flash_descriptor *flash);
+
+/**
+ * \brief Set the number of flash read wait states
+ *
+ * Disables the automatic wait states generation.
+ *
+ * \param[in, out] flash Pointer to the HAL FLASH instance
+ * \param[in] state The number of wait states
+ *
+ * \return Operation status.
+ */
+int32_t flash_set_wait_state(struct flash_descriptor *flash, const uint8_t state);
+
+/**
+ * \brief Set the minimum safe number of wait states for a CPU frequency
+ *
+ * Typically called with CONF_CPU_FREQUENCY once the clocks are set up. When
+ * the CPU frequency is raised, call it with the new frequency before the
+ * clock switch, when it is lowered, after the switch.
+ *
+ * \param[in, out] flash Pointer to the HAL FLASH instance
+ * \param[in] cpu_freq The CPU frequency in Hz
+ *
+ * \return The number of wait states set
+ */
+uint8_t flash_set_wait_state_for_frequency(struct flash_descriptor *flash, const uint32_t cpu_freq);
+
+/**
+ * \brief Enable/disable the automatic wait states generation
+ *
+ * \param[in, out] flash Pointer to the HAL FLASH instance
+ * \param[in] state true to let the hardware select the wait states
+ *
+ * \return Operation status.
+ */
+int32_t flash_set_auto_wait_state(struct flash_descriptor *flash, const bool state);
+
+/**
+ * \brief Enable/disable the cache of a flash bank
+ *
+ * \param[in, out] flash Pointer to the HAL FLASH instance
+ * \param[in] bank The flash bank, 0 or 1
+ * \param[in] state true to enable the cache
+ *
+ * \return Operation status.
+ */
+int32_t flash_set_cache(struct flash_descriptor *flash, const uint8_t bank, const bool state);
+
+/**
+ * \brief Check whether the cache of a flash bank is enabled
+ *
+ * \param[in, out] flash Pointer to the HAL FLASH instance
+ * \param[in] bank The flash bank, 0 or 1
+ *
+ * \return true if the cache is enabled
+ */
+bool flash_is_cache_enabled(struct flash_descriptor *flash, const uint8_t bank);
+
+/**
+ * \brief Measure the speed of code running from flash
+ *
+ * Runs a fixed workload from flash with the flash bank caches and the CMCC
+ * disabled, so the result shows the cost of the configured wait states. The
+ * caches are restored afterwards. Interrupts taken during the measurement
+ * are included.
+ *
+ * \param[in, out] flash Pointer to the HAL FLASH instance
+ * \param[in] iterations Number of workload iterations
+ *
+ * \return The number of CPU cycles spent
+ */
+uint32_t flash_benchmark(struct flash_descriptor *flash, const uint32_t iterations);
+
 /** \brief Retrieve the current driver version
  *
  *  \return Current driver version.
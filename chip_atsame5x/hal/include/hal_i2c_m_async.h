@@ -0,0 +1,227 @@
+/**
+ * \file
+ *
+ * \brief Async I2C Hardware Abstraction Layer(HAL) declaration.
+ *
+ * Copyright (c) 2014-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#ifndef _HAL_I2C_M_ASYNC_H_INCLUDED
+#define _HAL_I2C_M_ASYNC_H_INCLUDED
+
+#include <hpl_i2c_m_async.h>
+#include <utils_list.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup doc_driver_hal_i2c_master_async
+ *
+ * @{
+ */
+
+struct i2c_m_async_desc;
+struct i2c_m_async_transaction;
+
+/**
+ * \brief Transaction completion callback
+ *
+ * Invoked from interrupt context once the transaction has finished, its status
+ * field holds the result.
+ */
+typedef void (*i2c_m_async_cb_t)(struct i2c_m_async_desc *const i2c, struct i2c_m_async_transaction *const trans);
+
+/**
+ * \brief I2C master queued transaction
+ *
+ * The write buffer is sent first, then the read buffer is filled after a
+ * repeated start. Either part may be empty. The transaction and its buffers are
+ * owned by the driver from submission until the callback is invoked.
+ */
+struct i2c_m_async_transaction {
+	/** List element, managed by the driver */
+	struct list_element elem;
+	/** Slave address, or'ed with I2C_M_TEN for a ten-bit address */
+	uint16_t slave_addr;
+	/** Transfer flags, I2C_M_NO_HS to address a full speed slave on a high-speed bus */
+	uint16_t flags;
+	/** Data to write */
+	uint8_t *wbuf;
+	/** Number of bytes to write */
+	uint16_t wlen;
+	/** Buffer for the data read */
+	uint8_t *rbuf;
+	/** Number of bytes to read */
+	uint16_t rlen;
+	/** Completion callback, may be NULL */
+	i2c_m_async_cb_t cb;
+	/** Transaction status, I2C_OK on success, ERR_BUSY until completed */
+	volatile int32_t status;
+};
+
+/**
+ * \brief I2C descriptor structure, embed i2c_device & transaction queue
+ */
+struct i2c_m_async_desc {
+	struct _i2c_m_async_device device;
+	/** Pending transactions, the head is the one in progress */
+	struct list_descriptor queue;
+	/** Whether the queue is being processed */
+	volatile bool busy;
+	/** Whether the I2C is enabled */
+	bool enabled;
+	/** Whether the transaction in progress is in its read phase */
+	bool reading;
+};
+
+/**
+ * \brief Initialize asynchronous I2C interface
+ *
+ * The instance must have its SERCOM interrupt handler enabled, see
+ * CONF_SERCOM_n_IRQ_HANDLER_ENABLE.
+ *
+ * \param[in] i2c An I2C descriptor, which is used to communicate through I2C
+ * \param[in] hw The pointer to hardware instance
+ *
+ * \return Initialization status.
+ * \retval -1 The passed parameters were invalid or the interface is already initialized
+ * \retval 0 The initialization is completed successfully
+ */
+int32_t i2c_m_async_init(struct i2c_m_async_desc *const i2c, void *const hw);
+
+/**
+ * \brief Deinitialize I2C interface
+ *
+ * Pending transactions are dropped without their callbacks being invoked.
+ *
+ * \param[in] i2c An I2C descriptor, which is used to communicate through I2C
+ *
+ * \return De-initialization status.
+ */
+int32_t i2c_m_async_deinit(struct i2c_m_async_desc *const i2c);
+
+/**
+ * \brief Enable I2C interface and start processing queued transactions
+ *
+ * \param[in] i2c An I2C descriptor, which is used to communicate through I2C
+ *
+ * \return Enabling status.
+ */
+int32_t i2c_m_async_enable(struct i2c_m_async_desc *const i2c);
+
+/**
+ * \brief Disable I2C interface
+ *
+ * Must only be called while the queue is idle, transactions submitted while
+ * disabled are started by the next i2c_m_async_enable.
+ *
+ * \param[in] i2c An I2C descriptor, which is used to communicate through I2C
+ *
+ * \return Disabling status.
+ */
+int32_t i2c_m_async_disable(struct i2c_m_async_desc *const i2c);
+
+/**
+ * \brief Set baudrate
+ *
+ * Set the I2C device to run at the specified baudrate, the I2C must be
+ * disabled.
+ *
+ * \param[in] i2c An I2C descriptor, which is used to communicate through I2C
+ * \param[in] clkrate The unused parameter, using 0 as the default value
+ * \param[in] baudrate The specified baudrate in KHz
+ *
+ * \return The status whether successfully set the baudrate
+ * \retval -1 The passed parameters were invalid or the device is already enabled
+ * \retval 0 The baudrate setting is completed successfully
+ */
+int32_t i2c_m_async_set_baudrate(struct i2c_m_async_desc *const i2c, uint32_t clkrate, uint32_t baudrate);
+
+/**
+ * \brief Set speed mode
+ *
+ * Select the I2C bus speed mode: I2C_STANDARD_MODE (standard and fast mode),
+ * I2C_FASTMODE_PLUS or I2C_HIGHSPEED_MODE. The I2C must be disabled, the
+ * baudrate must be set again afterwards.
+ *
+ * In high-speed mode each transaction enters high-speed on its own: the master
+ * code is sent at the full speed baudrate, followed by a repeated start and the
+ * transfer at the high-speed baudrate. Transactions flagged I2C_M_NO_HS run
+ * entirely at full speed.
+ *
+ * \param[in] i2c An I2C descriptor, which is used to communicate through I2C
+ * \param[in] mode The speed mode
+ *
+ * \return The status whether successfully set the speed mode
+ * \retval ERR_DENIED The device is enabled
+ * \retval ERR_INVALID_ARG The mode is not supported
+ * \retval 0 The speed mode setting is completed successfully
+ */
+int32_t i2c_m_async_set_speed_mode(struct i2c_m_async_desc *const i2c, const uint16_t mode);
+
+/**
+ * \brief Queue a write-then-read transaction
+ *
+ * The transaction is started immediately if the queue is idle, otherwise it
+ * runs right after the ones queued before it.
+ *
+ * \param[in] i2c An I2C descriptor, which is used to communicate through I2C
+ * \param[in] trans The transaction to queue
+ *
+ * \return Operation status.
+ * \retval ERR_NONE Transaction queued
+ * \retval ERR_INVALID_ARG The transaction has nothing to write or read
+ * \retval ERR_BUSY The transaction is already queued
+ */
+int32_t i2c_m_async_submit(struct i2c_m_async_desc *const i2c, struct i2c_m_async_transaction *const trans);
+
+/**
+ * \brief Check whether transactions are pending
+ *
+ * \param[in] i2c An I2C descriptor, which is used to communicate through I2C
+ *
+ * \return true if a transaction is queued or in progress.
+ */
+bool i2c_m_async_is_busy(struct i2c_m_async_desc *const i2c);
+
+/**
+ * \brief Retrieve the current driver version
+ *
+ * \return Current driver version.
+ */
+uint32_t i2c_m_async_get_version(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HAL_I2C_M_ASYNC_H_INCLUDED */
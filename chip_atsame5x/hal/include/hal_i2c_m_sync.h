@@ -120,6 +120,23 @@ int32_t i2c_m_sync_set_slaveaddr(struct i2c_m_sync_desc *i2c, int16_t addr, int3
  */
 int32_t i2c_m_sync_set_baudrate(struct i2c_m_sync_desc *i2c, uint32_t clkrate, uint32_t baudrate);
 
+/**
+ * \brief Set speed mode
+ *
+ * This function selects the I2C bus speed mode: I2C_STANDARD_MODE (standard and
+ * fast mode), I2C_FASTMODE_PLUS or I2C_HIGHSPEED_MODE. It only takes effect
+ * when the hardware is disabled, the baudrate must be set again afterwards.
+ *
+ * \param[in] i2c An I2C descriptor, which is used to communicate through I2C
+ * \param[in] mode The speed mode
+ *
+ * \return Whether successfully set the speed mode
+ * \retval ERR_DENIED The device is enabled
+ * \retval ERR_INVALID_ARG The mode is not supported
+ * \retval 0 The speed mode set is completed successfully
+ */
+int32_t i2c_m_sync_set_speed_mode(struct i2c_m_sync_desc *i2c, const uint16_t mode);
+
 /**
  * \brief Sync version of enable hardware
  *
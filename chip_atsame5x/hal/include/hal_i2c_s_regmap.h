@@ -0,0 +1,192 @@
+/**
+ * \file
+ *
+ * \brief I2C slave register map declaration.
+ *
+ * Copyright (c) 2014-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#ifndef _HAL_I2C_S_REGMAP_H_INCLUDED
+#define _HAL_I2C_S_REGMAP_H_INCLUDED
+
+#include <hpl_dma.h>
+#include <hpl_i2c_s_async.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup doc_driver_hal_i2c_slave_regmap
+ *
+ * @{
+ */
+
+/** Value returned to the master for reads past the end of the register map */
+#define I2C_S_REGMAP_FILLER 0xFF
+
+struct i2c_s_regmap_descriptor;
+
+/**
+ * \brief Register write callback
+ *
+ * Invoked from interrupt context once the bytes written by the master have been
+ * committed to the register file.
+ *
+ * \param[in] descr The register map descriptor
+ * \param[in] offset The first register written
+ * \param[in] length The number of registers written
+ */
+typedef void (*i2c_s_regmap_write_cb_t)(struct i2c_s_regmap_descriptor *const descr, const uint16_t offset,
+                                        const uint16_t length);
+
+/**
+ * \brief I2C slave register map states
+ */
+enum i2c_s_regmap_state {
+	I2C_S_REGMAP_IDLE,
+	I2C_S_REGMAP_POINTER,
+	I2C_S_REGMAP_WRITE,
+	I2C_S_REGMAP_READ
+};
+
+/**
+ * \brief I2C slave register map descriptor
+ */
+struct i2c_s_regmap_descriptor {
+	struct _i2c_s_async_device device;
+	/** DMA resource serving reads */
+	struct _dma_resource *dma;
+	/** DMA channel serving reads */
+	uint8_t dma_channel;
+	/** Register file, owned by the application */
+	uint8_t *regs;
+	/** Copy of the register file the master reads from */
+	uint8_t *shadow;
+	/** Size of the register file */
+	uint16_t size;
+	/** Register pointer, set by the first byte of a write */
+	uint16_t pointer;
+	/** First register written in the current transaction */
+	uint16_t wr_offset;
+	/** Number of registers written in the current transaction */
+	uint16_t wr_length;
+	/** Bus transaction state */
+	volatile enum i2c_s_regmap_state state;
+	/** Register file changes waiting for the end of the bus transaction */
+	volatile bool publish_pending;
+	/** Register write callback */
+	i2c_s_regmap_write_cb_t write_cb;
+};
+
+/**
+ * \brief Initialize I2C slave register map
+ *
+ * The SERCOM must be configured as I2C slave in smart mode, with its interrupt
+ * handler enabled through CONF_SERCOM_n_IRQ_HANDLER_ENABLE. The DMA channel must
+ * be configured with the SERCOM TX trigger, beat trigger action, byte beats,
+ * source increment and fixed destination. Automatic address acknowledge is
+ * turned off, the address is acknowledged from the address match interrupt.
+ *
+ * \param[in] descr The register map descriptor to initialize
+ * \param[in] hw The pointer to hardware instance
+ * \param[in] regs The register file
+ * \param[in] shadow Buffer of the same size used to serve reads
+ * \param[in] size Size of the register file, at most 256 registers
+ * \param[in] dma_channel The DMA channel serving reads
+ *
+ * \return Initialization status.
+ * \retval ERR_INVALID_ARG The passed parameters were invalid
+ * \retval ERR_NONE The initialization is completed successfully
+ */
+int32_t i2c_s_regmap_init(struct i2c_s_regmap_descriptor *const descr, void *const hw, uint8_t *const regs,
+                          uint8_t *const shadow, const uint16_t size, const uint8_t dma_channel);
+
+/**
+ * \brief Deinitialize I2C slave register map
+ *
+ * \param[in] descr The register map descriptor
+ *
+ * \return De-initialization status.
+ */
+int32_t i2c_s_regmap_deinit(struct i2c_s_regmap_descriptor *const descr);
+
+/**
+ * \brief Enable I2C slave register map
+ *
+ * \param[in] descr The register map descriptor
+ *
+ * \return Enabling status.
+ */
+int32_t i2c_s_regmap_enable(struct i2c_s_regmap_descriptor *const descr);
+
+/**
+ * \brief Disable I2C slave register map
+ *
+ * \param[in] descr The register map descriptor
+ *
+ * \return Disabling status.
+ */
+int32_t i2c_s_regmap_disable(struct i2c_s_regmap_descriptor *const descr);
+
+/**
+ * \brief Register the register write callback
+ *
+ * \param[in] descr The register map descriptor
+ * \param[in] cb The callback, NULL to unregister
+ *
+ * \return Operation status.
+ */
+int32_t i2c_s_regmap_register_write_callback(struct i2c_s_regmap_descriptor *const descr,
+                                             const i2c_s_regmap_write_cb_t           cb);
+
+/**
+ * \brief Publish the register file to the master
+ *
+ * Copies the register file to the buffer reads are served from. While a bus
+ * transaction is in progress the copy is deferred to its STOP condition, so
+ * the master always reads a consistent snapshot.
+ *
+ * \param[in] descr The register map descriptor
+ */
+void i2c_s_regmap_publish(struct i2c_s_regmap_descriptor *const descr);
+
+/**
+ * \brief Retrieve the current driver version
+ *
+ * \return Current driver version.
+ */
+uint32_t i2c_s_regmap_get_version(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HAL_I2C_S_REGMAP_H_INCLUDED */
@@ -0,0 +1,223 @@
+/**
+ * \file
+ *
+ * \brief ICM functionality declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#ifndef HAL_ICM_H_INCLUDED
+#define HAL_ICM_H_INCLUDED
+
+#include <hpl_icm.h>
+#include <utils.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup doc_driver_hal_icm
+ *
+ *@{
+ */
+
+/**
+ * \brief SHA algorithms
+ */
+enum icm_sha_type { ICM_SHA1, ICM_SHA224, ICM_SHA256 };
+
+/**
+ * \brief ICM callback types
+ */
+enum icm_callback_type {
+	/** A monitored region does not match its digest */
+	ICM_CB_DIGEST_MISMATCH,
+	/** A bus error occurred while reading a monitored region */
+	ICM_CB_BUS_ERROR
+};
+
+struct icm_descriptor;
+
+/**
+ * \brief ICM callback, called from the interrupt with the region number
+ */
+typedef void (*icm_cb_t)(struct icm_descriptor *const descr, const uint8_t region);
+
+/**
+ * \brief ICM callbacks
+ */
+struct icm_callbacks {
+	icm_cb_t digest_mismatch;
+	icm_cb_t bus_error;
+};
+
+/**
+ * \brief ICM descriptor
+ */
+struct icm_descriptor {
+	struct _icm_device   dev; /*!< ICM HPL device descriptor */
+	struct icm_callbacks cb;  /*!< ICM callbacks */
+};
+
+/**
+ * \brief Streaming SHA context
+ */
+struct icm_sha_context {
+	struct icm_descriptor *descr;      /*!< ICM descriptor */
+	enum icm_sha_type      type;       /*!< SHA algorithm */
+	uint32_t               state[8];   /*!< Chaining state, in digest byte order */
+	uint32_t               buffer[16]; /*!< Partial block */
+	uint64_t               length;     /*!< Message length in bytes */
+};
+
+/**
+ * \brief              Initialize ICM
+ *
+ * \param[out] descr   The ICM descriptor
+ * \param[in]  hw      The pointer to hardware instance
+ *
+ * \return             ERR_NONE if successful
+ */
+int32_t icm_init(struct icm_descriptor *const descr, void *const hw);
+
+/**
+ * \brief              Deinitialize ICM
+ *
+ * \param[in]  descr   The ICM descriptor
+ *
+ * \return             ERR_NONE if successful
+ */
+int32_t icm_deinit(struct icm_descriptor *const descr);
+
+/**
+ * \brief              Start a SHA calculation
+ *
+ * \param[in]  descr   The ICM descriptor
+ * \param[out] ctx     The SHA context
+ * \param[in]  type    ICM_SHA1, ICM_SHA224 or ICM_SHA256
+ *
+ * \return             ERR_NONE if successful
+ */
+int32_t icm_sha_init(struct icm_descriptor *const descr, struct icm_sha_context *const ctx,
+                     const enum icm_sha_type type);
+
+/**
+ * \brief              Add data to a SHA calculation
+ *
+ * Whole blocks in a word aligned buffer are read by the ICM in place, other
+ * data is copied through the context.
+ *
+ * \param[in]  ctx     The SHA context
+ * \param[in]  data    Buffer holding the data
+ * \param[in]  length  Byte length of the data
+ *
+ * \return             ERR_NONE if successful, ERR_BUSY if the ICM is
+ *                     monitoring, ERR_IO on a bus error
+ */
+int32_t icm_sha_update(struct icm_sha_context *const ctx, const void *const data, const uint32_t length);
+
+/**
+ * \brief              Finish a SHA calculation
+ *
+ * \param[in]  ctx     The SHA context, cleared afterwards
+ * \param[out] digest  Buffer holding the digest, 20, 28 or 32 bytes
+ *
+ * \return             ERR_NONE if successful, ERR_BUSY if the ICM is
+ *                     monitoring, ERR_IO on a bus error
+ */
+int32_t icm_sha_final(struct icm_sha_context *const ctx, uint8_t *const digest);
+
+/**
+ * \brief              Calculate the SHA digest of a buffer
+ *
+ * \param[in]  descr   The ICM descriptor
+ * \param[in]  type    ICM_SHA1, ICM_SHA224 or ICM_SHA256
+ * \param[in]  data    Buffer holding the data
+ * \param[in]  length  Byte length of the data
+ * \param[out] digest  Buffer holding the digest, 20, 28 or 32 bytes
+ *
+ * \return             ERR_NONE if successful, ERR_BUSY if the ICM is
+ *                     monitoring, ERR_IO on a bus error
+ */
+int32_t icm_sha(struct icm_descriptor *const descr, const enum icm_sha_type type, const void *const data,
+                const uint32_t length, uint8_t *const digest);
+
+/**
+ * \brief              Start monitoring memory regions in the background
+ *
+ * The ICM hashes the regions once, then keeps hashing them in a loop and
+ * compares against the first digests. A difference invokes the digest
+ * mismatch callback.
+ *
+ * \param[in]  descr   The ICM descriptor
+ * \param[in]  type    ICM_SHA1, ICM_SHA224 or ICM_SHA256
+ * \param[in]  regions Regions to monitor, word aligned, whole 64 byte blocks
+ * \param[in]  count   Number of regions, 1 to ICM_REGIONS
+ *
+ * \return             ERR_NONE if successful, ERR_BUSY if the ICM is in use
+ */
+int32_t icm_monitor_start(struct icm_descriptor *const descr, const enum icm_sha_type type,
+                          const struct icm_region *const regions, const uint8_t count);
+
+/**
+ * \brief              Stop monitoring memory regions
+ *
+ * \param[in]  descr   The ICM descriptor
+ *
+ * \return             ERR_NONE if successful
+ */
+int32_t icm_monitor_stop(struct icm_descriptor *const descr);
+
+/**
+ * \brief              Register ICM callback
+ *
+ * \param[in]  descr   The ICM descriptor
+ * \param[in]  type    Callback type
+ * \param[in]  func    Callback function, NULL to remove it
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_ARG on an unknown
+ *                     type
+ */
+int32_t icm_register_callback(struct icm_descriptor *const descr, const enum icm_callback_type type,
+                              FUNC_PTR func);
+
+/**
+ * \brief Retrieve the current driver version
+ *
+ * \return Current driver version.
+ */
+uint32_t icm_get_version(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_ICM_H_INCLUDED */
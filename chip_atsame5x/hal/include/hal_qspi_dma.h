@@ -0,0 +1,196 @@
+/**
+ * \file
+ *
+ * \brief Quad SPI DMA related functionality declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#ifndef _HAL_QSPI_DMA_INCLUDED
+#define _HAL_QSPI_DMA_INCLUDED
+
+#include <hpl_qspi_dma.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup doc_driver_hal_quad_spi_dma
+ *
+ *@{
+ */
+
+struct qspi_dma_descriptor;
+
+/**
+ * \brief QSPI command completion callback type
+ */
+typedef void (*qspi_dma_cb_t)(struct qspi_dma_descriptor *const qspi);
+
+/**
+ * \brief QSPI callbacks
+ */
+struct qspi_dma_callbacks {
+	/** Command completed */
+	qspi_dma_cb_t xfer_done;
+	/** DMA error during the data phase */
+	qspi_dma_cb_t error;
+};
+
+/**
+ * \brief QSPI descriptor structure
+ */
+struct qspi_dma_descriptor {
+	struct _qspi_dma_dev      dev;
+	struct qspi_dma_callbacks cb;
+	/** A command is in progress */
+	volatile bool busy;
+};
+
+/**
+ *  \brief Initialize QSPI low level driver.
+ *
+ *  The DMA channels CONF_QSPI_DMA_TX_CHANNEL and CONF_QSPI_DMA_RX_CHANNEL must
+ *  be configured for software triggered block transfers.
+ *
+ *  \param[in] qspi Pointer to the QSPI device instance
+ *  \param[in] hw Pointer to the hardware base
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_dma_init(struct qspi_dma_descriptor *qspi, void *hw);
+
+/**
+ *  \brief Deinitialize QSPI low level driver.
+ *
+ *  \param[in] qspi Pointer to the QSPI device instance
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_dma_deinit(struct qspi_dma_descriptor *qspi);
+
+/**
+ *  \brief Enable QSPI
+ *
+ *  \param[in] qspi Pointer to the QSPI device instance
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_dma_enable(struct qspi_dma_descriptor *qspi);
+
+/**
+ *  \brief Disable QSPI
+ *
+ *  \param[in] qspi Pointer to the QSPI device instance
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_dma_disable(struct qspi_dma_descriptor *qspi);
+
+/**
+ *  \brief Register a QSPI callback
+ *
+ *  \param[in] qspi Pointer to the QSPI device instance
+ *  \param[in] type The callback type
+ *  \param[in] cb The callback function, NULL to unregister
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_dma_register_callback(struct qspi_dma_descriptor *qspi, const enum _qspi_dma_cb_type type,
+                                   qspi_dma_cb_t cb);
+
+/** \brief Execute command in Serial Memory Mode.
+ *
+ *  The data phase is moved by DMA through the QSPI AHB window and the function
+ *  returns as soon as it has started. The xfer_done callback is invoked from
+ *  the DMA interrupt once the command has completed. Commands without data
+ *  complete before the function returns. The buffer must stay valid until the
+ *  callback.
+ *
+ *  \param[in] qspi Pointer to the HAL QSPI instance
+ *  \param[in] cmd Pointer to the command structure
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ *  \retval ERR_BUSY A command is in progress
+ */
+int32_t qspi_dma_serial_run_command(struct qspi_dma_descriptor *qspi, const struct _qspi_command *cmd);
+
+/**
+ *  \brief Enable scrambling of memory transfers
+ *
+ *  See qspi_sync_enable_scrambling.
+ *
+ *  \param[in] qspi Pointer to the QSPI device instance
+ *  \param[in] key Scrambling user key
+ *  \param[in] device_unique Mix in the random value of this device
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_dma_enable_scrambling(struct qspi_dma_descriptor *qspi, const uint32_t key, const bool device_unique);
+
+/**
+ *  \brief Disable scrambling of memory transfers and clear the key
+ *
+ *  \param[in] qspi Pointer to the QSPI device instance
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_dma_disable_scrambling(struct qspi_dma_descriptor *qspi);
+
+/**
+ *  \brief Check if a command is in progress
+ *
+ *  \param[in] qspi Pointer to the QSPI device instance
+ *
+ *  \return true if a command is in progress
+ */
+bool qspi_dma_is_busy(const struct qspi_dma_descriptor *qspi);
+
+/**
+ *  \brief Retrieve the current driver version
+ *
+ *  \return Current driver version.
+ */
+uint32_t qspi_dma_get_version(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HAL_QSPI_DMA_INCLUDED */
@@ -106,6 +106,62 @@ int32_t qspi_sync_disable(struct qspi_sync_descriptor *qspi);
  */
 int32_t qspi_sync_serial_run_command(struct qspi_sync_descriptor *qspi, const struct _qspi_command *cmd);
 
+/** \brief Enable scrambling of memory transfers.
+ *
+ *  Data written with QSPI_WRITEMEM_ACCESS is scrambled with the key before it
+ *  reaches the serial memory, and unscrambled again when read with
+ *  QSPI_READMEM_ACCESS or through the AHB window. Other transfer types, like
+ *  status and SFDP reads, are not affected.
+ *
+ *  The scrambling algorithm is internal to the device, so scrambled images
+ *  are provisioned by writing the plain image through the QSPI with
+ *  scrambling enabled.
+ *
+ *  \param[in] qspi Pointer to the HAL QSPI instance
+ *  \param[in] key Scrambling user key
+ *  \param[in] device_unique Mix in the random value of this device, so the
+ *                           data can only be read back by this device
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_sync_enable_scrambling(struct qspi_sync_descriptor *qspi, const uint32_t key, const bool device_unique);
+
+/** \brief Disable scrambling of memory transfers and clear the key.
+ *
+ *  \param[in] qspi Pointer to the HAL QSPI instance
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_sync_disable_scrambling(struct qspi_sync_descriptor *qspi);
+
+/** \brief Map the serial memory into the QSPI AHB window.
+ *
+ *  Leaves the given read command in the instruction frame, so reads from
+ *  QSPI_AHB + address are fetched from the serial memory, including
+ *  instruction fetches for execute in place.
+ *
+ *  \param[in] qspi Pointer to the HAL QSPI instance
+ *  \param[in] cmd Pointer to the read command, with QSPI_READMEM_ACCESS
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_sync_enable_xip(struct qspi_sync_descriptor *qspi, const struct _qspi_command *cmd);
+
+/** \brief End the memory mapped access.
+ *
+ *  Must be called before running serial commands after qspi_sync_enable_xip.
+ *  Not allowed while executing from the QSPI AHB window.
+ *
+ *  \param[in] qspi Pointer to the HAL QSPI instance
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success
+ */
+int32_t qspi_sync_disable_xip(struct qspi_sync_descriptor *qspi);
+
 /**
  *  \brief Retrieve the current driver version
  *
@@ -0,0 +1,259 @@
+/**
+ * \file
+ *
+ * \brief SmartEEPROM functionality declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+
+#ifndef _HAL_SMART_EEPROM_H_INCLUDED
+#define _HAL_SMART_EEPROM_H_INCLUDED
+
+#include <hpl_smart_eeprom.h>
+#include <utils_assert.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup doc_driver_hal_smart_eeprom
+ *
+ *@{
+ */
+
+/**
+ * \brief SmartEEPROM descriptor
+ */
+struct smart_eeprom_descriptor {
+	struct _smart_eeprom_device dev; /*!< SmartEEPROM HPL device descriptor */
+};
+
+/**
+ * \brief SmartEEPROM wear statistics
+ *
+ * The counters start at zero on initialization.
+ */
+struct smart_eeprom_wear {
+	/** Number of write accesses which changed the SmartEEPROM content */
+	uint32_t writes;
+	/** Number of sector reallocations, each erases one sector */
+	uint32_t reallocations;
+	/** Number of writes rejected because the active sector overflowed */
+	uint32_t overflows;
+	/** Index of the active sector */
+	uint8_t active_sector;
+	/** Number of flash blocks per sector */
+	uint8_t sector_blocks;
+};
+
+/**
+ * \brief Initialize SmartEEPROM.
+ *
+ * \param[out] descr A SmartEEPROM descriptor to initialize
+ * \param[in] hw The pointer to hardware instance
+ *
+ * \return Initialization status.
+ * \retval ERR_NOT_INITIALIZED No SmartEEPROM is allocated in the user row
+ */
+int32_t smart_eeprom_init(struct smart_eeprom_descriptor *const descr, void *const hw);
+
+/**
+ * \brief Deinitialize SmartEEPROM.
+ *
+ * Pending buffered data is flushed.
+ *
+ * \param[in] descr A SmartEEPROM descriptor to deinitialize
+ *
+ * \return De-initialization status.
+ */
+int32_t smart_eeprom_deinit(struct smart_eeprom_descriptor *const descr);
+
+/**
+ * \brief Get the SmartEEPROM size.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ *
+ * \return The SmartEEPROM size in bytes.
+ */
+uint32_t smart_eeprom_get_size(struct smart_eeprom_descriptor *const descr);
+
+/**
+ * \brief Read bytes from the SmartEEPROM.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ * \param[in] offset Offset in the SmartEEPROM
+ * \param[out] buffer Pointer to the buffer to read to
+ * \param[in] length Number of bytes to read
+ *
+ * \return Read status.
+ * \retval ERR_BAD_ADDRESS The range exceeds the SmartEEPROM
+ */
+int32_t smart_eeprom_read(struct smart_eeprom_descriptor *const descr, const uint32_t offset, uint8_t *const buffer,
+                          const uint32_t length);
+
+/**
+ * \brief Write bytes to the SmartEEPROM.
+ *
+ * Only bytes which change are written. Aligned words are written with one
+ * access.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ * \param[in] offset Offset in the SmartEEPROM
+ * \param[in] buffer Pointer to the data to write
+ * \param[in] length Number of bytes to write
+ *
+ * \return Write status.
+ * \retval ERR_BAD_ADDRESS The range exceeds the SmartEEPROM
+ * \retval ERR_DENIED The SmartEEPROM is locked
+ * \retval ERR_IO A write was rejected because the active sector overflowed
+ */
+int32_t smart_eeprom_write(struct smart_eeprom_descriptor *const descr, const uint32_t offset,
+                           const uint8_t *const buffer, const uint32_t length);
+
+/**
+ * \brief Read a byte from the SmartEEPROM.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ * \param[in] offset Offset in the SmartEEPROM
+ * \param[out] value Pointer to the byte read
+ *
+ * \return Read status.
+ */
+int32_t smart_eeprom_read_byte(struct smart_eeprom_descriptor *const descr, const uint32_t offset,
+                               uint8_t *const value);
+
+/**
+ * \brief Write a byte to the SmartEEPROM.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ * \param[in] offset Offset in the SmartEEPROM
+ * \param[in] value The byte to write
+ *
+ * \return Write status.
+ */
+int32_t smart_eeprom_write_byte(struct smart_eeprom_descriptor *const descr, const uint32_t offset,
+                                const uint8_t value);
+
+/**
+ * \brief Read a word from the SmartEEPROM.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ * \param[in] offset Offset in the SmartEEPROM, word aligned
+ * \param[out] value Pointer to the word read
+ *
+ * \return Read status.
+ */
+int32_t smart_eeprom_read_word(struct smart_eeprom_descriptor *const descr, const uint32_t offset,
+                               uint32_t *const value);
+
+/**
+ * \brief Write a word to the SmartEEPROM.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ * \param[in] offset Offset in the SmartEEPROM, word aligned
+ * \param[in] value The word to write
+ *
+ * \return Write status.
+ */
+int32_t smart_eeprom_write_word(struct smart_eeprom_descriptor *const descr, const uint32_t offset,
+                                const uint32_t value);
+
+/**
+ * \brief Select buffered or unbuffered write mode.
+ *
+ * In buffered mode writes to the same SmartEEPROM page are collected in the
+ * page buffer, and only written to flash when another page is written or on
+ * \ref smart_eeprom_flush. Leaving buffered mode flushes the page buffer.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ * \param[in] buffered true for buffered mode
+ *
+ * \return Operation status.
+ */
+int32_t smart_eeprom_set_buffered(struct smart_eeprom_descriptor *const descr, const bool buffered);
+
+/**
+ * \brief Write the page buffer to flash in buffered mode.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ *
+ * \return Operation status.
+ */
+int32_t smart_eeprom_flush(struct smart_eeprom_descriptor *const descr);
+
+/**
+ * \brief Check whether the SmartEEPROM is busy.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ *
+ * \return true if a write or a sector reallocation is in progress
+ */
+bool smart_eeprom_is_busy(struct smart_eeprom_descriptor *const descr);
+
+/**
+ * \brief Get the SmartEEPROM wear statistics.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ * \param[out] wear Pointer to the statistics
+ *
+ * \return Operation status.
+ */
+int32_t smart_eeprom_get_wear(struct smart_eeprom_descriptor *const descr, struct smart_eeprom_wear *const wear);
+
+/**
+ * \brief Store the SmartEEPROM allocation in the user row.
+ *
+ * The allocation takes effect after the next reset, changing it loses the
+ * SmartEEPROM content.
+ *
+ * \param[in] descr A SmartEEPROM descriptor
+ * \param[in] sector_blocks Number of flash blocks per sector (1 to 10), 0 to
+ *                          disable the SmartEEPROM
+ * \param[in] page_size_sel SmartEEPROM page size selection (0 to 7), the
+ *                          virtual size is 512 << value bytes
+ *
+ * \return Operation status.
+ */
+int32_t smart_eeprom_configure(struct smart_eeprom_descriptor *const descr, const uint8_t sector_blocks,
+                               const uint8_t page_size_sel);
+
+/**
+ * \brief Retrieve the current driver version
+ *
+ * \return Current driver version.
+ */
+uint32_t smart_eeprom_get_version(void);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HAL_SMART_EEPROM_H_INCLUDED */
@@ -0,0 +1,187 @@
+/**
+ * \file
+ *
+ * \brief SPI master transaction queue functionality declaration.
+ *
+ * Copyright (c) 2014-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#ifndef _HAL_SPI_M_QUEUE_H_INCLUDED
+#define _HAL_SPI_M_QUEUE_H_INCLUDED
+
+#include <hpl_spi_m_async.h>
+#include <utils_list.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup doc_driver_hal_spi_master_queue
+ *
+ * @{
+ */
+
+/** Chip-select value for transactions that drive no chip-select pin */
+#define SPI_M_QUEUE_NO_CS 0xFF
+
+struct spi_m_queue_descriptor;
+struct spi_m_queue_transaction;
+
+/** \brief Transaction completion callback
+ *
+ *  Invoked from interrupt context once the transaction has finished, its
+ *  status field holds the result.
+ */
+typedef void (*spi_m_queue_cb_t)(struct spi_m_queue_descriptor *const spi,
+                                 struct spi_m_queue_transaction *const  trans);
+
+/** \brief SPI master queued transaction
+ *
+ *  A transaction is a list of segments clocked out back to back while the
+ *  chip-select pin is held low. The transaction, its segments and their buffers
+ *  are owned by the driver from submission until the callback is invoked.
+ */
+struct spi_m_queue_transaction {
+	/** List element, managed by the driver */
+	struct list_element elem;
+	/** Chip-select pin, or SPI_M_QUEUE_NO_CS */
+	uint8_t cs_pin;
+	/** SPI transfer mode used for this transaction */
+	enum spi_transfer_mode mode;
+	/** BAUD register value used for this transaction */
+	uint32_t baud_val;
+	/** Segments to transfer, a NULL txbuf sends the dummy character */
+	struct spi_xfer *segments;
+	/** Number of segments */
+	uint8_t segment_count;
+	/** Completion callback, may be NULL */
+	spi_m_queue_cb_t cb;
+	/** Transaction status, ERR_BUSY until completed */
+	volatile int32_t status;
+};
+
+/** \brief SPI master transaction queue descriptor
+ */
+struct spi_m_queue_descriptor {
+	/** SPI device instance */
+	struct _spi_m_async_dev dev;
+	/** Pending transactions, the head is the one in progress */
+	struct list_descriptor queue;
+	/** Whether the queue is being processed */
+	volatile bool busy;
+	/** Whether the SPI is enabled */
+	bool enabled;
+	/** Segment in progress */
+	uint8_t segment;
+	/** Characters written of the segment in progress */
+	uint32_t txcnt;
+	/** Characters read of the segment in progress */
+	uint32_t rxcnt;
+	/** Transfer mode currently programmed into the hardware */
+	enum spi_transfer_mode mode;
+	/** BAUD register value currently programmed into the hardware */
+	uint32_t baud_val;
+	/** Whether mode and baud_val reflect the hardware */
+	bool configured;
+};
+
+/** \brief Initialize SPI transaction queue instance and hardware
+ *
+ *  The instance must have its SERCOM interrupt handler enabled, see
+ *  CONF_SERCOM_n_IRQ_HANDLER_ENABLE.
+ *
+ *  \param[out] spi Pointer to the SPI queue instance.
+ *  \param[in] hw Pointer to the hardware base.
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success.
+ *  \retval <0 Error code.
+ */
+int32_t spi_m_queue_init(struct spi_m_queue_descriptor *spi, void *const hw);
+
+/** \brief Deinitialize SPI transaction queue instance and hardware
+ *
+ *  Pending transactions are dropped without their callbacks being invoked.
+ *
+ *  \param[in] spi Pointer to the SPI queue instance.
+ */
+void spi_m_queue_deinit(struct spi_m_queue_descriptor *spi);
+
+/** \brief Enable SPI and start processing queued transactions
+ *
+ *  \param[in] spi Pointer to the SPI queue instance.
+ */
+void spi_m_queue_enable(struct spi_m_queue_descriptor *spi);
+
+/** \brief Disable SPI
+ *
+ *  Must only be called while the queue is idle, transactions submitted while
+ *  disabled are started by the next spi_m_queue_enable.
+ *
+ *  \param[in] spi Pointer to the SPI queue instance.
+ */
+void spi_m_queue_disable(struct spi_m_queue_descriptor *spi);
+
+/** \brief Queue a transaction
+ *
+ *  The transaction is started immediately if the queue is idle, otherwise it
+ *  runs right after the ones queued before it. SPI mode and baudrate are only
+ *  reprogrammed when they differ from the previous transaction.
+ *
+ *  \param[in] spi Pointer to the SPI queue instance.
+ *  \param[in] trans Pointer to the transaction to queue.
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Transaction queued.
+ *  \retval ERR_INVALID_ARG The transaction has no segments.
+ *  \retval ERR_BUSY The transaction is already queued.
+ */
+int32_t spi_m_queue_submit(struct spi_m_queue_descriptor *spi, struct spi_m_queue_transaction *trans);
+
+/** \brief Check whether transactions are pending
+ *
+ *  \param[in] spi Pointer to the SPI queue instance.
+ *
+ *  \return true if a transaction is queued or in progress.
+ */
+bool spi_m_queue_is_busy(struct spi_m_queue_descriptor *spi);
+
+/** \brief Retrieve the current driver version
+ *
+ *  \return Current driver version.
+ */
+uint32_t spi_m_queue_get_version(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ifndef _HAL_SPI_M_QUEUE_H_INCLUDED */
@@ -180,6 +180,41 @@ int32_t spi_m_sync_set_char_size(struct spi_m_sync_descriptor *spi, const enum s
  */
 int32_t spi_m_sync_set_data_order(struct spi_m_sync_descriptor *spi, const enum spi_data_order dord);
 
+/** \brief Enable or disable pipelined SPI transfers
+ *
+ *  By default the driver does not load the next character before the previous
+ *  one has been received, which gives a clean waveform but leaves an idle gap
+ *  between characters. With pipelining enabled the TX data register is kept
+ *  loaded so SCK runs back to back, which matters most at high baudrates.
+ *
+ *  \param[in] spi Pointer to the HAL SPI instance.
+ *  \param[in] enable True to enable pipelined transfers.
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success.
+ */
+int32_t spi_m_sync_set_pipelined(struct spi_m_sync_descriptor *spi, const bool enable);
+
+/** \brief Enable or disable SPI 32-bit data extension
+ *
+ *  With 32-bit data extension enabled, four 8-bit characters are moved per
+ *  DATA register access, which cuts the number of bus accesses per character
+ *  by four. Transfers that are not a multiple of four characters complete the
+ *  tail through the hardware length counter.
+ *  Only 8-bit character size is supported, and the SPI must be disabled while
+ *  changing this setting.
+ *
+ *  \param[in] spi Pointer to the HAL SPI instance.
+ *  \param[in] enable True to enable 32-bit data extension.
+ *
+ *  \return Operation status.
+ *  \retval ERR_NONE Success.
+ *  \retval ERR_DENIED SPI is enabled.
+ *  \retval ERR_BUSY Busy
+ *  \retval ERR_INVALID_ARG The char size is not 8-bit.
+ */
+int32_t spi_m_sync_set_data32(struct spi_m_sync_descriptor *spi, const bool enable);
+
 /** \brief Perform the SPI data transfer (TX and RX) in polling way
  *
  *  Activate CS, do TX and RX and deactivate CS. It blocks.
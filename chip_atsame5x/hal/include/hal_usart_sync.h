@@ -194,6 +194,21 @@ int32_t usart_sync_set_stopbits(struct usart_sync_descriptor *const descr, const
  */
 int32_t usart_sync_set_character_size(struct usart_sync_descriptor *const descr, const enum usart_character_size size);
 
+/**
+ * \brief Set USART 32-bit data extension mode
+ *
+ * With 32-bit data extension enabled, the I/O read and write functions move
+ * four 8-bit characters per DATA register access. Transfer lengths that are
+ * not a multiple of four are completed through the data length counter.
+ * The character size must be 8 bits.
+ *
+ * \param[in] descr A USART descriptor which is used to communicate via USART
+ * \param[in] mode The 32-bit data extension mode to set
+ *
+ * \return The status of 32-bit data extension mode setting.
+ */
+int32_t usart_sync_set_data32_mode(struct usart_sync_descriptor *const descr, const enum usart_data32_mode mode);
+
 /**
  * \brief Retrieve the state of flow control pins
  *
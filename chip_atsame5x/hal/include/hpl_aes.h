@@ -40,4 +40,20 @@ enum aes_action { AES_DECRYPT, AES_ENCRYPT };
 
 enum aes_keysize { AES_KEY_128, AES_KEY_192, AES_KEY_256 };
 
+/**
+ * \brief One message of a batched AES-GCM operation
+ */
+struct aes_gcm_job {
+	const uint8_t *iv;      /*!< Initialization Vector */
+	uint32_t       iv_len;  /*!< Length of IV */
+	const uint8_t *aad;     /*!< Additional data */
+	uint32_t       aad_len; /*!< Length of additional data */
+	const uint8_t *input;   /*!< Buffer holding the input data */
+	uint8_t *      output;  /*!< Buffer holding the output data */
+	uint32_t       length;  /*!< Byte length of the input data */
+	uint8_t *      tag;     /*!< Tag, written on encrypt, checked on decrypt */
+	uint32_t       tag_len; /*!< Length of tag */
+	int32_t        status;  /*!< ERR_NONE or ERR_INVALID_DATA on tag mismatch */
+};
+
 #endif /* HPL_AES_H_INCLUDED */
@@ -0,0 +1,236 @@
+/**
+ * \file
+ *
+ * \brief AES DMA related functionality declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#ifndef _HPL_AES_DMA_H_INCLUDED
+#define _HPL_AES_DMA_H_INCLUDED
+
+#include <hpl_aes_sync.h>
+#include "hpl_dma.h"
+
+/**
+ * \addtogroup hpl__aes__dma AES DMA Driver
+ *
+ *@{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The callback types */
+enum _aes_dma_cb_type {
+	/** Callback type for the end of an operation */
+	AES_DMA_CB_DONE,
+	/** Callback type for DMA errors */
+	AES_DMA_CB_ERROR,
+};
+
+/** The operation in progress */
+enum _aes_dma_mode { AES_DMA_MODE_ECB, AES_DMA_MODE_CBC, AES_DMA_MODE_CTR, AES_DMA_MODE_GCM };
+
+struct _aes_dma_device;
+
+/**
+ * \brief AES DMA callback type
+ */
+typedef void (*_aes_dma_cb_t)(struct _aes_dma_device *dev);
+
+/**
+ * \brief AES DMA callbacks
+ */
+struct _aes_dma_callbacks {
+	_aes_dma_cb_t done;
+	_aes_dma_cb_t error;
+};
+
+/**
+ * \brief AES DMA device
+ */
+struct _aes_dma_device {
+	/** Key and GCM state, shared with the synchronous implementation */
+	struct _aes_sync_device sync;
+	/** Callbacks from interrupt context */
+	struct _aes_dma_callbacks cb;
+	/** DMA resource of the TX channel */
+	struct _dma_resource *tx_resource;
+	/** DMA resource of the RX channel */
+	struct _dma_resource *rx_resource;
+	/** The operation in progress */
+	enum _aes_dma_mode mode;
+	/** The direction of the operation in progress */
+	enum aes_action enc;
+	/** Input of the operation in progress */
+	const uint8_t *input;
+	/** Output of the operation in progress */
+	uint8_t *output;
+	/** Length of the operation in progress */
+	uint32_t length;
+	/** Length moved by the DMA */
+	uint32_t dma_length;
+	/** Caller IV or counter, updated at the end of the operation */
+	uint8_t *iv;
+	/** Last input block, saved for in place CBC decryption */
+	uint8_t block[16];
+};
+
+/**
+ * \brief Initialize AES DMA
+ *
+ * \param[in] dev The pointer to device instance
+ * \param[in] hw The pointer to hardware instance
+ *
+ * \return Initialization status.
+ */
+int32_t _aes_dma_init(struct _aes_dma_device *const dev, void *const hw);
+
+/**
+ * \brief Deinitialize AES DMA
+ *
+ * \param[in] dev The pointer to device instance
+ *
+ * \return De-initialization status.
+ */
+int32_t _aes_dma_deinit(struct _aes_dma_device *const dev);
+
+/**
+ * \brief Set the AES key
+ *
+ * \param[in] dev The pointer to device instance
+ * \param[in] key The key
+ * \param[in] size The key size
+ *
+ * \return Operation status.
+ */
+int32_t _aes_dma_set_key(struct _aes_dma_device *const dev, const uint8_t *key, const enum aes_keysize size);
+
+/**
+ * \brief Start AES-ECB encryption/decryption of blocks
+ *
+ * \param[in] dev The pointer to device instance
+ * \param[in] enc AES_ENCRYPT or AES_DECRYPT
+ * \param[in] input The input, word aligned
+ * \param[out] output The output, word aligned
+ * \param[in] length Length of the input, a multiple of 16
+ *
+ * \return Operation status.
+ */
+int32_t _aes_dma_ecb_crypt(struct _aes_dma_device *const dev, const enum aes_action enc, const uint8_t *input,
+                           uint8_t *output, uint32_t length);
+
+/**
+ * \brief Start AES-CBC encryption/decryption
+ *
+ * \param[in] dev The pointer to device instance
+ * \param[in] enc AES_ENCRYPT or AES_DECRYPT
+ * \param[in] input The input, word aligned
+ * \param[out] output The output, word aligned
+ * \param[in] length Length of the input, a multiple of 16
+ * \param[in,out] iv The IV, updated at the end of the operation
+ *
+ * \return Operation status.
+ */
+int32_t _aes_dma_cbc_crypt(struct _aes_dma_device *const dev, const enum aes_action enc, const uint8_t *input,
+                           uint8_t *output, uint32_t length, uint8_t iv[16]);
+
+/**
+ * \brief Start AES-CTR encryption/decryption
+ *
+ * \param[in] dev The pointer to device instance
+ * \param[in] input The input, word aligned
+ * \param[out] output The output, word aligned
+ * \param[in] length Length of the input, a multiple of 16
+ * \param[in,out] nc The counter, updated at the end of the operation
+ *
+ * \return Operation status.
+ */
+int32_t _aes_dma_ctr_crypt(struct _aes_dma_device *const dev, const uint8_t *input, uint8_t *output, uint32_t length,
+                           uint8_t nc[16]);
+
+/**
+ * \brief Compute the GCM hash key, J0 and the GHASH of the AAD
+ *
+ * \param[in] dev The pointer to device instance
+ * \param[in] enc AES_ENCRYPT or AES_DECRYPT
+ * \param[in] iv The IV
+ * \param[in] iv_len Length of the IV
+ * \param[in] aad The additional data
+ * \param[in] aad_len Length of the additional data
+ *
+ * \return Operation status.
+ */
+int32_t _aes_dma_gcm_start(struct _aes_dma_device *const dev, const enum aes_action enc, const uint8_t *iv,
+                           uint32_t iv_len, const uint8_t *aad, uint32_t aad_len);
+
+/**
+ * \brief Start AES-GCM encryption/decryption of the whole message
+ *
+ * The last block is processed by the CPU at the end of the DMA transfer, to
+ * mark the end of the message.
+ *
+ * \param[in] dev The pointer to device instance
+ * \param[in] input The input, word aligned
+ * \param[out] output The output, word aligned
+ * \param[in] length Length of the input
+ *
+ * \return Operation status.
+ */
+int32_t _aes_dma_gcm_update(struct _aes_dma_device *const dev, const uint8_t *input, uint8_t *output,
+                            uint32_t length);
+
+/**
+ * \brief Generate the GCM tag
+ *
+ * \param[in] dev The pointer to device instance
+ * \param[out] tag The tag
+ * \param[in] tag_len Length of the tag
+ *
+ * \return Operation status.
+ */
+int32_t _aes_dma_gcm_finish(struct _aes_dma_device *const dev, uint8_t *tag, uint32_t tag_len);
+
+/**
+ * \brief Register a callback
+ *
+ * \param[in] dev The pointer to device instance
+ * \param[in] type The callback type
+ * \param[in] cb The callback, called from interrupt context
+ */
+void _aes_dma_register_callback(struct _aes_dma_device *const dev, const enum _aes_dma_cb_type type,
+                                _aes_dma_cb_t cb);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+#endif /* _HPL_AES_DMA_H_INCLUDED */
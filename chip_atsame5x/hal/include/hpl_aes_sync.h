@@ -40,6 +40,11 @@
 extern "C" {
 #endif
 
+/**
+ * \brief Key slot value of a device whose key is not held in a key slot
+ */
+#define AES_KEY_SLOT_NONE 0xFF
+
 COMPILER_PACK_SET(4)
 struct _aes_sync_device {
 	void *           hw;      /*!< Hardware module instance handler */
@@ -47,6 +52,7 @@ struct _aes_sync_device {
 	uint8_t          iv[16];  /*!< Initialization Vector */
 	uint32_t         aad_len; /*!< length of additional data(GCM) */
 	enum aes_keysize keysize; /*!< bit length of key */
+	uint8_t          slot;    /*!< Key slot of the key, AES_KEY_SLOT_NONE if none */
 };
 COMPILER_PACK_RESET()
 
@@ -88,6 +94,45 @@ int32_t _aes_sync_disable(struct _aes_sync_device *const dev);
  */
 int32_t _aes_sync_set_key(struct _aes_sync_device *const dev, const uint8_t *key, const enum aes_keysize size);
 
+/**
+ * \brief              Store a key in a key slot and select it
+ *
+ * Other devices that selected the slot use the new key from their next
+ * operation.
+ *
+ * \param[in] dev      The pointer to device instance
+ * \param[in] slot     Key slot, less than CONF_AES_KEY_SLOTS
+ * \param[in] key      Encryption/decryption key
+ * \param[in] size     Bit length of key
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_ARG if the slot
+ *                     does not exist
+ */
+int32_t _aes_sync_set_slot_key(struct _aes_sync_device *const dev, const uint8_t slot, const uint8_t *key,
+                               const enum aes_keysize size);
+
+/**
+ * \brief              Use the key stored in a key slot
+ *
+ * \param[in] dev      The pointer to device instance
+ * \param[in] slot     Key slot, less than CONF_AES_KEY_SLOTS
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_ARG if the slot
+ *                     does not exist, ERR_NOT_FOUND if it holds no key
+ */
+int32_t _aes_sync_select_key_slot(struct _aes_sync_device *const dev, const uint8_t slot);
+
+/**
+ * \brief              Erase a key slot and the material derived from it
+ *
+ * \param[in] dev      The pointer to device instance
+ * \param[in] slot     Key slot, less than CONF_AES_KEY_SLOTS
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_ARG if the slot
+ *                     does not exist
+ */
+int32_t _aes_sync_clear_key_slot(struct _aes_sync_device *const dev, const uint8_t slot);
+
 /**
  * \brief              AES-ECB block encryption/decryption
  *
@@ -283,6 +328,22 @@ int32_t _aes_sync_gcm_update(struct _aes_sync_device *const dev, const uint8_t *
  */
 int32_t _aes_sync_gcm_finish(struct _aes_sync_device *const dev, uint8_t *tag, uint32_t tag_len);
 
+/**
+ * \brief              AES-GCM encryption/decryption of a batch of messages
+ *
+ * The key and hash subkey are loaded once for all messages.
+ *
+ * \param[in]  dev     The pointer to device instance
+ * \param[in]  enc     AES_SYNC_ENCRYPT or AES_SYNC_DECRYPT
+ * \param[in]  jobs    Array of messages
+ * \param[in]  count   Number of messages
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_DATA if a tag
+ *                     did not match on decrypt
+ */
+int32_t _aes_sync_gcm_crypt_and_tag_batch(struct _aes_sync_device *const dev, const enum aes_action enc,
+                                          struct aes_gcm_job *const jobs, const uint32_t count);
+
 /**
  * \brief              AES-CCM block encryption/decryption
  *
@@ -304,6 +365,62 @@ int32_t _aes_sync_ccm_crypt_and_tag(struct _aes_sync_device *const dev, const en
                                     uint8_t *output, uint32_t length, const uint8_t *iv, uint32_t iv_len,
                                     const uint8_t *aad, uint32_t aad_len, uint8_t *tag, uint32_t tag_len);
 
+/**
+ * \brief              AES-CMAC message authentication
+ *
+ * \param[in]  dev     The pointer to device instance
+ * \param[in]  input   Buffer holding the message
+ * \param[in]  length  Byte length of the message
+ * \param[out] mac     Buffer holding the MAC
+ * \param[in]  mac_len Length of MAC
+ *
+ * \return             ERR_NONE if successful
+ */
+int32_t _aes_sync_cmac(struct _aes_sync_device *const dev, const uint8_t *input, uint32_t length, uint8_t *mac,
+                       uint32_t mac_len);
+
+/**
+ * \brief              AES-XTS data unit encryption/decryption
+ *
+ * \param[in]  dev       The pointer to device instance
+ * \param[in]  enc       AES_SYNC_ENCRYPT or AES_SYNC_DECRYPT
+ * \param[in]  tweak_key Tweak key, same size as the data key
+ * \param[in]  input     Buffer holding the input data
+ * \param[out] output    Buffer holding the output data
+ * \param[in]  length    Byte length of the data unit, at least 16
+ * \param[in]  tweak     128-bit tweak, the data unit number
+ *
+ * \return             ERR_NONE if successful
+ */
+int32_t _aes_sync_xts_crypt(struct _aes_sync_device *const dev, const enum aes_action enc, const uint8_t *tweak_key,
+                            const uint8_t *input, uint8_t *output, uint32_t length, const uint8_t tweak[16]);
+
+/**
+ * \brief              AES key wrap (RFC 3394)
+ *
+ * \param[in]  dev     The pointer to device instance
+ * \param[in]  input   Key data to wrap
+ * \param[out] output  Wrapped key, length + 8 bytes
+ * \param[in]  length  Byte length of the key data, a multiple of 8, at least 16
+ *
+ * \return             ERR_NONE if successful
+ */
+int32_t _aes_sync_kw_wrap(struct _aes_sync_device *const dev, const uint8_t *input, uint8_t *output, uint32_t length);
+
+/**
+ * \brief              AES key unwrap (RFC 3394)
+ *
+ * \param[in]  dev     The pointer to device instance
+ * \param[in]  input   Wrapped key
+ * \param[out] output  Key data, length - 8 bytes
+ * \param[in]  length  Byte length of the wrapped key, a multiple of 8, at least 24
+ *
+ * \return             ERR_NONE if successful, ERR_INVALID_DATA if the
+ *                     integrity check failed
+ */
+int32_t _aes_sync_kw_unwrap(struct _aes_sync_device *const dev, const uint8_t *input, uint8_t *output,
+                            uint32_t length);
+
 /**
  * \brief Retrieve the current driver version
  *
@@ -53,7 +53,8 @@ extern "C" {
  * \brief CRC Device
  */
 struct _crc_sync_device {
-	void *hw; /*!< Hardware module instance handler */
+	void *  hw;       /*!< Hardware module instance handler */
+	uint8_t sessions; /*!< Number of users keeping the DSU writable */
 };
 
 /**
@@ -101,9 +102,33 @@ int32_t _crc_sync_enable(struct _crc_sync_device *const device);
  */
 int32_t _crc_sync_disable(struct _crc_sync_device *const device);
 
+/**
+ * \brief Keep the DSU writable until _crc_sync_end
+ *
+ * Calls nest, the PAC write protection is only changed by the outermost
+ * calls.
+ *
+ * \param[in] device The pointer to device instance
+ *
+ * \return Operation status.
+ */
+int32_t _crc_sync_begin(struct _crc_sync_device *const device);
+
+/**
+ * \brief Restore the DSU write protection
+ *
+ * \param[in] device The pointer to device instance
+ *
+ * \return Operation status.
+ */
+int32_t _crc_sync_end(struct _crc_sync_device *const device);
+
 /**
  * \brief Calculate CRC value of the buffer
  *
+ * Long buffers are split in runs of CONF_DSU_CRC_RUN_LENGTH words, interrupts
+ * are only disabled during a run.
+ *
  * \param[in] device The pointer to device instance
  * \param[in] data Pointer to the input data buffer
  * \param[in] len Length of the input data buffer
@@ -123,7 +148,7 @@ int32_t _crc_sync_crc32(struct _crc_sync_device *const device, uint32_t *const d
  *
  * \param[in] device The pointer to device instance
  * \param[in] data Pointer to the input data buffer
- * \param[in] len Length of the input data buffer
+ * \param[in] len Length of the input data buffer in half words
  * \param[in,out] pcrc Pointer to the CRC value
  *
  * \return Calculate result.
@@ -131,6 +131,18 @@ int32_t _dma_srcinc_enable(const uint8_t channel, const bool enable);
  * \return status of operation
  */
 int32_t _dma_dstinc_enable(const uint8_t channel, const bool enable);
+
+/**
+ * \brief Set the size of one DMA beat
+ *
+ * Must be called before setting the data amount, which is given in beats.
+ *
+ * \param[in] channel DMA channel to set beat size for
+ * \param[in] beat_size Beat size, 0 for byte, 1 for half-word, 2 for word
+ *
+ * \return status of operation
+ */
+int32_t _dma_set_beat_size(const uint8_t channel, const uint8_t beat_size);
 /**
  * \brief Set the amount of data to be transfered per transaction
  *
@@ -150,6 +162,28 @@ int32_t _dma_set_data_amount(const uint8_t channel, const uint32_t amount);
  */
 int32_t _dma_enable_transaction(const uint8_t channel, const bool software_trigger);
 
+/**
+ * \brief Disable DMA transaction on the given channel
+ *
+ * The ongoing burst, if any, is completed before the channel stops.
+ *
+ * \param[in] channel DMA channel to disable transaction on
+ *
+ * \return status of operation
+ */
+int32_t _dma_disable_transaction(const uint8_t channel);
+
+/**
+ * \brief Retrieve the number of beats left in the last transaction
+ *
+ * Only valid once the channel is disabled or the transaction is complete.
+ *
+ * \param[in] channel DMA channel to retrieve the amount for
+ *
+ * \return The number of beats not transferred
+ */
+uint32_t _dma_get_remaining_amount(const uint8_t channel);
+
 /**
  * \brief Retrieves DMA resource structure
  *
@@ -71,9 +71,10 @@ struct _flash_callback {
  * \brief FLASH descriptor device structure.
  */
 struct _flash_device {
-	struct _flash_callback flash_cb; /*!< Interrupt handers  */
-	struct _irq_descriptor irq;      /*!< Interrupt descriptor */
-	void *                 hw;       /*!< Hardware module instance handler */
+	struct _flash_callback flash_cb;     /*!< Interrupt handers  */
+	struct _irq_descriptor irq;          /*!< Interrupt descriptor */
+	void *                 hw;           /*!< Hardware module instance handler */
+	uint32_t *             block_buffer; /*!< Scratch buffer for block rewrites, NULL if not set */
 };
 
 /**
@@ -106,6 +107,27 @@ void _flash_deinit(struct _flash_device *const device);
  */
 void _flash_read(struct _flash_device *const device, const uint32_t src_addr, uint8_t *buffer, uint32_t length);
 
+/**
+ * \brief Get a pointer to the memory mapped flash content.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ * \param[in]  src_addr      Source bytes address in flash
+ *
+ * \return Pointer to the flash content at the given address
+ */
+const uint8_t *_flash_get_pointer(struct _flash_device *const device, const uint32_t src_addr);
+
+/**
+ * \brief Check whether a flash area can be read without stalling.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ * \param[in]  src_addr      Source bytes address in flash
+ * \param[in]  length        Number of bytes to read
+ *
+ * \return false if a flash command in progress stalls reads of the area
+ */
+bool _flash_is_readable(struct _flash_device *const device, const uint32_t src_addr, const uint32_t length);
+
 /**
  * \brief Writes a number of bytes in the internal Flash.
  *
@@ -200,6 +222,73 @@ uint8_t _flash_get_wait_state(struct _flash_device *const device);
  */
 void _flash_set_wait_state(struct _flash_device *const device, uint8_t state);
 
+/**
+ * \brief Get the minimum number of wait states for a CPU frequency.
+ *
+ * \param[in] cpu_freq       The CPU frequency in Hz
+ *
+ * \return The minimum number of wait states for read operations
+ */
+uint8_t _flash_get_min_wait_state(const uint32_t cpu_freq);
+
+/**
+ * \brief Enable/disable the automatic wait states generation.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ * \param[in] state          true to let the hardware select the wait states
+ */
+void _flash_set_auto_wait_state(struct _flash_device *const device, const bool state);
+
+/**
+ * \brief Check whether the automatic wait states generation is enabled.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ *
+ * \return true if the hardware selects the wait states
+ */
+bool _flash_get_auto_wait_state(struct _flash_device *const device);
+
+/**
+ * \brief Enable/disable the cache of a flash bank.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ * \param[in] bank           The flash bank, 0 or 1
+ * \param[in] state          true to enable the cache
+ */
+void _flash_set_cache(struct _flash_device *const device, const uint8_t bank, const bool state);
+
+/**
+ * \brief Check whether the cache of a flash bank is enabled.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ * \param[in] bank           The flash bank, 0 or 1
+ *
+ * \return true if the cache is enabled
+ */
+bool _flash_get_cache(struct _flash_device *const device, const uint8_t bank);
+
+/**
+ * \brief Set the power reduction mode of the flash during sleep.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ * \param[in] mode           The CTRLA.PRM value
+ */
+void _flash_set_power_reduction_mode(struct _flash_device *const device, const uint8_t mode);
+
+/**
+ * \brief Measure the execution time of code running from flash.
+ *
+ * Runs a fixed workload from flash with the current wait states. The flash
+ * bank caches and the CMCC are disabled for the measurement and restored
+ * afterwards.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ * \param[in] iterations     Number of workload iterations
+ *
+ * \return The number of CPU cycles spent
+ */
+uint32_t _flash_benchmark(struct _flash_device *const device, const uint32_t iterations);
+
 /**
  * \brief Enable/disable Flash interrupt
  *
@@ -209,6 +298,77 @@ void _flash_set_wait_state(struct _flash_device *const device, uint8_t state);
  */
 void _flash_set_irq_state(struct _flash_device *const device, const enum _flash_cb_type type, const bool state);
 
+/**
+ * \brief Get the flash erase block size.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ *
+ * \return The flash erase block size
+ */
+uint32_t _flash_get_block_size(struct _flash_device *const device);
+
+/**
+ * \brief Check whether the flash is ready to accept a new command.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ *
+ * \return true if the flash is ready, false if a command is in progress
+ */
+bool _flash_is_ready(struct _flash_device *const device);
+
+/**
+ * \brief Start erasing a block in the internal flash.
+ *
+ * Return once the command is issued, the ready interrupt signals its end.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ * \param[in]  dst_addr      Destination bytes address inside the block
+ */
+void _flash_start_erase_block(struct _flash_device *const device, const uint32_t dst_addr);
+
+/**
+ * \brief Start programming a number of bytes inside a page without erase.
+ *
+ * Return once the command is issued, the ready interrupt signals its end.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ * \param[in]  dst_addr      Destination bytes address to write into flash
+ * \param[in]  buffer        Pointer to buffer with data to write to flash
+ * \param[in]  length        Number of bytes to write, up to the page end
+ */
+void _flash_start_program(struct _flash_device *const device, const uint32_t dst_addr, const uint8_t *buffer,
+                          const uint32_t length);
+
+/**
+ * \brief Check whether the flash can be read while an address is written.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ * \param[in]  dst_addr      Destination bytes address to write into flash
+ *
+ * \return true if the code running the driver is not stalled while the
+ *         address is erased or written
+ */
+bool _flash_is_read_while_write(struct _flash_device *const device, const uint32_t dst_addr);
+
+/**
+ * \brief Check whether the physical bank A is mapped at the flash start.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ *
+ * \return true if bank A is mapped first, false if bank B is
+ */
+bool _flash_is_bank_a_first(struct _flash_device *const device);
+
+/**
+ * \brief Swap the flash banks and reset the device.
+ *
+ * The bank mapped in the second half of the flash is mapped at the flash
+ * start after the reset. This function does not return.
+ *
+ * \param[in] device         The pointer to FLASH device instance
+ */
+void _flash_swap_banks(struct _flash_device *const device);
+
 /*
  * Below RWW flash APIs are only available for device which has RWWEE
  * flash array, such as SAM C20/C21/D21/L21/L22/R30/DA1/HA1 etc.
@@ -146,6 +146,20 @@ int32_t _i2c_m_async_transfer(struct _i2c_m_async_device *const i2c_dev, struct
  */
 int32_t _i2c_m_async_set_baudrate(struct _i2c_m_async_device *const i2c_dev, uint32_t clkrate, uint32_t baudrate);
 
+/**
+ * \brief Set speed mode of I2C
+ *
+ * This function selects the bus speed mode, the I2C must be disabled. In
+ * high-speed mode every transfer not flagged I2C_M_NO_HS starts with the
+ * master code at the full speed baud rate and continues at the high-speed one.
+ *
+ * \param[in] i2c_dev The pointer to i2c device structure
+ * \param[in] mode I2C_STANDARD_MODE, I2C_FASTMODE_PLUS or I2C_HIGHSPEED_MODE
+ *
+ * \return Return 0 for success and negative value for error
+ */
+int32_t _i2c_m_async_set_speed_mode(struct _i2c_m_async_device *const i2c_dev, const uint16_t mode);
+
 /**
  * \brief Register callback to I2C
  *
@@ -44,6 +44,7 @@ extern "C" {
  */
 #define I2C_M_RD 0x0001 /* read data, from slave to master */
 #define I2C_M_BUSY 0x0100
+#define I2C_M_NO_HS 0x0200 /* full speed transfer on a high-speed bus */
 #define I2C_M_TEN 0x0400   /* this is a ten bit chip address */
 #define I2C_M_SEVEN 0x0800 /* this is a seven bit chip address */
 #define I2C_M_FAIL 0x1000
@@ -64,9 +65,10 @@ extern "C" {
 /**
  * \brief i2c I2C Modes
  */
-#define I2C_STANDARD_MODE 0x00
-#define I2C_FASTMODE 0x01
-#define I2C_HIGHSPEED_MODE 0x02
+#define I2C_STANDARD_MODE 0x00 /* Standard and Fast mode, up to 400 kHz */
+#define I2C_FASTMODE 0x01      /* Fast mode Plus, up to 1 MHz */
+#define I2C_FASTMODE_PLUS I2C_FASTMODE
+#define I2C_HIGHSPEED_MODE 0x02 /* High-speed mode, up to 3.4 MHz */
 
 /**
  * \brief i2c master message structure
@@ -167,6 +169,20 @@ int32_t _i2c_m_sync_transfer(struct _i2c_m_sync_device *const i2c_dev, struct _i
  */
 int32_t _i2c_m_sync_set_baudrate(struct _i2c_m_sync_device *const i2c_dev, uint32_t clkrate, uint32_t baudrate);
 
+/**
+ * \brief Set speed mode of I2C
+ *
+ * This function selects the bus speed mode, the I2C must be disabled. In
+ * high-speed mode every transfer not flagged I2C_M_NO_HS starts with the
+ * master code at the full speed baud rate and continues at the high-speed one.
+ *
+ * \param[in] i2c_dev The pointer to i2c device structure
+ * \param[in] mode I2C_STANDARD_MODE, I2C_FASTMODE_PLUS or I2C_HIGHSPEED_MODE
+ *
+ * \return Return 0 for success and negative value for error
+ */
+int32_t _i2c_m_sync_set_speed_mode(struct _i2c_m_sync_device *const i2c_dev, const uint16_t mode);
+
 /**
  * \brief Send send condition on the I2C bus
  *
@@ -44,7 +44,13 @@ extern "C" {
 /**
  * \brief i2c callback types
  */
-enum _i2c_s_async_callback_type { I2C_S_DEVICE_ERROR, I2C_S_DEVICE_TX, I2C_S_DEVICE_RX_COMPLETE };
+enum _i2c_s_async_callback_type {
+	I2C_S_DEVICE_ERROR,
+	I2C_S_DEVICE_TX,
+	I2C_S_DEVICE_RX_COMPLETE,
+	I2C_S_DEVICE_ADDR_MATCH,
+	I2C_S_DEVICE_STOP
+};
 
 /**
  * \brief Forward declaration of I2C Slave device
@@ -63,6 +69,8 @@ struct _i2c_s_async_callback {
 	void (*error)(struct _i2c_s_async_device *const device);
 	void (*tx)(struct _i2c_s_async_device *const device);
 	void (*rx_done)(struct _i2c_s_async_device *const device, const uint8_t data);
+	void (*addr_match)(struct _i2c_s_async_device *const device, const bool read);
+	void (*stop)(struct _i2c_s_async_device *const device);
 };
 
 /**
@@ -167,6 +175,28 @@ i2c_s_status_t _i2c_s_async_get_status(const struct _i2c_s_async_device *const d
  */
 int32_t _i2c_s_async_abort_transmission(const struct _i2c_s_async_device *const device);
 
+/**
+ * \brief Retrieve the address of the data register, for use as DMA target
+ *
+ * \param[in] device The pointer to i2c device structure
+ *
+ * \return The address of the data register
+ */
+void *_i2c_s_async_get_data_address(const struct _i2c_s_async_device *const device);
+
+/**
+ * \brief Enable/disable automatic acknowledge of the slave address
+ *
+ * The address match interrupt is only raised when the address is not
+ * acknowledged automatically. Must be called while the module is disabled.
+ *
+ * \param[in] device The pointer to i2c device structure
+ * \param[in] state Enable or disable
+ *
+ * \return Return 0 for success and negative value for error
+ */
+int32_t _i2c_s_async_set_auto_address_ack(struct _i2c_s_async_device *const device, const bool state);
+
 /**
  * \brief Enable/disable I2C slave interrupt
  *
@@ -0,0 +1,150 @@
+/**
+ * \file
+ *
+ * \brief ICM related functionality declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#ifndef HPL_ICM_H_INCLUDED
+#define HPL_ICM_H_INCLUDED
+
+#include <compiler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Number of ICM regions
+ */
+#define ICM_REGIONS 4
+
+/**
+ * \brief ICM hash algorithms
+ */
+enum icm_algo { ICM_ALGO_SHA1 = 0, ICM_ALGO_SHA256 = 1, ICM_ALGO_SHA224 = 4 };
+
+/**
+ * \brief Memory region monitored by the ICM
+ */
+struct icm_region {
+	const void *start;  /*!< Word aligned start address */
+	uint32_t    blocks; /*!< Length in 64 byte blocks, 1 to 65536 */
+};
+
+struct _icm_device;
+
+/**
+ * \brief ICM callbacks
+ */
+struct _icm_callbacks {
+	void (*digest_mismatch)(struct _icm_device *const dev, const uint8_t region);
+	void (*bus_error)(struct _icm_device *const dev, const uint8_t region);
+};
+
+/**
+ * \brief ICM device
+ */
+struct _icm_device {
+	void *                hw; /*!< Hardware module instance handler */
+	struct _icm_callbacks cb; /*!< Interrupt callbacks */
+};
+
+/**
+ * \brief              Initialize ICM
+ *
+ * \param[in]  dev     The pointer to device instance
+ * \param[in]  hw      The pointer to hardware instance
+ *
+ * \return             ERR_NONE if successful
+ */
+int32_t _icm_init(struct _icm_device *const dev, void *const hw);
+
+/**
+ * \brief              Deinitialize ICM
+ *
+ * \param[in]  dev     The pointer to device instance
+ */
+void _icm_deinit(struct _icm_device *const dev);
+
+/**
+ * \brief              Run the SHA compression function over whole blocks
+ *
+ * The ICM does not pad, data must be a multiple of 64 bytes. The state is
+ * kept in the byte order of the digest.
+ *
+ * \param[in]  dev     The pointer to device instance
+ * \param[in]  algo    ICM_ALGO_SHA1 or ICM_ALGO_SHA256
+ * \param[in, out] state Chaining state, 5 words for SHA-1, 8 for SHA-256
+ * \param[in]  data    Word aligned data
+ * \param[in]  blocks  Number of 64 byte blocks
+ *
+ * \return             ERR_NONE if successful, ERR_BUSY if the ICM is
+ *                     monitoring, ERR_IO on a bus error
+ */
+int32_t _icm_sha_process(struct _icm_device *const dev, const enum icm_algo algo, uint32_t *const state,
+                         const void *const data, uint32_t blocks);
+
+/**
+ * \brief              Start monitoring memory regions
+ *
+ * The digests of the first pass are stored, every following pass compares
+ * against them and raises the digest mismatch callback on a difference.
+ *
+ * \param[in]  dev     The pointer to device instance
+ * \param[in]  algo    Hash algorithm
+ * \param[in]  regions Regions to monitor
+ * \param[in]  count   Number of regions, 1 to ICM_REGIONS
+ *
+ * \return             ERR_NONE if successful, ERR_BUSY if the ICM is in use
+ */
+int32_t _icm_monitor_start(struct _icm_device *const dev, const enum icm_algo algo,
+                           const struct icm_region *const regions, const uint8_t count);
+
+/**
+ * \brief              Stop monitoring memory regions
+ *
+ * \param[in]  dev     The pointer to device instance
+ */
+void _icm_monitor_stop(struct _icm_device *const dev);
+
+/**
+ * \brief              Check if the ICM is monitoring
+ *
+ * \param[in]  dev     The pointer to device instance
+ *
+ * \return             true if the ICM is enabled
+ */
+bool _icm_is_monitoring(struct _icm_device *const dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HPL_ICM_H_INCLUDED */
@@ -80,8 +80,14 @@ struct _qspi_dma_dev {
 	 *  handle interrupts.
 	 */
 	struct _qspi_dma_callbacks cb;
-	/** DMA resource */
-	struct _dma_resource *resource;
+	/** DMA resource of the TX channel */
+	struct _dma_resource *tx_resource;
+	/** DMA resource of the RX channel */
+	struct _dma_resource *rx_resource;
+	/** DMA resource of the command in progress, reported to the callbacks */
+	struct _dma_resource *xfer_resource;
+	/** Set when the data phase of the command in progress failed */
+	volatile bool xfer_error;
 };
 
 /**
@@ -129,6 +135,23 @@ int32_t _qspi_dma_disable(struct _qspi_dma_dev *dev);
  */
 int32_t _qspi_dma_serial_run_command(struct _qspi_dma_dev *dev, const struct _qspi_command *cmd);
 
+/**
+ * \brief Configure scrambling of memory transfers.
+ *
+ * Data moved with QSPI_READMEM_ACCESS and QSPI_WRITEMEM_ACCESS transfers is
+ * scrambled on write and unscrambled on read, including memory mapped reads.
+ *
+ * \param[in] dev The pointer to QSPI device instance
+ * \param[in] enable Enable scrambling, disabling also clears the key
+ * \param[in] device_unique Mix in the random value of this device, so the
+ *                          stored data can only be read back by this device
+ * \param[in] key Scrambling user key
+ *  \return Operation status.
+ *  \retval ERR_NONE Operation done successfully.
+ */
+int32_t _qspi_dma_set_scrambling(struct _qspi_dma_dev *dev, const bool enable, const bool device_unique,
+                                 const uint32_t key);
+
 /**
  *  \brief Register the QSPI device callback
  *  \param[in] dev Pointer to the SPI device instance.
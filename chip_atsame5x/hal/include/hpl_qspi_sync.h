@@ -97,6 +97,48 @@ int32_t _qspi_sync_disable(struct _qspi_sync_dev *dev);
  */
 int32_t _qspi_sync_serial_run_command(struct _qspi_sync_dev *dev, const struct _qspi_command *cmd);
 
+/**
+ * \brief Configure scrambling of memory transfers.
+ *
+ * Data moved with QSPI_READMEM_ACCESS and QSPI_WRITEMEM_ACCESS transfers is
+ * scrambled on write and unscrambled on read, including memory mapped reads.
+ *
+ * \param[in] dev The pointer to QSPI device instance
+ * \param[in] enable Enable scrambling, disabling also clears the key
+ * \param[in] device_unique Mix in the random value of this device, so the
+ *                          stored data can only be read back by this device
+ * \param[in] key Scrambling user key
+ *  \return Operation status.
+ *  \retval ERR_NONE Operation done successfully.
+ */
+int32_t _qspi_sync_set_scrambling(struct _qspi_sync_dev *dev, const bool enable, const bool device_unique,
+                                  const uint32_t key);
+
+/**
+ * \brief Map the serial memory into the QSPI AHB window.
+ *
+ * The read command is left in the instruction frame, so every AHB read access
+ * at QSPI_AHB + address fetches from the serial memory. Code can be executed
+ * in place from the window.
+ *
+ * \param[in] dev The pointer to QSPI device instance
+ * \param[in] cmd The pointer to the read command, with QSPI_READMEM_ACCESS
+ *  \return Operation status.
+ *  \retval ERR_NONE Operation done successfully.
+ */
+int32_t _qspi_sync_enable_xip(struct _qspi_sync_dev *dev, const struct _qspi_command *cmd);
+
+/**
+ * \brief End the memory mapped read access.
+ *
+ * Must be called before running serial commands again.
+ *
+ * \param[in] dev The pointer to QSPI device instance
+ *  \return Operation status.
+ *  \retval ERR_NONE Operation done successfully.
+ */
+int32_t _qspi_sync_disable_xip(struct _qspi_sync_dev *dev);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,183 @@
+/**
+ * \file
+ *
+ * \brief SmartEEPROM related functionality declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+
+#ifndef _HPL_SMART_EEPROM_H_INCLUDED
+#define _HPL_SMART_EEPROM_H_INCLUDED
+
+#include <compiler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup hpl__smart__eeprom SmartEEPROM Driver
+ *
+ * \section smart_eeprom_rev Revision History
+ * - v0.0.0.1 Initial Commit
+ *
+ *@{
+ */
+
+/**
+ * \brief SmartEEPROM device structure
+ */
+struct _smart_eeprom_device {
+	void *   hw;            /*!< Hardware module instance handler */
+	uint32_t writes;        /*!< Number of write accesses to the SmartEEPROM */
+	uint32_t reallocations; /*!< Number of sector reallocations */
+	uint32_t overflows;     /*!< Number of writes rejected for lack of space */
+};
+
+/**
+ * \brief Initialize SmartEEPROM.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ * \param[in] hw The pointer to hardware instance
+ *
+ * \return Initialization status.
+ * \retval ERR_NOT_INITIALIZED No SmartEEPROM is allocated in the user row
+ */
+int32_t _smart_eeprom_init(struct _smart_eeprom_device *const device, void *const hw);
+
+/**
+ * \brief Deinitialize SmartEEPROM.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ */
+void _smart_eeprom_deinit(struct _smart_eeprom_device *const device);
+
+/**
+ * \brief Get the SmartEEPROM size.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ *
+ * \return The size in bytes of the SmartEEPROM address window, 0 if disabled
+ */
+uint32_t _smart_eeprom_get_size(struct _smart_eeprom_device *const device);
+
+/**
+ * \brief Read bytes from the SmartEEPROM.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ * \param[in] offset Offset in the SmartEEPROM
+ * \param[out] buffer Pointer to the buffer to read to
+ * \param[in] length Number of bytes to read
+ */
+void _smart_eeprom_read(struct _smart_eeprom_device *const device, const uint32_t offset, uint8_t *buffer,
+                        const uint32_t length);
+
+/**
+ * \brief Write bytes to the SmartEEPROM.
+ *
+ * Bytes which already hold the value to write are skipped.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ * \param[in] offset Offset in the SmartEEPROM
+ * \param[in] buffer Pointer to the data to write
+ * \param[in] length Number of bytes to write
+ *
+ * \return Write status.
+ * \retval ERR_DENIED The SmartEEPROM is locked
+ * \retval ERR_IO A write was rejected because the active sector overflowed
+ */
+int32_t _smart_eeprom_write(struct _smart_eeprom_device *const device, const uint32_t offset, const uint8_t *buffer,
+                            const uint32_t length);
+
+/**
+ * \brief Select the SmartEEPROM write mode.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ * \param[in] buffered true to collect writes in the page buffer until it is
+ *                     flushed, false to write them to flash at once
+ */
+void _smart_eeprom_set_buffered(struct _smart_eeprom_device *const device, const bool buffered);
+
+/**
+ * \brief Write the SmartEEPROM page buffer to flash.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ */
+void _smart_eeprom_flush(struct _smart_eeprom_device *const device);
+
+/**
+ * \brief Check whether the SmartEEPROM is busy.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ *
+ * \return true if a write or a sector reallocation is in progress
+ */
+bool _smart_eeprom_is_busy(struct _smart_eeprom_device *const device);
+
+/**
+ * \brief Get the SmartEEPROM sector in use.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ *
+ * \return The index of the active sector, 0 or 1
+ */
+uint8_t _smart_eeprom_get_active_sector(struct _smart_eeprom_device *const device);
+
+/**
+ * \brief Get the number of flash blocks in a SmartEEPROM sector.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ *
+ * \return The number of blocks per sector, 0 if disabled
+ */
+uint8_t _smart_eeprom_get_sector_blocks(struct _smart_eeprom_device *const device);
+
+/**
+ * \brief Store the SmartEEPROM allocation in the user row.
+ *
+ * The allocation takes effect after the next reset, changing it loses the
+ * SmartEEPROM content.
+ *
+ * \param[in] device The pointer to SmartEEPROM device instance
+ * \param[in] sector_blocks Number of flash blocks per sector, 0 to disable
+ * \param[in] page_size_sel SmartEEPROM page size selection, 4 << value bytes
+ *
+ * \return Operation status.
+ * \retval ERR_INVALID_ARG The allocation is not supported
+ */
+int32_t _smart_eeprom_configure(struct _smart_eeprom_device *const device, const uint8_t sector_blocks,
+                                const uint8_t page_size_sel);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HPL_SMART_EEPROM_H_INCLUDED */
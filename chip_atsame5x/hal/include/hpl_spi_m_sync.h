@@ -143,6 +143,34 @@ int32_t _spi_m_sync_set_char_size(struct _spi_m_sync_dev *dev, const enum spi_ch
  */
 int32_t _spi_m_sync_set_data_order(struct _spi_m_sync_dev *dev, const enum spi_data_order dord);
 
+/**
+ *  \brief Enable or disable SPI 32-bit data extension
+ *  With 32-bit data extension enabled, four 8-bit characters are moved per
+ *  DATA register access. Tail characters of messages that are not a multiple
+ *  of four are completed through the LENGTH counter.
+ *  \param[in, out] dev Pointer to the SPI device instance.
+ *  \param[in] enable True to enable 32-bit data extension.
+ *  \return Operation status.
+ *  \retval ERR_INVALID_ARG The character size is not 8-bit.
+ *  \retval ERR_DENIED SPI has been enabled.
+ *  \retval ERR_BUSY SPI is not ready to accept new setting.
+ *  \retval 0 Operation done successfully.
+ */
+int32_t _spi_m_sync_set_data32(struct _spi_m_sync_dev *dev, const bool enable);
+
+/**
+ *  \brief Enable or disable pipelined SPI transfers
+ *  By default the next character is not loaded before the previous one has
+ *  been received, which leaves a gap between characters. In pipelined mode the
+ *  TX data register is reloaded as soon as it is empty, keeping up to two
+ *  characters in flight so that the RX FIFO can not overflow.
+ *  \param[in, out] dev Pointer to the SPI device instance.
+ *  \param[in] enable True to enable pipelined transfers.
+ *  \return Operation status.
+ *  \retval 0 Operation done successfully.
+ */
+int32_t _spi_m_sync_set_pipelined(struct _spi_m_sync_dev *dev, const bool enable);
+
 /**
  *  \brief Transfer the whole message without interrupt
  *  Transfer the message, it will keep waiting until the message finish or
@@ -60,6 +60,8 @@ struct _spi_sync_dev {
 	uint8_t char_size;
 	/** Dummy byte used in master mode when reading the slave */
 	uint16_t dummy_byte;
+	/** Keep the next character loaded while the previous one is shifted */
+	bool pipelined;
 };
 
 #ifdef __cplusplus
@@ -104,6 +104,24 @@ enum usart_character_size {
 	USART_CHARACTER_SIZE_7BITS = 7
 };
 
+/**
+ * \brief USART 32-bit data extension
+ *
+ * Selects whether DATA register reads and writes move one character or four
+ * packed 8-bit characters per access.
+ */
+enum usart_data32_mode {
+	USART_DATA32_DISABLED   = 0,
+	USART_DATA32_WRITE      = 1,
+	USART_DATA32_READ       = 2,
+	USART_DATA32_READ_WRITE = 3
+};
+
+/**
+ * \brief USART data length counter mode
+ */
+enum usart_data_length_mode { USART_DATA_LENGTH_DISABLED = 0, USART_DATA_LENGTH_TX = 1, USART_DATA_LENGTH_RX = 2 };
+
 //@}
 
 #ifdef __cplusplus
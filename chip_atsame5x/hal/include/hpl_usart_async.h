@@ -185,6 +185,14 @@ void _usart_async_set_stop_bits(struct _usart_async_device *const device, const
  */
 void _usart_async_set_character_size(struct _usart_async_device *const device, const enum usart_character_size size);
 
+/**
+ * \brief Set 32-bit data extension mode
+ *
+ * \param[in] device The pointer to USART device instance
+ * \param[in] mode The 32-bit data extension mode to set
+ */
+void _usart_async_set_data32_mode(struct _usart_async_device *const device, const enum usart_data32_mode mode);
+
 /**
  * \brief Retrieve usart status
  *
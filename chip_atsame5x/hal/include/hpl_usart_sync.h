@@ -161,6 +161,36 @@ void _usart_sync_set_stop_bits(struct _usart_sync_device *const device, const en
  */
 void _usart_sync_set_character_size(struct _usart_sync_device *const device, const enum usart_character_size size);
 
+/**
+ * \brief Set 32-bit data extension mode
+ *
+ * \param[in] device The pointer to USART device instance
+ * \param[in] mode The 32-bit data extension mode to set
+ */
+void _usart_sync_set_data32_mode(struct _usart_sync_device *const device, const enum usart_data32_mode mode);
+
+/**
+ * \brief Retrieve 32-bit data extension mode
+ *
+ * \param[in] device The pointer to USART device instance
+ *
+ * \return The current 32-bit data extension mode
+ */
+enum usart_data32_mode _usart_sync_get_data32_mode(const struct _usart_sync_device *const device);
+
+/**
+ * \brief Set data length counter
+ *
+ * When enabled in 32-bit data extension mode, the last access of each
+ * \p length bytes long frame only moves the remaining length % 4 bytes.
+ *
+ * \param[in] device The pointer to USART device instance
+ * \param[in] mode The direction to apply the length counter to
+ * \param[in] length The number of bytes in a frame
+ */
+void _usart_sync_set_data_length(struct _usart_sync_device *const device, const enum usart_data_length_mode mode,
+                                 const uint8_t length);
+
 /**
  * \brief Retrieve usart status
  *
@@ -186,6 +216,27 @@ void _usart_sync_write_byte(struct _usart_sync_device *const device, uint8_t dat
  */
 uint8_t _usart_sync_read_byte(const struct _usart_sync_device *const device);
 
+/**
+ * \brief Write four packed characters to the given USART instance
+ *
+ * Only valid when 32-bit data extension is enabled for writes.
+ *
+ * \param[in] device The pointer to USART device instance
+ * \param[in] data Data to write, first character in the least significant byte
+ */
+void _usart_sync_write_word(struct _usart_sync_device *const device, uint32_t data);
+
+/**
+ * \brief Read four packed characters from the given USART instance
+ *
+ * Only valid when 32-bit data extension is enabled for reads.
+ *
+ * \param[in] device The pointer to USART device instance
+ *
+ * \return Data received, first character in the least significant byte
+ */
+uint32_t _usart_sync_read_word(const struct _usart_sync_device *const device);
+
 /**
  * \brief Check if USART is ready to send next byte
  *
@@ -0,0 +1,333 @@
+/**
+ * \file
+ *
+ * \brief AES DMA related functionality implementation.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#include "hal_aes_dma.h"
+#include <hal_atomic.h>
+#include <utils_assert.h>
+#include <utils.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Driver version
+ */
+#define AES_DMA_DRIVER_VERSION 0x00000001u
+
+static void aes_dma_done(struct _aes_dma_device *dev);
+static void aes_dma_error(struct _aes_dma_device *dev);
+
+/**
+ * \internal Claim the device, the completion interrupt releases it
+ */
+static int32_t aes_dma_acquire(struct aes_dma_descriptor *descr)
+{
+	bool busy;
+
+	CRITICAL_SECTION_ENTER()
+	busy        = descr->busy;
+	descr->busy = true;
+	CRITICAL_SECTION_LEAVE()
+
+	return busy ? ERR_BUSY : ERR_NONE;
+}
+
+/**
+ * \internal Release the device if the operation did not start
+ */
+static int32_t aes_dma_release_on_error(struct aes_dma_descriptor *descr, const int32_t rc)
+{
+	if (rc) {
+		descr->busy = false;
+	}
+
+	return rc;
+}
+
+/**
+ * \internal Check the DMA constraints of a block operation
+ */
+static int32_t aes_dma_check(const uint8_t *input, const uint8_t *output, const uint32_t length, const bool blocks)
+{
+	if ((((uint32_t)input | (uint32_t)output) & 0x3) || (blocks && (!length || (length & 0xF)))) {
+		return ERR_INVALID_ARG;
+	}
+
+	return ERR_NONE;
+}
+
+int32_t aes_dma_init(struct aes_dma_descriptor *descr, void *const hw)
+{
+	int32_t rc;
+
+	ASSERT(descr && hw);
+
+	descr->busy     = false;
+	descr->cb.done  = NULL;
+	descr->cb.error = NULL;
+
+	rc = _aes_dma_init(&descr->dev, hw);
+	if (rc) {
+		return rc;
+	}
+	_aes_dma_register_callback(&descr->dev, AES_DMA_CB_DONE, aes_dma_done);
+	_aes_dma_register_callback(&descr->dev, AES_DMA_CB_ERROR, aes_dma_error);
+
+	return ERR_NONE;
+}
+
+int32_t aes_dma_deinit(struct aes_dma_descriptor *descr)
+{
+	ASSERT(descr);
+
+	return _aes_dma_deinit(&descr->dev);
+}
+
+int32_t aes_dma_enable(struct aes_dma_descriptor *descr)
+{
+	ASSERT(descr);
+
+	return _aes_sync_enable(&descr->dev.sync);
+}
+
+int32_t aes_dma_disable(struct aes_dma_descriptor *descr)
+{
+	ASSERT(descr);
+
+	return _aes_sync_disable(&descr->dev.sync);
+}
+
+int32_t aes_dma_set_encrypt_key(struct aes_dma_descriptor *descr, const uint8_t *key, const enum aes_keysize size)
+{
+	int32_t rc;
+
+	ASSERT(descr && key);
+
+	rc = aes_dma_acquire(descr);
+	if (rc) {
+		return rc;
+	}
+	rc          = _aes_dma_set_key(&descr->dev, key, size);
+	descr->busy = false;
+
+	return rc;
+}
+
+int32_t aes_dma_set_decrypt_key(struct aes_dma_descriptor *descr, const uint8_t *key, const enum aes_keysize size)
+{
+	int32_t rc;
+
+	ASSERT(descr && key);
+
+	rc = aes_dma_acquire(descr);
+	if (rc) {
+		return rc;
+	}
+	rc          = _aes_dma_set_key(&descr->dev, key, size);
+	descr->busy = false;
+
+	return rc;
+}
+
+int32_t aes_dma_register_callback(struct aes_dma_descriptor *descr, const enum _aes_dma_cb_type type,
+                                  aes_dma_cb_t cb)
+{
+	ASSERT(descr);
+
+	switch (type) {
+	case AES_DMA_CB_DONE:
+		descr->cb.done = cb;
+		break;
+	case AES_DMA_CB_ERROR:
+		descr->cb.error = cb;
+		break;
+	default:
+		return ERR_INVALID_ARG;
+	}
+
+	return ERR_NONE;
+}
+
+int32_t aes_dma_ecb_crypt(struct aes_dma_descriptor *descr, const enum aes_action enc, const uint8_t *input,
+                          uint8_t *output, uint32_t length)
+{
+	int32_t rc;
+
+	ASSERT(descr && input && output);
+
+	rc = aes_dma_check(input, output, length, true);
+	if (rc) {
+		return rc;
+	}
+	rc = aes_dma_acquire(descr);
+	if (rc) {
+		return rc;
+	}
+
+	return aes_dma_release_on_error(descr, _aes_dma_ecb_crypt(&descr->dev, enc, input, output, length));
+}
+
+int32_t aes_dma_cbc_crypt(struct aes_dma_descriptor *descr, const enum aes_action enc, const uint8_t *input,
+                          uint8_t *output, uint32_t length, uint8_t iv[16])
+{
+	int32_t rc;
+
+	ASSERT(descr && input && output && iv);
+
+	rc = aes_dma_check(input, output, length, true);
+	if (rc) {
+		return rc;
+	}
+	rc = aes_dma_acquire(descr);
+	if (rc) {
+		return rc;
+	}
+
+	return aes_dma_release_on_error(descr, _aes_dma_cbc_crypt(&descr->dev, enc, input, output, length, iv));
+}
+
+int32_t aes_dma_ctr_crypt(struct aes_dma_descriptor *descr, const uint8_t *input, uint8_t *output, uint32_t length,
+                          uint8_t nc[16])
+{
+	int32_t rc;
+
+	ASSERT(descr && input && output && nc);
+
+	rc = aes_dma_check(input, output, length, true);
+	if (rc) {
+		return rc;
+	}
+	rc = aes_dma_acquire(descr);
+	if (rc) {
+		return rc;
+	}
+
+	return aes_dma_release_on_error(descr, _aes_dma_ctr_crypt(&descr->dev, input, output, length, nc));
+}
+
+int32_t aes_dma_gcm_start(struct aes_dma_descriptor *const descr, const enum aes_action enc, const uint8_t *iv,
+                          uint32_t iv_len, const uint8_t *aad, uint32_t aad_len)
+{
+	int32_t rc;
+
+	ASSERT(descr && iv && iv_len);
+	ASSERT((aad_len == 0) || aad);
+
+	rc = aes_dma_acquire(descr);
+	if (rc) {
+		return rc;
+	}
+	rc          = _aes_dma_gcm_start(&descr->dev, enc, iv, iv_len, aad, aad_len);
+	descr->busy = false;
+
+	return rc;
+}
+
+int32_t aes_dma_gcm_update(struct aes_dma_descriptor *const descr, const uint8_t *input, uint8_t *output,
+                           uint32_t length)
+{
+	int32_t rc;
+
+	ASSERT(descr);
+	ASSERT((length == 0) || (input && output));
+
+	rc = aes_dma_check(input, output, length, false);
+	if (rc) {
+		return rc;
+	}
+	rc = aes_dma_acquire(descr);
+	if (rc) {
+		return rc;
+	}
+
+	return aes_dma_release_on_error(descr, _aes_dma_gcm_update(&descr->dev, input, output, length));
+}
+
+int32_t aes_dma_gcm_finish(struct aes_dma_descriptor *const descr, uint8_t *tag, uint32_t tag_len)
+{
+	int32_t rc;
+
+	ASSERT(descr && tag && tag_len && (tag_len <= 16));
+
+	rc = aes_dma_acquire(descr);
+	if (rc) {
+		return rc;
+	}
+	rc          = _aes_dma_gcm_finish(&descr->dev, tag, tag_len);
+	descr->busy = false;
+
+	return rc;
+}
+
+bool aes_dma_is_busy(const struct aes_dma_descriptor *descr)
+{
+	ASSERT(descr);
+
+	return descr->busy;
+}
+
+uint32_t aes_dma_get_version(void)
+{
+	return AES_DMA_DRIVER_VERSION;
+}
+
+/**
+ * \internal Operation completed
+ */
+static void aes_dma_done(struct _aes_dma_device *dev)
+{
+	struct aes_dma_descriptor *descr = CONTAINER_OF(dev, struct aes_dma_descriptor, dev);
+
+	descr->busy = false;
+	if (descr->cb.done) {
+		descr->cb.done(descr);
+	}
+}
+
+/**
+ * \internal DMA error during the operation
+ */
+static void aes_dma_error(struct _aes_dma_device *dev)
+{
+	struct aes_dma_descriptor *descr = CONTAINER_OF(dev, struct aes_dma_descriptor, dev);
+
+	descr->busy = false;
+	if (descr->cb.error) {
+		descr->cb.error(descr);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
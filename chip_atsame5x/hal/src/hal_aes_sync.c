@@ -100,6 +100,34 @@ int32_t aes_sync_set_decrypt_key(struct aes_sync_descriptor *descr, const uint8_
 	return _aes_sync_set_key(&descr->dev, key, size);
 }
 
+/**
+ * \brief              Store a key in a key slot and select it
+ */
+int32_t aes_sync_set_slot_key(struct aes_sync_descriptor *descr, const uint8_t slot, const uint8_t *key,
+                              const enum aes_keysize size)
+{
+	ASSERT(descr && key);
+	return _aes_sync_set_slot_key(&descr->dev, slot, key, size);
+}
+
+/**
+ * \brief              Use the key stored in a key slot
+ */
+int32_t aes_sync_select_key_slot(struct aes_sync_descriptor *descr, const uint8_t slot)
+{
+	ASSERT(descr);
+	return _aes_sync_select_key_slot(&descr->dev, slot);
+}
+
+/**
+ * \brief              Erase a key slot
+ */
+int32_t aes_sync_clear_key_slot(struct aes_sync_descriptor *descr, const uint8_t slot)
+{
+	ASSERT(descr);
+	return _aes_sync_clear_key_slot(&descr->dev, slot);
+}
+
 /**
  * \brief              AES-ECB block encryption/decryption
  */
@@ -425,6 +453,68 @@ int32_t aes_sync_gcm_finish(struct aes_sync_descriptor *const descr, uint8_t *ta
 	return _aes_sync_gcm_finish(&descr->dev, tag, tag_len);
 }
 
+/**
+ * \brief              AES-GCM encryption/decryption of a batch of messages
+ */
+int32_t aes_sync_gcm_crypt_and_tag_batch(struct aes_sync_descriptor *const descr, const enum aes_action enc,
+                                         struct aes_gcm_job *const jobs, const uint32_t count)
+{
+	uint32_t i;
+
+	ASSERT(descr && (jobs || !count));
+	for (i = 0; i < count; i++) {
+		ASSERT(jobs[i].iv && jobs[i].iv_len);
+		ASSERT((jobs[i].input && jobs[i].output && jobs[i].length) || (!jobs[i].length));
+		ASSERT(((jobs[i].aad && jobs[i].aad_len) || !jobs[i].aad_len));
+		ASSERT((jobs[i].tag && jobs[i].tag_len && (jobs[i].tag_len <= 16)) || !jobs[i].tag_len);
+	}
+
+	return _aes_sync_gcm_crypt_and_tag_batch(&descr->dev, enc, jobs, count);
+}
+
+/**
+ * \brief              Measure per message cycles of single and batched AES-GCM
+ */
+int32_t aes_sync_gcm_benchmark(struct aes_sync_descriptor *const descr, struct aes_gcm_job *const jobs,
+                               const uint32_t count, uint32_t *const single_cycles, uint32_t *const batch_cycles)
+{
+	uint32_t demcr = CoreDebug->DEMCR;
+	uint32_t dwt   = DWT->CTRL;
+	uint32_t start;
+	uint32_t i;
+
+	ASSERT(descr && jobs && count && single_cycles && batch_cycles);
+
+	/* Count CPU cycles with the DWT */
+	CoreDebug->DEMCR = demcr | CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL        = dwt | DWT_CTRL_CYCCNTENA_Msk;
+
+	start = DWT->CYCCNT;
+	for (i = 0; i < count; i++) {
+		_aes_sync_gcm_crypt_and_tag(&descr->dev,
+		                            AES_ENCRYPT,
+		                            jobs[i].input,
+		                            jobs[i].output,
+		                            jobs[i].length,
+		                            jobs[i].iv,
+		                            jobs[i].iv_len,
+		                            jobs[i].aad,
+		                            jobs[i].aad_len,
+		                            jobs[i].tag,
+		                            jobs[i].tag_len);
+	}
+	*single_cycles = (DWT->CYCCNT - start) / count;
+
+	start = DWT->CYCCNT;
+	_aes_sync_gcm_crypt_and_tag_batch(&descr->dev, AES_ENCRYPT, jobs, count);
+	*batch_cycles = (DWT->CYCCNT - start) / count;
+
+	DWT->CTRL        = dwt;
+	CoreDebug->DEMCR = demcr;
+
+	return ERR_NONE;
+}
+
 /**
  * \brief              AES-CCM block encryption/decryption
  */
@@ -472,6 +562,47 @@ int32_t aes_sync_ccm_auth_decrypt(struct aes_sync_descriptor *const descr, const
 	return ERR_NONE;
 }
 
+/**
+ * \brief              AES-CMAC message authentication
+ */
+int32_t aes_sync_cmac(struct aes_sync_descriptor *const descr, const uint8_t *input, uint32_t length, uint8_t *mac,
+                      uint32_t mac_len)
+{
+	ASSERT(descr && (input || !length) && mac && mac_len && (mac_len <= 16));
+	return _aes_sync_cmac(&descr->dev, input, length, mac, mac_len);
+}
+
+/**
+ * \brief              AES-XTS data unit encryption/decryption
+ */
+int32_t aes_sync_xts_crypt(struct aes_sync_descriptor *const descr, const enum aes_action enc,
+                           const uint8_t *tweak_key, const uint8_t *input, uint8_t *output, uint32_t length,
+                           const uint8_t tweak[16])
+{
+	ASSERT(descr && tweak_key && input && output && tweak);
+	return _aes_sync_xts_crypt(&descr->dev, enc, tweak_key, input, output, length, tweak);
+}
+
+/**
+ * \brief              AES key wrap (RFC 3394)
+ */
+int32_t aes_sync_kw_wrap(struct aes_sync_descriptor *const descr, const uint8_t *input, uint8_t *output,
+                         uint32_t length)
+{
+	ASSERT(descr && input && output);
+	return _aes_sync_kw_wrap(&descr->dev, input, output, length);
+}
+
+/**
+ * \brief              AES key unwrap (RFC 3394)
+ */
+int32_t aes_sync_kw_unwrap(struct aes_sync_descriptor *const descr, const uint8_t *input, uint8_t *output,
+                           uint32_t length)
+{
+	ASSERT(descr && input && output);
+	return _aes_sync_kw_unwrap(&descr->dev, input, output, length);
+}
+
 /**
  * \brief Retrieve the current driver version
  */
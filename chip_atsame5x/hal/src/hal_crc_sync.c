@@ -32,9 +32,22 @@
  */
 
 #include <hal_crc_sync.h>
+#include <utils.h>
 
 #define DRIVER_VERSION 0x00000001u
 
+#ifndef CONF_CRC_SYNC_DSU_THRESHOLD
+/* The DSU needs the PAC unlocked and a few register accesses per run */
+#define CONF_CRC_SYNC_DSU_THRESHOLD 128
+#endif
+
+#ifndef CONF_CRC_SYNC_DMAC_THRESHOLD
+#define CONF_CRC_SYNC_DMAC_THRESHOLD 32
+#endif
+
+static int32_t crc_sync_run(struct crc_sync_descriptor *const descr, const enum crc_sync_polynomial poly,
+                            enum crc_sync_engine engine, const uint8_t *data, const uint32_t length, uint32_t *pcrc);
+
 /**
  * \brief Initialize CRC.
  */
@@ -42,6 +55,9 @@ int32_t crc_sync_init(struct crc_sync_descriptor *const descr, void *const hw)
 {
 	ASSERT(descr && hw);
 
+	descr->dsu_threshold  = CONF_CRC_SYNC_DSU_THRESHOLD;
+	descr->dmac_threshold = CONF_CRC_SYNC_DMAC_THRESHOLD;
+
 	return _crc_sync_init(&descr->dev, hw);
 }
 
@@ -91,9 +107,287 @@ int32_t crc_sync_crc32(struct crc_sync_descriptor *const descr, uint32_t *const
 int32_t crc_sync_crc16(struct crc_sync_descriptor *const descr, uint16_t *const data, const uint32_t len,
                        uint16_t *pcrc)
 {
+	uint32_t crc;
+	int32_t  rc;
+
 	ASSERT(descr && data && len && pcrc);
 
-	return _crc_sync_crc16(&descr->dev, data, len, pcrc);
+	crc = *pcrc;
+	rc  = crc_sync_compute(descr, CRC_SYNC_CRC16_CCITT, data, len * sizeof(uint16_t), &crc);
+	if (rc == ERR_NONE) {
+		*pcrc = (uint16_t)crc;
+	}
+
+	return rc;
+}
+
+/**
+ * \brief Calculate the CRC of a buffer with the fastest engine
+ */
+int32_t crc_sync_compute(struct crc_sync_descriptor *const descr, const enum crc_sync_polynomial poly,
+                         const void *const data, const uint32_t length, uint32_t *pcrc)
+{
+	int32_t rc;
+
+	ASSERT(descr && (data || !length) && pcrc);
+
+	rc = crc_sync_run(descr, poly, CRC_SYNC_ENGINE_AUTO, (const uint8_t *)data, length, pcrc);
+	if (rc == ERR_BUSY) {
+		/* The DMAC CRC is used by a DMA channel */
+		rc = crc_sync_run(descr, poly, CRC_SYNC_ENGINE_SOFTWARE, (const uint8_t *)data, length, pcrc);
+	}
+
+	return rc;
+}
+
+/**
+ * \brief Start a streaming CRC
+ */
+int32_t crc_sync_begin(struct crc_sync_descriptor *const descr, struct crc_sync_context *const ctx,
+                       const enum crc_sync_polynomial poly)
+{
+	ASSERT(descr && ctx);
+
+	ctx->descr = descr;
+	ctx->poly  = poly;
+
+	if (poly == CRC_SYNC_CRC16_CCITT) {
+		ctx->crc = 0xFFFF;
+		return ERR_NONE;
+	}
+
+	ctx->crc = 0xFFFFFFFF;
+	if (poly == CRC_SYNC_CRC32) {
+		return _crc_sync_begin(&descr->dev);
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Add a chunk of data to a streaming CRC
+ */
+int32_t crc_sync_update(struct crc_sync_context *const ctx, const void *const data, const uint32_t length)
+{
+	ASSERT(ctx && ctx->descr);
+
+	return crc_sync_compute(ctx->descr, ctx->poly, data, length, &ctx->crc);
+}
+
+/**
+ * \brief Finish a streaming CRC
+ */
+int32_t crc_sync_finish(struct crc_sync_context *const ctx, uint32_t *const crc)
+{
+	int32_t rc = ERR_NONE;
+
+	ASSERT(ctx && ctx->descr);
+
+	if (ctx->poly == CRC_SYNC_CRC32) {
+		rc = _crc_sync_end(&ctx->descr->dev);
+	}
+
+	if (crc) {
+		*crc = (ctx->poly == CRC_SYNC_CRC16_CCITT) ? ctx->crc : ~ctx->crc;
+	}
+	ctx->descr = NULL;
+
+	return rc;
+}
+
+/**
+ * \brief Set the shortest length computed by a hardware engine
+ */
+int32_t crc_sync_set_threshold(struct crc_sync_descriptor *const descr, const enum crc_sync_engine engine,
+                               const uint32_t length)
+{
+	ASSERT(descr);
+
+	switch (engine) {
+	case CRC_SYNC_ENGINE_DSU:
+		descr->dsu_threshold = length;
+		break;
+	case CRC_SYNC_ENGINE_DMAC:
+		descr->dmac_threshold = length;
+		break;
+	default:
+		return ERR_INVALID_ARG;
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Measure the time an engine takes to calculate a CRC
+ */
+int32_t crc_sync_benchmark(struct crc_sync_descriptor *const descr, const enum crc_sync_polynomial poly,
+                           const enum crc_sync_engine engine, const void *const data, const uint32_t length,
+                           uint32_t *const cycles)
+{
+	uint32_t demcr = CoreDebug->DEMCR;
+	uint32_t dwt   = DWT->CTRL;
+	uint32_t crc   = 0xFFFFFFFF;
+	uint32_t start;
+	int32_t  rc;
+
+	ASSERT(descr && (data || !length) && cycles);
+
+	/* Count CPU cycles with the DWT */
+	CoreDebug->DEMCR = demcr | CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL        = dwt | DWT_CTRL_CYCCNTENA_Msk;
+
+	start   = DWT->CYCCNT;
+	rc      = crc_sync_run(descr, poly, engine, (const uint8_t *)data, length, &crc);
+	*cycles = DWT->CYCCNT - start;
+
+	DWT->CTRL        = dwt;
+	CoreDebug->DEMCR = demcr;
+
+	return rc;
+}
+
+/**
+ * \brief Find the lengths above which the hardware engines are faster
+ */
+int32_t crc_sync_calibrate(struct crc_sync_descriptor *const descr, const void *const buffer, const uint32_t size)
+{
+	static const struct {
+		enum crc_sync_engine     engine;
+		enum crc_sync_polynomial poly;
+	} hw[] = {{CRC_SYNC_ENGINE_DSU, CRC_SYNC_CRC32}, {CRC_SYNC_ENGINE_DMAC, CRC_SYNC_CRC16_CCITT}};
+	uint32_t hw_cycles, sw_cycles;
+	uint32_t low, high, length;
+	uint8_t  i;
+	int32_t  rc;
+
+	ASSERT(descr && buffer && size);
+
+	for (i = 0; i < ARRAY_SIZE(hw); i++) {
+		/* The shortest length tried where the engine is faster */
+		low  = 0;
+		high = UINT32_MAX;
+
+		for (length = 4; length <= size && high == UINT32_MAX; length *= 2) {
+			rc = crc_sync_benchmark(descr, hw[i].poly, hw[i].engine, buffer, length, &hw_cycles);
+			if (rc == ERR_NONE) {
+				rc = crc_sync_benchmark(descr, hw[i].poly, CRC_SYNC_ENGINE_SOFTWARE, buffer, length, &sw_cycles);
+			}
+			if (rc != ERR_NONE) {
+				return rc;
+			}
+
+			if (hw_cycles < sw_cycles) {
+				high = length;
+			} else {
+				low = length;
+			}
+		}
+
+		/* Bisect down to a word */
+		while (high != UINT32_MAX && high - low > 4) {
+			length = ((low + high) / 2) & ~3u;
+			rc     = crc_sync_benchmark(descr, hw[i].poly, hw[i].engine, buffer, length, &hw_cycles);
+			if (rc == ERR_NONE) {
+				rc = crc_sync_benchmark(descr, hw[i].poly, CRC_SYNC_ENGINE_SOFTWARE, buffer, length, &sw_cycles);
+			}
+			if (rc != ERR_NONE) {
+				return rc;
+			}
+
+			if (hw_cycles < sw_cycles) {
+				high = length;
+			} else {
+				low = length;
+			}
+		}
+
+		crc_sync_set_threshold(descr, hw[i].engine, high);
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \internal Calculate a CRC with an engine
+ *
+ * \param[in] descr A CRC descriptor
+ * \param[in] poly The polynomial
+ * \param[in] engine The engine, or CRC_SYNC_ENGINE_AUTO
+ * \param[in] data Pointer to the input data buffer
+ * \param[in] length Length of the input data buffer in bytes
+ * \param[in,out] pcrc Pointer to the running CRC value, unchanged on error
+ *
+ * \return Calculated result.
+ */
+static int32_t crc_sync_run(struct crc_sync_descriptor *const descr, const enum crc_sync_polynomial poly,
+                            enum crc_sync_engine engine, const uint8_t *data, const uint32_t length, uint32_t *pcrc)
+{
+	uint32_t head, body, crc;
+	uint16_t crc16;
+	int32_t  rc;
+
+	if (engine == CRC_SYNC_ENGINE_AUTO) {
+		if (poly == CRC_SYNC_CRC32 && length >= descr->dsu_threshold) {
+			engine = CRC_SYNC_ENGINE_DSU;
+		} else if (poly == CRC_SYNC_CRC16_CCITT && length >= descr->dmac_threshold) {
+			engine = CRC_SYNC_ENGINE_DMAC;
+		} else {
+			engine = CRC_SYNC_ENGINE_SOFTWARE;
+		}
+	}
+
+	switch (engine) {
+	case CRC_SYNC_ENGINE_DSU:
+		if (poly != CRC_SYNC_CRC32) {
+			return ERR_UNSUPPORTED_OP;
+		}
+
+		/* The DSU reads words, the bytes around them are done in software */
+		head = min(length, (0 - (uint32_t)data) & 3);
+		body = (length - head) & ~3u;
+		crc  = utils_crc32(*pcrc, data, head);
+		if (body) {
+			rc = _crc_sync_crc32(&descr->dev, (uint32_t *)(data + head), body / 4, &crc);
+			if (rc != ERR_NONE) {
+				return rc;
+			}
+		}
+		*pcrc = utils_crc32(crc, data + head + body, length - head - body);
+		break;
+
+	case CRC_SYNC_ENGINE_DMAC:
+		if (poly != CRC_SYNC_CRC16_CCITT) {
+			return ERR_UNSUPPORTED_OP;
+		}
+
+		/* The DMAC is fed half words, the bytes around them are done in software */
+		head  = min(length, (uint32_t)data & 1);
+		body  = (length - head) & ~1u;
+		crc16 = utils_crc16_ccitt(*pcrc, data, head);
+		if (body) {
+			rc = _crc_sync_crc16(&descr->dev, (uint16_t *)(data + head), body / 2, &crc16);
+			if (rc != ERR_NONE) {
+				return rc;
+			}
+		}
+		*pcrc = utils_crc16_ccitt(crc16, data + head + body, length - head - body);
+		break;
+
+	case CRC_SYNC_ENGINE_SOFTWARE:
+		if (poly == CRC_SYNC_CRC32) {
+			*pcrc = utils_crc32(*pcrc, data, length);
+		} else if (poly == CRC_SYNC_CRC32C) {
+			*pcrc = utils_crc32c(*pcrc, data, length);
+		} else {
+			*pcrc = utils_crc16_ccitt(*pcrc, data, length);
+		}
+		break;
+
+	default:
+		return ERR_INVALID_ARG;
+	}
+
+	return ERR_NONE;
 }
 
 /**
@@ -45,6 +45,7 @@ static void flash_ready(struct _flash_device *device);
 static void flash_error(struct _flash_device *device);
 
 static int32_t flash_is_address_aligned(struct flash_descriptor *flash, const uint32_t flash_addr);
+static void flash_job_process(struct flash_descriptor *flash);
 
 /**
  * \brief Initialize the FLASH HAL instance and hardware for callback mode.
@@ -62,6 +63,7 @@ int32_t flash_init(struct flash_descriptor *flash, void *const hw)
 
 	flash->dev.flash_cb.ready_cb = flash_ready;
 	flash->dev.flash_cb.error_cb = flash_error;
+	list_reset(&flash->jobs);
 
 	return ERR_NONE;
 }
@@ -98,6 +100,24 @@ int32_t flash_read(struct flash_descriptor *flash, uint32_t src_addr, uint8_t *b
 	return ERR_NONE;
 }
 
+/**
+ * \brief Get read-only access to the flash content without copy
+ */
+const uint8_t *flash_get_pointer(struct flash_descriptor *flash, const uint32_t src_addr, const uint32_t length)
+{
+	ASSERT(flash);
+
+	uint32_t page_size   = _flash_get_page_size(&flash->dev);
+	uint32_t total_pages = _flash_get_total_pages(&flash->dev);
+
+	/* Check if the address is valid */
+	if ((src_addr > page_size * total_pages) || (src_addr + length > page_size * total_pages)) {
+		return NULL;
+	}
+
+	return _flash_get_pointer(&flash->dev, src_addr);
+}
+
 /**
  * \brief Updates several bytes to the internal Flash
  */
@@ -117,11 +137,27 @@ int32_t flash_write(struct flash_descriptor *flash, uint32_t dst_addr, uint8_t *
 		return ERR_DENIED;
 	}
 
+	if (flash_is_busy(flash)) {
+		return ERR_BUSY;
+	}
+
 	_flash_write(&flash->dev, dst_addr, buffer, length);
 
 	return ERR_NONE;
 }
 
+/**
+ * \brief Set the scratch buffer used to rewrite a flash block
+ */
+int32_t flash_set_block_buffer(struct flash_descriptor *flash, uint32_t *buffer)
+{
+	ASSERT(flash);
+
+	flash->dev.block_buffer = buffer;
+
+	return ERR_NONE;
+}
+
 /**
  * \brief Appends a number of bytes to a page in the internal Flash
  */
@@ -141,6 +177,10 @@ int32_t flash_append(struct flash_descriptor *flash, uint32_t dst_addr, uint8_t
 		return ERR_DENIED;
 	}
 
+	if (flash_is_busy(flash)) {
+		return ERR_BUSY;
+	}
+
 	_flash_append(&flash->dev, dst_addr, buffer, length);
 
 	return ERR_NONE;
@@ -165,6 +205,10 @@ int32_t flash_erase(struct flash_descriptor *flash, const uint32_t dst_addr, con
 		return ERR_INVALID_ARG;
 	}
 
+	if (flash_is_busy(flash)) {
+		return ERR_BUSY;
+	}
+
 	_flash_erase(&flash->dev, dst_addr, page_nums);
 
 	return ERR_NONE;
@@ -190,11 +234,110 @@ int32_t flash_register_callback(struct flash_descriptor *flash, const enum flash
 		return ERR_INVALID_ARG;
 	}
 
-	_flash_set_irq_state(&flash->dev, (enum _flash_cb_type)type, NULL != func);
+	/* Pending flash jobs still need the interrupts */
+	_flash_set_irq_state(&flash->dev, (enum _flash_cb_type)type, (NULL != func) || flash_is_busy(flash));
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Queue a flash job
+ */
+int32_t flash_submit_job(struct flash_descriptor *flash, struct flash_job *job)
+{
+	ASSERT(flash && job && job->length);
+	ASSERT((FLASH_JOB_ERASE == job->type) || job->buffer);
+
+	uint32_t page_size   = _flash_get_page_size(&flash->dev);
+	uint32_t total_pages = _flash_get_total_pages(&flash->dev);
+	uint32_t block_size  = _flash_get_block_size(&flash->dev);
+	int32_t  rc          = ERR_NONE;
+
+	/* Check if the address is valid */
+	if ((job->addr > page_size * total_pages) || (job->addr + job->length > page_size * total_pages)) {
+		return ERR_BAD_ADDRESS;
+	}
+
+	if ((FLASH_JOB_ERASE == job->type) && ((job->addr | job->length) & (block_size - 1))) {
+		return ERR_INVALID_ARG;
+	}
+
+	if (_flash_is_locked(&flash->dev, job->addr)) {
+		return ERR_DENIED;
+	}
+
+	CRITICAL_SECTION_ENTER()
+	if (is_list_element(&flash->jobs, job)) {
+		rc = ERR_BUSY;
+	} else {
+		job->offset = 0;
+		job->status = ERR_BUSY;
+		list_insert_at_end(&flash->jobs, job);
+
+		/* Start the engine if the job is the only one */
+		if (list_get_head(&flash->jobs) == job) {
+			_flash_set_irq_state(&flash->dev, FLASH_DEVICE_CB_READY, true);
+			_flash_set_irq_state(&flash->dev, FLASH_DEVICE_CB_ERROR, true);
+			flash_job_process(flash);
+		}
+	}
+	CRITICAL_SECTION_LEAVE()
+
+	return rc;
+}
+
+/**
+ * \brief Check whether flash jobs are pending
+ */
+bool flash_is_busy(struct flash_descriptor *flash)
+{
+	ASSERT(flash);
+	return NULL != list_get_head(&flash->jobs);
+}
+
+/**
+ * \brief Check whether a flash job on given address uses read-while-write
+ */
+bool flash_is_read_while_write(struct flash_descriptor *flash, const uint32_t dst_addr)
+{
+	ASSERT(flash);
+	return _flash_is_read_while_write(&flash->dev, dst_addr);
+}
+
+/**
+ * \brief Get the physical bank mapped at the flash start
+ */
+uint8_t flash_get_active_bank(struct flash_descriptor *flash)
+{
+	ASSERT(flash);
+	return _flash_is_bank_a_first(&flash->dev) ? 0 : 1;
+}
+
+/**
+ * \brief Swap the flash banks and reset the device
+ */
+int32_t flash_swap_banks(struct flash_descriptor *flash)
+{
+	ASSERT(flash);
+
+	if (flash_is_busy(flash)) {
+		return ERR_BUSY;
+	}
+
+	_flash_swap_banks(&flash->dev);
 
 	return ERR_NONE;
 }
 
+/**
+ * \brief Get the flash erase block size.
+ */
+uint32_t flash_get_block_size(struct flash_descriptor *flash)
+{
+	ASSERT(flash);
+	return _flash_get_block_size(&flash->dev);
+}
+
 /**
  * \brief Execute lock in the internal flash
  */
@@ -257,6 +400,86 @@ uint32_t flash_get_total_pages(struct flash_descriptor *flash)
 	return _flash_get_total_pages(&flash->dev);
 }
 
+/**
+ * \brief Get the number of flash read wait states
+ */
+uint8_t flash_get_wait_state(struct flash_descriptor *flash)
+{
+	ASSERT(flash);
+	return _flash_get_wait_state(&flash->dev);
+}
+
+/**
+ * \brief Set the number of flash read wait states
+ */
+int32_t flash_set_wait_state(struct flash_descriptor *flash, const uint8_t state)
+{
+	ASSERT(flash);
+
+	_flash_set_wait_state(&flash->dev, state);
+	_flash_set_auto_wait_state(&flash->dev, false);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Set the minimum safe number of wait states for a CPU frequency
+ */
+uint8_t flash_set_wait_state_for_frequency(struct flash_descriptor *flash, const uint32_t cpu_freq)
+{
+	uint8_t state = _flash_get_min_wait_state(cpu_freq);
+
+	flash_set_wait_state(flash, state);
+
+	return state;
+}
+
+/**
+ * \brief Enable/disable the automatic wait states generation
+ */
+int32_t flash_set_auto_wait_state(struct flash_descriptor *flash, const bool state)
+{
+	ASSERT(flash);
+
+	_flash_set_auto_wait_state(&flash->dev, state);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Enable/disable the cache of a flash bank
+ */
+int32_t flash_set_cache(struct flash_descriptor *flash, const uint8_t bank, const bool state)
+{
+	ASSERT(flash);
+
+	if (bank > 1) {
+		return ERR_INVALID_ARG;
+	}
+
+	_flash_set_cache(&flash->dev, bank, state);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Check whether the cache of a flash bank is enabled
+ */
+bool flash_is_cache_enabled(struct flash_descriptor *flash, const uint8_t bank)
+{
+	ASSERT(flash && (bank < 2));
+	return _flash_get_cache(&flash->dev, bank);
+}
+
+/**
+ * \brief Measure the speed of code running from flash
+ */
+uint32_t flash_benchmark(struct flash_descriptor *flash, const uint32_t iterations)
+{
+	ASSERT(flash);
+	return _flash_benchmark(&flash->dev, iterations);
+}
+
 /**
  * \brief Retrieve the current driver version
  */
@@ -295,6 +518,9 @@ static int32_t flash_is_address_aligned(struct flash_descriptor *flash, const ui
 static void flash_ready(struct _flash_device *device)
 {
 	struct flash_descriptor *const descr = CONTAINER_OF(device, struct flash_descriptor, dev);
+
+	flash_job_process(descr);
+
 	if (descr->callbacks.cb_ready) {
 		descr->callbacks.cb_ready(descr);
 	}
@@ -308,7 +534,65 @@ static void flash_ready(struct _flash_device *device)
 static void flash_error(struct _flash_device *device)
 {
 	struct flash_descriptor *const descr = CONTAINER_OF(device, struct flash_descriptor, dev);
+	struct flash_job *             job   = (struct flash_job *)list_remove_head(&descr->jobs);
+
+	/* The job in progress failed, drop it and go on with the next one */
+	if (job) {
+		job->status = ERR_IO;
+		if (job->cb) {
+			job->cb(descr, job);
+		}
+		flash_job_process(descr);
+	}
+
 	if (descr->callbacks.cb_error) {
 		descr->callbacks.cb_error(descr);
 	}
 }
+
+/**
+ * \internal Start the next step of the pending flash jobs
+ *
+ * Called when a job is queued on an idle flash, and from the ready
+ * interrupt. Completed jobs are removed from the queue and reported.
+ *
+ * \param[in] flash The pointer to the HAL FLASH instance
+ */
+static void flash_job_process(struct flash_descriptor *flash)
+{
+	struct flash_job *job = (struct flash_job *)list_get_head(&flash->jobs);
+	uint32_t          page_size, addr, size;
+
+	while (job) {
+		/* A step is still in progress, wait for its ready interrupt */
+		if (!_flash_is_ready(&flash->dev)) {
+			return;
+		}
+
+		if (job->offset < job->length) {
+			addr = job->addr + job->offset;
+
+			if (FLASH_JOB_ERASE == job->type) {
+				_flash_start_erase_block(&flash->dev, addr);
+				job->offset += _flash_get_block_size(&flash->dev);
+			} else {
+				page_size = _flash_get_page_size(&flash->dev);
+				size      = min(job->length - job->offset, page_size - (addr & (page_size - 1)));
+				_flash_start_program(&flash->dev, addr, job->buffer + job->offset, size);
+				job->offset += size;
+			}
+			return;
+		}
+
+		list_remove_head(&flash->jobs);
+		job->status = ERR_NONE;
+		if (job->cb) {
+			job->cb(flash, job);
+		}
+		job = (struct flash_job *)list_get_head(&flash->jobs);
+	}
+
+	/* All jobs done, leave the interrupts as the user callbacks need them */
+	_flash_set_irq_state(&flash->dev, FLASH_DEVICE_CB_READY, NULL != flash->callbacks.cb_ready);
+	_flash_set_irq_state(&flash->dev, FLASH_DEVICE_CB_ERROR, NULL != flash->callbacks.cb_error);
+}
@@ -0,0 +1,303 @@
+/**
+ * \file
+ *
+ * \brief I/O I2C related functionality implementation.
+ *
+ * Copyright (c) 2014-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+#include <hal_atomic.h>
+#include <hal_i2c_m_async.h>
+#include <utils.h>
+#include <utils_assert.h>
+
+/**
+ * \brief Driver version
+ */
+#define DRIVER_VERSION 0x00000001u
+
+/**
+ * \internal Start one phase of the transaction at the head of the queue
+ */
+static int32_t i2c_m_async_start_phase(struct i2c_m_async_desc *const i2c, struct i2c_m_async_transaction *const trans)
+{
+	struct _i2c_m_msg msg;
+
+	msg.addr = trans->slave_addr;
+	if (!i2c->reading) {
+		msg.len    = trans->wlen;
+		msg.flags  = trans->rlen ? 0 : I2C_M_STOP;
+		msg.buffer = trans->wbuf;
+	} else {
+		msg.len    = trans->rlen;
+		msg.flags  = I2C_M_STOP | I2C_M_RD;
+		msg.buffer = trans->rbuf;
+	}
+	msg.flags |= trans->flags & I2C_M_NO_HS;
+
+	return _i2c_m_async_transfer(&i2c->device, &msg);
+}
+
+/**
+ * \internal Complete the transaction at the head of the queue
+ */
+static void i2c_m_async_finish(struct i2c_m_async_desc *const i2c, const int32_t status)
+{
+	struct i2c_m_async_transaction *trans = list_remove_head(&i2c->queue);
+
+	trans->status = status;
+	if (trans->cb) {
+		trans->cb(i2c, trans);
+	}
+}
+
+/**
+ * \internal Start the transaction at the head of the queue
+ *
+ * The busy flag is cleared once the queue runs empty.
+ */
+static void i2c_m_async_start(struct i2c_m_async_desc *const i2c)
+{
+	struct i2c_m_async_transaction *trans;
+	int32_t                         ret;
+
+	i2c->busy = true;
+	while ((trans = (struct i2c_m_async_transaction *)list_get_head(&i2c->queue)) != NULL) {
+		i2c->reading = !trans->wlen;
+		ret          = i2c_m_async_start_phase(i2c, trans);
+		if (!ret) {
+			return;
+		}
+		i2c_m_async_finish(i2c, ret);
+	}
+	i2c->busy = false;
+}
+
+/**
+ * \internal Message sent, continue with the read phase or the next transaction
+ */
+static void i2c_m_async_tx_complete(struct _i2c_m_async_device *const i2c_dev)
+{
+	struct i2c_m_async_desc *       i2c   = CONTAINER_OF(i2c_dev, struct i2c_m_async_desc, device);
+	struct i2c_m_async_transaction *trans = (struct i2c_m_async_transaction *)list_get_head(&i2c->queue);
+	int32_t                         ret;
+
+	if (trans->rlen) {
+		/* Repeated start */
+		i2c->reading = true;
+		ret          = i2c_m_async_start_phase(i2c, trans);
+		if (!ret) {
+			return;
+		}
+		_i2c_m_async_send_stop(i2c_dev);
+		i2c_m_async_finish(i2c, ret);
+	} else {
+		i2c_m_async_finish(i2c, I2C_OK);
+	}
+	i2c_m_async_start(i2c);
+}
+
+/**
+ * \internal Message received, start the next transaction
+ */
+static void i2c_m_async_rx_complete(struct _i2c_m_async_device *const i2c_dev)
+{
+	struct i2c_m_async_desc *i2c = CONTAINER_OF(i2c_dev, struct i2c_m_async_desc, device);
+
+	i2c_m_async_finish(i2c, I2C_OK);
+	i2c_m_async_start(i2c);
+}
+
+/**
+ * \internal Transfer error, abort the transaction in progress
+ */
+static void i2c_m_async_error(struct _i2c_m_async_device *const i2c_dev, int32_t errcode)
+{
+	struct i2c_m_async_desc *       i2c   = CONTAINER_OF(i2c_dev, struct i2c_m_async_desc, device);
+	struct i2c_m_async_transaction *trans = (struct i2c_m_async_transaction *)list_get_head(&i2c->queue);
+
+	/* A NACK in the write phase of a write-then-read leaves the bus owned */
+	if (errcode == I2C_NACK && !i2c->reading && trans->rlen) {
+		_i2c_m_async_send_stop(i2c_dev);
+	}
+	i2c_m_async_finish(i2c, errcode);
+	i2c_m_async_start(i2c);
+}
+
+/**
+ * \brief Async version of I2C initialize
+ */
+int32_t i2c_m_async_init(struct i2c_m_async_desc *const i2c, void *const hw)
+{
+	int32_t init_status;
+	ASSERT(i2c);
+
+	init_status = _i2c_m_async_init(&i2c->device, hw);
+	if (init_status) {
+		return init_status;
+	}
+
+	list_reset(&i2c->queue);
+	i2c->busy    = false;
+	i2c->enabled = false;
+	i2c->reading = false;
+
+	_i2c_m_async_register_callback(&i2c->device, I2C_M_ASYNC_DEVICE_ERROR, (FUNC_PTR)i2c_m_async_error);
+	_i2c_m_async_register_callback(&i2c->device, I2C_M_ASYNC_DEVICE_TX_COMPLETE, (FUNC_PTR)i2c_m_async_tx_complete);
+	_i2c_m_async_register_callback(&i2c->device, I2C_M_ASYNC_DEVICE_RX_COMPLETE, (FUNC_PTR)i2c_m_async_rx_complete);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Async version of I2C deinitialize
+ */
+int32_t i2c_m_async_deinit(struct i2c_m_async_desc *const i2c)
+{
+	int32_t status;
+	ASSERT(i2c);
+
+	status = _i2c_m_async_deinit(&i2c->device);
+	if (status) {
+		return status;
+	}
+
+	list_reset(&i2c->queue);
+	i2c->busy    = false;
+	i2c->enabled = false;
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Async version of I2C enable
+ */
+int32_t i2c_m_async_enable(struct i2c_m_async_desc *const i2c)
+{
+	int32_t status;
+	ASSERT(i2c);
+
+	status = _i2c_m_async_enable(&i2c->device);
+	if (status) {
+		return status;
+	}
+
+	_i2c_m_async_set_irq_state(&i2c->device, I2C_M_ASYNC_DEVICE_TX_COMPLETE, true);
+	_i2c_m_async_set_irq_state(&i2c->device, I2C_M_ASYNC_DEVICE_ERROR, true);
+
+	CRITICAL_SECTION_ENTER()
+	i2c->enabled = true;
+	if (!i2c->busy) {
+		i2c_m_async_start(i2c);
+	}
+	CRITICAL_SECTION_LEAVE()
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Async version of I2C disable
+ */
+int32_t i2c_m_async_disable(struct i2c_m_async_desc *const i2c)
+{
+	ASSERT(i2c);
+
+	CRITICAL_SECTION_ENTER()
+	i2c->enabled = false;
+	CRITICAL_SECTION_LEAVE()
+
+	_i2c_m_async_set_irq_state(&i2c->device, I2C_M_ASYNC_DEVICE_TX_COMPLETE, false);
+	_i2c_m_async_set_irq_state(&i2c->device, I2C_M_ASYNC_DEVICE_ERROR, false);
+
+	return _i2c_m_async_disable(&i2c->device);
+}
+
+/**
+ * \brief Async version of I2C set baudrate
+ */
+int32_t i2c_m_async_set_baudrate(struct i2c_m_async_desc *const i2c, uint32_t clkrate, uint32_t baudrate)
+{
+	ASSERT(i2c);
+
+	return _i2c_m_async_set_baudrate(&i2c->device, clkrate, baudrate);
+}
+
+/**
+ * \brief Async version of I2C set speed mode
+ */
+int32_t i2c_m_async_set_speed_mode(struct i2c_m_async_desc *const i2c, const uint16_t mode)
+{
+	ASSERT(i2c);
+
+	return _i2c_m_async_set_speed_mode(&i2c->device, mode);
+}
+
+/**
+ * \brief Async version of I2C transaction submission
+ */
+int32_t i2c_m_async_submit(struct i2c_m_async_desc *const i2c, struct i2c_m_async_transaction *const trans)
+{
+	int32_t rc = ERR_NONE;
+
+	ASSERT(i2c && trans);
+
+	if (!trans->wlen && !trans->rlen) {
+		return ERR_INVALID_ARG;
+	}
+
+	CRITICAL_SECTION_ENTER()
+	if (is_list_element(&i2c->queue, trans)) {
+		rc = ERR_BUSY;
+	} else {
+		trans->status = ERR_BUSY;
+		list_insert_at_end(&i2c->queue, trans);
+		if (i2c->enabled && !i2c->busy) {
+			i2c_m_async_start(i2c);
+		}
+	}
+	CRITICAL_SECTION_LEAVE()
+
+	return rc;
+}
+
+/**
+ * \brief Check whether transactions are pending
+ */
+bool i2c_m_async_is_busy(struct i2c_m_async_desc *const i2c)
+{
+	ASSERT(i2c);
+
+	return list_get_head(&i2c->queue) != NULL;
+}
+
+/**
+ * \brief Retrieve the current driver version
+ */
+uint32_t i2c_m_async_get_version(void)
+{
+	return DRIVER_VERSION;
+}
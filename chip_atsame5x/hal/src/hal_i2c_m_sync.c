@@ -156,6 +156,14 @@ int32_t i2c_m_sync_set_baudrate(struct i2c_m_sync_desc *i2c, uint32_t clkrate, u
 	return _i2c_m_sync_set_baudrate(&i2c->device, clkrate, baudrate);
 }
 
+/**
+ * \brief Sync version of i2c set speed mode
+ */
+int32_t i2c_m_sync_set_speed_mode(struct i2c_m_sync_desc *i2c, const uint16_t mode)
+{
+	return _i2c_m_sync_set_speed_mode(&i2c->device, mode);
+}
+
 /**
  * \brief Sync version of i2c write command
  */
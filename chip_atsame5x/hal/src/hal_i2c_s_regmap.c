@@ -0,0 +1,318 @@
+/**
+ * \file
+ *
+ * \brief I2C slave register map implementation.
+ *
+ * Copyright (c) 2014-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+#include <hal_atomic.h>
+#include <hal_i2c_s_regmap.h>
+#include <string.h>
+#include <utils.h>
+#include <utils_assert.h>
+
+/**
+ * \brief Driver version
+ */
+#define DRIVER_VERSION 0x00000001u
+
+/**
+ * \internal Commit the registers written by the master
+ */
+static void i2c_s_regmap_commit(struct i2c_s_regmap_descriptor *const descr)
+{
+	if (!descr->wr_length) {
+		return;
+	}
+
+	memcpy(&descr->regs[descr->wr_offset], &descr->shadow[descr->wr_offset], descr->wr_length);
+	if (descr->write_cb) {
+		descr->write_cb(descr, descr->wr_offset, descr->wr_length);
+	}
+	descr->wr_length = 0;
+}
+
+/**
+ * \internal Start serving a read, by DMA up to the end of the register file
+ */
+static void i2c_s_regmap_start_read(struct i2c_s_regmap_descriptor *const descr)
+{
+	descr->state = I2C_S_REGMAP_READ;
+
+	if (descr->pointer >= descr->size) {
+		/* Nothing to read, DRDY interrupt sends filler */
+		_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_TX, true);
+		return;
+	}
+
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_TX, false);
+	_dma_set_source_address(descr->dma_channel, &descr->shadow[descr->pointer]);
+	_dma_set_destination_address(descr->dma_channel, _i2c_s_async_get_data_address(&descr->device));
+	_dma_set_data_amount(descr->dma_channel, descr->size - descr->pointer);
+	_dma_enable_transaction(descr->dma_channel, false);
+}
+
+/**
+ * \internal End a read, the register pointer advances past the bytes sent by DMA
+ */
+static void i2c_s_regmap_end_read(struct i2c_s_regmap_descriptor *const descr)
+{
+	if (descr->pointer < descr->size) {
+		_dma_disable_transaction(descr->dma_channel);
+		descr->pointer = descr->size - _dma_get_remaining_amount(descr->dma_channel);
+	}
+}
+
+/**
+ * \internal Address matched, end the previous transfer and prepare for the new direction
+ */
+static void i2c_s_regmap_addr_match(struct _i2c_s_async_device *const device, const bool read)
+{
+	struct i2c_s_regmap_descriptor *descr = CONTAINER_OF(device, struct i2c_s_regmap_descriptor, device);
+
+	if (descr->state == I2C_S_REGMAP_READ) {
+		/* Repeated start after a read */
+		i2c_s_regmap_end_read(descr);
+	} else {
+		/* Repeated start after a write */
+		i2c_s_regmap_commit(descr);
+	}
+
+	if (read) {
+		i2c_s_regmap_start_read(descr);
+	} else {
+		_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_RX_COMPLETE, true);
+		descr->state = I2C_S_REGMAP_POINTER;
+	}
+}
+
+/**
+ * \internal Data register empty in read direction, past the end of the register file
+ */
+static void i2c_s_regmap_tx(struct _i2c_s_async_device *const device)
+{
+	_i2c_s_async_write_byte(device, I2C_S_REGMAP_FILLER);
+}
+
+/**
+ * \internal Byte written by the master
+ */
+static void i2c_s_regmap_rx_done(struct _i2c_s_async_device *const device, const uint8_t data)
+{
+	struct i2c_s_regmap_descriptor *descr = CONTAINER_OF(device, struct i2c_s_regmap_descriptor, device);
+
+	if (descr->state == I2C_S_REGMAP_POINTER) {
+		descr->state     = I2C_S_REGMAP_WRITE;
+		descr->pointer   = data;
+		descr->wr_offset = data;
+		descr->wr_length = 0;
+		return;
+	}
+
+	if (descr->state == I2C_S_REGMAP_WRITE && descr->pointer < descr->size) {
+		descr->shadow[descr->pointer++] = data;
+		descr->wr_length++;
+	}
+}
+
+/**
+ * \internal Stop condition, end of the bus transaction
+ */
+static void i2c_s_regmap_stop(struct _i2c_s_async_device *const device)
+{
+	struct i2c_s_regmap_descriptor *descr = CONTAINER_OF(device, struct i2c_s_regmap_descriptor, device);
+
+	if (descr->state == I2C_S_REGMAP_READ) {
+		i2c_s_regmap_end_read(descr);
+	}
+	i2c_s_regmap_commit(descr);
+	if (descr->publish_pending) {
+		memcpy(descr->shadow, descr->regs, descr->size);
+		descr->publish_pending = false;
+	}
+	descr->state = I2C_S_REGMAP_IDLE;
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_TX, true);
+}
+
+/**
+ * \internal Bus error, drop the transaction
+ */
+static void i2c_s_regmap_error(struct _i2c_s_async_device *const device)
+{
+	struct i2c_s_regmap_descriptor *descr = CONTAINER_OF(device, struct i2c_s_regmap_descriptor, device);
+
+	descr->wr_length = 0;
+	i2c_s_regmap_stop(device);
+}
+
+/**
+ * \internal Register file end reached by DMA, further reads get filler
+ */
+static void i2c_s_regmap_dma_done(struct _dma_resource *resource)
+{
+	struct i2c_s_regmap_descriptor *descr = (struct i2c_s_regmap_descriptor *)resource->back;
+
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_TX, true);
+}
+
+/**
+ * \brief Initialize I2C slave register map
+ */
+int32_t i2c_s_regmap_init(struct i2c_s_regmap_descriptor *const descr, void *const hw, uint8_t *const regs,
+                          uint8_t *const shadow, const uint16_t size, const uint8_t dma_channel)
+{
+	int32_t init_status;
+
+	ASSERT(descr && hw && regs && shadow);
+
+	if (!size || size > 256) {
+		return ERR_INVALID_ARG;
+	}
+
+	init_status = _i2c_s_async_init(&descr->device, hw);
+	if (init_status) {
+		return init_status;
+	}
+	/* Acknowledge the address from the address match interrupt, so that
+	 * repeated starts are seen */
+	_i2c_s_async_set_auto_address_ack(&descr->device, false);
+
+	descr->regs            = regs;
+	descr->shadow          = shadow;
+	descr->size            = size;
+	descr->pointer         = 0;
+	descr->wr_length       = 0;
+	descr->state           = I2C_S_REGMAP_IDLE;
+	descr->publish_pending = false;
+	descr->write_cb        = NULL;
+	memcpy(shadow, regs, size);
+
+	descr->device.cb.error      = i2c_s_regmap_error;
+	descr->device.cb.tx         = i2c_s_regmap_tx;
+	descr->device.cb.rx_done    = i2c_s_regmap_rx_done;
+	descr->device.cb.addr_match = i2c_s_regmap_addr_match;
+	descr->device.cb.stop       = i2c_s_regmap_stop;
+
+	descr->dma_channel = dma_channel;
+	_dma_get_channel_resource(&descr->dma, dma_channel);
+	descr->dma->back                 = descr;
+	descr->dma->dma_cb.transfer_done = i2c_s_regmap_dma_done;
+	descr->dma->dma_cb.error         = i2c_s_regmap_dma_done;
+	_dma_srcinc_enable(dma_channel, true);
+	_dma_dstinc_enable(dma_channel, false);
+	_dma_set_irq_state(dma_channel, DMA_TRANSFER_COMPLETE_CB, true);
+	_dma_set_irq_state(dma_channel, DMA_TRANSFER_ERROR_CB, true);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Deinitialize I2C slave register map
+ */
+int32_t i2c_s_regmap_deinit(struct i2c_s_regmap_descriptor *const descr)
+{
+	ASSERT(descr);
+
+	_dma_disable_transaction(descr->dma_channel);
+	_dma_set_irq_state(descr->dma_channel, DMA_TRANSFER_COMPLETE_CB, false);
+	_dma_set_irq_state(descr->dma_channel, DMA_TRANSFER_ERROR_CB, false);
+
+	return _i2c_s_async_deinit(&descr->device);
+}
+
+/**
+ * \brief Enable I2C slave register map
+ */
+int32_t i2c_s_regmap_enable(struct i2c_s_regmap_descriptor *const descr)
+{
+	ASSERT(descr);
+
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_TX, true);
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_ERROR, true);
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_ADDR_MATCH, true);
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_STOP, true);
+
+	return _i2c_s_async_enable(&descr->device);
+}
+
+/**
+ * \brief Disable I2C slave register map
+ */
+int32_t i2c_s_regmap_disable(struct i2c_s_regmap_descriptor *const descr)
+{
+	int32_t status;
+
+	ASSERT(descr);
+
+	status = _i2c_s_async_disable(&descr->device);
+	_dma_disable_transaction(descr->dma_channel);
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_TX, false);
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_ERROR, false);
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_ADDR_MATCH, false);
+	_i2c_s_async_set_irq_state(&descr->device, I2C_S_DEVICE_STOP, false);
+	descr->state = I2C_S_REGMAP_IDLE;
+
+	return status;
+}
+
+/**
+ * \brief Register the register write callback
+ */
+int32_t i2c_s_regmap_register_write_callback(struct i2c_s_regmap_descriptor *const descr,
+                                             const i2c_s_regmap_write_cb_t           cb)
+{
+	ASSERT(descr);
+
+	descr->write_cb = cb;
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Publish the register file to the master
+ */
+void i2c_s_regmap_publish(struct i2c_s_regmap_descriptor *const descr)
+{
+	ASSERT(descr);
+
+	CRITICAL_SECTION_ENTER()
+	if (descr->state == I2C_S_REGMAP_IDLE) {
+		memcpy(descr->shadow, descr->regs, descr->size);
+	} else {
+		descr->publish_pending = true;
+	}
+	CRITICAL_SECTION_LEAVE()
+}
+
+/**
+ * \brief Retrieve the current driver version
+ */
+uint32_t i2c_s_regmap_get_version(void)
+{
+	return DRIVER_VERSION;
+}
@@ -0,0 +1,315 @@
+/**
+ * \file
+ *
+ * \brief ICM functionality implementation.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#include <string.h>
+#include <utils_assert.h>
+#include <hal_icm.h>
+
+/**
+ * \brief Driver version
+ */
+#define DRIVER_VERSION 0x00000001u
+
+/**
+ * \brief Initial hash values, in digest byte order
+ *
+ * SHA-224 uses the SHA-256 compression function with its own initial value,
+ * so the ICM writes back the whole state between blocks.
+ */
+static const uint8_t icm_sha_iv[3][32] = {
+    {0x67, 0x45, 0x23, 0x01, 0xef, 0xcd, 0xab, 0x89, 0x98, 0xba, 0xdc, 0xfe, 0x10, 0x32, 0x54, 0x76,
+     0xc3, 0xd2, 0xe1, 0xf0},
+    {0xc1, 0x05, 0x9e, 0xd8, 0x36, 0x7c, 0xd5, 0x07, 0x30, 0x70, 0xdd, 0x17, 0xf7, 0x0e, 0x59, 0x39,
+     0xff, 0xc0, 0x0b, 0x31, 0x68, 0x58, 0x15, 0x11, 0x64, 0xf9, 0x8f, 0xa7, 0xbe, 0xfa, 0x4f, 0xa4},
+    {0x6a, 0x09, 0xe6, 0x67, 0xbb, 0x67, 0xae, 0x85, 0x3c, 0x6e, 0xf3, 0x72, 0xa5, 0x4f, 0xf5, 0x3a,
+     0x51, 0x0e, 0x52, 0x7f, 0x9b, 0x05, 0x68, 0x8c, 0x1f, 0x83, 0xd9, 0xab, 0x5b, 0xe0, 0xcd, 0x19}};
+
+/**
+ * \brief Digest lengths
+ */
+static const uint8_t icm_sha_digest_len[3] = {20, 28, 32};
+
+/**
+ * \brief Compression function used for streaming
+ */
+static const enum icm_algo icm_sha_algo[3] = {ICM_ALGO_SHA1, ICM_ALGO_SHA256, ICM_ALGO_SHA256};
+
+/**
+ * \brief Algorithm used for monitoring
+ */
+static const enum icm_algo icm_monitor_algo[3] = {ICM_ALGO_SHA1, ICM_ALGO_SHA224, ICM_ALGO_SHA256};
+
+static void icm_digest_mismatch(struct _icm_device *const dev, const uint8_t region);
+static void icm_bus_error(struct _icm_device *const dev, const uint8_t region);
+
+/**
+ * \brief Initialize ICM
+ */
+int32_t icm_init(struct icm_descriptor *const descr, void *const hw)
+{
+	int32_t rc;
+
+	ASSERT(descr && hw);
+
+	rc = _icm_init(&descr->dev, hw);
+	if (rc) {
+		return rc;
+	}
+	descr->dev.cb.digest_mismatch = icm_digest_mismatch;
+	descr->dev.cb.bus_error       = icm_bus_error;
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Deinitialize ICM
+ */
+int32_t icm_deinit(struct icm_descriptor *const descr)
+{
+	ASSERT(descr);
+
+	_icm_deinit(&descr->dev);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Start a SHA calculation
+ */
+int32_t icm_sha_init(struct icm_descriptor *const descr, struct icm_sha_context *const ctx,
+                     const enum icm_sha_type type)
+{
+	ASSERT(descr && ctx && (type <= ICM_SHA256));
+
+	ctx->descr  = descr;
+	ctx->type   = type;
+	ctx->length = 0;
+	memcpy(ctx->state, icm_sha_iv[type], sizeof(ctx->state));
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Add data to a SHA calculation
+ */
+int32_t icm_sha_update(struct icm_sha_context *const ctx, const void *const data, const uint32_t length)
+{
+	const uint8_t *ptr  = (const uint8_t *)data;
+	uint32_t       used = ctx->length & 0x3F;
+	uint32_t       left = length;
+	uint32_t       use_len;
+	uint32_t       blocks;
+	int32_t        rc;
+
+	ASSERT(ctx && ctx->descr && (data || !length));
+
+	ctx->length += length;
+
+	/* Complete a partial block first */
+	if (used) {
+		use_len = min(64 - used, left);
+		memcpy((uint8_t *)ctx->buffer + used, ptr, use_len);
+		ptr += use_len;
+		left -= use_len;
+		if (used + use_len < 64) {
+			return ERR_NONE;
+		}
+		rc = _icm_sha_process(&ctx->descr->dev, icm_sha_algo[ctx->type], ctx->state, ctx->buffer, 1);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	/* Let the ICM read whole blocks in place, or copy them if unaligned */
+	blocks = left >> 6;
+	if (blocks && !((uint32_t)ptr & 0x3)) {
+		rc = _icm_sha_process(&ctx->descr->dev, icm_sha_algo[ctx->type], ctx->state, ptr, blocks);
+		if (rc) {
+			return rc;
+		}
+		ptr += blocks << 6;
+		left &= 0x3F;
+	}
+	while (left >= 64) {
+		memcpy(ctx->buffer, ptr, 64);
+		rc = _icm_sha_process(&ctx->descr->dev, icm_sha_algo[ctx->type], ctx->state, ctx->buffer, 1);
+		if (rc) {
+			return rc;
+		}
+		ptr += 64;
+		left -= 64;
+	}
+
+	memcpy(ctx->buffer, ptr, left);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Finish a SHA calculation
+ */
+int32_t icm_sha_final(struct icm_sha_context *const ctx, uint8_t *const digest)
+{
+	uint8_t *buf  = (uint8_t *)ctx->buffer;
+	uint32_t used = ctx->length & 0x3F;
+	uint64_t bits = ctx->length << 3;
+	int32_t  rc   = ERR_NONE;
+	uint8_t  i;
+
+	ASSERT(ctx && ctx->descr && digest);
+
+	/* The ICM does not pad, append 0x80, zeros and the bit length */
+	buf[used++] = 0x80;
+	if (used > 56) {
+		memset(buf + used, 0, 64 - used);
+		rc   = _icm_sha_process(&ctx->descr->dev, icm_sha_algo[ctx->type], ctx->state, ctx->buffer, 1);
+		used = 0;
+	}
+	if (rc == ERR_NONE) {
+		memset(buf + used, 0, 56 - used);
+		for (i = 0; i < 8; i++) {
+			buf[63 - i] = (bits >> (i << 3)) & 0xFF;
+		}
+		rc = _icm_sha_process(&ctx->descr->dev, icm_sha_algo[ctx->type], ctx->state, ctx->buffer, 1);
+	}
+	if (rc == ERR_NONE) {
+		memcpy(digest, ctx->state, icm_sha_digest_len[ctx->type]);
+	}
+	memset(ctx, 0, sizeof(struct icm_sha_context));
+
+	return rc;
+}
+
+/**
+ * \brief Calculate the SHA digest of a buffer
+ */
+int32_t icm_sha(struct icm_descriptor *const descr, const enum icm_sha_type type, const void *const data,
+                const uint32_t length, uint8_t *const digest)
+{
+	struct icm_sha_context ctx;
+	int32_t                rc;
+
+	rc = icm_sha_init(descr, &ctx, type);
+	if (rc == ERR_NONE) {
+		rc = icm_sha_update(&ctx, data, length);
+	}
+	if (rc == ERR_NONE) {
+		return icm_sha_final(&ctx, digest);
+	}
+	memset(&ctx, 0, sizeof(ctx));
+
+	return rc;
+}
+
+/**
+ * \brief Start monitoring memory regions in the background
+ */
+int32_t icm_monitor_start(struct icm_descriptor *const descr, const enum icm_sha_type type,
+                          const struct icm_region *const regions, const uint8_t count)
+{
+	ASSERT(descr && regions && count && (count <= ICM_REGIONS) && (type <= ICM_SHA256));
+
+	return _icm_monitor_start(&descr->dev, icm_monitor_algo[type], regions, count);
+}
+
+/**
+ * \brief Stop monitoring memory regions
+ */
+int32_t icm_monitor_stop(struct icm_descriptor *const descr)
+{
+	ASSERT(descr);
+
+	_icm_monitor_stop(&descr->dev);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Register ICM callback
+ */
+int32_t icm_register_callback(struct icm_descriptor *const descr, const enum icm_callback_type type,
+                              FUNC_PTR func)
+{
+	ASSERT(descr);
+
+	switch (type) {
+	case ICM_CB_DIGEST_MISMATCH:
+		descr->cb.digest_mismatch = (icm_cb_t)func;
+		break;
+	case ICM_CB_BUS_ERROR:
+		descr->cb.bus_error = (icm_cb_t)func;
+		break;
+	default:
+		return ERR_INVALID_ARG;
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Retrieve the current driver version
+ */
+uint32_t icm_get_version(void)
+{
+	return DRIVER_VERSION;
+}
+
+/**
+ * \internal Digest mismatch handler
+ *
+ * \param[in] dev The pointer to ICM device structure
+ * \param[in] region The region that does not match
+ */
+static void icm_digest_mismatch(struct _icm_device *const dev, const uint8_t region)
+{
+	struct icm_descriptor *const descr = CONTAINER_OF(dev, struct icm_descriptor, dev);
+
+	if (descr->cb.digest_mismatch) {
+		descr->cb.digest_mismatch(descr, region);
+	}
+}
+
+/**
+ * \internal Bus error handler
+ *
+ * \param[in] dev The pointer to ICM device structure
+ * \param[in] region The region being read
+ */
+static void icm_bus_error(struct _icm_device *const dev, const uint8_t region)
+{
+	struct icm_descriptor *const descr = CONTAINER_OF(dev, struct icm_descriptor, dev);
+
+	if (descr->cb.bus_error) {
+		descr->cb.bus_error(descr, region);
+	}
+}
@@ -0,0 +1,185 @@
+/**
+ * \file
+ *
+ * \brief Quad SPI DMA related functionality implementation.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#include "hal_qspi_dma.h"
+#include <hal_atomic.h>
+#include <utils_assert.h>
+#include <utils.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Driver version
+ */
+#define QSPI_DMA_DRIVER_VERSION 0x00000001u
+
+static void qspi_dma_xfer_done(struct _dma_resource *resource);
+static void qspi_dma_error(struct _dma_resource *resource);
+
+int32_t qspi_dma_init(struct qspi_dma_descriptor *qspi, void *const hw)
+{
+	int32_t rc;
+
+	ASSERT(qspi && hw);
+
+	qspi->busy         = false;
+	qspi->cb.xfer_done = NULL;
+	qspi->cb.error     = NULL;
+
+	rc = _qspi_dma_init(&qspi->dev, hw);
+	if (rc) {
+		return rc;
+	}
+	_qspi_dma_register_callback(&qspi->dev, QSPI_DMA_CB_XFER_DONE, qspi_dma_xfer_done);
+	_qspi_dma_register_callback(&qspi->dev, QSPI_DMA_CB_ERROR, qspi_dma_error);
+
+	return ERR_NONE;
+}
+
+int32_t qspi_dma_deinit(struct qspi_dma_descriptor *qspi)
+{
+	ASSERT(qspi);
+
+	return _qspi_dma_deinit(&qspi->dev);
+}
+
+int32_t qspi_dma_enable(struct qspi_dma_descriptor *qspi)
+{
+	ASSERT(qspi);
+
+	return _qspi_dma_enable(&qspi->dev);
+}
+
+int32_t qspi_dma_disable(struct qspi_dma_descriptor *qspi)
+{
+	ASSERT(qspi);
+
+	return _qspi_dma_disable(&qspi->dev);
+}
+
+int32_t qspi_dma_register_callback(struct qspi_dma_descriptor *qspi, const enum _qspi_dma_cb_type type,
+                                   qspi_dma_cb_t cb)
+{
+	ASSERT(qspi);
+
+	switch (type) {
+	case QSPI_DMA_CB_XFER_DONE:
+		qspi->cb.xfer_done = cb;
+		break;
+	case QSPI_DMA_CB_ERROR:
+		qspi->cb.error = cb;
+		break;
+	default:
+		return ERR_INVALID_ARG;
+	}
+
+	return ERR_NONE;
+}
+
+int32_t qspi_dma_serial_run_command(struct qspi_dma_descriptor *qspi, const struct _qspi_command *cmd)
+{
+	bool busy;
+
+	ASSERT(qspi && cmd);
+
+	/* The completion interrupt clears busy */
+	CRITICAL_SECTION_ENTER()
+	busy       = qspi->busy;
+	qspi->busy = true;
+	CRITICAL_SECTION_LEAVE()
+	if (busy) {
+		return ERR_BUSY;
+	}
+
+	return _qspi_dma_serial_run_command(&qspi->dev, cmd);
+}
+
+int32_t qspi_dma_enable_scrambling(struct qspi_dma_descriptor *qspi, const uint32_t key, const bool device_unique)
+{
+	ASSERT(qspi);
+
+	return _qspi_dma_set_scrambling(&qspi->dev, true, device_unique, key);
+}
+
+int32_t qspi_dma_disable_scrambling(struct qspi_dma_descriptor *qspi)
+{
+	ASSERT(qspi);
+
+	return _qspi_dma_set_scrambling(&qspi->dev, false, false, 0);
+}
+
+bool qspi_dma_is_busy(const struct qspi_dma_descriptor *qspi)
+{
+	ASSERT(qspi);
+
+	return qspi->busy;
+}
+
+uint32_t qspi_dma_get_version(void)
+{
+	return QSPI_DMA_DRIVER_VERSION;
+}
+
+/**
+ * \internal Command completed
+ */
+static void qspi_dma_xfer_done(struct _dma_resource *resource)
+{
+	struct _qspi_dma_dev *      dev  = (struct _qspi_dma_dev *)resource->back;
+	struct qspi_dma_descriptor *qspi = CONTAINER_OF(dev, struct qspi_dma_descriptor, dev);
+
+	qspi->busy = false;
+	if (qspi->cb.xfer_done) {
+		qspi->cb.xfer_done(qspi);
+	}
+}
+
+/**
+ * \internal DMA error during the data phase
+ */
+static void qspi_dma_error(struct _dma_resource *resource)
+{
+	struct _qspi_dma_dev *      dev  = (struct _qspi_dma_dev *)resource->back;
+	struct qspi_dma_descriptor *qspi = CONTAINER_OF(dev, struct qspi_dma_descriptor, dev);
+
+	qspi->busy = false;
+	if (qspi->cb.error) {
+		qspi->cb.error(qspi);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
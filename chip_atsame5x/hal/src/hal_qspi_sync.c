@@ -79,6 +79,34 @@ int32_t qspi_sync_serial_run_command(struct qspi_sync_descriptor *qspi, const st
 	return _qspi_sync_serial_run_command(&qspi->dev, cmd);
 }
 
+int32_t qspi_sync_enable_scrambling(struct qspi_sync_descriptor *qspi, const uint32_t key, const bool device_unique)
+{
+	ASSERT(qspi);
+
+	return _qspi_sync_set_scrambling(&qspi->dev, true, device_unique, key);
+}
+
+int32_t qspi_sync_disable_scrambling(struct qspi_sync_descriptor *qspi)
+{
+	ASSERT(qspi);
+
+	return _qspi_sync_set_scrambling(&qspi->dev, false, false, 0);
+}
+
+int32_t qspi_sync_enable_xip(struct qspi_sync_descriptor *qspi, const struct _qspi_command *cmd)
+{
+	ASSERT(qspi && cmd);
+
+	return _qspi_sync_enable_xip(&qspi->dev, cmd);
+}
+
+int32_t qspi_sync_disable_xip(struct qspi_sync_descriptor *qspi)
+{
+	ASSERT(qspi);
+
+	return _qspi_sync_disable_xip(&qspi->dev);
+}
+
 uint32_t qspi_sync_get_version(void)
 {
 	return QSPI_SYNC_DRIVER_VERSION;
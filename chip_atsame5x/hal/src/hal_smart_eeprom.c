@@ -0,0 +1,210 @@
+/**
+ * \file
+ *
+ * \brief SmartEEPROM functionality implementation.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+
+#include <hal_smart_eeprom.h>
+
+#define DRIVER_VERSION 0x00000001u
+
+/**
+ * \brief Initialize SmartEEPROM.
+ */
+int32_t smart_eeprom_init(struct smart_eeprom_descriptor *const descr, void *const hw)
+{
+	ASSERT(descr && hw);
+
+	return _smart_eeprom_init(&descr->dev, hw);
+}
+
+/**
+ * \brief Deinitialize SmartEEPROM.
+ */
+int32_t smart_eeprom_deinit(struct smart_eeprom_descriptor *const descr)
+{
+	ASSERT(descr);
+
+	_smart_eeprom_deinit(&descr->dev);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Get the SmartEEPROM size.
+ */
+uint32_t smart_eeprom_get_size(struct smart_eeprom_descriptor *const descr)
+{
+	ASSERT(descr);
+
+	return _smart_eeprom_get_size(&descr->dev);
+}
+
+/**
+ * \brief Read bytes from the SmartEEPROM.
+ */
+int32_t smart_eeprom_read(struct smart_eeprom_descriptor *const descr, const uint32_t offset, uint8_t *const buffer,
+                          const uint32_t length)
+{
+	ASSERT(descr && buffer);
+
+	if ((offset > _smart_eeprom_get_size(&descr->dev)) || (length > _smart_eeprom_get_size(&descr->dev) - offset)) {
+		return ERR_BAD_ADDRESS;
+	}
+
+	_smart_eeprom_read(&descr->dev, offset, buffer, length);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Write bytes to the SmartEEPROM.
+ */
+int32_t smart_eeprom_write(struct smart_eeprom_descriptor *const descr, const uint32_t offset,
+                           const uint8_t *const buffer, const uint32_t length)
+{
+	ASSERT(descr && buffer);
+
+	if ((offset > _smart_eeprom_get_size(&descr->dev)) || (length > _smart_eeprom_get_size(&descr->dev) - offset)) {
+		return ERR_BAD_ADDRESS;
+	}
+
+	return _smart_eeprom_write(&descr->dev, offset, buffer, length);
+}
+
+/**
+ * \brief Read a byte from the SmartEEPROM.
+ */
+int32_t smart_eeprom_read_byte(struct smart_eeprom_descriptor *const descr, const uint32_t offset,
+                               uint8_t *const value)
+{
+	return smart_eeprom_read(descr, offset, value, 1);
+}
+
+/**
+ * \brief Write a byte to the SmartEEPROM.
+ */
+int32_t smart_eeprom_write_byte(struct smart_eeprom_descriptor *const descr, const uint32_t offset,
+                                const uint8_t value)
+{
+	return smart_eeprom_write(descr, offset, &value, 1);
+}
+
+/**
+ * \brief Read a word from the SmartEEPROM.
+ */
+int32_t smart_eeprom_read_word(struct smart_eeprom_descriptor *const descr, const uint32_t offset,
+                               uint32_t *const value)
+{
+	ASSERT(!(offset & 3));
+
+	return smart_eeprom_read(descr, offset, (uint8_t *)value, sizeof(*value));
+}
+
+/**
+ * \brief Write a word to the SmartEEPROM.
+ */
+int32_t smart_eeprom_write_word(struct smart_eeprom_descriptor *const descr, const uint32_t offset,
+                                const uint32_t value)
+{
+	ASSERT(!(offset & 3));
+
+	return smart_eeprom_write(descr, offset, (const uint8_t *)&value, sizeof(value));
+}
+
+/**
+ * \brief Select buffered or unbuffered write mode.
+ */
+int32_t smart_eeprom_set_buffered(struct smart_eeprom_descriptor *const descr, const bool buffered)
+{
+	ASSERT(descr);
+
+	_smart_eeprom_set_buffered(&descr->dev, buffered);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Write the page buffer to flash in buffered mode.
+ */
+int32_t smart_eeprom_flush(struct smart_eeprom_descriptor *const descr)
+{
+	ASSERT(descr);
+
+	_smart_eeprom_flush(&descr->dev);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Check whether the SmartEEPROM is busy.
+ */
+bool smart_eeprom_is_busy(struct smart_eeprom_descriptor *const descr)
+{
+	ASSERT(descr);
+
+	return _smart_eeprom_is_busy(&descr->dev);
+}
+
+/**
+ * \brief Get the SmartEEPROM wear statistics.
+ */
+int32_t smart_eeprom_get_wear(struct smart_eeprom_descriptor *const descr, struct smart_eeprom_wear *const wear)
+{
+	ASSERT(descr && wear);
+
+	wear->writes        = descr->dev.writes;
+	wear->reallocations = descr->dev.reallocations;
+	wear->overflows     = descr->dev.overflows;
+	wear->active_sector = _smart_eeprom_get_active_sector(&descr->dev);
+	wear->sector_blocks = _smart_eeprom_get_sector_blocks(&descr->dev);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Store the SmartEEPROM allocation in the user row.
+ */
+int32_t smart_eeprom_configure(struct smart_eeprom_descriptor *const descr, const uint8_t sector_blocks,
+                               const uint8_t page_size_sel)
+{
+	ASSERT(descr);
+
+	return _smart_eeprom_configure(&descr->dev, sector_blocks, page_size_sel);
+}
+
+/**
+ * \brief Retrieve the current driver version
+ */
+uint32_t smart_eeprom_get_version(void)
+{
+	return DRIVER_VERSION;
+}
@@ -0,0 +1,291 @@
+/**
+ * \file
+ *
+ * \brief SPI master transaction queue functionality implementation.
+ *
+ * Copyright (c) 2014-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#include <hal_atomic.h>
+#include <hal_gpio.h>
+#include <hal_spi_m_queue.h>
+#include <utils_assert.h>
+#include <utils.h>
+
+/**
+ * \brief Driver version
+ */
+#define SPI_M_QUEUE_DRIVER_VERSION 0x00000001u
+
+static void spi_m_queue_rx(struct _spi_m_async_dev *dev);
+static void spi_m_queue_error(struct _spi_m_async_dev *dev, int32_t status);
+
+/** \internal Write the next character of the segment in progress
+ *
+ *  \param[in] spi Pointer to the SPI queue instance.
+ *  \param[in] seg Pointer to the segment in progress.
+ */
+static void spi_m_queue_write_next(struct spi_m_queue_descriptor *spi, const struct spi_xfer *seg)
+{
+	uint16_t data = spi->dev.dummy_byte;
+
+	if (seg->txbuf) {
+		if (spi->dev.char_size > 1) {
+			data = seg->txbuf[spi->txcnt * 2] | (seg->txbuf[spi->txcnt * 2 + 1] << 8);
+		} else {
+			data = seg->txbuf[spi->txcnt];
+		}
+	}
+	spi->txcnt++;
+	_spi_m_async_write_one(&spi->dev, data);
+}
+
+/** \internal Start the first non-empty segment from the current one on
+ *
+ *  \param[in] spi Pointer to the SPI queue instance.
+ *  \param[in] trans Pointer to the transaction in progress.
+ *
+ *  \return false if the transaction has no characters left.
+ */
+static bool spi_m_queue_start_segment(struct spi_m_queue_descriptor *spi, struct spi_m_queue_transaction *trans)
+{
+	for (; spi->segment < trans->segment_count; spi->segment++) {
+		if (trans->segments[spi->segment].size) {
+			spi->txcnt = 0;
+			spi->rxcnt = 0;
+			spi_m_queue_write_next(spi, &trans->segments[spi->segment]);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** \internal Complete the transaction at the head of the queue
+ *
+ *  \param[in] spi Pointer to the SPI queue instance.
+ *  \param[in] status The transaction status.
+ */
+static void spi_m_queue_finish(struct spi_m_queue_descriptor *spi, const int32_t status)
+{
+	struct spi_m_queue_transaction *trans = list_remove_head(&spi->queue);
+
+	if (trans->cs_pin != SPI_M_QUEUE_NO_CS) {
+		gpio_set_pin_level(trans->cs_pin, true);
+	}
+	trans->status = status;
+	if (trans->cb) {
+		trans->cb(spi, trans);
+	}
+}
+
+/** \internal Start the transaction at the head of the queue
+ *
+ *  Transactions without any characters are completed right away. The busy flag
+ *  is cleared once the queue runs empty.
+ *
+ *  \param[in] spi Pointer to the SPI queue instance.
+ */
+static void spi_m_queue_start(struct spi_m_queue_descriptor *spi)
+{
+	struct spi_m_queue_transaction *trans;
+
+	spi->busy = true;
+	while ((trans = (struct spi_m_queue_transaction *)list_get_head(&spi->queue)) != NULL) {
+		if (!spi->configured || spi->mode != trans->mode || spi->baud_val != trans->baud_val) {
+			/* CPOL and CPHA are enable-protected */
+			_spi_m_async_disable(&spi->dev);
+			_spi_m_async_set_mode(&spi->dev, trans->mode);
+			_spi_m_async_set_baudrate(&spi->dev, trans->baud_val);
+			_spi_m_async_enable(&spi->dev);
+			spi->mode       = trans->mode;
+			spi->baud_val   = trans->baud_val;
+			spi->configured = true;
+		}
+
+		if (trans->cs_pin != SPI_M_QUEUE_NO_CS) {
+			gpio_set_pin_level(trans->cs_pin, false);
+		}
+		spi->segment = 0;
+		if (spi_m_queue_start_segment(spi, trans)) {
+			_spi_m_async_set_irq_state(&spi->dev, SPI_DEV_CB_ERROR, true);
+			_spi_m_async_enable_rx(&spi->dev, true);
+			return;
+		}
+		spi_m_queue_finish(spi, ERR_NONE);
+	}
+	spi->busy = false;
+}
+
+/** \internal Stop the interrupts, complete the transaction and start the next
+ *
+ *  \param[in] spi Pointer to the SPI queue instance.
+ *  \param[in] status The transaction status.
+ */
+static void spi_m_queue_next(struct spi_m_queue_descriptor *spi, const int32_t status)
+{
+	_spi_m_async_enable_rx(&spi->dev, false);
+	_spi_m_async_set_irq_state(&spi->dev, SPI_DEV_CB_ERROR, false);
+	spi_m_queue_finish(spi, status);
+	spi_m_queue_start(spi);
+}
+
+/** \internal Character received, store it and clock out the next one
+ *
+ *  \param[in] dev Pointer to the SPI device instance.
+ */
+static void spi_m_queue_rx(struct _spi_m_async_dev *dev)
+{
+	struct spi_m_queue_descriptor * spi   = CONTAINER_OF(dev, struct spi_m_queue_descriptor, dev);
+	struct spi_m_queue_transaction *trans = (struct spi_m_queue_transaction *)list_get_head(&spi->queue);
+	const struct spi_xfer *         seg   = &trans->segments[spi->segment];
+	uint16_t                        data  = _spi_m_async_read_one(dev);
+
+	if (seg->rxbuf) {
+		if (dev->char_size > 1) {
+			seg->rxbuf[spi->rxcnt * 2]     = (uint8_t)data;
+			seg->rxbuf[spi->rxcnt * 2 + 1] = (uint8_t)(data >> 8);
+		} else {
+			seg->rxbuf[spi->rxcnt] = (uint8_t)data;
+		}
+	}
+	spi->rxcnt++;
+
+	if (spi->txcnt < seg->size) {
+		spi_m_queue_write_next(spi, seg);
+		return;
+	}
+
+	spi->segment++;
+	if (spi_m_queue_start_segment(spi, trans)) {
+		return;
+	}
+	spi_m_queue_next(spi, ERR_NONE);
+}
+
+/** \internal Transfer error, abort the transaction in progress
+ *
+ *  \param[in] dev Pointer to the SPI device instance.
+ *  \param[in] status The error status.
+ */
+static void spi_m_queue_error(struct _spi_m_async_dev *dev, int32_t status)
+{
+	struct spi_m_queue_descriptor *spi = CONTAINER_OF(dev, struct spi_m_queue_descriptor, dev);
+
+	spi_m_queue_next(spi, status);
+}
+
+int32_t spi_m_queue_init(struct spi_m_queue_descriptor *spi, void *const hw)
+{
+	int32_t rc;
+
+	ASSERT(spi && hw);
+	spi->dev.prvt = (void *)hw;
+	rc            = _spi_m_async_init(&spi->dev, hw);
+	if (rc < 0) {
+		return rc;
+	}
+
+	list_reset(&spi->queue);
+	spi->busy       = false;
+	spi->enabled    = false;
+	spi->configured = false;
+	_spi_m_async_register_callback(&spi->dev, SPI_DEV_CB_RX, (FUNC_PTR)spi_m_queue_rx);
+	_spi_m_async_register_callback(&spi->dev, SPI_DEV_CB_ERROR, (FUNC_PTR)spi_m_queue_error);
+
+	return ERR_NONE;
+}
+
+void spi_m_queue_deinit(struct spi_m_queue_descriptor *spi)
+{
+	ASSERT(spi);
+	_spi_m_async_deinit(&spi->dev);
+	list_reset(&spi->queue);
+	spi->busy    = false;
+	spi->enabled = false;
+}
+
+void spi_m_queue_enable(struct spi_m_queue_descriptor *spi)
+{
+	ASSERT(spi);
+
+	CRITICAL_SECTION_ENTER()
+	_spi_m_async_enable(&spi->dev);
+	spi->enabled = true;
+	if (!spi->busy) {
+		spi_m_queue_start(spi);
+	}
+	CRITICAL_SECTION_LEAVE()
+}
+
+void spi_m_queue_disable(struct spi_m_queue_descriptor *spi)
+{
+	ASSERT(spi);
+
+	CRITICAL_SECTION_ENTER()
+	spi->enabled = false;
+	_spi_m_async_disable(&spi->dev);
+	CRITICAL_SECTION_LEAVE()
+}
+
+int32_t spi_m_queue_submit(struct spi_m_queue_descriptor *spi, struct spi_m_queue_transaction *trans)
+{
+	int32_t rc = ERR_NONE;
+
+	ASSERT(spi && trans);
+
+	if (!trans->segment_count) {
+		return ERR_INVALID_ARG;
+	}
+
+	CRITICAL_SECTION_ENTER()
+	if (is_list_element(&spi->queue, trans)) {
+		rc = ERR_BUSY;
+	} else {
+		trans->status = ERR_BUSY;
+		list_insert_at_end(&spi->queue, trans);
+		if (spi->enabled && !spi->busy) {
+			spi_m_queue_start(spi);
+		}
+	}
+	CRITICAL_SECTION_LEAVE()
+
+	return rc;
+}
+
+bool spi_m_queue_is_busy(struct spi_m_queue_descriptor *spi)
+{
+	ASSERT(spi);
+
+	return list_get_head(&spi->queue) != NULL;
+}
+
+uint32_t spi_m_queue_get_version(void)
+{
+	return SPI_M_QUEUE_DRIVER_VERSION;
+}
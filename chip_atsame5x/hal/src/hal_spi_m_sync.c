@@ -69,6 +69,8 @@ int32_t spi_m_sync_init(struct spi_m_sync_descriptor *spi, void *const hw)
 		return rc;
 	}
 
+	spi->dev.pipelined = false;
+
 	spi->flags    = SPI_DEACTIVATE_NEXT;
 	spi->io.read  = _spi_m_sync_io_read;
 	spi->io.write = _spi_m_sync_io_write;
@@ -118,6 +120,18 @@ int32_t spi_m_sync_set_data_order(struct spi_m_sync_descriptor *spi, const enum
 	return _spi_m_sync_set_data_order(&spi->dev, dord);
 }
 
+int32_t spi_m_sync_set_pipelined(struct spi_m_sync_descriptor *spi, const bool enable)
+{
+	ASSERT(spi);
+	return _spi_m_sync_set_pipelined(&spi->dev, enable);
+}
+
+int32_t spi_m_sync_set_data32(struct spi_m_sync_descriptor *spi, const bool enable)
+{
+	ASSERT(spi);
+	return _spi_m_sync_set_data32(&spi->dev, enable);
+}
+
 /** \brief Do SPI read in polling way
  *  For SPI master, activate CS, do send 0xFFs and read data, deactivate CS.
  *
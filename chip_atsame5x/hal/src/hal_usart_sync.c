@@ -42,6 +42,10 @@
 
 static int32_t usart_sync_write(struct io_descriptor *const io_descr, const uint8_t *const buf, const uint16_t length);
 static int32_t usart_sync_read(struct io_descriptor *const io_descr, uint8_t *const buf, const uint16_t length);
+static int32_t usart_sync_write_data32(struct usart_sync_descriptor *const descr, const uint8_t *const buf,
+                                       const uint16_t length);
+static int32_t usart_sync_read_data32(struct usart_sync_descriptor *const descr, uint8_t *const buf,
+                                      const uint16_t length);
 
 /**
  * \brief Initialize usart interface
@@ -186,6 +190,17 @@ int32_t usart_sync_set_character_size(struct usart_sync_descriptor *const descr,
 	return ERR_NONE;
 }
 
+/**
+ * \brief Set usart 32-bit data extension mode
+ */
+int32_t usart_sync_set_data32_mode(struct usart_sync_descriptor *const descr, const enum usart_data32_mode mode)
+{
+	ASSERT(descr);
+	_usart_sync_set_data32_mode(&descr->device, mode);
+
+	return ERR_NONE;
+}
+
 /**
  * \brief Retrieve the state of flow control pins
  */
@@ -239,6 +254,9 @@ static int32_t usart_sync_write(struct io_descriptor *const io_descr, const uint
 	struct usart_sync_descriptor *descr  = CONTAINER_OF(io_descr, struct usart_sync_descriptor, io);
 
 	ASSERT(io_descr && buf && length);
+	if (_usart_sync_get_data32_mode(&descr->device) & USART_DATA32_WRITE) {
+		return usart_sync_write_data32(descr, buf, length);
+	}
 	while (!_usart_sync_is_ready_to_send(&descr->device))
 		;
 	do {
@@ -266,6 +284,9 @@ static int32_t usart_sync_read(struct io_descriptor *const io_descr, uint8_t *co
 	struct usart_sync_descriptor *descr  = CONTAINER_OF(io_descr, struct usart_sync_descriptor, io);
 
 	ASSERT(io_descr && buf && length);
+	if (_usart_sync_get_data32_mode(&descr->device) & USART_DATA32_READ) {
+		return usart_sync_read_data32(descr, buf, length);
+	}
 	do {
 		while (!_usart_sync_is_byte_received(&descr->device))
 			;
@@ -274,3 +295,89 @@ static int32_t usart_sync_read(struct io_descriptor *const io_descr, uint8_t *co
 
 	return (int32_t)offset;
 }
+
+/*
+ * \internal Write the given data to usart interface, four characters per access
+ *
+ * Whole words are sent with the length counter disabled. The remaining one to
+ * three characters are sent as a single word once the transmitter is idle,
+ * with the length counter limiting the frame to the remaining characters.
+ *
+ * \param[in] descr The pointer to an usart descriptor
+ * \param[in] buf Data to write to usart
+ * \param[in] length The number of bytes to write
+ *
+ * \return The number of bytes written.
+ */
+static int32_t usart_sync_write_data32(struct usart_sync_descriptor *const descr, const uint8_t *const buf,
+                                       const uint16_t length)
+{
+	uint32_t offset = 0;
+	uint32_t data;
+	uint8_t  i;
+
+	while (!_usart_sync_is_ready_to_send(&descr->device))
+		;
+	for (; length - offset >= 4; offset += 4) {
+		data = buf[offset] | (buf[offset + 1] << 8) | (buf[offset + 2] << 16) | ((uint32_t)buf[offset + 3] << 24);
+		_usart_sync_write_word(&descr->device, data);
+		while (!_usart_sync_is_ready_to_send(&descr->device))
+			;
+	}
+	if (offset < length) {
+		if (offset) {
+			while (!_usart_sync_is_transmit_done(&descr->device))
+				;
+		}
+		_usart_sync_set_data_length(&descr->device, USART_DATA_LENGTH_TX, length - offset);
+		for (data = 0, i = 0; offset < length; offset++, i += 8) {
+			data |= (uint32_t)buf[offset] << i;
+		}
+		_usart_sync_write_word(&descr->device, data);
+	}
+	while (!_usart_sync_is_transmit_done(&descr->device))
+		;
+	_usart_sync_set_data_length(&descr->device, USART_DATA_LENGTH_DISABLED, 0);
+
+	return (int32_t)offset;
+}
+
+/*
+ * \internal Read data from usart interface, four characters per access
+ *
+ * Reads of up to 255 characters program the length counter once so the
+ * hardware completes the last partial word. For longer reads the counter is
+ * enabled for the remaining characters after the last whole word is read, so
+ * the sender must leave at least one character time before the tail.
+ *
+ * \param[in] descr The pointer to an usart descriptor
+ * \param[in] buf A buffer to read data to
+ * \param[in] length The size of a buffer
+ *
+ * \return The number of bytes read.
+ */
+static int32_t usart_sync_read_data32(struct usart_sync_descriptor *const descr, uint8_t *const buf,
+                                      const uint16_t length)
+{
+	uint32_t offset = 0;
+	uint32_t data;
+	uint8_t  i;
+
+	if (length <= 0xFF) {
+		_usart_sync_set_data_length(&descr->device, USART_DATA_LENGTH_RX, length);
+	}
+	while (offset < length) {
+		if (length > 0xFF && length - offset < 4) {
+			_usart_sync_set_data_length(&descr->device, USART_DATA_LENGTH_RX, length - offset);
+		}
+		while (!_usart_sync_is_byte_received(&descr->device))
+			;
+		data = _usart_sync_read_word(&descr->device);
+		for (i = 0; i < 4 && offset < length; i++, offset++) {
+			buf[offset] = (uint8_t)(data >> (i * 8));
+		}
+	}
+	_usart_sync_set_data_length(&descr->device, USART_DATA_LENGTH_DISABLED, 0);
+
+	return (int32_t)offset;
+}
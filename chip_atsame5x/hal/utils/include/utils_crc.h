@@ -0,0 +1,102 @@
+/**
+ * \file
+ *
+ * \brief Software CRC declaration.
+ *
+ * Copyright (c) 2014-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#ifndef _UTILS_CRC_H_INCLUDED
+#define _UTILS_CRC_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup doc_driver_hal_utils_crc
+ *
+ * The CRCs are computed 8 bytes per step with slice-by-8 tables, held in
+ * flash. Each table set takes 8 kB for a 32 bit CRC and 4 kB for a 16 bit
+ * CRC, unused tables are removed by the linker.
+ *
+ * The CRC value passed and returned is the running register: start with the
+ * initial value, pass the result to the next call to continue over separate
+ * memory blocks, and apply the final XOR at the end.
+ *
+ * @{
+ */
+
+#include <compiler.h>
+
+/**
+ * \brief Update a CRC-32 (IEEE 802.3)
+ *
+ * Start with 0xFFFFFFFF and complement the result, as for the DSU.
+ *
+ * \param[in] crc The running CRC
+ * \param[in] data The data, any alignment
+ * \param[in] length Length of the data in bytes
+ *
+ * \return The updated running CRC
+ */
+uint32_t utils_crc32(uint32_t crc, const void *const data, uint32_t length);
+
+/**
+ * \brief Update a CRC-32C (Castagnoli)
+ *
+ * Start with 0xFFFFFFFF and complement the result.
+ *
+ * \param[in] crc The running CRC
+ * \param[in] data The data, any alignment
+ * \param[in] length Length of the data in bytes
+ *
+ * \return The updated running CRC
+ */
+uint32_t utils_crc32c(uint32_t crc, const void *const data, uint32_t length);
+
+/**
+ * \brief Update a CRC-16 (CCITT)
+ *
+ * The polynomial 0x1021 without reflection, usually started with 0xFFFF.
+ *
+ * \param[in] crc The running CRC
+ * \param[in] data The data, any alignment
+ * \param[in] length Length of the data in bytes
+ *
+ * \return The updated running CRC
+ */
+uint16_t utils_crc16_ccitt(uint16_t crc, const void *const data, uint32_t length);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _UTILS_CRC_H_INCLUDED */
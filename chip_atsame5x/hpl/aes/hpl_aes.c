@@ -31,10 +31,16 @@
  *
  */
 #include <string.h>
+#include <utils.h>
 #include <utils_assert.h>
 #include <hpl_aes_sync.h>
+#include <hpl_aes_dma.h>
 #include <hpl_aes_config.h>
 
+#ifndef CONF_AES_KEY_SLOTS
+#define CONF_AES_KEY_SLOTS 4
+#endif
+
 /**
  * \brief Update the AES KEY Register
  */
@@ -69,6 +75,16 @@ static void __aes_sync_gcm_start(struct _aes_sync_device *const dev, const enum
 static void __aes_sync_gcm_update(struct _aes_sync_device *const dev, const uint8_t *input, uint8_t *output,
                                   uint32_t length);
 static void __aes_sync_gcm_generate_tag(struct _aes_sync_device *const dev, uint8_t *tag, uint32_t tag_len);
+static void __aes_sync_gcm_set_hashkey(struct _aes_sync_device *const dev, const enum aes_action enc);
+/**
+ * GCM helpers for the batch API, they expect the module to be enabled in
+ * GCM mode with the key and hash subkey already loaded.
+ */
+static void __aes_sync_gcm_load_block(uint32_t *block, const uint8_t *data, uint32_t length);
+static void __aes_sync_gcm_ghash(struct _aes_sync_device *const dev, const uint8_t *data, uint32_t length);
+static void __aes_sync_gcm_ghash_lengths(struct _aes_sync_device *const dev, uint32_t aad_len, uint32_t length);
+static void __aes_sync_gcm_crypt_blocks(struct _aes_sync_device *const dev, uint8_t *counter, const uint8_t *input,
+                                        uint8_t *output, uint32_t length);
 /**
  * CCM encrypt decrypt function
  */
@@ -90,13 +106,58 @@ struct aes_configuration {
  */
 static struct aes_configuration _aes = {(CONF_AES_DBGCTRL << AES_DBGCTRL_DBGRUN_Pos)};
 
+/**
+ * \brief AES key slot, a key and the material derived from it
+ */
+struct aes_key_slot {
+	uint32_t         key[8];
+	uint32_t         hashkey[4]; /*!< GCM hash subkey H = E(K, 0) */
+	enum aes_keysize keysize;
+	bool             used;
+	bool             has_hashkey;
+};
+
+static struct aes_key_slot _aes_key_slots[CONF_AES_KEY_SLOTS];
+
+/**
+ * \brief Slot of the key in the KEYWORD registers
+ *
+ * The KEYWORD registers keep their value while the module is disabled and
+ * reconfigured, only a software reset clears them. So a key from a slot is
+ * written once and then reused until another key is written.
+ */
+static uint8_t _aes_loaded_slot = AES_KEY_SLOT_NONE;
+
+/**
+ * \brief Size of the key in use, the key slot holds it when one is selected
+ */
+static inline enum aes_keysize __aes_sync_keysize(const struct _aes_sync_device *const dev)
+{
+	return (dev->slot != AES_KEY_SLOT_NONE) ? _aes_key_slots[dev->slot].keysize : dev->keysize;
+}
+
+/**
+ * \brief Load the key in use, from the key slot when one is selected
+ *
+ * Devices sharing a slot always load the current slot content, so a slot
+ * rewritten through one device is picked up by the others.
+ */
 static inline void __aes_sync_set_key(struct _aes_sync_device *const dev)
 {
-	int i;
+	const uint32_t *key;
+	int             i;
 
-	for (i = 0; i < ((dev->keysize + 2) << 1); i++) {
-		hri_aes_write_KEYWORD_reg(dev->hw, i, (((uint32_t *)(dev->key))[i]));
+	if (dev->slot == AES_KEY_SLOT_NONE) {
+		key = (const uint32_t *)dev->key;
+	} else if (dev->slot == _aes_loaded_slot) {
+		return;
+	} else {
+		key = _aes_key_slots[dev->slot].key;
 	}
+	for (i = 0; i < ((__aes_sync_keysize(dev) + 2) << 1); i++) {
+		hri_aes_write_KEYWORD_reg(dev->hw, i, key[i]);
+	}
+	_aes_loaded_slot = dev->slot;
 }
 
 static inline void __aes_sync_set_iv(struct _aes_sync_device *const dev, uint8_t *iv)
@@ -169,7 +230,9 @@ int32_t _aes_sync_init(struct _aes_sync_device *const dev, void *const hw)
 	hri_aes_write_CTRLA_reg(hw, 0);
 	hri_aes_write_CTRLA_reg(hw, AES_CTRLA_SWRST);
 
-	dev->hw = hw;
+	dev->hw          = hw;
+	dev->slot        = AES_KEY_SLOT_NONE;
+	_aes_loaded_slot = AES_KEY_SLOT_NONE;
 
 	hri_aes_write_DBGCTRL_reg(dev->hw, _aes.dbgctrl);
 
@@ -183,7 +246,8 @@ int32_t _aes_sync_deinit(struct _aes_sync_device *dev)
 {
 	hri_aes_clear_CTRLA_ENABLE_bit(dev->hw);
 	hri_aes_set_CTRLA_SWRST_bit(dev->hw);
-	dev->hw = NULL;
+	dev->hw          = NULL;
+	_aes_loaded_slot = AES_KEY_SLOT_NONE;
 
 	return ERR_NONE;
 }
@@ -213,10 +277,68 @@ int32_t _aes_sync_set_key(struct _aes_sync_device *const dev, const uint8_t *key
 {
 
 	dev->keysize = size;
+	dev->slot    = AES_KEY_SLOT_NONE;
 	memcpy(dev->key, key, (size + 2) << 3);
 	return ERR_NONE;
 }
 
+/**
+ * \brief              Store a key in a key slot and select it
+ */
+int32_t _aes_sync_set_slot_key(struct _aes_sync_device *const dev, const uint8_t slot, const uint8_t *key,
+                               const enum aes_keysize size)
+{
+	if (slot >= CONF_AES_KEY_SLOTS) {
+		return ERR_INVALID_ARG;
+	}
+	if (_aes_loaded_slot == slot) {
+		_aes_loaded_slot = AES_KEY_SLOT_NONE;
+	}
+	memcpy(_aes_key_slots[slot].key, key, (size + 2) << 3);
+	_aes_key_slots[slot].keysize     = size;
+	_aes_key_slots[slot].used        = true;
+	_aes_key_slots[slot].has_hashkey = false;
+
+	return _aes_sync_select_key_slot(dev, slot);
+}
+
+/**
+ * \brief              Use the key stored in a key slot
+ */
+int32_t _aes_sync_select_key_slot(struct _aes_sync_device *const dev, const uint8_t slot)
+{
+	if (slot >= CONF_AES_KEY_SLOTS) {
+		return ERR_INVALID_ARG;
+	}
+	if (!_aes_key_slots[slot].used) {
+		return ERR_NOT_FOUND;
+	}
+	/* The key is loaded from the slot, drop the key set before */
+	dev->keysize = _aes_key_slots[slot].keysize;
+	dev->slot    = slot;
+	memset(dev->key, 0, sizeof(dev->key));
+	return ERR_NONE;
+}
+
+/**
+ * \brief              Erase a key slot and the material derived from it
+ */
+int32_t _aes_sync_clear_key_slot(struct _aes_sync_device *const dev, const uint8_t slot)
+{
+	if (slot >= CONF_AES_KEY_SLOTS) {
+		return ERR_INVALID_ARG;
+	}
+	if (_aes_loaded_slot == slot) {
+		_aes_loaded_slot = AES_KEY_SLOT_NONE;
+	}
+	if (dev->slot == slot) {
+		dev->slot = AES_KEY_SLOT_NONE;
+	}
+	memset(&_aes_key_slots[slot], 0, sizeof(struct aes_key_slot));
+
+	return ERR_NONE;
+}
+
 /**
  * \brief              AES-ECB block encryption/decryption
  */
@@ -227,7 +349,7 @@ int32_t _aes_sync_ecb_crypt(struct _aes_sync_device *const dev, const enum aes_a
 	hri_aes_clear_CTRLA_ENABLE_bit(dev->hw);
 	hri_aes_write_CTRLA_reg(dev->hw, 0);
 	hri_aes_write_CTRLB_reg(dev->hw, 0);
-	hri_aes_write_CTRLA_reg(dev->hw, AES_CTRLA_KEYSIZE(dev->keysize) | (enc << AES_CTRLA_CIPHER_Pos));
+	hri_aes_write_CTRLA_reg(dev->hw, AES_CTRLA_KEYSIZE(__aes_sync_keysize(dev)) | (enc << AES_CTRLA_CIPHER_Pos));
 	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
 
 	/* Key must be set for each ECB encrypt */
@@ -257,7 +379,7 @@ int32_t _aes_sync_cbc_crypt(struct _aes_sync_device *const dev, const enum aes_a
 	hri_aes_clear_CTRLA_ENABLE_bit(dev->hw);
 	hri_aes_write_CTRLA_reg(dev->hw, 0);
 	hri_aes_write_CTRLA_reg(dev->hw,
-	                        AES_CTRLA_AESMODE(1) | AES_CTRLA_KEYSIZE(dev->keysize) | (enc << AES_CTRLA_CIPHER_Pos));
+	                        AES_CTRLA_AESMODE(1) | AES_CTRLA_KEYSIZE(__aes_sync_keysize(dev)) | (enc << AES_CTRLA_CIPHER_Pos));
 	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
 	hri_aes_write_CTRLB_reg(dev->hw, 0);
 
@@ -345,7 +467,7 @@ int32_t _aes_sync_cfb64_crypt(struct _aes_sync_device *const dev, const enum aes
 	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, enc);
 	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 3);
 	hri_aes_write_CTRLA_CFBS_bf(dev->hw, 1);
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
 	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
 
 	__aes_sync_set_key(dev);
@@ -389,7 +511,7 @@ int32_t _aes_sync_cfb32_crypt(struct _aes_sync_device *const dev, const enum aes
 	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, enc);
 	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 3);
 	hri_aes_write_CTRLA_CFBS_bf(dev->hw, 2);
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
 	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
 
 	__aes_sync_set_key(dev);
@@ -430,7 +552,7 @@ int32_t _aes_sync_cfb16_crypt(struct _aes_sync_device *const dev, const enum aes
 	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, enc);
 	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 3);
 	hri_aes_write_CTRLA_CFBS_bf(dev->hw, 3);
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
 	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
 
 	__aes_sync_set_key(dev);
@@ -469,7 +591,7 @@ int32_t _aes_sync_cfb8_crypt(struct _aes_sync_device *const dev, const enum aes_
 	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, enc);
 	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 3);
 	hri_aes_write_CTRLA_CFBS_bf(dev->hw, 4);
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
 	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
 
 	__aes_sync_set_key(dev);
@@ -511,7 +633,7 @@ int32_t _aes_sync_ofb_crypt(struct _aes_sync_device *const dev, const uint8_t *i
 	hri_aes_write_CTRLB_reg(dev->hw, 0);
 	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, 1);
 	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 2);
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
 	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
 
 	__aes_sync_set_key(dev);
@@ -559,7 +681,7 @@ int32_t _aes_sync_ctr_crypt(struct _aes_sync_device *const dev, const uint8_t *i
 	hri_aes_write_CTRLA_reg(dev->hw, 0x00);
 	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, 1);
 	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 4);
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
 	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
 
 	__aes_sync_set_key(dev);
@@ -647,6 +769,102 @@ int32_t _aes_sync_gcm_finish(struct _aes_sync_device *const dev, uint8_t *tag, u
 	return ERR_NONE;
 }
 
+/**
+ * \brief              AES-GCM encryption/decryption of a batch of messages
+ */
+int32_t _aes_sync_gcm_crypt_and_tag_batch(struct _aes_sync_device *const dev, const enum aes_action enc,
+                                          struct aes_gcm_job *const jobs, const uint32_t count)
+{
+	const uint8_t zero[16] = {0};
+	uint32_t      j0[4];
+	uint32_t      counter[4];
+	uint32_t      ghash[4];
+	uint32_t      tag[4];
+	uint8_t       diff;
+	uint32_t      i;
+	uint32_t      index;
+	int32_t       rc = ERR_NONE;
+
+	/* Generate HASHKEY once for the whole batch and stay in GCM mode until
+	 * the last message is done, the tag is generated with a GCM counter
+	 * block on j0 instead of switching to counter mode, so the key is loaded
+	 * only once.
+	 */
+	__aes_sync_gcm_set_hashkey(dev, enc);
+
+	for (i = 0; i < count; i++) {
+		/* Pre-counter block j0 */
+		hri_aes_set_CTRLB_GFMUL_bit(dev->hw);
+		if (jobs[i].iv_len == 12) {
+			memcpy(j0, jobs[i].iv, 12);
+			memset((uint8_t *)j0 + 12, 0, 3);
+			((uint8_t *)j0)[15] = 0x01;
+		} else {
+			__aes_sync_gcm_ghash(dev, jobs[i].iv, jobs[i].iv_len);
+			__aes_sync_gcm_ghash_lengths(dev, 0, jobs[i].iv_len);
+			for (index = 0; index < 4; index++) {
+				j0[index] = hri_aes_read_GHASH_reg(dev->hw, index);
+				hri_aes_write_GHASH_reg(dev->hw, index, 0x00);
+			}
+		}
+
+		__aes_sync_gcm_ghash(dev, jobs[i].aad, jobs[i].aad_len);
+		hri_aes_clear_CTRLB_GFMUL_bit(dev->hw);
+
+		/* Payload with j1 = j0 + 1 */
+		memcpy(counter, j0, 16);
+		for (index = 16; index > 12; index--) {
+			if (++((uint8_t *)counter)[index - 1] != 0)
+				break;
+		}
+		__aes_sync_gcm_crypt_blocks(dev, (uint8_t *)counter, jobs[i].input, jobs[i].output, jobs[i].length);
+
+		hri_aes_set_CTRLB_GFMUL_bit(dev->hw);
+		__aes_sync_gcm_ghash_lengths(dev, jobs[i].aad_len, jobs[i].length);
+		hri_aes_clear_CTRLB_GFMUL_bit(dev->hw);
+		for (index = 0; index < 4; index++) {
+			ghash[index] = hri_aes_read_GHASH_reg(dev->hw, index);
+		}
+
+		/* Tag = E(K, j0) ^ GHASH, E(K, j0) is a zero block run on j0. This
+		 * updates GHASHx as well, which is cleared for the next message.
+		 */
+		memcpy(counter, j0, 16);
+		__aes_sync_gcm_crypt_blocks(dev, (uint8_t *)counter, zero, (uint8_t *)tag, 16);
+		for (index = 0; index < 4; index++) {
+			tag[index] ^= ghash[index];
+			hri_aes_write_GHASH_reg(dev->hw, index, 0x00);
+		}
+
+		jobs[i].status = ERR_NONE;
+		if (enc) {
+			memcpy(jobs[i].tag, tag, jobs[i].tag_len);
+		} else {
+			diff = 0;
+			for (index = 0; index < jobs[i].tag_len; index++) {
+				diff |= ((uint8_t *)tag)[index] ^ jobs[i].tag[index];
+			}
+			if (diff) {
+				jobs[i].status = ERR_INVALID_DATA;
+				rc             = ERR_INVALID_DATA;
+			}
+		}
+	}
+
+	/* Cleanup, same as after a single GCM crypt */
+	for (index = 0; index < 4; index++) {
+		hri_aes_write_GHASH_reg(dev->hw, index, 0x00);
+		hri_aes_write_HASHKEY_reg(dev->hw, index, 0x00);
+		hri_aes_write_INDATA_reg(dev->hw, 0x00);
+	}
+	hri_aes_write_CTRLB_reg(dev->hw, 0);
+	hri_aes_write_CIPLEN_reg(dev->hw, 0x00);
+	hri_aes_write_DATABUFPTR_reg(dev->hw, 0x00);
+	hri_aes_clear_CTRLA_ENABLE_bit(dev->hw);
+
+	return rc;
+}
+
 /**
  * \brief              AES-CCM block encryption/decryption
  */
@@ -671,33 +889,8 @@ static void __aes_sync_gcm_start(struct _aes_sync_device *const dev, const enum
 	uint8_t        workbuf[16];
 	const uint8_t *ptr;
 
-	/* Step 1 Generate HASHKEY */
-	hri_aes_clear_CTRLA_ENABLE_bit(dev->hw);
-	hri_aes_write_CTRLA_reg(dev->hw, 0);
-	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, 1);
-	hri_aes_clear_CTRLA_AESMODE_bf(dev->hw, 0x7u); /* 0: ECB */
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
-	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
-
-	__aes_sync_set_key(dev);
-	for (index = 0; index < 4; index++) {
-		hri_aes_write_INDATA_reg(dev->hw, 0);
-	}
-	hri_aes_set_CTRLB_START_bit(dev->hw);
-	/* HashKey is ready*/
-	while (hri_aes_get_interrupt_ENCCMP_bit(dev->hw) == 0)
-		;
-
-	/* Change to GCM mode */
-	hri_aes_clear_CTRLA_ENABLE_bit(dev->hw);
-	hri_aes_write_CTRLA_STARTMODE_bit(dev->hw, 0);
-	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, 1);
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
-	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 6); /* GCM */
-	hri_aes_clear_CTRLA_CTYPE_bf(dev->hw, 0xFu);
-	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
-
-	__aes_sync_set_key(dev);
+	/* Step 1 Generate HASHKEY and change to GCM mode */
+	__aes_sync_gcm_set_hashkey(dev, AES_ENCRYPT);
 	hri_aes_set_CTRLB_GFMUL_bit(dev->hw);
 
 	/* Step 2: Generate pre-counter block j0 from the IV */
@@ -885,7 +1078,7 @@ static void __aes_sync_gcm_generate_tag(struct _aes_sync_device *const dev, uint
 	hri_aes_write_CTRLA_reg(dev->hw, 0);
 	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, 1);
 	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 4); /* Counter */
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
 	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
 	hri_aes_write_CTRLB_reg(dev->hw, 0);
 
@@ -917,6 +1110,169 @@ static void __aes_sync_gcm_generate_tag(struct _aes_sync_device *const dev, uint
 	hri_aes_clear_CTRLA_ENABLE_bit(dev->hw);
 }
 
+/**
+ * \brief Enable GCM mode with the key and hash subkey H loaded
+ *
+ * H = E(K, 0) is generated in ECB mode, unless the key slot in use already
+ * holds it from an earlier GCM operation.
+ */
+static void __aes_sync_gcm_set_hashkey(struct _aes_sync_device *const dev, const enum aes_action enc)
+{
+	struct aes_key_slot *slot = (dev->slot != AES_KEY_SLOT_NONE) ? &_aes_key_slots[dev->slot] : NULL;
+	uint8_t              index;
+
+	hri_aes_clear_CTRLA_ENABLE_bit(dev->hw);
+	hri_aes_write_CTRLA_reg(dev->hw, 0);
+	if (!slot || !slot->has_hashkey) {
+		hri_aes_write_CTRLA_CIPHER_bit(dev->hw, 1);
+		hri_aes_clear_CTRLA_AESMODE_bf(dev->hw, 0x7u); /* 0: ECB */
+		hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
+		hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
+
+		__aes_sync_set_key(dev);
+		for (index = 0; index < 4; index++) {
+			hri_aes_write_INDATA_reg(dev->hw, 0);
+		}
+		hri_aes_set_CTRLB_START_bit(dev->hw);
+		/* HashKey is ready*/
+		while (hri_aes_get_interrupt_ENCCMP_bit(dev->hw) == 0)
+			;
+		hri_aes_clear_CTRLA_ENABLE_bit(dev->hw);
+	}
+
+	/* Change to GCM mode */
+	hri_aes_write_CTRLA_STARTMODE_bit(dev->hw, 0);
+	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, enc);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
+	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 6); /* GCM */
+	hri_aes_clear_CTRLA_CTYPE_bf(dev->hw, 0xFu);
+	hri_aes_set_CTRLA_ENABLE_bit(dev->hw);
+
+	__aes_sync_set_key(dev);
+
+	if (slot) {
+		for (index = 0; index < 4; index++) {
+			if (slot->has_hashkey) {
+				hri_aes_write_HASHKEY_reg(dev->hw, index, slot->hashkey[index]);
+			} else {
+				slot->hashkey[index] = hri_aes_read_HASHKEY_reg(dev->hw, index);
+			}
+		}
+		slot->has_hashkey = true;
+	}
+}
+
+/**
+ * \brief Copy up to one block into a word buffer, zero padding a short block
+ */
+static void __aes_sync_gcm_load_block(uint32_t *block, const uint8_t *data, uint32_t length)
+{
+	if (length < 16) {
+		memset(block, 0, 16);
+	} else {
+		length = 16;
+	}
+	memcpy(block, data, length);
+}
+
+/**
+ * \brief GHASH data into GHASHx, GFMUL must be set
+ *
+ * The next block is gathered while the multiplication of the current one
+ * runs, so unaligned and short buffers cost no extra wait.
+ */
+static void __aes_sync_gcm_ghash(struct _aes_sync_device *const dev, const uint8_t *data, uint32_t length)
+{
+	uint32_t block[4];
+	uint32_t use_len;
+
+	if (length) {
+		__aes_sync_gcm_load_block(block, data, length);
+	}
+	while (length) {
+		__aes_sync_set_indata(dev, (const uint8_t *)block, 4);
+		hri_aes_set_CTRLB_START_bit(dev->hw);
+
+		use_len = min(length, 16);
+		data += use_len;
+		length -= use_len;
+		if (length) {
+			__aes_sync_gcm_load_block(block, data, length);
+		}
+		while (hri_aes_get_interrupt_GFMCMP_bit(dev->hw) == 0)
+			;
+	}
+}
+
+/**
+ * \brief GHASH the len(A)64 || len(C)64 block, GFMUL must be set
+ */
+static void __aes_sync_gcm_ghash_lengths(struct _aes_sync_device *const dev, uint32_t aad_len, uint32_t length)
+{
+	uint8_t workbuf[16];
+
+	memset(workbuf, 0, 16);
+	workbuf[4]  = ((aad_len << 3) >> 24) & 0xFF;
+	workbuf[5]  = ((aad_len << 3) >> 16) & 0xFF;
+	workbuf[6]  = ((aad_len << 3) >> 8) & 0xFF;
+	workbuf[7]  = (aad_len << 3) & 0xFF;
+	workbuf[12] = ((length << 3) >> 24) & 0xFF;
+	workbuf[13] = ((length << 3) >> 16) & 0xFF;
+	workbuf[14] = ((length << 3) >> 8) & 0xFF;
+	workbuf[15] = (length << 3) & 0xFF;
+	__aes_sync_gcm_ghash(dev, workbuf, 16);
+}
+
+/**
+ * \brief En/decrypt one GCM message starting at counter, GFMUL must be clear
+ *
+ * As for GHASH, the next input block is gathered while the current one is
+ * being processed.
+ */
+static void __aes_sync_gcm_crypt_blocks(struct _aes_sync_device *const dev, uint8_t *counter, const uint8_t *input,
+                                        uint8_t *output, uint32_t length)
+{
+	uint32_t block[4];
+	uint32_t use_len;
+
+	hri_aes_clear_interrupt_ENCCMP_bit(dev->hw);
+	hri_aes_set_CTRLB_NEWMSG_bit(dev->hw);
+	hri_aes_write_CIPLEN_reg(dev->hw, length);
+	__aes_sync_set_iv(dev, counter);
+	hri_aes_clear_DATABUFPTR_INDATAPTR_bf(dev->hw, 0x3u);
+
+	if (length) {
+		__aes_sync_gcm_load_block(block, input, length);
+	}
+	while (length) {
+		use_len = min(length, 16);
+		if (use_len == length) {
+			hri_aes_set_CTRLB_EOM_bit(dev->hw);
+		}
+		__aes_sync_set_indata(dev, (const uint8_t *)block, 4);
+		hri_aes_set_CTRLB_START_bit(dev->hw);
+
+		if (length > 16) {
+			__aes_sync_gcm_load_block(block, input + 16, length - 16);
+		}
+		while (hri_aes_get_interrupt_ENCCMP_bit(dev->hw) == 0)
+			;
+		hri_aes_clear_CTRLB_NEWMSG_bit(dev->hw);
+		hri_aes_clear_CTRLB_EOM_bit(dev->hw);
+
+		if (use_len == 16) {
+			__aes_sync_get_indata(dev, output, 4);
+		} else {
+			/* Only the last block can be short, block is free again */
+			__aes_sync_get_indata(dev, (uint8_t *)block, 4);
+			memcpy(output, block, use_len);
+		}
+		input += use_len;
+		output += use_len;
+		length -= use_len;
+	}
+}
+
 /*
  * Encrypt CCM Data, the process follow the SP800-38C
  * Section 6.1 Generation-Encryption Process
@@ -958,7 +1314,7 @@ int32_t __aes_sync_ccm_crypt_and_tag(struct _aes_sync_device *const dev, const u
 	hri_aes_write_CTRLB_reg(dev->hw, 0);
 	hri_aes_write_CTRLA_STARTMODE_bit(dev->hw, 0);
 	hri_aes_write_CTRLA_CIPHER_bit(dev->hw, 1);
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
 	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 5); /* CCM */
 	hri_aes_set_CTRLA_LOD_bit(dev->hw);         /* CBC-MAC */
 	hri_aes_clear_CTRLA_CTYPE_bf(dev->hw, 0xFu);
@@ -1135,7 +1491,7 @@ int32_t __aes_sync_ccm_decrypt_and_tag(struct _aes_sync_device *const dev, const
 	hri_aes_write_CTRLB_reg(dev->hw, 0);
 	hri_aes_write_CTRLA_STARTMODE_bit(dev->hw, 0);
 	hri_aes_clear_CTRLA_CIPHER_bit(dev->hw);
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
 	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 5); /* CCM */
 	hri_aes_clear_CTRLA_LOD_bit(dev->hw);       /* Counter mode */
 	hri_aes_clear_CTRLA_CTYPE_bf(dev->hw, 0xFu);
@@ -1174,7 +1530,7 @@ int32_t __aes_sync_ccm_decrypt_and_tag(struct _aes_sync_device *const dev, const
 	/* Step 7(SP800-38C, 6.2) Prepare CBC-MAC */
 	hri_aes_write_CTRLA_reg(dev->hw, 0);
 	hri_aes_write_CTRLA_STARTMODE_bit(dev->hw, 0);
-	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, dev->keysize);
+	hri_aes_write_CTRLA_KEYSIZE_bf(dev->hw, __aes_sync_keysize(dev));
 	hri_aes_write_CTRLA_AESMODE_bf(dev->hw, 5); /* CCM */
 	hri_aes_set_CTRLA_LOD_bit(dev->hw);         /* CBC-MAC */
 	hri_aes_set_CTRLA_CIPHER_bit(dev->hw);
@@ -1291,3 +1647,546 @@ int32_t __aes_sync_ccm_decrypt_and_tag(struct _aes_sync_device *const dev, const
 
 	return ERR_NONE;
 }
+
+/**
+ * \brief Double a block in GF(2^128), big-endian bit order (CMAC)
+ */
+static void __aes_sync_cmac_double(uint8_t block[16])
+{
+	uint8_t carry = block[0] >> 7;
+	uint8_t index;
+
+	for (index = 0; index < 15; index++) {
+		block[index] = (block[index] << 1) | (block[index + 1] >> 7);
+	}
+	block[15] = (block[15] << 1) ^ (carry ? 0x87 : 0x00);
+}
+
+/**
+ * \brief Multiply a tweak by alpha in GF(2^128), little-endian bit order (XTS)
+ */
+static void __aes_sync_xts_double(uint8_t tweak[16])
+{
+	uint8_t carry = tweak[15] >> 7;
+	int8_t  index;
+
+	for (index = 15; index > 0; index--) {
+		tweak[index] = (tweak[index] << 1) | (tweak[index - 1] >> 7);
+	}
+	tweak[0] = (tweak[0] << 1) ^ (carry ? 0x87 : 0x00);
+}
+
+/**
+ * \brief One XTS block, output = E/D(K1, input ^ tweak) ^ tweak
+ */
+static void __aes_sync_xts_block(struct _aes_sync_device *const dev, const enum aes_action enc, const uint8_t *input,
+                                 uint8_t *output, const uint8_t tweak[16])
+{
+	uint8_t block[16];
+	uint8_t index;
+
+	for (index = 0; index < 16; index++) {
+		block[index] = input[index] ^ tweak[index];
+	}
+	_aes_sync_ecb_crypt(dev, enc, block, block);
+	for (index = 0; index < 16; index++) {
+		output[index] = block[index] ^ tweak[index];
+	}
+}
+
+/**
+ * \brief              AES-CMAC message authentication
+ */
+int32_t _aes_sync_cmac(struct _aes_sync_device *const dev, const uint8_t *input, uint32_t length, uint8_t *mac,
+                       uint32_t mac_len)
+{
+	uint8_t  subkey[16] = {0};
+	uint8_t  x[16]      = {0};
+	uint8_t  workbuf[64];
+	uint32_t last;
+	uint32_t use_len;
+	uint8_t  index;
+
+	/* Subkeys K1 = dbl(E(K, 0)), K2 = dbl(K1) */
+	_aes_sync_ecb_crypt(dev, AES_ENCRYPT, subkey, subkey);
+	__aes_sync_cmac_double(subkey);
+
+	/* The last block is the only one that may be short or empty */
+	last = (length && !(length & 0xF)) ? length - 16 : length & ~0xFu;
+
+	/* CBC-MAC of all other blocks, x holds the chaining value */
+	while (last) {
+		use_len = min(last, sizeof(workbuf));
+		_aes_sync_cbc_crypt(dev, AES_ENCRYPT, input, workbuf, use_len, x);
+		input += use_len;
+		length -= use_len;
+		last -= use_len;
+	}
+
+	if (length < 16) {
+		__aes_sync_cmac_double(subkey);
+		memset(workbuf, 0, 16);
+		memcpy(workbuf, input, length);
+		workbuf[length] = 0x80;
+	} else {
+		memcpy(workbuf, input, 16);
+	}
+	for (index = 0; index < 16; index++) {
+		x[index] ^= workbuf[index] ^ subkey[index];
+	}
+	_aes_sync_ecb_crypt(dev, AES_ENCRYPT, x, x);
+	memcpy(mac, x, mac_len);
+
+	memset(subkey, 0, 16);
+	return ERR_NONE;
+}
+
+/**
+ * \brief              AES-XTS data unit encryption/decryption
+ */
+int32_t _aes_sync_xts_crypt(struct _aes_sync_device *const dev, const enum aes_action enc, const uint8_t *tweak_key,
+                            const uint8_t *input, uint8_t *output, uint32_t length, const uint8_t tweak[16])
+{
+	uint8_t          key[32];
+	uint8_t          t[16];
+	uint8_t          t_next[16];
+	uint8_t          block[16];
+	uint8_t          slot    = dev->slot;
+	enum aes_keysize keysize = __aes_sync_keysize(dev);
+	uint8_t          swap;
+	uint8_t          index;
+	uint32_t         blocks;
+	uint32_t         rest = length & 0xF;
+
+	if (length < 16) {
+		return ERR_INVALID_ARG;
+	}
+
+	/* T = E(K2, tweak), with the data key swapped out for the tweak key */
+	memcpy(key, dev->key, sizeof(key));
+	memcpy(dev->key, tweak_key, (keysize + 2) << 3);
+	dev->keysize = keysize;
+	dev->slot    = AES_KEY_SLOT_NONE;
+	_aes_sync_ecb_crypt(dev, AES_ENCRYPT, tweak, t);
+	memcpy(dev->key, key, sizeof(key));
+	dev->slot = slot;
+	memset(key, 0, sizeof(key));
+
+	/* With ciphertext stealing the last full block is handled below */
+	for (blocks = (length >> 4) - (rest ? 1 : 0); blocks; blocks--) {
+		__aes_sync_xts_block(dev, enc, input, output, t);
+		__aes_sync_xts_double(t);
+		input += 16;
+		output += 16;
+	}
+
+	if (rest) {
+		memcpy(t_next, t, 16);
+		__aes_sync_xts_double(t_next);
+
+		/* Decryption uses the tweaks of the last two blocks swapped */
+		__aes_sync_xts_block(dev, enc, input, block, (enc == AES_ENCRYPT) ? t : t_next);
+		for (index = 0; index < rest; index++) {
+			swap               = block[index];
+			block[index]       = input[16 + index];
+			output[16 + index] = swap;
+		}
+		__aes_sync_xts_block(dev, enc, block, output, (enc == AES_ENCRYPT) ? t_next : t);
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief              AES key wrap (RFC 3394)
+ */
+int32_t _aes_sync_kw_wrap(struct _aes_sync_device *const dev, const uint8_t *input, uint8_t *output, uint32_t length)
+{
+	uint8_t  b[16];
+	uint32_t n = length >> 3;
+	uint32_t t;
+	uint32_t i;
+	uint8_t  j;
+
+	if (length < 16 || (length & 0x7)) {
+		return ERR_INVALID_ARG;
+	}
+
+	/* A = default IV, R[1..n] are kept in output + 8 */
+	memmove(output + 8, input, length);
+	memset(b, 0xA6, 8);
+
+	for (j = 0, t = 1; j < 6; j++) {
+		for (i = 1; i <= n; i++, t++) {
+			memcpy(b + 8, output + (i << 3), 8);
+			_aes_sync_ecb_crypt(dev, AES_ENCRYPT, b, b);
+			b[4] ^= (t >> 24) & 0xFF;
+			b[5] ^= (t >> 16) & 0xFF;
+			b[6] ^= (t >> 8) & 0xFF;
+			b[7] ^= t & 0xFF;
+			memcpy(output + (i << 3), b + 8, 8);
+		}
+	}
+	memcpy(output, b, 8);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief              AES key unwrap (RFC 3394)
+ */
+int32_t _aes_sync_kw_unwrap(struct _aes_sync_device *const dev, const uint8_t *input, uint8_t *output, uint32_t length)
+{
+	uint8_t  b[16];
+	uint8_t  diff = 0;
+	uint32_t n    = (length >> 3) - 1;
+	uint32_t t;
+	uint32_t i;
+	uint8_t  j;
+
+	if (length < 24 || (length & 0x7)) {
+		return ERR_INVALID_ARG;
+	}
+
+	/* A = C[0], R[1..n] are kept in output - 8 */
+	memcpy(b, input, 8);
+	memmove(output, input + 8, n << 3);
+
+	for (j = 0, t = 6 * n; j < 6; j++) {
+		for (i = n; i >= 1; i--, t--) {
+			b[4] ^= (t >> 24) & 0xFF;
+			b[5] ^= (t >> 16) & 0xFF;
+			b[6] ^= (t >> 8) & 0xFF;
+			b[7] ^= t & 0xFF;
+			memcpy(b + 8, output + ((i - 1) << 3), 8);
+			_aes_sync_ecb_crypt(dev, AES_DECRYPT, b, b);
+			memcpy(output + ((i - 1) << 3), b + 8, 8);
+		}
+	}
+
+	for (j = 0; j < 8; j++) {
+		diff |= b[j] ^ 0xA6;
+	}
+	if (diff) {
+		memset(output, 0, n << 3);
+		return ERR_INVALID_DATA;
+	}
+	return ERR_NONE;
+}
+
+#if defined(CONF_AES_DMA_TX_CHANNEL) && defined(CONF_AES_DMA_RX_CHANNEL)
+
+/**
+ * \brief Configure the AES for DMA, which starts each block once its 4 input
+ *        words are written
+ */
+static void __aes_dma_configure(struct _aes_dma_device *const dev, const hri_aes_ctrla_reg_t ctrla)
+{
+	hri_aes_clear_CTRLA_ENABLE_bit(dev->sync.hw);
+	hri_aes_write_CTRLA_reg(dev->sync.hw, 0);
+	hri_aes_write_CTRLB_reg(dev->sync.hw, 0);
+	hri_aes_write_CTRLA_reg(dev->sync.hw, ctrla | AES_CTRLA_STARTMODE_AUTO | AES_CTRLA_KEYSIZE(__aes_sync_keysize(&dev->sync)));
+	hri_aes_set_CTRLA_ENABLE_bit(dev->sync.hw);
+
+	__aes_sync_set_key(&dev->sync);
+	hri_aes_write_DATABUFPTR_reg(dev->sync.hw, 0);
+}
+
+/**
+ * \brief Start the DMA channels moving blocks to and from INDATA
+ */
+static void __aes_dma_run(struct _aes_dma_device *const dev, const uint8_t *input, uint8_t *output, uint32_t length)
+{
+	void *indata = (void *)&((Aes *)dev->sync.hw)->INDATA.reg;
+
+	dev->dma_length = length;
+
+	/* The output channel ends the operation */
+	_dma_set_source_address(CONF_AES_DMA_RX_CHANNEL, indata);
+	_dma_set_destination_address(CONF_AES_DMA_RX_CHANNEL, output);
+	_dma_srcinc_enable(CONF_AES_DMA_RX_CHANNEL, false);
+	_dma_dstinc_enable(CONF_AES_DMA_RX_CHANNEL, true);
+	_dma_set_beat_size(CONF_AES_DMA_RX_CHANNEL, DMAC_BTCTRL_BEATSIZE_WORD_Val);
+	_dma_set_data_amount(CONF_AES_DMA_RX_CHANNEL, length >> 2);
+	_dma_set_irq_state(CONF_AES_DMA_RX_CHANNEL, DMA_TRANSFER_COMPLETE_CB, true);
+	_dma_set_irq_state(CONF_AES_DMA_RX_CHANNEL, DMA_TRANSFER_ERROR_CB, true);
+
+	_dma_set_source_address(CONF_AES_DMA_TX_CHANNEL, input);
+	_dma_set_destination_address(CONF_AES_DMA_TX_CHANNEL, indata);
+	_dma_srcinc_enable(CONF_AES_DMA_TX_CHANNEL, true);
+	_dma_dstinc_enable(CONF_AES_DMA_TX_CHANNEL, false);
+	_dma_set_beat_size(CONF_AES_DMA_TX_CHANNEL, DMAC_BTCTRL_BEATSIZE_WORD_Val);
+	_dma_set_data_amount(CONF_AES_DMA_TX_CHANNEL, length >> 2);
+	_dma_set_irq_state(CONF_AES_DMA_TX_CHANNEL, DMA_TRANSFER_COMPLETE_CB, false);
+	_dma_set_irq_state(CONF_AES_DMA_TX_CHANNEL, DMA_TRANSFER_ERROR_CB, true);
+
+	/* Both channels are triggered by the AES */
+	_dma_enable_transaction(CONF_AES_DMA_RX_CHANNEL, false);
+	_dma_enable_transaction(CONF_AES_DMA_TX_CHANNEL, false);
+}
+
+/**
+ * \brief Process the last GCM block and the length block
+ */
+static void __aes_dma_gcm_end(struct _aes_dma_device *const dev)
+{
+	uint8_t  workbuf[16];
+	uint32_t offset = dev->dma_length;
+	uint32_t left   = dev->length - offset;
+
+	/* The last block, full or not, marks the end of the message */
+	if (left) {
+		memset(workbuf, 0, 16);
+		memcpy(workbuf, dev->input + offset, left);
+
+		hri_aes_set_CTRLB_EOM_bit(dev->sync.hw);
+		__aes_sync_set_indata(&dev->sync, workbuf, 4);
+		while (hri_aes_get_interrupt_ENCCMP_bit(dev->sync.hw) == 0)
+			;
+		hri_aes_clear_CTRLB_NEWMSG_bit(dev->sync.hw);
+		hri_aes_clear_CTRLB_EOM_bit(dev->sync.hw);
+		__aes_sync_get_indata(&dev->sync, workbuf, 4);
+		memcpy(dev->output + offset, workbuf, left);
+	}
+
+	/* The GHASH is kept while disabled, back to manual start for GFMUL */
+	hri_aes_clear_CTRLA_ENABLE_bit(dev->sync.hw);
+	hri_aes_clear_CTRLA_STARTMODE_bit(dev->sync.hw);
+	hri_aes_set_CTRLA_ENABLE_bit(dev->sync.hw);
+
+	/* Generate Final GHASH by GHASH(H, A, C) */
+	memset(workbuf, 0, 16);
+	workbuf[4]  = ((dev->sync.aad_len << 3) >> 24) & 0xFF;
+	workbuf[5]  = ((dev->sync.aad_len << 3) >> 16) & 0xFF;
+	workbuf[6]  = ((dev->sync.aad_len << 3) >> 8) & 0xFF;
+	workbuf[7]  = (dev->sync.aad_len << 3) & 0xFF;
+	workbuf[12] = ((dev->length << 3) >> 24) & 0xFF;
+	workbuf[13] = ((dev->length << 3) >> 16) & 0xFF;
+	workbuf[14] = ((dev->length << 3) >> 8) & 0xFF;
+	workbuf[15] = (dev->length << 3) & 0xFF;
+
+	hri_aes_write_DATABUFPTR_reg(dev->sync.hw, 0);
+	__aes_sync_set_indata(&dev->sync, workbuf, 4);
+	hri_aes_set_CTRLB_GFMUL_bit(dev->sync.hw);
+	hri_aes_set_CTRLB_START_bit(dev->sync.hw);
+	while (hri_aes_get_interrupt_GFMCMP_bit(dev->sync.hw) == 0)
+		;
+	hri_aes_clear_CTRLB_GFMUL_bit(dev->sync.hw);
+}
+
+/**
+ * \brief End the operation and update the caller state
+ */
+static void __aes_dma_end(struct _aes_dma_device *const dev)
+{
+	uint32_t blocks = dev->length >> 4;
+	int8_t   index;
+
+	switch (dev->mode) {
+	case AES_DMA_MODE_CBC:
+		/* IV equals last cipher text */
+		memcpy(dev->iv, (dev->enc == AES_ENCRYPT) ? dev->output + dev->length - 16 : dev->block, 16);
+		break;
+	case AES_DMA_MODE_CTR:
+		/* NC equals last NC + number of blocks */
+		for (index = 15; index >= 0 && blocks; index--, blocks >>= 8) {
+			blocks += dev->iv[index];
+			dev->iv[index] = blocks & 0xFF;
+		}
+		break;
+	case AES_DMA_MODE_GCM:
+		__aes_dma_gcm_end(dev);
+		break;
+	default:
+		break;
+	}
+
+	hri_aes_clear_CTRLB_NEWMSG_bit(dev->sync.hw);
+	hri_aes_clear_CTRLA_ENABLE_bit(dev->sync.hw);
+
+	if (dev->cb.done) {
+		dev->cb.done(dev);
+	}
+}
+
+/**
+ * \brief Callback for DMA transfer done.
+ */
+static void _aes_dma_xfer_done(struct _dma_resource *resource)
+{
+	__aes_dma_end((struct _aes_dma_device *)resource->back);
+}
+
+/**
+ * \brief Callback for DMA errors.
+ */
+static void _aes_dma_error_occured(struct _dma_resource *resource)
+{
+	struct _aes_dma_device *dev = (struct _aes_dma_device *)resource->back;
+
+	_dma_disable_transaction(CONF_AES_DMA_TX_CHANNEL);
+	_dma_disable_transaction(CONF_AES_DMA_RX_CHANNEL);
+	hri_aes_clear_CTRLA_ENABLE_bit(dev->sync.hw);
+
+	if (dev->cb.error) {
+		dev->cb.error(dev);
+	}
+}
+
+int32_t _aes_dma_init(struct _aes_dma_device *const dev, void *const hw)
+{
+	ASSERT(dev && hw);
+
+	_aes_sync_init(&dev->sync, hw);
+
+	_dma_get_channel_resource(&dev->tx_resource, CONF_AES_DMA_TX_CHANNEL);
+	dev->tx_resource->back                 = dev;
+	dev->tx_resource->dma_cb.transfer_done = _aes_dma_xfer_done;
+	dev->tx_resource->dma_cb.error         = _aes_dma_error_occured;
+
+	_dma_get_channel_resource(&dev->rx_resource, CONF_AES_DMA_RX_CHANNEL);
+	dev->rx_resource->back                 = dev;
+	dev->rx_resource->dma_cb.transfer_done = _aes_dma_xfer_done;
+	dev->rx_resource->dma_cb.error         = _aes_dma_error_occured;
+
+	return ERR_NONE;
+}
+
+int32_t _aes_dma_deinit(struct _aes_dma_device *const dev)
+{
+	_dma_set_irq_state(CONF_AES_DMA_TX_CHANNEL, DMA_TRANSFER_COMPLETE_CB, false);
+	_dma_set_irq_state(CONF_AES_DMA_TX_CHANNEL, DMA_TRANSFER_ERROR_CB, false);
+	_dma_set_irq_state(CONF_AES_DMA_RX_CHANNEL, DMA_TRANSFER_COMPLETE_CB, false);
+	_dma_set_irq_state(CONF_AES_DMA_RX_CHANNEL, DMA_TRANSFER_ERROR_CB, false);
+
+	return _aes_sync_deinit(&dev->sync);
+}
+
+int32_t _aes_dma_set_key(struct _aes_dma_device *const dev, const uint8_t *key, const enum aes_keysize size)
+{
+	return _aes_sync_set_key(&dev->sync, key, size);
+}
+
+int32_t _aes_dma_ecb_crypt(struct _aes_dma_device *const dev, const enum aes_action enc, const uint8_t *input,
+                           uint8_t *output, uint32_t length)
+{
+	dev->mode   = AES_DMA_MODE_ECB;
+	dev->enc    = enc;
+	dev->input  = input;
+	dev->output = output;
+	dev->length = length;
+
+	__aes_dma_configure(dev, enc << AES_CTRLA_CIPHER_Pos);
+	__aes_dma_run(dev, input, output, length);
+
+	return ERR_NONE;
+}
+
+int32_t _aes_dma_cbc_crypt(struct _aes_dma_device *const dev, const enum aes_action enc, const uint8_t *input,
+                           uint8_t *output, uint32_t length, uint8_t iv[16])
+{
+	dev->mode   = AES_DMA_MODE_CBC;
+	dev->enc    = enc;
+	dev->input  = input;
+	dev->output = output;
+	dev->length = length;
+	dev->iv     = iv;
+
+	/* The next IV is the last cipher text, which in place decryption overwrites */
+	memcpy(dev->block, input + length - 16, 16);
+
+	__aes_dma_configure(dev, AES_CTRLA_AESMODE(1) | (enc << AES_CTRLA_CIPHER_Pos));
+	hri_aes_set_CTRLB_NEWMSG_bit(dev->sync.hw);
+	__aes_sync_set_iv(&dev->sync, iv);
+	__aes_dma_run(dev, input, output, length);
+
+	return ERR_NONE;
+}
+
+int32_t _aes_dma_ctr_crypt(struct _aes_dma_device *const dev, const uint8_t *input, uint8_t *output, uint32_t length,
+                           uint8_t nc[16])
+{
+	dev->mode   = AES_DMA_MODE_CTR;
+	dev->enc    = AES_ENCRYPT;
+	dev->input  = input;
+	dev->output = output;
+	dev->length = length;
+	dev->iv     = nc;
+
+	__aes_dma_configure(dev, AES_CTRLA_AESMODE(4) | AES_CTRLA_CIPHER);
+	hri_aes_set_CTRLB_NEWMSG_bit(dev->sync.hw);
+	__aes_sync_set_iv(&dev->sync, nc);
+	__aes_dma_run(dev, input, output, length);
+
+	return ERR_NONE;
+}
+
+int32_t _aes_dma_gcm_start(struct _aes_dma_device *const dev, const enum aes_action enc, const uint8_t *iv,
+                           uint32_t iv_len, const uint8_t *aad, uint32_t aad_len)
+{
+	dev->enc = enc;
+	__aes_sync_gcm_start(&dev->sync, enc, iv, iv_len, aad, aad_len);
+
+	return ERR_NONE;
+}
+
+int32_t _aes_dma_gcm_update(struct _aes_dma_device *const dev, const uint8_t *input, uint8_t *output,
+                            uint32_t length)
+{
+	int8_t  index;
+	uint8_t j1[16];
+
+	dev->mode   = AES_DMA_MODE_GCM;
+	dev->input  = input;
+	dev->output = output;
+	dev->length = length;
+
+	/* Set iv = j1 = j0 + 1, j0 is kept for the tag */
+	memcpy(j1, dev->sync.iv, 16);
+	for (index = 16; index > 12; index--) {
+		if (++j1[index - 1] != 0)
+			break;
+	}
+
+	/* Keep the GCM state from start, only change to automatic start */
+	hri_aes_clear_CTRLA_ENABLE_bit(dev->sync.hw);
+	hri_aes_set_CTRLA_STARTMODE_bit(dev->sync.hw);
+	hri_aes_set_CTRLA_ENABLE_bit(dev->sync.hw);
+	hri_aes_clear_interrupt_ENCCMP_bit(dev->sync.hw);
+	hri_aes_set_CTRLB_NEWMSG_bit(dev->sync.hw);
+	hri_aes_write_CIPLEN_reg(dev->sync.hw, length);
+	__aes_sync_set_iv(&dev->sync, j1);
+	hri_aes_clear_DATABUFPTR_INDATAPTR_bf(dev->sync.hw, 0x3u);
+
+	/* All blocks but the last one are moved by the DMA */
+	if (length > 16) {
+		__aes_dma_run(dev, input, output, (length - 1) & ~0xFu);
+	} else {
+		dev->dma_length = 0;
+		__aes_dma_end(dev);
+	}
+
+	return ERR_NONE;
+}
+
+int32_t _aes_dma_gcm_finish(struct _aes_dma_device *const dev, uint8_t *tag, uint32_t tag_len)
+{
+	/* Generate Tag, The final GHash should be present at GHASHx reg now */
+	__aes_sync_gcm_generate_tag(&dev->sync, tag, tag_len);
+	return ERR_NONE;
+}
+
+void _aes_dma_register_callback(struct _aes_dma_device *const dev, const enum _aes_dma_cb_type type,
+                                _aes_dma_cb_t cb)
+{
+	switch (type) {
+	case AES_DMA_CB_DONE:
+		dev->cb.done = cb;
+		break;
+	case AES_DMA_CB_ERROR:
+		dev->cb.error = cb;
+		break;
+	}
+}
+
+#endif
@@ -163,6 +163,13 @@ int32_t _dma_srcinc_enable(const uint8_t channel, const bool enable)
 	return ERR_NONE;
 }
 
+int32_t _dma_set_beat_size(const uint8_t channel, const uint8_t beat_size)
+{
+	hri_dmacdescriptor_write_BTCTRL_BEATSIZE_bf(&_descriptor_section[channel], beat_size);
+
+	return ERR_NONE;
+}
+
 int32_t _dma_set_data_amount(const uint8_t channel, const uint32_t amount)
 {
 	uint32_t address   = hri_dmacdescriptor_read_DSTADDR_reg(&_descriptor_section[channel]);
@@ -195,6 +202,20 @@ int32_t _dma_enable_transaction(const uint8_t channel, const bool software_trigg
 	return ERR_NONE;
 }
 
+int32_t _dma_disable_transaction(const uint8_t channel)
+{
+	hri_dmac_clear_CHCTRLA_ENABLE_bit(DMAC, channel);
+	while (hri_dmac_get_CHCTRLA_ENABLE_bit(DMAC, channel)) {
+	}
+
+	return ERR_NONE;
+}
+
+uint32_t _dma_get_remaining_amount(const uint8_t channel)
+{
+	return hri_dmacdescriptor_read_BTCNT_reg(&_write_back_section[channel]);
+}
+
 int32_t _dma_get_channel_resource(struct _dma_resource **resource, const uint8_t channel)
 {
 	*resource = &_resources[channel];
@@ -36,13 +36,20 @@
 #include <hpl_crc_sync.h>
 #include <utils_assert.h>
 #include <err_codes.h>
+#include <utils.h>
+
+#ifndef CONF_DSU_CRC_RUN_LENGTH
+/* Longest DSU run in words, interrupts are disabled during a run */
+#define CONF_DSU_CRC_RUN_LENGTH 256
+#endif
 
 /**
  * \brief Initialize CRC.
  */
 int32_t _crc_sync_init(struct _crc_sync_device *const device, void *const hw)
 {
-	device->hw = hw;
+	device->hw       = hw;
+	device->sessions = 0;
 
 	return ERR_NONE;
 }
@@ -77,51 +84,139 @@ int32_t _crc_sync_disable(struct _crc_sync_device *const device)
 	return ERR_NONE;
 }
 
+/**
+ * \brief Keep the DSU writable until _crc_sync_end
+ */
+int32_t _crc_sync_begin(struct _crc_sync_device *const device)
+{
+	int32_t rc = ERR_NONE;
+
+	CRITICAL_SECTION_ENTER()
+	if (device->sessions == 0) {
+		/* Disable write-protected by PAC1->DSU before write DSU registers */
+		rc = _periph_unlock(device->hw);
+	}
+	if (rc == ERR_NONE) {
+		device->sessions++;
+	}
+	CRITICAL_SECTION_LEAVE()
+
+	return rc;
+}
+
+/**
+ * \brief Restore the DSU write protection
+ */
+int32_t _crc_sync_end(struct _crc_sync_device *const device)
+{
+	int32_t rc = ERR_NONE;
+
+	CRITICAL_SECTION_ENTER()
+	ASSERT(device->sessions);
+	device->sessions--;
+	if (device->sessions == 0) {
+		/* Restore write-protected of PAC->DSU */
+		rc = _periph_lock(device->hw);
+	}
+	CRITICAL_SECTION_LEAVE()
+
+	return rc;
+}
+
 /**
  * \brief Calculate CRC value of the buffer
  */
 int32_t _crc_sync_crc32(struct _crc_sync_device *const device, uint32_t *const data, const uint32_t len, uint32_t *pcrc)
 {
-	int32_t rc = ERR_NONE;
+	int32_t  rc = ERR_NONE;
+	uint32_t crc, offset, run;
+
 	if (((uint32_t)data) & 0x00000003) {
 		/* Address must be align with 4 bytes, refer to datasheet */
 		return ERR_INVALID_ARG;
 	}
 
-	CRITICAL_SECTION_ENTER()
-	/* Disable write-protected by PAC1->DSU before write DSU registers */
-	_periph_unlock(device->hw);
+	rc = _crc_sync_begin(device);
+	if (rc != ERR_NONE) {
+		return rc;
+	}
 
-	hri_dsu_write_ADDR_reg(device->hw, (uint32_t)data);
-	hri_dsu_write_LENGTH_LENGTH_bf(device->hw, len);
-	hri_dsu_write_DATA_reg(device->hw, *pcrc);
-	hri_dsu_write_CTRL_reg(device->hw, DSU_CTRL_CRC);
+	crc = *pcrc;
 
-	while (hri_dsu_get_STATUSA_DONE_bit(device->hw) == 0) {
-	}
+	/* Interrupts are served between runs, the DSU is reloaded with the CRC
+	 * of the previous run, in case an interrupt used it */
+	for (offset = 0; offset < len && rc == ERR_NONE; offset += run) {
+		run = min(len - offset, CONF_DSU_CRC_RUN_LENGTH);
 
-	if (hri_dsu_get_STATUSA_BERR_bit(device->hw)) {
-		hri_dsu_clear_STATUSA_BERR_bit(device->hw);
+		CRITICAL_SECTION_ENTER()
+		hri_dsu_write_ADDR_reg(device->hw, (uint32_t)(data + offset));
+		hri_dsu_write_LENGTH_LENGTH_bf(device->hw, run);
+		hri_dsu_write_DATA_reg(device->hw, crc);
+		hri_dsu_write_CTRL_reg(device->hw, DSU_CTRL_CRC);
+
+		while (hri_dsu_get_STATUSA_DONE_bit(device->hw) == 0) {
+		}
+
+		if (hri_dsu_get_STATUSA_BERR_bit(device->hw)) {
+			hri_dsu_clear_STATUSA_BERR_bit(device->hw);
+			rc = ERR_IO;
+		} else {
+			crc = (uint32_t)hri_dsu_read_DATA_reg(device->hw);
+		}
 		hri_dsu_clear_STATUSA_DONE_bit(device->hw);
-		rc = ERR_IO;
-	} else {
-		*pcrc = (uint32_t)hri_dsu_read_DATA_reg(device->hw);
+		CRITICAL_SECTION_LEAVE()
 	}
-	hri_dsu_clear_STATUSA_DONE_bit(device->hw);
 
-	/* Restore write-protected of PAC->DSU */
-	_periph_lock(device->hw);
+	if (rc == ERR_NONE) {
+		*pcrc = crc;
+	}
 
-	CRITICAL_SECTION_LEAVE()
+	_crc_sync_end(device);
 
 	return rc;
 }
 
 /**
  * \brief Compute CRC16 value of the buffer
+ *
+ * The DSU only computes CRC-32, CRC-16 is computed by the CRC engine of the
+ * DMAC, fed by the CPU through its I/O interface.
  */
 int32_t _crc_sync_crc16(struct _crc_sync_device *const device, uint16_t *const data, const uint32_t len, uint16_t *pcrc)
 {
-	(void)device, (void)data, (void)len, (void)pcrc;
-	return ERR_UNSUPPORTED_OP;
+	int32_t  rc = ERR_NONE;
+	uint32_t i;
+
+	(void)device;
+
+	if (((uint32_t)data) & 0x00000001) {
+		/* Half word beats, address must be align with 2 bytes */
+		return ERR_INVALID_ARG;
+	}
+
+	CRITICAL_SECTION_ENTER()
+	if (hri_dmac_read_CRCCTRL_CRCSRC_bf(DMAC) != DMAC_CRCCTRL_CRCSRC_DISABLE_Val) {
+		/* The CRC engine is used by a DMA channel */
+		rc = ERR_BUSY;
+	} else {
+		/* The checksum can only be written while the CRC is disabled */
+		hri_dmac_write_CRCCHKSUM_reg(DMAC, *pcrc);
+		hri_dmac_write_CRCCTRL_reg(DMAC,
+		                           DMAC_CRCCTRL_CRCBEATSIZE_HWORD | DMAC_CRCCTRL_CRCPOLY_CRC16
+		                               | DMAC_CRCCTRL_CRCSRC_IO);
+
+		/* A half word beat takes two cycles, less than a loop iteration */
+		for (i = 0; i < len; i++) {
+			hri_dmac_write_CRCDATAIN_reg(DMAC, data[i]);
+		}
+		__NOP();
+		__NOP();
+
+		*pcrc = (uint16_t)hri_dmac_read_CRCCHKSUM_reg(DMAC);
+		hri_dmac_write_CRCCTRL_reg(DMAC, DMAC_CRCCTRL_CRCSRC_DISABLE);
+		hri_dmac_clear_CRCSTATUS_CRCBUSY_bit(DMAC);
+	}
+	CRITICAL_SECTION_LEAVE()
+
+	return rc;
 }
@@ -0,0 +1,241 @@
+/**
+ * \file
+ *
+ * \brief ICM related functionality implementation.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#include <utils.h>
+#include <utils_assert.h>
+#include <hpl_icm.h>
+
+#ifndef CONF_ICM_BBC
+/* Bus burden control, the ICM waits 2^BBC cycles between blocks */
+#define CONF_ICM_BBC 0
+#endif
+
+/**
+ * \brief All region interrupts disabled
+ */
+#define ICM_RCFG_IRQ_DIS                                                                                              \
+	(ICM_RCFG_RHIEN_DIS | ICM_RCFG_DMIEN_DIS | ICM_RCFG_BEIEN_DIS | ICM_RCFG_WCIEN_DIS | ICM_RCFG_ECIEN_DIS          \
+	 | ICM_RCFG_SUIEN_DIS)
+
+/* Region descriptor area, must be 64 byte aligned */
+COMPILER_ALIGNED(64)
+static IcmDescriptor _icm_descriptors[ICM_REGIONS];
+
+/* Region hash area, 0x20 bytes per region, must be 128 byte aligned */
+COMPILER_ALIGNED(128)
+static volatile uint32_t _icm_hash[ICM_REGIONS][8];
+
+/*!< Pointer to hpl device */
+static struct _icm_device *_icm_dev = NULL;
+
+/**
+ * \brief Disable ICM and wait until it has stopped
+ */
+static void __icm_disable(void *const hw)
+{
+	hri_icm_write_CTRL_reg(hw, ICM_CTRL_DISABLE);
+	while (hri_icm_get_SR_ENABLE_bit(hw))
+		;
+}
+
+/**
+ * \brief Initialize ICM
+ */
+int32_t _icm_init(struct _icm_device *const dev, void *const hw)
+{
+	ASSERT(dev && hw);
+
+	hri_icm_write_CTRL_reg(hw, ICM_CTRL_SWRST);
+	hri_icm_write_DSCR_reg(hw, (uint32_t)_icm_descriptors);
+	hri_icm_write_HASH_reg(hw, (uint32_t)_icm_hash);
+
+	dev->hw  = hw;
+	_icm_dev = dev;
+
+	NVIC_DisableIRQ(ICM_IRQn);
+	NVIC_ClearPendingIRQ(ICM_IRQn);
+	NVIC_EnableIRQ(ICM_IRQn);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief De-initialize ICM
+ */
+void _icm_deinit(struct _icm_device *const dev)
+{
+	ASSERT(dev);
+
+	NVIC_DisableIRQ(ICM_IRQn);
+	NVIC_ClearPendingIRQ(ICM_IRQn);
+	__icm_disable(dev->hw);
+	hri_icm_write_CTRL_reg(dev->hw, ICM_CTRL_SWRST);
+	_icm_dev = NULL;
+}
+
+/**
+ * \brief Run the SHA compression function over whole blocks
+ */
+int32_t _icm_sha_process(struct _icm_device *const dev, const enum icm_algo algo, uint32_t *const state,
+                         const void *const data, uint32_t blocks)
+{
+	const uint8_t *ptr   = (const uint8_t *)data;
+	uint8_t        words = (algo == ICM_ALGO_SHA1) ? 5 : 8;
+	uint32_t       count;
+	uint32_t       isr;
+	uint8_t        index;
+
+	ASSERT(dev && state && !((uint32_t)data & 0x3));
+
+	if (hri_icm_get_SR_ENABLE_bit(dev->hw)) {
+		return ERR_BUSY;
+	}
+
+	/* The chaining state is passed in as user initial hash value and
+	 * written back to the hash area of region 0 */
+	hri_icm_write_CFG_reg(dev->hw,
+	                      ICM_CFG_SLBDIS | ICM_CFG_BBC(CONF_ICM_BBC) | ICM_CFG_UIHASH | ICM_CFG_UALGO(algo));
+
+	while (blocks) {
+		count = min(blocks, ICM_RCTRL_TRSIZE_Msk + 1);
+
+		hri_icmdescriptor_write_RADDR_reg(&_icm_descriptors[0], (uint32_t)ptr);
+		hri_icmdescriptor_write_RCFG_reg(&_icm_descriptors[0],
+		                                 ICM_RCFG_EOM_YES | ICM_RCFG_ALGO(algo)
+		                                     | (ICM_RCFG_IRQ_DIS & ~(ICM_RCFG_RHIEN | ICM_RCFG_BEIEN)));
+		hri_icmdescriptor_write_RCTRL_reg(&_icm_descriptors[0], ICM_RCTRL_TRSIZE(count - 1));
+		hri_icmdescriptor_write_RNEXT_reg(&_icm_descriptors[0], 0);
+		for (index = 0; index < words; index++) {
+			hri_icm_write_UIHVAL_reg(dev->hw, index, state[index]);
+		}
+		__DSB();
+
+		hri_icm_write_CTRL_reg(dev->hw, ICM_CTRL_ENABLE);
+		/* Status flags are cleared when ISR is read */
+		do {
+			isr = hri_icm_read_ISR_reg(dev->hw);
+		} while (!(isr & (ICM_ISR_RHC(1) | ICM_ISR_RBE(1))));
+		__icm_disable(dev->hw);
+
+		if (isr & ICM_ISR_RBE(1)) {
+			return ERR_IO;
+		}
+		for (index = 0; index < words; index++) {
+			state[index] = _icm_hash[0][index];
+		}
+		ptr += count << 6;
+		blocks -= count;
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Start monitoring memory regions
+ */
+int32_t _icm_monitor_start(struct _icm_device *const dev, const enum icm_algo algo,
+                           const struct icm_region *const regions, const uint8_t count)
+{
+	uint8_t i;
+
+	ASSERT(dev && regions && count && (count <= ICM_REGIONS));
+
+	if (hri_icm_get_SR_ENABLE_bit(dev->hw)) {
+		return ERR_BUSY;
+	}
+
+	/* The first pass writes the digests back, later passes compare */
+	hri_icm_write_CFG_reg(dev->hw, ICM_CFG_SLBDIS | ICM_CFG_ASCD | ICM_CFG_BBC(CONF_ICM_BBC));
+
+	for (i = 0; i < count; i++) {
+		ASSERT(!((uint32_t)regions[i].start & 0x3) && regions[i].blocks
+		       && (regions[i].blocks <= ICM_RCTRL_TRSIZE_Msk + 1));
+
+		hri_icmdescriptor_write_RADDR_reg(&_icm_descriptors[i], (uint32_t)regions[i].start);
+		hri_icmdescriptor_write_RCFG_reg(&_icm_descriptors[i],
+		                                 ICM_RCFG_CDWBN_WRBA | ((i == count - 1) ? ICM_RCFG_WRAP_YES : 0)
+		                                     | ICM_RCFG_ALGO(algo)
+		                                     | (ICM_RCFG_IRQ_DIS & ~(ICM_RCFG_DMIEN | ICM_RCFG_BEIEN)));
+		hri_icmdescriptor_write_RCTRL_reg(&_icm_descriptors[i], ICM_RCTRL_TRSIZE(regions[i].blocks - 1));
+		hri_icmdescriptor_write_RNEXT_reg(&_icm_descriptors[i], 0);
+	}
+	__DSB();
+
+	/* Drop stale status and enable mismatch and bus error interrupts */
+	hri_icm_read_ISR_reg(dev->hw);
+	hri_icm_set_IMR_RDM_bf(dev->hw, (1u << count) - 1);
+	hri_icm_set_IMR_RBE_bf(dev->hw, (1u << count) - 1);
+	hri_icm_write_CTRL_reg(dev->hw, ICM_CTRL_ENABLE);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Stop monitoring memory regions
+ */
+void _icm_monitor_stop(struct _icm_device *const dev)
+{
+	ASSERT(dev);
+
+	hri_icm_clear_IMR_reg(dev->hw, ICM_IMR_MASK);
+	__icm_disable(dev->hw);
+}
+
+/**
+ * \brief Check if the ICM is monitoring
+ */
+bool _icm_is_monitoring(struct _icm_device *const dev)
+{
+	ASSERT(dev);
+
+	return hri_icm_get_SR_ENABLE_bit(dev->hw);
+}
+
+/**
+ * \internal ICM interrupt handler
+ */
+void ICM_Handler(void)
+{
+	void *const hw  = _icm_dev->hw;
+	uint32_t    isr = hri_icm_read_ISR_reg(hw) & hri_icm_read_IMR_reg(hw);
+	uint8_t     region;
+
+	for (region = 0; region < ICM_REGIONS; region++) {
+		if ((isr & ICM_ISR_RDM(1u << region)) && _icm_dev->cb.digest_mismatch) {
+			_icm_dev->cb.digest_mismatch(_icm_dev, region);
+		}
+		if ((isr & ICM_ISR_RBE(1u << region)) && _icm_dev->cb.bus_error) {
+			_icm_dev->cb.bus_error(_icm_dev, region);
+		}
+	}
+}
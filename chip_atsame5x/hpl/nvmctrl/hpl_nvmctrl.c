@@ -34,13 +34,16 @@
 
 #include <hpl_flash.h>
 #include <hpl_user_area.h>
+#include <hpl_smart_eeprom.h>
 #include <string.h>
 #include <utils_assert.h>
 #include <utils.h>
+#include <hpl_cmcc.h>
 #include <hpl_nvmctrl_config.h>
 
 #define NVM_MEMORY ((volatile uint32_t *)FLASH_ADDR)
 #define NVMCTRL_BLOCK_PAGES (NVMCTRL_BLOCK_SIZE / NVMCTRL_PAGE_SIZE)
+#define NVMCTRL_QUAD_WORD_SIZE 16
 #define NVMCTRL_REGIONS_NUM 32
 #define NVMCTRL_INTFLAG_ERR                                                                                            \
 	(NVMCTRL_INTFLAG_ADDRE | NVMCTRL_INTFLAG_PROGE | NVMCTRL_INTFLAG_LOCKE | NVMCTRL_INTFLAG_ECCSE                     \
@@ -62,8 +65,22 @@ static struct nvm_configuration _nvm
 /*!< Pointer to hpl device */
 static struct _flash_device *_nvm_dev = NULL;
 
+/* Set to 0 to rewrite blocks through a buffer in stack instead, when no
+ * buffer is set by flash_set_block_buffer */
+#ifndef CONF_NVM_STATIC_BLOCK_BUFFER
+#define CONF_NVM_STATIC_BLOCK_BUFFER 1
+#endif
+
+#if CONF_NVM_STATIC_BLOCK_BUFFER
+/*!< Scratch buffer used when a block has to be erased and rewritten */
+static uint32_t _nvm_block_buffer[NVMCTRL_BLOCK_SIZE / 4];
+#endif
+
 static void _flash_erase_block(void *const hw, const uint32_t dst_addr);
 static void _flash_program(void *const hw, const uint32_t dst_addr, const uint8_t *buffer, const uint16_t size);
+static void _flash_program_quad_word(void *const hw, const uint32_t dst_addr, const uint32_t *buffer);
+static void _flash_write_block(struct _flash_device *const device, const uint32_t dst_addr, const uint8_t *buffer,
+                               const uint32_t length);
 
 /**
  * \brief Initialize NVM
@@ -74,8 +91,9 @@ int32_t _flash_init(struct _flash_device *const device, void *const hw)
 
 	ASSERT(device && (hw == NVMCTRL));
 
-	device->hw = hw;
-	ctrla      = hri_nvmctrl_read_CTRLA_reg(hw);
+	device->hw           = hw;
+	device->block_buffer = NULL;
+	ctrla                = hri_nvmctrl_read_CTRLA_reg(hw);
 	ctrla &= ~(NVMCTRL_CTRLA_CACHEDIS0 | NVMCTRL_CTRLA_CACHEDIS1 | NVMCTRL_CTRLA_PRM_Msk);
 	ctrla |= _nvm.ctrla;
 	hri_nvmctrl_write_CTRLA_reg(hw, ctrla);
@@ -136,66 +154,205 @@ void _flash_set_wait_state(struct _flash_device *const device, uint8_t state)
 }
 
 /**
- * \brief Reads a number of bytes to a page in the internal Flash.
+ * \internal Maximum CPU frequency for each number of read wait states
  */
-void _flash_read(struct _flash_device *const device, const uint32_t src_addr, uint8_t *buffer, uint32_t length)
+static const uint32_t _nvm_wait_state_max_freq[] = {24000000, 51000000, 77000000, 101000000, 119000000};
+
+/**
+ * \brief Get the minimum number of wait states for a CPU frequency.
+ */
+uint8_t _flash_get_min_wait_state(const uint32_t cpu_freq)
 {
-	uint8_t *nvm_addr = (uint8_t *)NVM_MEMORY;
-	uint32_t i;
+	uint8_t i;
 
-	/* Check if the module is busy */
-	while (!hri_nvmctrl_get_STATUS_READY_bit(device->hw)) {
-		/* Wait until this module isn't busy */
+	for (i = 0; i < ARRAY_SIZE(_nvm_wait_state_max_freq); i++) {
+		if (cpu_freq <= _nvm_wait_state_max_freq[i]) {
+			break;
+		}
 	}
 
-	for (i = 0; i < length; i++) {
-		buffer[i] = nvm_addr[src_addr + i];
+	return i;
+}
+
+/**
+ * \brief Enable/disable the automatic wait states generation.
+ */
+void _flash_set_auto_wait_state(struct _flash_device *const device, const bool state)
+{
+	hri_nvmctrl_write_CTRLA_AUTOWS_bit(device->hw, state);
+}
+
+/**
+ * \brief Check whether the automatic wait states generation is enabled.
+ */
+bool _flash_get_auto_wait_state(struct _flash_device *const device)
+{
+	return hri_nvmctrl_get_CTRLA_AUTOWS_bit(device->hw);
+}
+
+/**
+ * \brief Enable/disable the cache of a flash bank.
+ */
+void _flash_set_cache(struct _flash_device *const device, const uint8_t bank, const bool state)
+{
+	ASSERT(bank < 2);
+
+	if (bank) {
+		hri_nvmctrl_write_CTRLA_CACHEDIS1_bit(device->hw, !state);
+	} else {
+		hri_nvmctrl_write_CTRLA_CACHEDIS0_bit(device->hw, !state);
 	}
 }
 
 /**
- * \brief Writes a number of bytes to a page in the internal Flash.
+ * \brief Check whether the cache of a flash bank is enabled.
  */
-void _flash_write(struct _flash_device *const device, const uint32_t dst_addr, uint8_t *buffer, uint32_t length)
+bool _flash_get_cache(struct _flash_device *const device, const uint8_t bank)
 {
-	uint8_t  tmp_buffer[NVMCTRL_BLOCK_PAGES][NVMCTRL_PAGE_SIZE];
-	uint32_t block_start_addr, block_end_addr;
-	uint32_t i, j, k;
-	uint32_t wr_start_addr = dst_addr;
+	ASSERT(bank < 2);
 
-	do {
-		block_start_addr = wr_start_addr & ~(NVMCTRL_BLOCK_SIZE - 1);
-		block_end_addr   = block_start_addr + NVMCTRL_BLOCK_SIZE - 1;
+	if (bank) {
+		return !hri_nvmctrl_get_CTRLA_CACHEDIS1_bit(device->hw);
+	}
+	return !hri_nvmctrl_get_CTRLA_CACHEDIS0_bit(device->hw);
+}
 
-		/* store the erase data into temp buffer before write */
-		for (i = 0; i < NVMCTRL_BLOCK_PAGES; i++) {
-			_flash_read(device, block_start_addr + i * NVMCTRL_PAGE_SIZE, tmp_buffer[i], NVMCTRL_PAGE_SIZE);
+/**
+ * \brief Set the power reduction mode of the flash during sleep.
+ */
+void _flash_set_power_reduction_mode(struct _flash_device *const device, const uint8_t mode)
+{
+	hri_nvmctrl_write_CTRLA_PRM_bf(device->hw, mode);
+}
+
+/**
+ * \internal Flash resident benchmark workload
+ *
+ * Mixes branches, literal pool loads and arithmetic, so that its speed
+ * depends on instruction fetches from flash. Kept out of line to run from
+ * flash even when the caller is inlined elsewhere. The loop fits in any
+ * cache, so it only shows the wait states with the caches disabled.
+ *
+ * \param[in] iterations Number of iterations
+ *
+ * \return A value depending on all iterations
+ */
+static uint32_t __attribute__((noinline)) _flash_benchmark_workload(uint32_t iterations)
+{
+	uint32_t acc = 0x12345678;
+
+	while (iterations--) {
+		if (acc & 1) {
+			acc = (acc >> 1) ^ 0xEDB88320;
+		} else {
+			acc = (acc >> 1) + 0x9E3779B9;
 		}
+		acc ^= iterations * 0x01000193;
+	}
 
-		/* temp buffer update */
-		j = (wr_start_addr - block_start_addr) / NVMCTRL_PAGE_SIZE;
-		k = wr_start_addr - block_start_addr - j * NVMCTRL_PAGE_SIZE;
-		while ((wr_start_addr <= block_end_addr) && (length > 0)) {
-			tmp_buffer[j][k] = *buffer;
-			k                = (k + 1) % NVMCTRL_PAGE_SIZE;
+	return acc;
+}
 
-			if (0 == k) {
-				j++;
-			}
+/**
+ * \brief Measure the execution time of code running from flash.
+ */
+uint32_t _flash_benchmark(struct _flash_device *const device, const uint32_t iterations)
+{
+	uint32_t          demcr  = CoreDebug->DEMCR;
+	uint32_t          dwt    = DWT->CTRL;
+	bool              cache0 = _flash_get_cache(device, 0);
+	bool              cache1 = _flash_get_cache(device, 1);
+	bool              cmcc   = _is_cache_enabled(CMCC);
+	uint32_t          start, cycles;
+	volatile uint32_t result;
+
+	/* Every instruction fetch goes to the flash, so the wait states show */
+	if (cmcc) {
+		_cmcc_disable(CMCC);
+	}
+	_flash_set_cache(device, 0, false);
+	_flash_set_cache(device, 1, false);
 
-			wr_start_addr++;
-			buffer++;
-			length--;
-		}
+	/* Count CPU cycles with the DWT */
+	CoreDebug->DEMCR = demcr | CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL        = dwt | DWT_CTRL_CYCCNTENA_Msk;
 
-		/* erase row before write */
-		_flash_erase_block(device->hw, block_start_addr);
+	start  = DWT->CYCCNT;
+	result = _flash_benchmark_workload(iterations);
+	cycles = DWT->CYCCNT - start;
+	(void)result;
 
-		/* write buffer to flash */
-		for (i = 0; i < NVMCTRL_BLOCK_PAGES; i++) {
-			_flash_program(device->hw, block_start_addr + i * NVMCTRL_PAGE_SIZE, tmp_buffer[i], NVMCTRL_PAGE_SIZE);
-		}
-	} while (block_end_addr < (wr_start_addr + length - 1));
+	DWT->CTRL        = dwt;
+	CoreDebug->DEMCR = demcr;
+
+	_flash_set_cache(device, 0, cache0);
+	_flash_set_cache(device, 1, cache1);
+	if (cmcc) {
+		_cmcc_enable(CMCC);
+	}
+
+	return cycles;
+}
+
+/**
+ * \brief Reads a number of bytes to a page in the internal Flash.
+ */
+void _flash_read(struct _flash_device *const device, const uint32_t src_addr, uint8_t *buffer, uint32_t length)
+{
+	/* Check if the module is busy with the bank to read */
+	while (!_flash_is_readable(device, src_addr, length)) {
+		/* Wait until this module isn't busy */
+	}
+
+	/* The flash is memory mapped, memcpy uses word and burst accesses
+	 * where the alignment allows */
+	memcpy(buffer, (const uint8_t *)NVM_MEMORY + src_addr, length);
+}
+
+/**
+ * \brief Get a pointer to the memory mapped flash content.
+ */
+const uint8_t *_flash_get_pointer(struct _flash_device *const device, const uint32_t src_addr)
+{
+	(void)device;
+	return (const uint8_t *)NVM_MEMORY + src_addr;
+}
+
+/**
+ * \brief Check whether a flash area can be read without stalling.
+ */
+bool _flash_is_readable(struct _flash_device *const device, const uint32_t src_addr, const uint32_t length)
+{
+	uint32_t cmd_addr;
+
+	if (hri_nvmctrl_get_STATUS_READY_bit(device->hw)) {
+		return true;
+	}
+
+	/* The bank of the command in progress stalls reads, the other bank can
+	 * be read while it is written */
+	cmd_addr = hri_nvmctrl_read_ADDR_reg(device->hw);
+
+	return ((cmd_addr ^ src_addr) & (FLASH_SIZE / 2)) && ((cmd_addr ^ (src_addr + length - 1)) & (FLASH_SIZE / 2));
+}
+
+/**
+ * \brief Writes a number of bytes to a page in the internal Flash.
+ */
+void _flash_write(struct _flash_device *const device, const uint32_t dst_addr, uint8_t *buffer, uint32_t length)
+{
+	uint32_t wr_start_addr = dst_addr;
+	uint32_t size;
+
+	/* Split the write at block boundaries, each block is handled on its own */
+	while (length > 0) {
+		size = min(length, NVMCTRL_BLOCK_SIZE - (wr_start_addr & (NVMCTRL_BLOCK_SIZE - 1)));
+		_flash_write_block(device, wr_start_addr, buffer, size);
+
+		wr_start_addr += size;
+		buffer += size;
+		length -= size;
+	}
 }
 
 /**
@@ -342,13 +499,91 @@ void _flash_set_irq_state(struct _flash_device *const device, const enum _flash_
 		hri_nvmctrl_write_INTEN_DONE_bit(device->hw, state);
 	} else if (FLASH_DEVICE_CB_ERROR == type) {
 		if (state) {
-			hri_nvmctrl_write_INTEN_reg(device->hw, NVMCTRL_INTFLAG_ERR);
+			hri_nvmctrl_set_INTEN_reg(device->hw, NVMCTRL_INTFLAG_ERR);
 		} else {
 			hri_nvmctrl_clear_INTEN_reg(device->hw, NVMCTRL_INTFLAG_ERR);
 		}
 	}
 }
 
+/**
+ * \brief Get the flash erase block size.
+ */
+uint32_t _flash_get_block_size(struct _flash_device *const device)
+{
+	(void)device;
+	return (uint32_t)NVMCTRL_BLOCK_SIZE;
+}
+
+/**
+ * \brief Check whether the flash is ready to accept a new command.
+ */
+bool _flash_is_ready(struct _flash_device *const device)
+{
+	return hri_nvmctrl_get_STATUS_READY_bit(device->hw);
+}
+
+/**
+ * \brief Start erasing a block in the internal flash.
+ */
+void _flash_start_erase_block(struct _flash_device *const device, const uint32_t dst_addr)
+{
+	_flash_erase_block(device->hw, dst_addr & ~(NVMCTRL_BLOCK_SIZE - 1));
+}
+
+/**
+ * \brief Start programming a number of bytes inside a page without erase.
+ */
+void _flash_start_program(struct _flash_device *const device, const uint32_t dst_addr, const uint8_t *buffer,
+                          const uint32_t length)
+{
+	ASSERT(length <= NVMCTRL_PAGE_SIZE - (dst_addr & (NVMCTRL_PAGE_SIZE - 1)));
+
+	_flash_program(device->hw, dst_addr, buffer, length);
+}
+
+/**
+ * \brief Check whether the flash can be read while an address is written.
+ */
+bool _flash_is_read_while_write(struct _flash_device *const device, const uint32_t dst_addr)
+{
+	uint32_t code_addr = (uint32_t)_flash_is_read_while_write;
+
+	(void)device;
+
+	/* Code running from RAM is never stalled by the flash */
+	if (code_addr >= FLASH_ADDR + FLASH_SIZE) {
+		return true;
+	}
+
+	/* Each half of the flash is a bank, the other bank can be read */
+	return ((code_addr ^ dst_addr) & (FLASH_SIZE / 2)) != 0;
+}
+
+/**
+ * \brief Check whether the physical bank A is mapped at the flash start.
+ */
+bool _flash_is_bank_a_first(struct _flash_device *const device)
+{
+	return hri_nvmctrl_get_STATUS_AFIRST_bit(device->hw);
+}
+
+/**
+ * \brief Swap the flash banks and reset the device.
+ */
+void _flash_swap_banks(struct _flash_device *const device)
+{
+	while (!hri_nvmctrl_get_STATUS_READY_bit(device->hw)) {
+		/* Wait until this module isn't busy */
+	}
+
+	hri_nvmctrl_write_CTRLB_reg(device->hw, NVMCTRL_CTRLB_CMD_BKSWRST | NVMCTRL_CTRLB_CMDEX_KEY);
+
+	while (1) {
+		/* Wait for the reset */
+	}
+}
+
 /**
  * \internal   erase a row in flash
  * \param[in]  hw            The pointer to hardware instance
@@ -388,6 +623,8 @@ static void _flash_program(void *const hw, const uint32_t dst_addr, const uint8_
 	while (!hri_nvmctrl_get_STATUS_READY_bit(hw)) {
 		/* Wait until this module isn't busy */
 	}
+	/* Only the end of the write command has to raise the ready interrupt */
+	hri_nvmctrl_clear_INTFLAG_DONE_bit(hw);
 
 	/* Writes to the page buffer must be 32 bits, perform manual copy
 	 * to ensure alignment */
@@ -404,6 +641,180 @@ static void _flash_program(void *const hw, const uint32_t dst_addr, const uint8_
 	hri_nvmctrl_write_CTRLB_reg(hw, NVMCTRL_CTRLB_CMD_WP | NVMCTRL_CTRLB_CMDEX_KEY);
 }
 
+/**
+ * \internal   write a quad word in flash
+ * \param[in]  hw            The pointer to hardware instance
+ * \param[in]  dst_addr      Destination quad word address to write
+ * \param[in]  buffer        Pointer to the four words to write
+ */
+static void _flash_program_quad_word(void *const hw, const uint32_t dst_addr, const uint32_t *buffer)
+{
+	uint32_t nvm_address = dst_addr / 4;
+	uint8_t  i;
+
+	while (!hri_nvmctrl_get_STATUS_READY_bit(hw)) {
+		/* Wait until this module isn't busy */
+	}
+
+	hri_nvmctrl_write_CTRLB_reg(hw, NVMCTRL_CTRLB_CMD_PBC | NVMCTRL_CTRLB_CMDEX_KEY);
+
+	while (!hri_nvmctrl_get_STATUS_READY_bit(hw)) {
+		/* Wait until this module isn't busy */
+	}
+	hri_nvmctrl_clear_INTFLAG_DONE_bit(hw);
+
+	for (i = 0; i < NVMCTRL_QUAD_WORD_SIZE / 4; i++) {
+		NVM_MEMORY[nvm_address++] = buffer[i];
+	}
+
+	while (!hri_nvmctrl_get_STATUS_READY_bit(hw)) {
+		/* Wait until this module isn't busy */
+	}
+
+	hri_nvmctrl_write_ADDR_reg(hw, dst_addr);
+	hri_nvmctrl_write_CTRLB_reg(hw, NVMCTRL_CTRLB_CMD_WQW | NVMCTRL_CTRLB_CMDEX_KEY);
+}
+
+/**
+ * \internal   check whether a word aligned area only holds erased words
+ * \param[in]  ptr           Pointer to the area, in flash or in RAM
+ * \param[in]  size          The size of the area in bytes
+ */
+static bool _flash_is_erased(const uint32_t *ptr, const uint32_t size)
+{
+	uint32_t i;
+
+	for (i = 0; i < size / 4; i++) {
+		if (ptr[i] != 0xFFFFFFFF) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * \internal   erase a block and write it back merged with new data
+ *
+ * Only pages that hold programmed data after the merge are written back.
+ *
+ * \param[in]  hw            The pointer to hardware instance
+ * \param[in]  dst_addr      Destination address, inside a single block
+ * \param[in]  buffer        Pointer to the data to write
+ * \param[in]  length        The size of data to write
+ * \param[in]  scratch       Word aligned buffer holding a whole block
+ */
+static void _flash_rewrite_block(void *const hw, const uint32_t dst_addr, const uint8_t *buffer, const uint32_t length,
+                                 uint32_t *scratch)
+{
+	uint32_t block_start_addr = dst_addr & ~(NVMCTRL_BLOCK_SIZE - 1);
+	uint8_t *tmp_buffer       = (uint8_t *)scratch;
+	uint32_t i;
+
+	while (!hri_nvmctrl_get_STATUS_READY_bit(hw)) {
+		/* Wait until this module isn't busy */
+	}
+
+	/* store the block content into the scratch buffer and update it */
+	memcpy(tmp_buffer, (const uint8_t *)NVM_MEMORY + block_start_addr, NVMCTRL_BLOCK_SIZE);
+	memcpy(tmp_buffer + (dst_addr - block_start_addr), buffer, length);
+
+	_flash_erase_block(hw, block_start_addr);
+
+	/* erased pages do not need to be programmed again */
+	for (i = 0; i < NVMCTRL_BLOCK_PAGES; i++) {
+		if (!_flash_is_erased(scratch + i * NVMCTRL_PAGE_SIZE / 4, NVMCTRL_PAGE_SIZE)) {
+			_flash_program(hw, block_start_addr + i * NVMCTRL_PAGE_SIZE, tmp_buffer + i * NVMCTRL_PAGE_SIZE,
+			               NVMCTRL_PAGE_SIZE);
+		}
+	}
+}
+
+#if !CONF_NVM_STATIC_BLOCK_BUFFER
+/**
+ * \internal   erase and rewrite a block using a temporary buffer in stack
+ *
+ * Kept apart so that the block sized buffer only occupies the stack when a
+ * block really has to be erased.
+ */
+static void _flash_rewrite_block_on_stack(void *const hw, const uint32_t dst_addr, const uint8_t *buffer,
+                                          const uint32_t length)
+{
+	uint32_t tmp_buffer[NVMCTRL_BLOCK_SIZE / 4];
+
+	_flash_rewrite_block(hw, dst_addr, buffer, length, tmp_buffer);
+}
+#endif
+
+/**
+ * \internal   write a number of bytes inside a single block
+ *
+ * The flash content is compared with the new data quad word by quad word.
+ * Unchanged quad words are skipped. Changed quad words are programmed in place
+ * as long as they are still erased, the quad word is the smallest unit the ECC
+ * allows to be programmed once. If a changed quad word is already programmed,
+ * the whole block is erased and rewritten.
+ *
+ * \param[in]  device        The pointer to FLASH device instance
+ * \param[in]  dst_addr      Destination address, inside a single block
+ * \param[in]  buffer        Pointer to the data to write
+ * \param[in]  length        The size of data to write
+ */
+static void _flash_write_block(struct _flash_device *const device, const uint32_t dst_addr, const uint8_t *buffer,
+                               const uint32_t length)
+{
+	const uint8_t *nvm_addr = (const uint8_t *)NVM_MEMORY;
+	uint32_t       end_addr = dst_addr + length;
+	uint32_t       tmp_buffer[NVMCTRL_QUAD_WORD_SIZE / 4];
+	uint32_t       qw_addr, start, end;
+	bool           changed = false;
+
+	while (!hri_nvmctrl_get_STATUS_READY_bit(device->hw)) {
+		/* Wait until this module isn't busy */
+	}
+
+	for (qw_addr = dst_addr & ~(NVMCTRL_QUAD_WORD_SIZE - 1); qw_addr < end_addr; qw_addr += NVMCTRL_QUAD_WORD_SIZE) {
+		start = max(qw_addr, dst_addr);
+		end   = min(qw_addr + NVMCTRL_QUAD_WORD_SIZE, end_addr);
+
+		if (memcmp(nvm_addr + start, buffer + (start - dst_addr), end - start) == 0) {
+			continue;
+		}
+
+		if (!_flash_is_erased((const uint32_t *)(nvm_addr + qw_addr), NVMCTRL_QUAD_WORD_SIZE)) {
+			if (device->block_buffer) {
+				_flash_rewrite_block(device->hw, dst_addr, buffer, length, device->block_buffer);
+			} else {
+#if CONF_NVM_STATIC_BLOCK_BUFFER
+				_flash_rewrite_block(device->hw, dst_addr, buffer, length, _nvm_block_buffer);
+#else
+				_flash_rewrite_block_on_stack(device->hw, dst_addr, buffer, length);
+#endif
+			}
+			return;
+		}
+		changed = true;
+	}
+
+	if (!changed) {
+		return;
+	}
+
+	/* Only erased quad words are touched, program them in place */
+	for (qw_addr = dst_addr & ~(NVMCTRL_QUAD_WORD_SIZE - 1); qw_addr < end_addr; qw_addr += NVMCTRL_QUAD_WORD_SIZE) {
+		start = max(qw_addr, dst_addr);
+		end   = min(qw_addr + NVMCTRL_QUAD_WORD_SIZE, end_addr);
+
+		if (memcmp(nvm_addr + start, buffer + (start - dst_addr), end - start) == 0) {
+			continue;
+		}
+
+		memset(tmp_buffer, 0xFF, NVMCTRL_QUAD_WORD_SIZE);
+		memcpy((uint8_t *)tmp_buffer + (start - qw_addr), buffer + (start - dst_addr), end - start);
+		_flash_program_quad_word(device->hw, qw_addr, tmp_buffer);
+	}
+}
+
 /**
  * \internal NVM interrupt handler
  *
@@ -413,18 +824,19 @@ static void _nvm_interrupt_handler(struct _flash_device *device)
 {
 	void *const hw = device->hw;
 
-	if (hri_nvmctrl_get_INTFLAG_DONE_bit(hw)) {
+	/* A failed command also ends with DONE, report the error instead */
+	if (hri_nvmctrl_read_INTFLAG_reg(hw) & hri_nvmctrl_read_INTEN_reg(hw) & NVMCTRL_INTFLAG_ERR) {
+		hri_nvmctrl_clear_INTFLAG_reg(hw, NVMCTRL_INTFLAG_ERR | NVMCTRL_INTFLAG_DONE);
+
+		if (NULL != device->flash_cb.error_cb) {
+			device->flash_cb.error_cb(device);
+		}
+	} else if (hri_nvmctrl_get_INTFLAG_DONE_bit(hw)) {
 		hri_nvmctrl_clear_INTFLAG_DONE_bit(hw);
 
 		if (NULL != device->flash_cb.ready_cb) {
 			device->flash_cb.ready_cb(device);
 		}
-	} else if (hri_nvmctrl_read_INTFLAG_reg(hw) && ~NVMCTRL_INTFLAG_ERR) {
-		hri_nvmctrl_clear_INTFLAG_reg(hw, NVMCTRL_INTFLAG_ERR);
-
-		if (NULL != device->flash_cb.error_cb) {
-			device->flash_cb.error_cb(device);
-		}
 	}
 }
 
@@ -693,3 +1105,231 @@ int32_t _user_area_write_bits(void *base, const uint32_t bit_offset, const uint3
 
 	return _user_row_write_exec(_row);
 }
+
+/*
+   The SmartEEPROM emulates an EEPROM in two sectors at the end of the flash.
+   Its allocation is read from the NVM User Row at power on: SEESBLK gives the
+   number of blocks per sector and SEEPSZ the SmartEEPROM page size. The data
+   is accessed through the SmartEEPROM address window.
+ */
+#define SEE_MEMORY ((volatile uint8_t *)SEEPROM_ADDR)
+/* Both fuses live in the second user row word (NVMCTRL_USER + 4) */
+#define _NVM_USER_ROW_SEESBLK_POS (32 + NVMCTRL_FUSES_SEESBLK_Pos)
+#define _NVM_USER_ROW_SEESBLK_N_BITS 4
+#define _NVM_USER_ROW_SEEPSZ_POS (32 + NVMCTRL_FUSES_SEEPSZ_Pos)
+#define _NVM_USER_ROW_SEEPSZ_N_BITS 3
+#define _SEE_MAX_SECTOR_BLOCKS 10
+#define _SEE_MAX_PAGE_SIZE_SEL 7
+
+/**
+ * \internal Wait until the SmartEEPROM accepts a new write
+ * \param[in] hw The pointer to hardware instance
+ */
+static inline void _smart_eeprom_wait_ready(const void *const hw)
+{
+	while (hri_nvmctrl_get_SEESTAT_BUSY_bit(hw)) {
+		/* Wait until the SmartEEPROM isn't busy */
+	}
+}
+
+/**
+ * \brief Initialize SmartEEPROM.
+ */
+int32_t _smart_eeprom_init(struct _smart_eeprom_device *const device, void *const hw)
+{
+	ASSERT(device && (hw == NVMCTRL));
+
+	device->hw            = hw;
+	device->writes        = 0;
+	device->reallocations = 0;
+	device->overflows     = 0;
+
+	if (!hri_nvmctrl_read_SEESTAT_SBLK_bf(hw)) {
+		return ERR_NOT_INITIALIZED;
+	}
+
+	hri_nvmctrl_clear_INTFLAG_reg(hw, NVMCTRL_INTFLAG_SEESFULL | NVMCTRL_INTFLAG_SEESOVF | NVMCTRL_INTFLAG_SEEWRC);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Deinitialize SmartEEPROM.
+ */
+void _smart_eeprom_deinit(struct _smart_eeprom_device *const device)
+{
+	if (hri_nvmctrl_get_SEESTAT_LOAD_bit(device->hw)) {
+		_smart_eeprom_flush(device);
+	}
+	device->hw = NULL;
+}
+
+/**
+ * \brief Get the SmartEEPROM size.
+ */
+uint32_t _smart_eeprom_get_size(struct _smart_eeprom_device *const device)
+{
+	uint8_t  sblk = hri_nvmctrl_read_SEESTAT_SBLK_bf(device->hw);
+	uint32_t size = 512ul << hri_nvmctrl_read_SEESTAT_PSZ_bf(device->hw);
+	uint32_t max_size;
+
+	/* The sector size bounds the virtual size, see SmartEEPROM size table */
+	if (!sblk) {
+		return 0;
+	} else if (sblk == 1) {
+		max_size = 4096;
+	} else if (sblk == 2) {
+		max_size = 8192;
+	} else if (sblk <= 4) {
+		max_size = 16384;
+	} else if (sblk <= 8) {
+		max_size = 32768;
+	} else {
+		max_size = 65536;
+	}
+
+	return min(size, max_size);
+}
+
+/**
+ * \brief Read bytes from the SmartEEPROM.
+ */
+void _smart_eeprom_read(struct _smart_eeprom_device *const device, const uint32_t offset, uint8_t *buffer,
+                        const uint32_t length)
+{
+	uint32_t i = 0;
+
+	(void)device;
+
+	/* Word accesses when aligned, a SmartEEPROM read costs the same for
+	 * a byte or a word */
+	if (!((offset | (uint32_t)buffer) & 3)) {
+		for (; i + 4 <= length; i += 4) {
+			*(uint32_t *)(buffer + i) = *(volatile uint32_t *)(SEE_MEMORY + offset + i);
+		}
+	}
+
+	for (; i < length; i++) {
+		buffer[i] = SEE_MEMORY[offset + i];
+	}
+}
+
+/**
+ * \brief Write bytes to the SmartEEPROM.
+ */
+int32_t _smart_eeprom_write(struct _smart_eeprom_device *const device, const uint32_t offset, const uint8_t *buffer,
+                            const uint32_t length)
+{
+	void *const hw   = device->hw;
+	uint32_t    addr = offset;
+	uint32_t    end  = offset + length;
+	uint32_t    value;
+	int32_t     rc = ERR_NONE;
+
+	if (hri_nvmctrl_get_SEESTAT_LOCK_bit(hw)) {
+		return ERR_DENIED;
+	}
+
+	while (addr < end) {
+		if (!(addr & 3) && (end - addr >= 4)) {
+			memcpy(&value, buffer + (addr - offset), 4);
+			if (*(volatile uint32_t *)(SEE_MEMORY + addr) != value) {
+				_smart_eeprom_wait_ready(hw);
+				*(volatile uint32_t *)(SEE_MEMORY + addr) = value;
+				device->writes++;
+			}
+			addr += 4;
+		} else {
+			if (SEE_MEMORY[addr] != buffer[addr - offset]) {
+				_smart_eeprom_wait_ready(hw);
+				SEE_MEMORY[addr] = buffer[addr - offset];
+				device->writes++;
+			}
+			addr++;
+		}
+	}
+
+	/* Account for sector reallocations and rejected writes */
+	if (hri_nvmctrl_get_INTFLAG_SEESFULL_bit(hw)) {
+		hri_nvmctrl_clear_INTFLAG_SEESFULL_bit(hw);
+		device->reallocations++;
+	}
+	if (hri_nvmctrl_get_INTFLAG_SEESOVF_bit(hw)) {
+		hri_nvmctrl_clear_INTFLAG_SEESOVF_bit(hw);
+		device->overflows++;
+		rc = ERR_IO;
+	}
+
+	return rc;
+}
+
+/**
+ * \brief Select the SmartEEPROM write mode.
+ */
+void _smart_eeprom_set_buffered(struct _smart_eeprom_device *const device, const bool buffered)
+{
+	if (!buffered && hri_nvmctrl_get_SEESTAT_LOAD_bit(device->hw)) {
+		_smart_eeprom_flush(device);
+	}
+	_smart_eeprom_wait_ready(device->hw);
+	hri_nvmctrl_write_SEECFG_WMODE_bit(device->hw, buffered);
+}
+
+/**
+ * \brief Write the SmartEEPROM page buffer to flash.
+ */
+void _smart_eeprom_flush(struct _smart_eeprom_device *const device)
+{
+	void *const hw = device->hw;
+
+	_smart_eeprom_wait_ready(hw);
+	while (!hri_nvmctrl_get_STATUS_READY_bit(hw)) {
+		/* Wait until this module isn't busy */
+	}
+
+	hri_nvmctrl_write_CTRLB_reg(hw, NVMCTRL_CTRLB_CMD_SEEFLUSH | NVMCTRL_CTRLB_CMDEX_KEY);
+}
+
+/**
+ * \brief Check whether the SmartEEPROM is busy.
+ */
+bool _smart_eeprom_is_busy(struct _smart_eeprom_device *const device)
+{
+	return hri_nvmctrl_get_SEESTAT_BUSY_bit(device->hw);
+}
+
+/**
+ * \brief Get the SmartEEPROM sector in use.
+ */
+uint8_t _smart_eeprom_get_active_sector(struct _smart_eeprom_device *const device)
+{
+	return hri_nvmctrl_get_SEESTAT_ASEES_bit(device->hw);
+}
+
+/**
+ * \brief Get the number of flash blocks in a SmartEEPROM sector.
+ */
+uint8_t _smart_eeprom_get_sector_blocks(struct _smart_eeprom_device *const device)
+{
+	return hri_nvmctrl_read_SEESTAT_SBLK_bf(device->hw);
+}
+
+/**
+ * \brief Store the SmartEEPROM allocation in the user row.
+ */
+int32_t _smart_eeprom_configure(struct _smart_eeprom_device *const device, const uint8_t sector_blocks,
+                                const uint8_t page_size_sel)
+{
+	(void)device;
+
+	if ((sector_blocks > _SEE_MAX_SECTOR_BLOCKS) || (page_size_sel > _SEE_MAX_PAGE_SIZE_SEL)) {
+		return ERR_INVALID_ARG;
+	}
+
+	/* SEESBLK (bits 32..35) and SEEPSZ (bits 36..38) are adjacent, update them with one row write */
+	return _user_area_write_bits(
+	    (void *)_NVM_USER_ROW_BASE,
+	    _NVM_USER_ROW_SEESBLK_POS,
+	    sector_blocks | (page_size_sel << (_NVM_USER_ROW_SEEPSZ_POS - _NVM_USER_ROW_SEESBLK_POS)),
+	    (_NVM_USER_ROW_SEEPSZ_POS - _NVM_USER_ROW_SEESBLK_POS) + _NVM_USER_ROW_SEEPSZ_N_BITS);
+}
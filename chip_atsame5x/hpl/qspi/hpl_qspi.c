@@ -33,17 +33,64 @@
 
 #include <utils_assert.h>
 #include <hpl_qspi_sync.h>
+#include <hpl_qspi_dma.h>
 #include <hpl_qspi_config.h>
 
 /**
  * \brief Memory copy function.
  *
+ * The AHB window is accessed with words, four per iteration so the copy is
+ * issued as LDM/STM bursts. Bytes before the first and after the last word
+ * boundary of the AHB address are copied one at a time. The buffer side may
+ * be unaligned.
+ *
  * \param dst  Pointer to destination buffer.
  * \param src  Pointer to source buffer.
  * \param count  Bytes to be copied.
+ * \param ahb  Pointer to the AHB window side of the copy, dst or src.
  */
-static void _qspi_memcpy(uint8_t *dst, uint8_t *src, uint32_t count)
+static void _qspi_memcpy(uint8_t *dst, uint8_t *src, uint32_t count, const uint8_t *ahb)
 {
+	uint32_t head = (4 - ((uint32_t)ahb & 3)) & 3;
+
+	if (head > count) {
+		head = count;
+	}
+	count -= head;
+	while (head--) {
+		*dst++ = *src++;
+	}
+
+	if ((((uint32_t)dst | (uint32_t)src) & 3) == 0) {
+		uint32_t *      d = (uint32_t *)dst;
+		const uint32_t *s = (const uint32_t *)src;
+
+		for (; count >= 16; count -= 16) {
+			uint32_t w0 = s[0];
+			uint32_t w1 = s[1];
+			uint32_t w2 = s[2];
+			uint32_t w3 = s[3];
+
+			d[0] = w0;
+			d[1] = w1;
+			d[2] = w2;
+			d[3] = w3;
+			s += 4;
+			d += 4;
+		}
+		for (; count >= 4; count -= 4) {
+			*d++ = *s++;
+		}
+		dst = (uint8_t *)d;
+		src = (uint8_t *)s;
+	} else {
+		for (; count >= 4; count -= 4) {
+			__UNALIGNED_UINT32_WRITE(dst, __UNALIGNED_UINT32_READ(src));
+			dst += 4;
+			src += 4;
+		}
+	}
+
 	while (count--) {
 		*dst++ = *src++;
 	}
@@ -59,11 +106,14 @@ static inline void _qspi_end_transfer(void *hw)
 	hri_qspi_write_CTRLA_reg(hw, QSPI_CTRLA_ENABLE | QSPI_CTRLA_LASTXFER);
 }
 
-int32_t _qspi_sync_init(struct _qspi_sync_dev *dev, void *const hw)
+/**
+ * \brief Reset QSPI and load the configuration.
+ *
+ * \param hw  Pointer to an Qspi instance.
+ */
+static void _qspi_init_hw(void *const hw)
 {
-	ASSERT(dev && hw);
-	dev->prvt = hw;
-	hri_qspi_write_CTRLA_reg(dev->prvt, QSPI_CTRLA_SWRST);
+	hri_qspi_write_CTRLA_reg(hw, QSPI_CTRLA_SWRST);
 
 	hri_qspi_write_CTRLB_reg(hw,
 	                         QSPI_CTRLB_MODE_MEMORY | QSPI_CTRLB_CSMODE_LASTXFER | QSPI_CTRLB_DATALEN(0)
@@ -72,6 +122,33 @@ int32_t _qspi_sync_init(struct _qspi_sync_dev *dev, void *const hw)
 	hri_qspi_write_BAUD_reg(hw,
 	                        CONF_QSPI_CPOL << QSPI_BAUD_CPOL_Pos | CONF_QSPI_CPHA << QSPI_BAUD_CPHA_Pos
 	                            | QSPI_BAUD_BAUD(CONF_QSPI_BAUD_RATE) | QSPI_BAUD_DLYBS(CONF_QSPI_DLYBS));
+}
+
+/**
+ * \brief Configure scrambling of memory transfers.
+ *
+ * \param hw  Pointer to an Qspi instance.
+ * \param enable  Enable scrambling.
+ * \param device_unique  Include the device specific random value.
+ * \param key  Scrambling user key.
+ */
+static void _qspi_set_scrambling(void *const hw, const bool enable, const bool device_unique, const uint32_t key)
+{
+	if (!enable) {
+		hri_qspi_write_SCRAMBCTRL_reg(hw, 0);
+		hri_qspi_write_SCRAMBKEY_reg(hw, 0);
+		return;
+	}
+
+	hri_qspi_write_SCRAMBKEY_reg(hw, key);
+	hri_qspi_write_SCRAMBCTRL_reg(hw, QSPI_SCRAMBCTRL_ENABLE | (device_unique ? 0 : QSPI_SCRAMBCTRL_RANDOMDIS));
+}
+
+int32_t _qspi_sync_init(struct _qspi_sync_dev *dev, void *const hw)
+{
+	ASSERT(dev && hw);
+	dev->prvt = hw;
+	_qspi_init_hw(hw);
 	return ERR_NONE;
 }
 
@@ -96,9 +173,8 @@ int32_t _qspi_sync_disable(struct _qspi_sync_dev *dev)
 /**
  * \brief Set instruction frame param.
  */
-static void _qspi_sync_command_set_ifr(struct _qspi_sync_dev *dev, const struct _qspi_command *cmd)
+static void _qspi_command_set_ifr(void *hw, const struct _qspi_command *cmd)
 {
-	void *hw = dev->prvt;
 	if (cmd->inst_frame.bits.addr_en) {
 		hri_qspi_write_INSTRADDR_reg(hw, cmd->address);
 	}
@@ -130,9 +206,9 @@ static void _qspi_sync_run_transfer(struct _qspi_sync_dev *dev, const struct _qs
 	ASSERT(cmd->tx_buf || cmd->rx_buf);
 
 	if (cmd->tx_buf) {
-		_qspi_memcpy((uint8_t *)qspi_mem, (uint8_t *)cmd->tx_buf, cmd->buf_len);
+		_qspi_memcpy((uint8_t *)qspi_mem, (uint8_t *)cmd->tx_buf, cmd->buf_len, qspi_mem);
 	} else {
-		_qspi_memcpy((uint8_t *)cmd->rx_buf, (uint8_t *)qspi_mem, cmd->buf_len);
+		_qspi_memcpy((uint8_t *)cmd->rx_buf, (uint8_t *)qspi_mem, cmd->buf_len, qspi_mem);
 	}
 
 	__DSB();
@@ -141,7 +217,7 @@ static void _qspi_sync_run_transfer(struct _qspi_sync_dev *dev, const struct _qs
 
 int32_t _qspi_sync_serial_run_command(struct _qspi_sync_dev *dev, const struct _qspi_command *cmd)
 {
-	_qspi_sync_command_set_ifr(dev, cmd);
+	_qspi_command_set_ifr(dev->prvt, cmd);
 
 	if (cmd->inst_frame.bits.data_en) {
 		_qspi_sync_run_transfer(dev, cmd);
@@ -154,3 +230,224 @@ int32_t _qspi_sync_serial_run_command(struct _qspi_sync_dev *dev, const struct _
 	hri_qspi_clear_INTFLAG_INSTREND_bit(dev->prvt);
 	return ERR_NONE;
 }
+
+int32_t _qspi_sync_set_scrambling(struct _qspi_sync_dev *dev, const bool enable, const bool device_unique,
+                                   const uint32_t key)
+{
+	_qspi_set_scrambling(dev->prvt, enable, device_unique, key);
+	return ERR_NONE;
+}
+
+int32_t _qspi_sync_enable_xip(struct _qspi_sync_dev *dev, const struct _qspi_command *cmd)
+{
+	ASSERT(cmd->inst_frame.bits.tfr_type == QSPI_READMEM_ACCESS);
+
+	hri_qspi_set_CTRLB_MODE_bit(dev->prvt);
+	_qspi_command_set_ifr(dev->prvt, cmd);
+
+	/* To synchronize system bus accesses */
+	hri_qspi_read_INSTRFRAME_reg(dev->prvt);
+
+	return ERR_NONE;
+}
+
+int32_t _qspi_sync_disable_xip(struct _qspi_sync_dev *dev)
+{
+	_qspi_end_transfer(dev->prvt);
+
+	while (!hri_qspi_get_STATUS_CSSTATUS_bit(dev->prvt))
+		;
+	hri_qspi_clear_INTFLAG_INSTREND_bit(dev->prvt);
+	return ERR_NONE;
+}
+
+#if defined(CONF_QSPI_DMA_TX_CHANNEL) && defined(CONF_QSPI_DMA_RX_CHANNEL)
+
+/** QSPI DMA device, for the instruction end interrupt */
+static struct _qspi_dma_dev *_qspi_dma_dev = NULL;
+
+/**
+ * \brief Release CS, the command is completed by the instruction end interrupt.
+ */
+static void _qspi_dma_end_command(struct _qspi_dma_dev *dev)
+{
+	_qspi_end_transfer(dev->prvt);
+	hri_qspi_set_INTEN_INSTREND_bit(dev->prvt);
+}
+
+/**
+ * \brief Callback for DMA transfer done.
+ */
+static void _qspi_dma_xfer_done(struct _dma_resource *resource)
+{
+	struct _qspi_dma_dev *dev = (struct _qspi_dma_dev *)resource->back;
+
+	_qspi_dma_end_command(dev);
+}
+
+/**
+ * \brief Callback for DMA errors.
+ */
+static void _qspi_dma_error_occured(struct _dma_resource *resource)
+{
+	struct _qspi_dma_dev *dev = (struct _qspi_dma_dev *)resource->back;
+
+	dev->xfer_error = true;
+	_qspi_dma_end_command(dev);
+}
+
+/**
+ * \brief QSPI interrupt handler, the instruction has ended
+ */
+void QSPI_Handler(void)
+{
+	struct _qspi_dma_dev *dev = _qspi_dma_dev;
+
+	if (!hri_qspi_get_INTFLAG_INSTREND_bit(dev->prvt)) {
+		return;
+	}
+	hri_qspi_clear_INTEN_INSTREND_bit(dev->prvt);
+	hri_qspi_clear_INTFLAG_INSTREND_bit(dev->prvt);
+
+	if (dev->xfer_error) {
+		if (dev->cb.error) {
+			dev->cb.error(dev->xfer_resource);
+		}
+	} else if (dev->cb.xfer_done) {
+		dev->cb.xfer_done(dev->xfer_resource);
+	}
+}
+
+int32_t _qspi_dma_init(struct _qspi_dma_dev *dev, void *const hw)
+{
+	ASSERT(dev && hw);
+	dev->prvt       = hw;
+	dev->xfer_error = false;
+	_qspi_init_hw(hw);
+
+	_dma_get_channel_resource(&dev->rx_resource, CONF_QSPI_DMA_RX_CHANNEL);
+	dev->rx_resource->back                 = dev;
+	dev->rx_resource->dma_cb.transfer_done = _qspi_dma_xfer_done;
+	dev->rx_resource->dma_cb.error         = _qspi_dma_error_occured;
+
+	_dma_get_channel_resource(&dev->tx_resource, CONF_QSPI_DMA_TX_CHANNEL);
+	dev->tx_resource->back                 = dev;
+	dev->tx_resource->dma_cb.transfer_done = _qspi_dma_xfer_done;
+	dev->tx_resource->dma_cb.error         = _qspi_dma_error_occured;
+	dev->xfer_resource                     = dev->tx_resource;
+
+	_qspi_dma_dev = dev;
+	NVIC_DisableIRQ(QSPI_IRQn);
+	NVIC_ClearPendingIRQ(QSPI_IRQn);
+	NVIC_EnableIRQ(QSPI_IRQn);
+
+	return ERR_NONE;
+}
+
+int32_t _qspi_dma_deinit(struct _qspi_dma_dev *dev)
+{
+	NVIC_DisableIRQ(QSPI_IRQn);
+	NVIC_ClearPendingIRQ(QSPI_IRQn);
+	_qspi_dma_dev = NULL;
+	_dma_set_irq_state(CONF_QSPI_DMA_TX_CHANNEL, DMA_TRANSFER_COMPLETE_CB, false);
+	_dma_set_irq_state(CONF_QSPI_DMA_TX_CHANNEL, DMA_TRANSFER_ERROR_CB, false);
+	_dma_set_irq_state(CONF_QSPI_DMA_RX_CHANNEL, DMA_TRANSFER_COMPLETE_CB, false);
+	_dma_set_irq_state(CONF_QSPI_DMA_RX_CHANNEL, DMA_TRANSFER_ERROR_CB, false);
+	hri_qspi_write_CTRLA_reg(dev->prvt, QSPI_CTRLA_SWRST);
+	return ERR_NONE;
+}
+
+int32_t _qspi_dma_enable(struct _qspi_dma_dev *dev)
+{
+	hri_qspi_write_CTRLA_reg(dev->prvt, QSPI_CTRLA_ENABLE);
+	return ERR_NONE;
+}
+
+int32_t _qspi_dma_disable(struct _qspi_dma_dev *dev)
+{
+	hri_qspi_write_CTRLA_reg(dev->prvt, 0);
+	return ERR_NONE;
+}
+
+int32_t _qspi_dma_set_scrambling(struct _qspi_dma_dev *dev, const bool enable, const bool device_unique,
+                                  const uint32_t key)
+{
+	_qspi_set_scrambling(dev->prvt, enable, device_unique, key);
+	return ERR_NONE;
+}
+
+/**
+ * \brief Start the DMA copy between the buffer and the QSPI AHB window.
+ *
+ * Word beats are used when the buffer, the address and the length allow it.
+ */
+static void _qspi_dma_run_transfer(struct _qspi_dma_dev *dev, const struct _qspi_command *cmd)
+{
+	uint8_t *qspi_mem  = (uint8_t *)QSPI_AHB;
+	uint8_t  beat_size = 0;
+	uint8_t  channel;
+
+	if (cmd->inst_frame.bits.addr_en)
+		qspi_mem += cmd->address;
+
+	/* To synchronize system bus accesses */
+	hri_qspi_read_INSTRFRAME_reg(dev->prvt);
+
+	ASSERT(cmd->tx_buf || cmd->rx_buf);
+
+	if (cmd->tx_buf) {
+		channel            = CONF_QSPI_DMA_TX_CHANNEL;
+		dev->xfer_resource = dev->tx_resource;
+		if ((((uint32_t)qspi_mem | (uint32_t)cmd->tx_buf | cmd->buf_len) & 3) == 0) {
+			beat_size = 2;
+		}
+		_dma_set_source_address(channel, cmd->tx_buf);
+		_dma_set_destination_address(channel, qspi_mem);
+	} else {
+		channel            = CONF_QSPI_DMA_RX_CHANNEL;
+		dev->xfer_resource = dev->rx_resource;
+		if ((((uint32_t)qspi_mem | (uint32_t)cmd->rx_buf | cmd->buf_len) & 3) == 0) {
+			beat_size = 2;
+		}
+		_dma_set_source_address(channel, qspi_mem);
+		_dma_set_destination_address(channel, cmd->rx_buf);
+	}
+
+	_dma_srcinc_enable(channel, true);
+	_dma_dstinc_enable(channel, true);
+	_dma_set_beat_size(channel, beat_size);
+	_dma_set_data_amount(channel, cmd->buf_len >> beat_size);
+	_dma_set_irq_state(channel, DMA_TRANSFER_COMPLETE_CB, true);
+	_dma_set_irq_state(channel, DMA_TRANSFER_ERROR_CB, true);
+	_dma_enable_transaction(channel, true);
+}
+
+int32_t _qspi_dma_serial_run_command(struct _qspi_dma_dev *dev, const struct _qspi_command *cmd)
+{
+	dev->xfer_error = false;
+	hri_qspi_clear_INTFLAG_INSTREND_bit(dev->prvt);
+	_qspi_command_set_ifr(dev->prvt, cmd);
+
+	if (cmd->inst_frame.bits.data_en && cmd->buf_len) {
+		_qspi_dma_run_transfer(dev, cmd);
+		return ERR_NONE;
+	}
+
+	/* Nothing to move, end the instruction right away */
+	_qspi_dma_end_command(dev);
+	return ERR_NONE;
+}
+
+void _qspi_dma_register_callback(struct _qspi_dma_dev *dev, const enum _qspi_dma_cb_type type, _qspi_dma_cb_t cb)
+{
+	switch (type) {
+	case QSPI_DMA_CB_XFER_DONE:
+		dev->cb.xfer_done = cb;
+		break;
+	case QSPI_DMA_CB_ERROR:
+		dev->cb.error = cb;
+		break;
+	}
+}
+
+#endif
@@ -168,6 +168,9 @@ static uint8_t _sercom_get_irq_num(const void *const hw);
 static void    _sercom_init_irq_param(const void *const hw, void *dev);
 static uint8_t _sercom_get_hardware_index(const void *const hw);
 
+/** Device bound to each SERCOM instance, looked up by the interrupt handlers */
+static void *_sercom_dev[SERCOM_INST_NUM];
+
 static int32_t     _usart_init(void *const hw);
 static inline void _usart_deinit(void *const hw);
 static uint16_t    _usart_calculate_baud_rate(const uint32_t baud, const uint32_t clock_rate, const uint8_t samples,
@@ -178,6 +181,7 @@ static void        _usart_set_mode(void *const hw, const enum usart_mode mode);
 static void        _usart_set_parity(void *const hw, const enum usart_parity parity);
 static void        _usart_set_stop_bits(void *const hw, const enum usart_stop_bits stop_bits);
 static void        _usart_set_character_size(void *const hw, const enum usart_character_size size);
+static void        _usart_set_data32_mode(void *const hw, const enum usart_data32_mode mode);
 
 /**
  * \brief Initialize synchronous SERCOM USART
@@ -379,6 +383,40 @@ void _usart_async_set_character_size(struct _usart_async_device *const device, c
 	_usart_set_character_size(device->hw, size);
 }
 
+/**
+ * \brief Set 32-bit data extension mode
+ */
+void _usart_sync_set_data32_mode(struct _usart_sync_device *const device, const enum usart_data32_mode mode)
+{
+	_usart_set_data32_mode(device->hw, mode);
+}
+
+/**
+ * \brief Set 32-bit data extension mode
+ */
+void _usart_async_set_data32_mode(struct _usart_async_device *const device, const enum usart_data32_mode mode)
+{
+	_usart_set_data32_mode(device->hw, mode);
+}
+
+/**
+ * \brief Retrieve 32-bit data extension mode
+ */
+enum usart_data32_mode _usart_sync_get_data32_mode(const struct _usart_sync_device *const device)
+{
+	return (enum usart_data32_mode)hri_sercomusart_read_CTRLC_DATA32B_bf(device->hw);
+}
+
+/**
+ * \brief Set data length counter
+ */
+void _usart_sync_set_data_length(struct _usart_sync_device *const device, const enum usart_data_length_mode mode,
+                                 const uint8_t length)
+{
+	hri_sercomusart_write_LENGTH_reg(device->hw, SERCOM_USART_LENGTH_LENEN(mode) | SERCOM_USART_LENGTH_LEN(length));
+	hri_sercomusart_wait_for_sync(device->hw, SERCOM_USART_SYNCBUSY_LENGTH);
+}
+
 /**
  * \brief Retrieve SERCOM usart status
  */
@@ -419,6 +457,22 @@ uint8_t _usart_sync_read_byte(const struct _usart_sync_device *const device)
 	return hri_sercomusart_read_DATA_reg(device->hw);
 }
 
+/**
+ * \brief Write four packed characters to the given SERCOM USART instance
+ */
+void _usart_sync_write_word(struct _usart_sync_device *const device, uint32_t data)
+{
+	hri_sercomusart_write_DATA_reg(device->hw, data);
+}
+
+/**
+ * \brief Read four packed characters from the given SERCOM USART instance
+ */
+uint32_t _usart_sync_read_word(const struct _usart_sync_device *const device)
+{
+	return hri_sercomusart_read_DATA_reg(device->hw);
+}
+
 /**
  * \brief Check if USART is ready to send next byte
  */
@@ -589,6 +643,7 @@ static uint8_t _get_sercom_index(const void *const hw)
  */
 static void _sercom_init_irq_param(const void *const hw, void *dev)
 {
+	_sercom_dev[_sercom_get_hardware_index(hw)] = dev;
 }
 
 /**
@@ -797,6 +852,28 @@ static void _usart_set_character_size(void *const hw, const enum usart_character
 	}
 }
 
+/**
+ * \internal Set 32-bit data extension mode
+ *
+ * \param[in] device The pointer to USART device instance
+ * \param[in] mode The 32-bit data extension mode to set
+ */
+static void _usart_set_data32_mode(void *const hw, const enum usart_data32_mode mode)
+{
+	bool enabled = hri_sercomusart_get_CTRLA_ENABLE_bit(hw);
+
+	hri_sercomusart_clear_CTRLA_ENABLE_bit(hw);
+
+	CRITICAL_SECTION_ENTER()
+	hri_sercomusart_wait_for_sync(hw, SERCOM_USART_SYNCBUSY_ENABLE);
+	hri_sercomusart_write_CTRLC_DATA32B_bf(hw, mode);
+	CRITICAL_SECTION_LEAVE()
+
+	if (enabled) {
+		hri_sercomusart_set_CTRLA_ENABLE_bit(hw);
+	}
+}
+
 	/* Sercom I2C implementation */
 
 #ifndef CONF_SERCOM_0_I2CM_ENABLE
@@ -829,6 +906,10 @@ static void _usart_set_character_size(void *const hw, const enum usart_character
 	(CONF_SERCOM_0_I2CM_ENABLE + CONF_SERCOM_1_I2CM_ENABLE + CONF_SERCOM_2_I2CM_ENABLE + CONF_SERCOM_3_I2CM_ENABLE     \
 	 + CONF_SERCOM_4_I2CM_ENABLE + CONF_SERCOM_5_I2CM_ENABLE + CONF_SERCOM_6_I2CM_ENABLE + CONF_SERCOM_7_I2CM_ENABLE)
 
+#ifndef SERCOM_I2CM_CTRLA_MODE_I2C_MASTER
+#define SERCOM_I2CM_CTRLA_MODE_I2C_MASTER (5 << 2)
+#endif
+
 /**
  * \brief Macro is used to fill i2cm configuration structure based on
  * its number
@@ -862,6 +943,9 @@ static void _usart_set_character_size(void *const hw, const enum usart_character
 #define TEN_ADDR_MASK 0x3ff
 #define SEVEN_ADDR_MASK 0x7f
 
+/** Highest SCL frequency in KHz for each speed mode, indexed by CTRLA.SPEED */
+static const uint16_t _i2c_m_max_baudrate[] = {400, 1000, 3400};
+
 /**
  * \brief SERCOM I2CM configuration type
  */
@@ -1034,6 +1118,90 @@ static inline int32_t _sercom_i2c_sync_analyse_flags(void *const hw, uint32_t fl
 	return I2C_OK;
 }
 
+/**
+ * \internal Set baudrate of master
+ *
+ * \param[in] service The pointer to i2c service
+ * \param[in] hw The pointer to hardware instance
+ * \param[in] baudrate The baud rate desired for i2c master, in KHz
+ */
+static int32_t _i2c_m_set_baudrate(struct _i2c_m_service *const service, void *const hw, uint32_t baudrate)
+{
+	int32_t  tmp;
+	uint32_t clkrate;
+
+	if (hri_sercomi2cm_get_CTRLA_ENABLE_bit(hw)) {
+		return ERR_DENIED;
+	}
+
+	clkrate = _i2cms[_get_i2cm_index(hw)].clk / 1000;
+
+	if (service->mode > I2C_HIGHSPEED_MODE || baudrate == 0 || baudrate > _i2c_m_max_baudrate[service->mode]) {
+		return ERR_INVALID_ARG;
+	}
+
+	if (service->mode == I2C_HIGHSPEED_MODE) {
+		/* The master code keeps using BAUD.BAUD, only the high-speed rate is set here */
+		tmp = (int32_t)((clkrate - 2 * baudrate) / (2 * baudrate));
+		if (tmp < 0 || tmp > 0xFF) {
+			return ERR_INVALID_ARG;
+		}
+		hri_sercomi2cm_write_BAUD_HSBAUD_bf(hw, tmp);
+		hri_sercomi2cm_write_BAUD_HSBAUDLOW_bf(hw, 0);
+	} else {
+		tmp = (int32_t)((clkrate - 10 * baudrate - baudrate * clkrate * (service->trise * 0.000000001))
+		                / (2 * baudrate));
+		if (tmp < 0 || tmp > 0xFF) {
+			return ERR_INVALID_ARG;
+		}
+		hri_sercomi2cm_write_BAUD_BAUD_bf(hw, tmp);
+		hri_sercomi2cm_write_BAUD_BAUDLOW_bf(hw, 0);
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \internal Set speed mode of master
+ *
+ * \param[in] service The pointer to i2c service
+ * \param[in] hw The pointer to hardware instance
+ * \param[in] mode The speed mode
+ */
+static int32_t _i2c_m_set_speed_mode(struct _i2c_m_service *const service, void *const hw, const uint16_t mode)
+{
+	if (hri_sercomi2cm_get_CTRLA_ENABLE_bit(hw)) {
+		return ERR_DENIED;
+	}
+
+	if (mode > I2C_HIGHSPEED_MODE) {
+		return ERR_INVALID_ARG;
+	}
+
+	hri_sercomi2cm_write_CTRLA_SPEED_bf(hw, mode);
+	/* SCL clock stretching after ACK is mandatory in high-speed mode,
+	 * the other modes keep the configured stretch mode */
+	if (mode == I2C_HIGHSPEED_MODE) {
+		hri_sercomi2cm_set_CTRLA_SCLSM_bit(hw);
+	} else {
+		hri_sercomi2cm_write_CTRLA_SCLSM_bit(hw, (_i2cms[_get_i2cm_index(hw)].ctrl_a & SERCOM_I2CM_CTRLA_SCLSM) != 0);
+	}
+	service->mode = mode;
+
+	return ERR_NONE;
+}
+
+/**
+ * \internal ADDR.HS value for the given message
+ *
+ * \param[in] service The pointer to i2c service
+ * \param[in] msg The pointer to i2c message
+ */
+static inline uint32_t _i2c_m_addr_hs(const struct _i2c_m_service *const service, const struct _i2c_m_msg *const msg)
+{
+	return (service->mode == I2C_HIGHSPEED_MODE && !(msg->flags & I2C_M_NO_HS)) ? SERCOM_I2CM_ADDR_HS : 0;
+}
+
 /**
  * \brief Enable the i2c master module
  *
@@ -1043,6 +1211,11 @@ int32_t _i2c_m_async_enable(struct _i2c_m_async_device *const i2c_dev)
 {
 	ASSERT(i2c_dev);
 
+	uint8_t irq = _sercom_get_irq_num(i2c_dev->hw);
+	for (uint32_t i = 0; i < 4; i++) {
+		NVIC_EnableIRQ((IRQn_Type)irq++);
+	}
+
 	return _i2c_m_enable_implementation(i2c_dev->hw);
 }
 
@@ -1058,7 +1231,10 @@ int32_t _i2c_m_async_disable(struct _i2c_m_async_device *const i2c_dev)
 	ASSERT(i2c_dev);
 	ASSERT(i2c_dev->hw);
 
-	NVIC_DisableIRQ((IRQn_Type)_sercom_get_irq_num(hw));
+	uint8_t irq = _sercom_get_irq_num(hw);
+	for (uint32_t i = 0; i < 4; i++) {
+		NVIC_DisableIRQ((IRQn_Type)irq++);
+	}
 	hri_sercomi2cm_clear_CTRLA_ENABLE_bit(hw);
 
 	return ERR_NONE;
@@ -1073,33 +1249,20 @@ int32_t _i2c_m_async_disable(struct _i2c_m_async_device *const i2c_dev)
  */
 int32_t _i2c_m_async_set_baudrate(struct _i2c_m_async_device *const i2c_dev, uint32_t clkrate, uint32_t baudrate)
 {
-	uint32_t tmp;
-	void *   hw = i2c_dev->hw;
-
-	if (hri_sercomi2cm_get_CTRLA_ENABLE_bit(hw)) {
-		return ERR_DENIED;
-	}
-
-	tmp     = _get_i2cm_index(hw);
-	clkrate = _i2cms[tmp].clk / 1000;
+	return _i2c_m_set_baudrate(&i2c_dev->service, i2c_dev->hw, baudrate);
+}
 
-	if (i2c_dev->service.mode == I2C_STANDARD_MODE) {
-		tmp = (uint32_t)((clkrate - 10 * baudrate - baudrate * clkrate * (i2c_dev->service.trise * 0.000000001))
-		                 / (2 * baudrate));
-		hri_sercomi2cm_write_BAUD_BAUD_bf(hw, tmp);
-	} else if (i2c_dev->service.mode == I2C_FASTMODE) {
-		tmp = (uint32_t)((clkrate - 10 * baudrate - baudrate * clkrate * (i2c_dev->service.trise * 0.000000001))
-		                 / (2 * baudrate));
-		hri_sercomi2cm_write_BAUD_BAUD_bf(hw, tmp);
-	} else if (i2c_dev->service.mode == I2C_HIGHSPEED_MODE) {
-		tmp = (clkrate - 2 * baudrate) / (2 * baudrate);
-		hri_sercomi2cm_write_BAUD_HSBAUD_bf(hw, tmp);
-	} else {
-		/* error baudrate */
-		return ERR_INVALID_ARG;
-	}
+/**
+ * \brief Set speed mode of master
+ *
+ * \param[in] i2c_dev The pointer to i2c device
+ * \param[in] mode The speed mode
+ */
+int32_t _i2c_m_async_set_speed_mode(struct _i2c_m_async_device *const i2c_dev, const uint16_t mode)
+{
+	ASSERT(i2c_dev);
 
-	return ERR_NONE;
+	return _i2c_m_set_speed_mode(&i2c_dev->service, i2c_dev->hw, mode);
 }
 
 /**
@@ -1181,11 +1344,11 @@ static int32_t _sercom_i2c_send_address(struct _i2c_m_async_device *const i2c_de
 
 		hri_sercomi2cm_write_ADDR_reg(hw,
 		                              ((msg->addr & TEN_ADDR_MASK) << 1) | SERCOM_I2CM_ADDR_TENBITEN
-		                                  | (hri_sercomi2cm_read_ADDR_reg(hw) & SERCOM_I2CM_ADDR_HS));
+		                                  | _i2c_m_addr_hs(&i2c_dev->service, msg));
 	} else {
 		hri_sercomi2cm_write_ADDR_reg(hw,
 		                              ((msg->addr & SEVEN_ADDR_MASK) << 1) | (msg->flags & I2C_M_RD ? I2C_M_RD : 0x0)
-		                                  | (hri_sercomi2cm_read_ADDR_reg(hw) & SERCOM_I2CM_ADDR_HS));
+		                                  | _i2c_m_addr_hs(&i2c_dev->service, msg));
 	}
 
 	return ERR_NONE;
@@ -1294,6 +1457,59 @@ int32_t _i2c_m_async_get_bytes_left(struct _i2c_m_async_device *const i2c_dev)
 	return 0;
 }
 
+/**
+ * \internal Sercom i2c master interrupt handler
+ *
+ * \param[in] i2c_dev The pointer to i2c device
+ */
+static void _sercom_i2c_m_irq_handler(struct _i2c_m_async_device *i2c_dev)
+{
+	void *             hw    = i2c_dev->hw;
+	struct _i2c_m_msg *msg   = &i2c_dev->service.msg;
+	uint32_t           flags = hri_sercomi2cm_read_INTFLAG_reg(hw);
+	int32_t            ret;
+
+	ASSERT(i2c_dev);
+	ASSERT(i2c_dev->hw);
+
+	if (flags & ERROR_FLAG) {
+		hri_sercomi2cm_clear_STATUS_reg(hw, SERCOM_I2CM_STATUS_BUSERR | SERCOM_I2CM_STATUS_ARBLOST);
+		hri_sercomi2cm_clear_interrupt_ERROR_bit(hw);
+		hri_sercomi2cm_clear_interrupt_MB_bit(hw);
+		hri_sercomi2cm_clear_interrupt_SB_bit(hw);
+		ret = I2C_ERR_BUS;
+	} else {
+		ret = _sercom_i2c_sync_analyse_flags(hw, flags, msg);
+	}
+
+	/* A NACK on the last byte written still completes the message */
+	if (ret == I2C_NACK && (flags & MB_FLAG) && !(msg->flags & I2C_M_FAIL)) {
+		ret = I2C_OK;
+	}
+
+	if (ret != I2C_OK) {
+		msg->flags &= ~I2C_M_BUSY;
+		if (i2c_dev->cb.error) {
+			i2c_dev->cb.error(i2c_dev, ret);
+		}
+		return;
+	}
+
+	if (msg->flags & I2C_M_BUSY) {
+		return;
+	}
+
+	if (flags & MB_FLAG) {
+		if (i2c_dev->cb.tx_complete) {
+			i2c_dev->cb.tx_complete(i2c_dev);
+		}
+	} else if (flags & SB_FLAG) {
+		if (i2c_dev->cb.rx_complete) {
+			i2c_dev->cb.rx_complete(i2c_dev);
+		}
+	}
+}
+
 /**
  * \brief Initialize sercom i2c module to use in sync mode
  *
@@ -1361,33 +1577,20 @@ int32_t _i2c_m_sync_disable(struct _i2c_m_sync_device *const i2c_dev)
  */
 int32_t _i2c_m_sync_set_baudrate(struct _i2c_m_sync_device *const i2c_dev, uint32_t clkrate, uint32_t baudrate)
 {
-	uint32_t tmp;
-	void *   hw = i2c_dev->hw;
-
-	if (hri_sercomi2cm_get_CTRLA_ENABLE_bit(hw)) {
-		return ERR_DENIED;
-	}
-
-	tmp     = _get_i2cm_index(hw);
-	clkrate = _i2cms[tmp].clk / 1000;
+	return _i2c_m_set_baudrate(&i2c_dev->service, i2c_dev->hw, baudrate);
+}
 
-	if (i2c_dev->service.mode == I2C_STANDARD_MODE) {
-		tmp = (uint32_t)((clkrate - 10 * baudrate - baudrate * clkrate * (i2c_dev->service.trise * 0.000000001))
-		                 / (2 * baudrate));
-		hri_sercomi2cm_write_BAUD_BAUD_bf(hw, tmp);
-	} else if (i2c_dev->service.mode == I2C_FASTMODE) {
-		tmp = (uint32_t)((clkrate - 10 * baudrate - baudrate * clkrate * (i2c_dev->service.trise * 0.000000001))
-		                 / (2 * baudrate));
-		hri_sercomi2cm_write_BAUD_BAUD_bf(hw, tmp);
-	} else if (i2c_dev->service.mode == I2C_HIGHSPEED_MODE) {
-		tmp = (clkrate - 2 * baudrate) / (2 * baudrate);
-		hri_sercomi2cm_write_BAUD_HSBAUD_bf(hw, tmp);
-	} else {
-		/* error baudrate */
-		return ERR_INVALID_ARG;
-	}
+/**
+ * \brief Set speed mode of master
+ *
+ * \param[in] i2c_dev The pointer to i2c device
+ * \param[in] mode The speed mode
+ */
+int32_t _i2c_m_sync_set_speed_mode(struct _i2c_m_sync_device *const i2c_dev, const uint16_t mode)
+{
+	ASSERT(i2c_dev);
 
-	return ERR_NONE;
+	return _i2c_m_set_speed_mode(&i2c_dev->service, i2c_dev->hw, mode);
 }
 
 /**
@@ -1458,11 +1661,11 @@ static int32_t _sercom_i2c_sync_send_address(struct _i2c_m_sync_device *const i2
 
 		hri_sercomi2cm_write_ADDR_reg(hw,
 		                              ((msg->addr & TEN_ADDR_MASK) << 1) | SERCOM_I2CM_ADDR_TENBITEN
-		                                  | (hri_sercomi2cm_read_ADDR_reg(hw) & SERCOM_I2CM_ADDR_HS));
+		                                  | _i2c_m_addr_hs(&i2c_dev->service, msg));
 	} else {
 		hri_sercomi2cm_write_ADDR_reg(hw,
 		                              ((msg->addr & SEVEN_ADDR_MASK) << 1) | (msg->flags & I2C_M_RD ? I2C_M_RD : 0x0)
-		                                  | (hri_sercomi2cm_read_ADDR_reg(hw) & SERCOM_I2CM_ADDR_HS));
+		                                  | _i2c_m_addr_hs(&i2c_dev->service, msg));
 	}
 
 	_sercom_i2c_sync_wait_bus(i2c_dev, &flags);
@@ -1642,6 +1845,10 @@ static int32_t _i2c_m_sync_init_impl(struct _i2c_m_service *const service, void
  */
 #define I2CS_7BIT_ADDRESSING_MASK 0x7F
 
+#ifndef SERCOM_I2CM_CTRLA_MODE_I2C_SLAVE
+#define SERCOM_I2CM_CTRLA_MODE_I2C_SLAVE (4 << 2)
+#endif
+
 static int32_t     _i2c_s_init(void *const hw);
 static int8_t      _get_i2c_s_index(const void *const hw);
 static inline void _i2c_s_deinit(void *const hw);
@@ -1909,6 +2116,69 @@ int32_t _i2c_s_async_abort_transmission(const struct _i2c_s_async_device *const
 	return ERR_NONE;
 }
 
+/**
+ * \brief Retrieve the address of the data register
+ */
+void *_i2c_s_async_get_data_address(const struct _i2c_s_async_device *const device)
+{
+	return (void *)&((Sercom *)device->hw)->I2CS.DATA.reg;
+}
+
+/**
+ * \brief Enable/disable automatic acknowledge of the slave address
+ */
+int32_t _i2c_s_async_set_auto_address_ack(struct _i2c_s_async_device *const device, const bool state)
+{
+	if (hri_sercomi2cs_get_CTRLA_ENABLE_bit(device->hw)) {
+		return ERR_DENIED;
+	}
+
+	hri_sercomi2cs_write_CTRLB_AACKEN_bit(device->hw, state);
+
+	return ERR_NONE;
+}
+
+/**
+ * \internal Sercom i2c slave interrupt handler
+ *
+ * \param[in] device The pointer to i2c slave device
+ */
+static void _sercom_i2c_s_irq_handler(struct _i2c_s_async_device *device)
+{
+	void *   hw    = device->hw;
+	uint32_t flags = hri_sercomi2cs_read_INTFLAG_reg(hw) & hri_sercomi2cs_read_INTEN_reg(hw);
+
+	if (flags & SERCOM_I2CS_INTFLAG_ERROR) {
+		hri_sercomi2cs_clear_INTFLAG_reg(hw, SERCOM_I2CS_INTFLAG_ERROR);
+		if (device->cb.error) {
+			device->cb.error(device);
+		}
+	} else if (flags & SERCOM_I2CS_INTFLAG_AMATCH) {
+		if (device->cb.addr_match) {
+			device->cb.addr_match(device, hri_sercomi2cs_get_STATUS_DIR_bit(hw));
+		}
+		/* Clearing the flag acknowledges the address */
+		hri_sercomi2cs_clear_CTRLB_ACKACT_bit(hw);
+		hri_sercomi2cs_clear_INTFLAG_reg(hw, SERCOM_I2CS_INTFLAG_AMATCH);
+	} else if (flags & SERCOM_I2CS_INTFLAG_DRDY) {
+		if (hri_sercomi2cs_get_STATUS_DIR_bit(hw)) {
+			if (device->cb.tx) {
+				device->cb.tx(device);
+			}
+		} else {
+			uint8_t data = hri_sercomi2cs_read_DATA_reg(hw);
+			if (device->cb.rx_done) {
+				device->cb.rx_done(device, data);
+			}
+		}
+	} else if (flags & SERCOM_I2CS_INTFLAG_PREC) {
+		hri_sercomi2cs_clear_INTFLAG_reg(hw, SERCOM_I2CS_INTFLAG_PREC);
+		if (device->cb.stop) {
+			device->cb.stop(device);
+		}
+	}
+}
+
 /**
  * \brief Enable/disable I2C slave interrupt
  */
@@ -1921,6 +2191,10 @@ int32_t _i2c_s_async_set_irq_state(struct _i2c_s_async_device *const device, con
 		hri_sercomi2cs_write_INTEN_DRDY_bit(device->hw, state);
 	} else if (I2C_S_DEVICE_ERROR == type) {
 		hri_sercomi2cs_write_INTEN_ERROR_bit(device->hw, state);
+	} else if (I2C_S_DEVICE_ADDR_MATCH == type) {
+		hri_sercomi2cs_write_INTEN_AMATCH_bit(device->hw, state);
+	} else if (I2C_S_DEVICE_STOP == type) {
+		hri_sercomi2cs_write_INTEN_PREC_bit(device->hw, state);
 	}
 
 	return ERR_NONE;
@@ -2020,8 +2294,15 @@ static int32_t _i2c_s_set_address(void *const hw, const uint16_t address)
 #define SERCOM_USART_CTRLA_MODE_SPI_SLAVE (2 << 2)
 #endif
 
+#ifndef SERCOM_USART_CTRLA_MODE_SPI_MASTER
+#define SERCOM_USART_CTRLA_MODE_SPI_MASTER (3 << 2)
+#endif
+
 #define SPI_DEV_IRQ_MODE 0x8000
 
+/** Characters in flight in pipelined mode, limited by the 2-level RX FIFO. */
+#define SPI_PIPELINE_DEPTH 2
+
 #define _SPI_CS_PORT_EXTRACT(cs) (((cs) >> 0) & 0xFF)
 #define _SPI_CS_PIN_EXTRACT(cs) (((cs) >> 8) & 0xFF)
 
@@ -2302,6 +2583,30 @@ static int32_t _spi_set_data_order(void *const hw, const enum spi_data_order dor
 	return ERR_NONE;
 }
 
+/** \internal Set SERCOM SPI 32-bit data extension
+ *
+ * \param[in] hw Pointer to the hardware register base.
+ * \param[in] enable True to enable 32-bit data extension
+ *
+ * \return Setting 32-bit data extension status
+ */
+static int32_t _spi_set_data32(void *const hw, const bool enable)
+{
+	if (hri_sercomspi_get_CTRLA_ENABLE_bit(hw)) {
+		return ERR_DENIED;
+	}
+
+	if (hri_sercomspi_is_syncing(hw, SERCOM_SPI_SYNCBUSY_SWRST)) {
+		return ERR_BUSY;
+	}
+
+	hri_sercomspi_write_CTRLC_DATA32B_bit(hw, enable);
+	hri_sercomspi_write_LENGTH_reg(hw, 0);
+	hri_sercomspi_wait_for_sync(hw, SERCOM_SPI_SYNCBUSY_LENGTH);
+
+	return ERR_NONE;
+}
+
 /** \brief Load SERCOM registers to init for SPI master mode
  *  The settings will be applied with default master mode, unsupported things
  *  are ignored.
@@ -2609,6 +2914,26 @@ int32_t _spi_m_sync_set_data_order(struct _spi_m_sync_dev *dev, const enum spi_d
 	return _spi_set_data_order(dev->prvt, dord);
 }
 
+int32_t _spi_m_sync_set_pipelined(struct _spi_m_sync_dev *dev, const bool enable)
+{
+	ASSERT(dev && dev->prvt);
+
+	dev->pipelined = enable;
+
+	return ERR_NONE;
+}
+
+int32_t _spi_m_sync_set_data32(struct _spi_m_sync_dev *dev, const bool enable)
+{
+	ASSERT(dev && dev->prvt);
+
+	if (enable && dev->char_size > 1) {
+		return ERR_INVALID_ARG;
+	}
+
+	return _spi_set_data32(dev->prvt, enable);
+}
+
 int32_t _spi_m_async_set_data_order(struct _spi_async_dev *dev, const enum spi_data_order dord)
 {
 	ASSERT(dev && dev->prvt);
@@ -2714,11 +3039,98 @@ static inline int32_t _spi_err_check(const uint32_t iflag, void *const hw)
 	return ERR_NONE;
 }
 
+/** Pack up to four characters of the TX buffer into one 32-bit data word. */
+static inline uint32_t _spi_data32_pack(struct _spi_trans_ctrl *ctrl, const uint8_t n, const uint16_t dummy)
+{
+	uint32_t data = 0;
+	uint8_t  i;
+
+	for (i = 0; i < n; i++) {
+		data |= (uint32_t)(ctrl->txbuf ? *ctrl->txbuf++ : (uint8_t)dummy) << (i * 8);
+	}
+
+	return data;
+}
+
+/** Unpack up to four characters of one 32-bit data word into the RX buffer. */
+static inline void _spi_data32_unpack(struct _spi_trans_ctrl *ctrl, const uint8_t n, uint32_t data)
+{
+	uint8_t i;
+
+	if (!ctrl->rxbuf) {
+		return;
+	}
+	for (i = 0; i < n; i++) {
+		*ctrl->rxbuf++ = (uint8_t)(data >> (i * 8));
+	}
+}
+
+/** Transfer a message with 32-bit data extension, four characters per access.
+ *  Whole words are exchanged with the LENGTH counter disabled, the one to three
+ *  remaining characters are exchanged as one word with LENGTH limiting the
+ *  final access.
+ */
+static int32_t _spi_m_sync_trans_data32(void *const hw, const struct spi_msg *msg, const uint16_t dummy,
+                                        const uint8_t depth)
+{
+	struct _spi_trans_ctrl ctrl  = {msg->txbuf, msg->rxbuf, 0, 0, 1};
+	uint32_t               words = msg->size >> 2;
+	uint8_t                tail  = msg->size & 0x3;
+	uint32_t               iflag;
+	int32_t                rc;
+
+	while (ctrl.rxcnt < words) {
+		iflag = hri_sercomspi_read_INTFLAG_reg(hw);
+
+		if (iflag & SERCOM_SPI_INTFLAG_RXC) {
+			_spi_data32_unpack(&ctrl, 4, hri_sercomspi_read_DATA_reg(hw));
+			ctrl.rxcnt++;
+		} else if ((iflag & SERCOM_SPI_INTFLAG_DRE) && ctrl.txcnt < words && ctrl.txcnt - ctrl.rxcnt < depth) {
+			hri_sercomspi_write_DATA_reg(hw, _spi_data32_pack(&ctrl, 4, dummy));
+			ctrl.txcnt++;
+		}
+
+		rc = _spi_err_check(iflag, hw);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	if (tail) {
+		hri_sercomspi_write_LENGTH_reg(hw, SERCOM_SPI_LENGTH_LENEN | SERCOM_SPI_LENGTH_LEN(tail));
+		hri_sercomspi_wait_for_sync(hw, SERCOM_SPI_SYNCBUSY_LENGTH);
+
+		while (!hri_sercomspi_get_INTFLAG_reg(hw, SERCOM_SPI_INTFLAG_DRE)) {
+			;
+		}
+		hri_sercomspi_write_DATA_reg(hw, _spi_data32_pack(&ctrl, tail, dummy));
+
+		do {
+			iflag = hri_sercomspi_read_INTFLAG_reg(hw);
+			rc    = _spi_err_check(iflag, hw);
+		} while (!(iflag & SERCOM_SPI_INTFLAG_RXC) && rc == ERR_NONE);
+
+		if (rc == ERR_NONE) {
+			_spi_data32_unpack(&ctrl, tail, hri_sercomspi_read_DATA_reg(hw));
+		}
+
+		hri_sercomspi_write_LENGTH_reg(hw, 0);
+		hri_sercomspi_wait_for_sync(hw, SERCOM_SPI_SYNCBUSY_LENGTH);
+
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return msg->size;
+}
+
 int32_t _spi_m_sync_trans(struct _spi_m_sync_dev *dev, const struct spi_msg *msg)
 {
-	void *                 hw   = dev->prvt;
-	int32_t                rc   = 0;
-	struct _spi_trans_ctrl ctrl = {msg->txbuf, msg->rxbuf, 0, 0, dev->char_size};
+	void *                 hw    = dev->prvt;
+	int32_t                rc    = 0;
+	struct _spi_trans_ctrl ctrl  = {msg->txbuf, msg->rxbuf, 0, 0, dev->char_size};
+	uint8_t                depth = dev->pipelined ? SPI_PIPELINE_DEPTH : 1;
 
 	ASSERT(dev && hw);
 
@@ -2733,13 +3145,21 @@ int32_t _spi_m_sync_trans(struct _spi_m_sync_dev *dev, const struct spi_msg *msg
 		return ERR_NOT_INITIALIZED;
 	}
 
+	if (hri_sercomspi_get_CTRLC_DATA32B_bit(hw)) {
+		rc = _spi_m_sync_trans_data32(hw, msg, dev->dummy_byte, depth);
+		_spi_wait_bus_idle(hw);
+
+		return rc;
+	}
+
 	for (;;) {
 		uint32_t iflag = hri_sercomspi_read_INTFLAG_reg(hw);
 
 		if (!_spi_rx_check_and_receive(hw, iflag, &ctrl)) {
 			/* In master mode, do not start next byte before previous byte received
-			 * to make better output waveform */
-			if (ctrl.rxcnt >= ctrl.txcnt) {
+			 * to make better output waveform, unless pipelining is enabled, then
+			 * keep the data register loaded as long as the RX FIFO has room */
+			if (ctrl.txcnt < msg->size && ctrl.txcnt - ctrl.rxcnt < depth) {
 				_spi_tx_check_and_send(hw, iflag, &ctrl, dev->dummy_byte);
 			}
 		}
@@ -2957,3 +3377,135 @@ void _spi_s_async_set_irq_state(struct _spi_async_dev *const device, const enum
 {
 	_spi_m_async_set_irq_state(device, type, state);
 }
+
+/**
+ * \internal SERCOM SPI master interrupt handler
+ *
+ * \param[in] dev The pointer to SPI device instance
+ */
+static void _spi_m_irq_handler(struct _spi_async_dev *dev)
+{
+	void *                      hw = dev->prvt;
+	hri_sercomspi_intflag_reg_t st;
+
+	st = hri_sercomspi_read_INTFLAG_reg(hw);
+	st &= hri_sercomspi_read_INTEN_reg(hw);
+
+	if (st & SERCOM_SPI_INTFLAG_DRE) {
+		dev->callbacks.tx(dev);
+	} else if (st & SERCOM_SPI_INTFLAG_RXC) {
+		dev->callbacks.rx(dev);
+	} else if (st & SERCOM_SPI_INTFLAG_TXC) {
+		hri_sercomspi_clear_INTFLAG_reg(hw, SERCOM_SPI_INTFLAG_TXC);
+		dev->callbacks.complete(dev);
+	} else if (st & SERCOM_SPI_INTFLAG_ERROR) {
+		hri_sercomspi_clear_STATUS_reg(hw, SERCOM_SPI_STATUS_BUFOVF);
+		hri_sercomspi_clear_INTFLAG_reg(hw, SERCOM_SPI_INTFLAG_ERROR);
+		dev->callbacks.err(dev, ERR_OVERFLOW);
+	}
+}
+
+	/* Sercom interrupt handlers */
+
+#ifndef CONF_SERCOM_0_IRQ_HANDLER_ENABLE
+#define CONF_SERCOM_0_IRQ_HANDLER_ENABLE 0
+#endif
+#ifndef CONF_SERCOM_1_IRQ_HANDLER_ENABLE
+#define CONF_SERCOM_1_IRQ_HANDLER_ENABLE 0
+#endif
+#ifndef CONF_SERCOM_2_IRQ_HANDLER_ENABLE
+#define CONF_SERCOM_2_IRQ_HANDLER_ENABLE 0
+#endif
+#ifndef CONF_SERCOM_3_IRQ_HANDLER_ENABLE
+#define CONF_SERCOM_3_IRQ_HANDLER_ENABLE 0
+#endif
+#ifndef CONF_SERCOM_4_IRQ_HANDLER_ENABLE
+#define CONF_SERCOM_4_IRQ_HANDLER_ENABLE 0
+#endif
+#ifndef CONF_SERCOM_5_IRQ_HANDLER_ENABLE
+#define CONF_SERCOM_5_IRQ_HANDLER_ENABLE 0
+#endif
+#ifndef CONF_SERCOM_6_IRQ_HANDLER_ENABLE
+#define CONF_SERCOM_6_IRQ_HANDLER_ENABLE 0
+#endif
+#ifndef CONF_SERCOM_7_IRQ_HANDLER_ENABLE
+#define CONF_SERCOM_7_IRQ_HANDLER_ENABLE 0
+#endif
+
+/**
+ * \internal Dispatch a SERCOM interrupt to the driver the instance is running
+ *
+ * \param[in] n The ordinal number of the SERCOM instance
+ */
+static void _sercom_irq_handler(const uint8_t n)
+{
+	Sercom *const sercom_modules[] = SERCOM_INSTS;
+	void *const   hw               = sercom_modules[n];
+	void *const   dev              = _sercom_dev[n];
+
+	if (dev == NULL) {
+		return;
+	}
+
+	switch (hri_sercomspi_get_CTRLA_reg(hw, SERCOM_SPI_CTRLA_MODE_Msk)) {
+	case SERCOM_I2CM_CTRLA_MODE_I2C_MASTER:
+		_sercom_i2c_m_irq_handler((struct _i2c_m_async_device *)dev);
+		break;
+	case SERCOM_I2CM_CTRLA_MODE_I2C_SLAVE:
+		_sercom_i2c_s_irq_handler((struct _i2c_s_async_device *)dev);
+		break;
+	case SERCOM_USART_CTRLA_MODE_SPI_MASTER:
+		_spi_m_irq_handler((struct _spi_async_dev *)dev);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * The SERCOM handlers are only provided for the instances enabled with
+ * CONF_SERCOM_n_IRQ_HANDLER_ENABLE, so applications that service an instance
+ * themselves keep their own handlers.
+ */
+#define SERCOM_IRQ_HANDLERS(n)                                                                                         \
+	void SERCOM##n##_0_Handler(void)                                                                                   \
+	{                                                                                                                  \
+		_sercom_irq_handler(n);                                                                                        \
+	}                                                                                                                  \
+	void SERCOM##n##_1_Handler(void)                                                                                   \
+	{                                                                                                                  \
+		_sercom_irq_handler(n);                                                                                        \
+	}                                                                                                                  \
+	void SERCOM##n##_2_Handler(void)                                                                                   \
+	{                                                                                                                  \
+		_sercom_irq_handler(n);                                                                                        \
+	}                                                                                                                  \
+	void SERCOM##n##_3_Handler(void)                                                                                   \
+	{                                                                                                                  \
+		_sercom_irq_handler(n);                                                                                        \
+	}
+
+#if CONF_SERCOM_0_IRQ_HANDLER_ENABLE == 1
+SERCOM_IRQ_HANDLERS(0)
+#endif
+#if CONF_SERCOM_1_IRQ_HANDLER_ENABLE == 1
+SERCOM_IRQ_HANDLERS(1)
+#endif
+#if CONF_SERCOM_2_IRQ_HANDLER_ENABLE == 1
+SERCOM_IRQ_HANDLERS(2)
+#endif
+#if CONF_SERCOM_3_IRQ_HANDLER_ENABLE == 1
+SERCOM_IRQ_HANDLERS(3)
+#endif
+#if CONF_SERCOM_4_IRQ_HANDLER_ENABLE == 1
+SERCOM_IRQ_HANDLERS(4)
+#endif
+#if CONF_SERCOM_5_IRQ_HANDLER_ENABLE == 1
+SERCOM_IRQ_HANDLERS(5)
+#endif
+#if CONF_SERCOM_6_IRQ_HANDLER_ENABLE == 1
+SERCOM_IRQ_HANDLERS(6)
+#endif
+#if CONF_SERCOM_7_IRQ_HANDLER_ENABLE == 1
+SERCOM_IRQ_HANDLERS(7)
+#endif
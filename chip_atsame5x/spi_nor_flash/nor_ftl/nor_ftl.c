@@ -0,0 +1,719 @@
+/**
+ * \file
+ *
+ * \brief NOR flash translation layer implementation.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+/*
+ * Support and FAQ: visit <a href="https://www.microchip.com/support/">Microchip Support</a>
+ */
+
+#include <nor_ftl.h>
+#include <nor_ftl_config.h>
+#include <string.h>
+#include <utils_assert.h>
+
+/**
+ * Every sector starts with a header page followed by data slots of one page.
+ * The header page holds the sector header and one tag per data slot. A slot
+ * is written by programming its data first and its tag last, so a slot only
+ * counts once it has been written completely. Rewritten logical pages go to
+ * a new slot; the copy in the most recently used sector, last slot, wins.
+ */
+
+/** Sector header magic, "NFTL" */
+#define NOR_FTL_MAGIC 0x4C54464Eu
+/** Erased flash word */
+#define NOR_FTL_ERASED 0xFFFFFFFFu
+/** Size of the sector header */
+#define NOR_FTL_HEADER_SIZE 16
+/** Offset of the erase count in the sector header */
+#define NOR_FTL_ERASE_COUNT_OFFSET 4
+/** Offset of the sequence in the sector header */
+#define NOR_FTL_SEQUENCE_OFFSET 8
+/** Size of a slot tag */
+#define NOR_FTL_TAG_SIZE 4
+/** Free sectors needed to accept writes, one is kept for garbage collection */
+#define NOR_FTL_RESERVED_SECTORS 2
+
+/** Slot tag, logical page with its complement */
+#define NOR_FTL_TAG(lpn) ((uint32_t)(lpn) | ((uint32_t)(uint16_t)~(lpn) << 16))
+
+/**
+ * \brief Sector header
+ */
+struct nor_ftl_header {
+	uint32_t magic;
+	uint32_t erase_count;
+	uint32_t sequence;
+	uint32_t sequence_check;
+};
+
+/**
+ * \internal Flash address of a sector
+ */
+static uint32_t nor_ftl_sector_address(const struct nor_ftl *const ftl, const uint16_t sector)
+{
+	return ftl->cfg.base + (uint32_t)sector * ftl->cfg.sector_size;
+}
+
+/**
+ * \internal Flash address of a data slot
+ */
+static uint32_t nor_ftl_slot_address(const struct nor_ftl *const ftl, const uint16_t sector, const uint16_t slot)
+{
+	return nor_ftl_sector_address(ftl, sector) + (uint32_t)(slot + 1) * ftl->cfg.page_size;
+}
+
+/**
+ * \internal Flash address of a slot tag
+ */
+static uint32_t nor_ftl_tag_address(const struct nor_ftl *const ftl, const uint16_t sector, const uint16_t slot)
+{
+	return nor_ftl_sector_address(ftl, sector) + NOR_FTL_HEADER_SIZE + (uint32_t)slot * NOR_FTL_TAG_SIZE;
+}
+
+/**
+ * \internal Get the logical page of a tag
+ *
+ * \return The logical page, NOR_FTL_UNMAPPED for erased or torn tags
+ */
+static uint16_t nor_ftl_tag_page(const struct nor_ftl *const ftl, const uint32_t tag)
+{
+	uint16_t lpn = tag & 0xFFFF;
+
+	if (tag != NOR_FTL_TAG(lpn) || lpn >= ftl->cfg.logical_pages) {
+		return NOR_FTL_UNMAPPED;
+	}
+
+	return lpn;
+}
+
+/**
+ * \internal Erase a sector and write its header with the new erase count
+ *
+ * The magic is programmed after the erase count, so a valid magic always comes
+ * with a complete erase count.
+ */
+static int32_t nor_ftl_erase_sector(struct nor_ftl *const ftl, const uint16_t sector)
+{
+	struct nor_ftl_sector *info  = &ftl->cfg.sectors[sector];
+	uint32_t               magic = NOR_FTL_MAGIC;
+	int32_t                rc;
+
+	rc = spi_nor_flash_erase(ftl->flash, nor_ftl_sector_address(ftl, sector), ftl->cfg.sector_size);
+	if (rc) {
+		return rc;
+	}
+
+	info->erase_count++;
+	rc = spi_nor_flash_write(ftl->flash,
+	                         (uint8_t *)&info->erase_count,
+	                         nor_ftl_sector_address(ftl, sector) + NOR_FTL_ERASE_COUNT_OFFSET,
+	                         sizeof(info->erase_count));
+	if (!rc) {
+		rc = spi_nor_flash_write(ftl->flash, (uint8_t *)&magic, nor_ftl_sector_address(ftl, sector), sizeof(magic));
+	}
+	if (rc) {
+		info->state = NOR_FTL_SECTOR_DIRTY;
+		return rc;
+	}
+
+	if (info->state != NOR_FTL_SECTOR_FREE) {
+		ftl->free_sectors++;
+	}
+	info->state    = NOR_FTL_SECTOR_FREE;
+	info->sequence = 0;
+	info->valid    = 0;
+	info->used     = 0;
+
+	return ERR_NONE;
+}
+
+/**
+ * \internal Take the least worn free sector into use
+ */
+static int32_t nor_ftl_open_sector(struct nor_ftl *const ftl)
+{
+	uint16_t best = ftl->cfg.sector_count;
+	uint32_t seq[2];
+	int32_t  rc;
+
+	for (uint16_t i = 0; i < ftl->cfg.sector_count; i++) {
+		if (ftl->cfg.sectors[i].state == NOR_FTL_SECTOR_FREE
+		    && (best == ftl->cfg.sector_count
+		        || ftl->cfg.sectors[i].erase_count < ftl->cfg.sectors[best].erase_count)) {
+			best = i;
+		}
+	}
+	if (best == ftl->cfg.sector_count) {
+		return ERR_NO_RESOURCE;
+	}
+
+	seq[0] = ftl->sequence + 1;
+	seq[1] = ~seq[0];
+	rc     = spi_nor_flash_write(ftl->flash,
+	                             (uint8_t *)seq,
+	                             nor_ftl_sector_address(ftl, best) + NOR_FTL_SEQUENCE_OFFSET,
+	                             sizeof(seq));
+	if (rc) {
+		return rc;
+	}
+
+	ftl->sequence                    = seq[0];
+	ftl->cfg.sectors[best].sequence = seq[0];
+	ftl->cfg.sectors[best].state    = NOR_FTL_SECTOR_USED;
+	ftl->free_sectors--;
+	ftl->active = best;
+
+	return ERR_NONE;
+}
+
+/**
+ * \internal Write a logical page to the next slot of the active sector
+ */
+static int32_t nor_ftl_program_page(struct nor_ftl *const ftl, const uint16_t lpn, const uint8_t *const data)
+{
+	struct nor_ftl_sector *info;
+	uint32_t               tag = NOR_FTL_TAG(lpn);
+	uint16_t               old = ftl->cfg.map[lpn];
+	uint16_t               slot;
+	int32_t                rc;
+
+	if (ftl->active == ftl->cfg.sector_count || ftl->cfg.sectors[ftl->active].used >= ftl->slots) {
+		rc = nor_ftl_open_sector(ftl);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	info = &ftl->cfg.sectors[ftl->active];
+	slot = info->used++;
+
+	rc = spi_nor_flash_write(ftl->flash, data, nor_ftl_slot_address(ftl, ftl->active, slot), ftl->cfg.page_size);
+	if (!rc) {
+		rc = spi_nor_flash_write(ftl->flash, (uint8_t *)&tag, nor_ftl_tag_address(ftl, ftl->active, slot), sizeof(tag));
+	}
+	if (rc) {
+		return rc;
+	}
+
+	if (old != NOR_FTL_UNMAPPED) {
+		ftl->cfg.sectors[old / ftl->slots].valid--;
+	}
+	ftl->cfg.map[lpn] = ftl->active * ftl->slots + slot;
+	info->valid++;
+
+	return ERR_NONE;
+}
+
+/**
+ * \internal Move the valid pages out of a sector and erase it
+ */
+static int32_t nor_ftl_collect_sector(struct nor_ftl *const ftl, const uint16_t sector)
+{
+	struct nor_ftl_sector *info = &ftl->cfg.sectors[sector];
+	uint32_t               tag;
+	int32_t                rc;
+
+	for (uint16_t slot = 0; slot < info->used && info->valid; slot++) {
+		uint16_t lpn;
+
+		rc = spi_nor_flash_read(ftl->flash, (uint8_t *)&tag, nor_ftl_tag_address(ftl, sector, slot), sizeof(tag));
+		if (rc) {
+			return rc;
+		}
+		lpn = nor_ftl_tag_page(ftl, tag);
+		if (lpn == NOR_FTL_UNMAPPED || ftl->cfg.map[lpn] != sector * ftl->slots + slot) {
+			continue;
+		}
+
+		rc = spi_nor_flash_read(ftl->flash, ftl->cfg.scratch, nor_ftl_slot_address(ftl, sector, slot),
+		                        ftl->cfg.page_size);
+		if (!rc) {
+			rc = nor_ftl_program_page(ftl, lpn, ftl->cfg.scratch);
+		}
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return nor_ftl_erase_sector(ftl, sector);
+}
+
+/**
+ * \internal Find the used sector with the fewest valid pages
+ *
+ * \return The sector, sector_count if no sector has stale pages
+ */
+static uint16_t nor_ftl_find_victim(const struct nor_ftl *const ftl)
+{
+	uint16_t best = ftl->cfg.sector_count;
+
+	for (uint16_t i = 0; i < ftl->cfg.sector_count; i++) {
+		const struct nor_ftl_sector *info = &ftl->cfg.sectors[i];
+
+		if (info->state != NOR_FTL_SECTOR_USED || i == ftl->active || info->valid >= info->used) {
+			continue;
+		}
+		if (best == ftl->cfg.sector_count || info->valid < ftl->cfg.sectors[best].valid
+		    || (info->valid == ftl->cfg.sectors[best].valid
+		        && info->erase_count < ftl->cfg.sectors[best].erase_count)) {
+			best = i;
+		}
+	}
+
+	return best;
+}
+
+/**
+ * \internal Collect sectors until a page can be written
+ *
+ * A collection interrupted by a power failure may have taken the last free
+ * sector. It is resumed into the room left in the active sector before that
+ * room is used for writes.
+ */
+static int32_t nor_ftl_make_room(struct nor_ftl *const ftl)
+{
+	while (ftl->free_sectors < NOR_FTL_RESERVED_SECTORS
+	       && (!ftl->free_sectors || ftl->active == ftl->cfg.sector_count
+	           || ftl->cfg.sectors[ftl->active].used >= ftl->slots)) {
+		uint16_t victim = nor_ftl_find_victim(ftl);
+		int32_t  rc;
+
+		if (victim == ftl->cfg.sector_count) {
+			/* Full, the reserve may still take this page */
+			return ftl->free_sectors ? ERR_NONE : ERR_NO_RESOURCE;
+		}
+		rc = nor_ftl_collect_sector(ftl, victim);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Initialize the NOR FTL
+ */
+int32_t nor_ftl_init(struct nor_ftl *const ftl, struct spi_nor_flash *const flash,
+                     const struct nor_ftl_config *const cfg)
+{
+	uint32_t slots;
+
+	ASSERT(ftl && flash && cfg && cfg->map && cfg->sectors && cfg->cache && cfg->scratch);
+
+	if (!cfg->page_size || cfg->sector_size % cfg->page_size || cfg->sector_count <= NOR_FTL_RESERVED_SECTORS) {
+		return ERR_INVALID_ARG;
+	}
+	slots = cfg->sector_size / cfg->page_size - 1;
+	if (!slots || slots > 255 || NOR_FTL_HEADER_SIZE + slots * NOR_FTL_TAG_SIZE > cfg->page_size
+	    || (uint32_t)cfg->sector_count * slots >= NOR_FTL_UNMAPPED
+	    || cfg->logical_pages > (uint32_t)(cfg->sector_count - NOR_FTL_RESERVED_SECTORS) * slots) {
+		return ERR_INVALID_ARG;
+	}
+
+	ftl->flash       = flash;
+	ftl->cfg         = *cfg;
+	ftl->slots       = slots;
+	ftl->active      = cfg->sector_count;
+	ftl->cache_page  = NOR_FTL_UNMAPPED;
+	ftl->cache_dirty = false;
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Erase all sectors, keeping their erase counts, and mount
+ */
+int32_t nor_ftl_format(struct nor_ftl *const ftl)
+{
+	struct nor_ftl_header header;
+	int32_t               rc;
+
+	ASSERT(ftl);
+
+	for (uint16_t i = 0; i < ftl->cfg.sector_count; i++) {
+		rc = spi_nor_flash_read(ftl->flash, (uint8_t *)&header, nor_ftl_sector_address(ftl, i), sizeof(header));
+		if (rc) {
+			return rc;
+		}
+		ftl->cfg.sectors[i].erase_count = header.magic == NOR_FTL_MAGIC ? header.erase_count : 0;
+		ftl->cfg.sectors[i].state       = NOR_FTL_SECTOR_DIRTY;
+		rc                              = nor_ftl_erase_sector(ftl, i);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return nor_ftl_mount(ftl);
+}
+
+/**
+ * \internal Map the slots of a used sector
+ */
+static int32_t nor_ftl_mount_sector(struct nor_ftl *const ftl, const uint16_t sector)
+{
+	uint32_t *tags = (uint32_t *)ftl->cfg.scratch;
+	int32_t   rc;
+
+	rc = spi_nor_flash_read(
+	    ftl->flash, ftl->cfg.scratch, nor_ftl_tag_address(ftl, sector, 0), ftl->slots * NOR_FTL_TAG_SIZE);
+	if (rc) {
+		return rc;
+	}
+
+	for (uint16_t slot = 0; slot < ftl->slots; slot++) {
+		uint32_t tag;
+		uint16_t lpn;
+		uint16_t old;
+
+		memcpy(&tag, &tags[slot], sizeof(tag));
+		if (tag == NOR_FTL_ERASED) {
+			/* Not written, or torn before its tag and skipped */
+			continue;
+		}
+		ftl->cfg.sectors[sector].used = slot + 1;
+		lpn = nor_ftl_tag_page(ftl, tag);
+		if (lpn == NOR_FTL_UNMAPPED) {
+			continue;
+		}
+		old = ftl->cfg.map[lpn];
+		if (old == NOR_FTL_UNMAPPED || old / ftl->slots == sector
+		    || ftl->cfg.sectors[old / ftl->slots].sequence < ftl->cfg.sectors[sector].sequence) {
+			ftl->cfg.map[lpn] = sector * ftl->slots + slot;
+		}
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \internal Resume writing in the newest sector at its next blank slot
+ */
+static int32_t nor_ftl_mount_active(struct nor_ftl *const ftl, const uint16_t sector)
+{
+	struct nor_ftl_sector *info = &ftl->cfg.sectors[sector];
+	uint16_t               i;
+	int32_t                rc;
+
+	/* A power failure may have left a partly programmed slot without tag, it
+	 * is skipped. The slots behind the last tag are blank otherwise. */
+	for (; info->used < ftl->slots; info->used++) {
+		rc = spi_nor_flash_read(
+		    ftl->flash, ftl->cfg.scratch, nor_ftl_slot_address(ftl, sector, info->used), ftl->cfg.page_size);
+		if (rc) {
+			return rc;
+		}
+		for (i = 0; i < ftl->cfg.page_size && ftl->cfg.scratch[i] == 0xFF; i++) {
+		}
+		if (i == ftl->cfg.page_size) {
+			ftl->active = sector;
+			break;
+		}
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Rebuild the RAM state from flash
+ */
+int32_t nor_ftl_mount(struct nor_ftl *const ftl)
+{
+	struct nor_ftl_header header;
+	uint16_t              newest = ftl->cfg.sector_count;
+	uint32_t              wear   = 0;
+	int32_t               rc;
+
+	ASSERT(ftl);
+
+	ftl->active       = ftl->cfg.sector_count;
+	ftl->free_sectors = 0;
+	ftl->sequence     = 0;
+	ftl->cache_page   = NOR_FTL_UNMAPPED;
+	ftl->cache_dirty  = false;
+	memset(ftl->cfg.map, 0xFF, ftl->cfg.logical_pages * sizeof(ftl->cfg.map[0]));
+
+	for (uint16_t i = 0; i < ftl->cfg.sector_count; i++) {
+		struct nor_ftl_sector *info = &ftl->cfg.sectors[i];
+
+		rc = spi_nor_flash_read(ftl->flash, (uint8_t *)&header, nor_ftl_sector_address(ftl, i), sizeof(header));
+		if (rc) {
+			return rc;
+		}
+
+		info->sequence    = 0;
+		info->valid       = 0;
+		info->used        = 0;
+		info->erase_count = 0;
+		if (header.magic != NOR_FTL_MAGIC || header.erase_count == NOR_FTL_ERASED) {
+			/* Interrupted erase, the erase count is lost */
+			info->state = NOR_FTL_SECTOR_DIRTY;
+			continue;
+		}
+
+		info->erase_count = header.erase_count;
+		if (header.erase_count > wear) {
+			wear = header.erase_count;
+		}
+		if (header.sequence == NOR_FTL_ERASED && header.sequence_check == NOR_FTL_ERASED) {
+			info->state = NOR_FTL_SECTOR_FREE;
+			ftl->free_sectors++;
+		} else if (header.sequence_check != ~header.sequence) {
+			/* Interrupted while taken into use, before any data */
+			info->state = NOR_FTL_SECTOR_DIRTY;
+		} else {
+			info->state    = NOR_FTL_SECTOR_USED;
+			info->sequence = header.sequence;
+			if (header.sequence > ftl->sequence) {
+				ftl->sequence = header.sequence;
+				newest        = i;
+			}
+		}
+	}
+
+	for (uint16_t i = 0; i < ftl->cfg.sector_count; i++) {
+		/* A lost erase count is estimated as the highest one, so the sector is
+		 * not favoured by wear leveling */
+		if (!ftl->cfg.sectors[i].erase_count) {
+			ftl->cfg.sectors[i].erase_count = wear;
+		}
+		if (ftl->cfg.sectors[i].state == NOR_FTL_SECTOR_USED) {
+			rc = nor_ftl_mount_sector(ftl, i);
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+	for (uint16_t lpn = 0; lpn < ftl->cfg.logical_pages; lpn++) {
+		if (ftl->cfg.map[lpn] != NOR_FTL_UNMAPPED) {
+			ftl->cfg.sectors[ftl->cfg.map[lpn] / ftl->slots].valid++;
+		}
+	}
+
+	if (newest != ftl->cfg.sector_count) {
+		rc = nor_ftl_mount_active(ftl, newest);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	for (uint16_t i = 0; i < ftl->cfg.sector_count; i++) {
+		if (ftl->cfg.sectors[i].state == NOR_FTL_SECTOR_DIRTY) {
+			rc = nor_ftl_erase_sector(ftl, i);
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Read logical bytes
+ */
+int32_t nor_ftl_read(struct nor_ftl *const ftl, const uint32_t address, uint8_t *const buf, const uint32_t length)
+{
+	uint32_t offset = 0;
+
+	ASSERT(ftl && buf);
+
+	if (address > (uint32_t)ftl->cfg.logical_pages * ftl->cfg.page_size
+	    || length > (uint32_t)ftl->cfg.logical_pages * ftl->cfg.page_size - address) {
+		return ERR_INVALID_ARG;
+	}
+
+	while (offset < length) {
+		uint16_t lpn   = (address + offset) / ftl->cfg.page_size;
+		uint16_t start = (address + offset) % ftl->cfg.page_size;
+		uint32_t chunk = ftl->cfg.page_size - start;
+		uint16_t loc   = ftl->cfg.map[lpn];
+		int32_t  rc;
+
+		if (chunk > length - offset) {
+			chunk = length - offset;
+		}
+
+		if (lpn == ftl->cache_page) {
+			memcpy(buf + offset, ftl->cfg.cache + start, chunk);
+		} else if (loc == NOR_FTL_UNMAPPED) {
+			memset(buf + offset, 0xFF, chunk);
+		} else {
+			rc = spi_nor_flash_read(ftl->flash,
+			                        buf + offset,
+			                        nor_ftl_slot_address(ftl, loc / ftl->slots, loc % ftl->slots) + start,
+			                        chunk);
+			if (rc) {
+				return rc;
+			}
+		}
+		offset += chunk;
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Program the write-back cache to flash
+ */
+int32_t nor_ftl_sync(struct nor_ftl *const ftl)
+{
+	int32_t rc;
+
+	ASSERT(ftl);
+
+	if (!ftl->cache_dirty) {
+		return ERR_NONE;
+	}
+
+	rc = nor_ftl_make_room(ftl);
+	if (!rc) {
+		rc = nor_ftl_program_page(ftl, ftl->cache_page, ftl->cfg.cache);
+	}
+	if (!rc) {
+		ftl->cache_dirty = false;
+	}
+
+	return rc;
+}
+
+/**
+ * \brief Write logical bytes
+ */
+int32_t nor_ftl_write(struct nor_ftl *const ftl, const uint32_t address, const uint8_t *const buf,
+                      const uint32_t length)
+{
+	uint32_t offset = 0;
+	int32_t  rc;
+
+	ASSERT(ftl && buf);
+
+	if (address > (uint32_t)ftl->cfg.logical_pages * ftl->cfg.page_size
+	    || length > (uint32_t)ftl->cfg.logical_pages * ftl->cfg.page_size - address) {
+		return ERR_INVALID_ARG;
+	}
+
+	while (offset < length) {
+		uint16_t lpn   = (address + offset) / ftl->cfg.page_size;
+		uint16_t start = (address + offset) % ftl->cfg.page_size;
+		uint32_t chunk = ftl->cfg.page_size - start;
+
+		if (chunk > length - offset) {
+			chunk = length - offset;
+		}
+
+		if (lpn != ftl->cache_page) {
+			rc = nor_ftl_sync(ftl);
+			if (rc) {
+				return rc;
+			}
+			/* Load the page unless it is overwritten completely */
+			if (chunk != ftl->cfg.page_size) {
+				ftl->cache_page = NOR_FTL_UNMAPPED;
+
+				rc = nor_ftl_read(ftl, (uint32_t)lpn * ftl->cfg.page_size, ftl->cfg.cache, ftl->cfg.page_size);
+				if (rc) {
+					return rc;
+				}
+			}
+			ftl->cache_page = lpn;
+		}
+
+		memcpy(ftl->cfg.cache + start, buf + offset, chunk);
+		ftl->cache_dirty = true;
+		offset += chunk;
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Run one garbage collection or wear leveling step
+ */
+int32_t nor_ftl_maintenance(struct nor_ftl *const ftl)
+{
+	uint16_t victim  = ftl->cfg.sector_count;
+	uint16_t coldest = ftl->cfg.sector_count;
+	uint32_t min;
+	uint32_t max;
+
+	ASSERT(ftl);
+
+	/* Sectors without valid data only need an erase */
+	for (uint16_t i = 0; i < ftl->cfg.sector_count; i++) {
+		const struct nor_ftl_sector *info = &ftl->cfg.sectors[i];
+
+		if (info->state == NOR_FTL_SECTOR_USED && i != ftl->active && !info->valid) {
+			return nor_ftl_erase_sector(ftl, i);
+		}
+		if (info->state == NOR_FTL_SECTOR_USED && i != ftl->active
+		    && (coldest == ftl->cfg.sector_count || info->erase_count < ftl->cfg.sectors[coldest].erase_count)) {
+			coldest = i;
+		}
+	}
+
+	if (ftl->free_sectors < CONF_NOR_FTL_FREE_SECTORS) {
+		victim = nor_ftl_find_victim(ftl);
+	}
+
+	/* Static wear leveling, move cold data off the least worn sector */
+	nor_ftl_get_wear(ftl, &min, &max);
+	if (victim == ftl->cfg.sector_count && coldest != ftl->cfg.sector_count && ftl->free_sectors
+	    && max - ftl->cfg.sectors[coldest].erase_count > CONF_NOR_FTL_WEAR_THRESHOLD) {
+		victim = coldest;
+	}
+
+	if (victim == ftl->cfg.sector_count) {
+		return ERR_NO_CHANGE;
+	}
+
+	return nor_ftl_collect_sector(ftl, victim);
+}
+
+/**
+ * \brief Get the lowest and highest sector erase count
+ */
+void nor_ftl_get_wear(const struct nor_ftl *const ftl, uint32_t *const min, uint32_t *const max)
+{
+	ASSERT(ftl && min && max);
+
+	*min = NOR_FTL_ERASED;
+	*max = 0;
+	for (uint16_t i = 0; i < ftl->cfg.sector_count; i++) {
+		if (ftl->cfg.sectors[i].erase_count < *min) {
+			*min = ftl->cfg.sectors[i].erase_count;
+		}
+		if (ftl->cfg.sectors[i].erase_count > *max) {
+			*max = ftl->cfg.sectors[i].erase_count;
+		}
+	}
+}
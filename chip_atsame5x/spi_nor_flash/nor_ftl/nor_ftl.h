@@ -0,0 +1,229 @@
+/**
+ * \file
+ *
+ * \brief NOR flash translation layer declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+/*
+ * Support and FAQ: visit <a href="https://www.microchip.com/support/">Microchip Support</a>
+ */
+
+#ifndef _NOR_FTL_H_INCLUDED
+#define _NOR_FTL_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <spi_nor_flash.h>
+
+/** Logical page not stored in flash */
+#define NOR_FTL_UNMAPPED 0xFFFF
+
+/**
+ * \brief NOR FTL sector states
+ */
+enum nor_ftl_sector_state {
+	/** Contents unknown, must be erased before use */
+	NOR_FTL_SECTOR_DIRTY,
+	/** Erased and ready to be written */
+	NOR_FTL_SECTOR_FREE,
+	/** Holds logical pages */
+	NOR_FTL_SECTOR_USED
+};
+
+/**
+ * \brief RAM state of one erase sector
+ */
+struct nor_ftl_sector {
+	/** Order in which the sector was taken into use */
+	uint32_t sequence;
+	/** Number of times the sector was erased */
+	uint32_t erase_count;
+	/** Number of slots holding the current copy of a logical page */
+	uint8_t valid;
+	/** Number of slots written */
+	uint8_t used;
+	/** Sector state, enum nor_ftl_sector_state */
+	uint8_t state;
+};
+
+/**
+ * \brief NOR FTL geometry and work memory
+ */
+struct nor_ftl_config {
+	/** Flash address of the first sector, aligned to the erase sector size */
+	uint32_t base;
+	/** Erase sector size in bytes */
+	uint32_t sector_size;
+	/** Program page size in bytes, also the logical page size */
+	uint16_t page_size;
+	/** Number of erase sectors */
+	uint16_t sector_count;
+	/** Number of logical pages, at most (sector_count - 2) data slots worth */
+	uint16_t logical_pages;
+	/** Logical to physical map, logical_pages entries */
+	uint16_t *map;
+	/** Sector state, sector_count entries */
+	struct nor_ftl_sector *sectors;
+	/** Write-back cache, page_size bytes */
+	uint8_t *cache;
+	/** Scratch buffer for garbage collection, page_size bytes */
+	uint8_t *scratch;
+};
+
+/**
+ * \brief NOR flash translation layer
+ */
+struct nor_ftl {
+	/** The flash holding the sectors */
+	struct spi_nor_flash *flash;
+	/** Geometry and work memory */
+	struct nor_ftl_config cfg;
+	/** Data slots per sector */
+	uint16_t slots;
+	/** Sector receiving writes, sector_count if none */
+	uint16_t active;
+	/** Number of free sectors */
+	uint16_t free_sectors;
+	/** Logical page held by the cache, NOR_FTL_UNMAPPED if none */
+	uint16_t cache_page;
+	/** Cache holds data not yet written to flash */
+	bool cache_dirty;
+	/** Highest sector sequence in use */
+	uint32_t sequence;
+};
+
+/**
+ * \brief Initialize the NOR FTL
+ *
+ * The first page of every sector holds a header and a tag per data slot, so
+ * 16 + 4 * (sector_size / page_size - 1) must fit in one page.
+ *
+ * \param[in] ftl The FTL to initialize
+ * \param[in] flash The flash holding the sectors
+ * \param[in] cfg Geometry and work memory, copied
+ *
+ * \return Initialization status.
+ * \retval ERR_INVALID_ARG The geometry is not supported
+ */
+int32_t nor_ftl_init(struct nor_ftl *const ftl, struct spi_nor_flash *const flash,
+                     const struct nor_ftl_config *const cfg);
+
+/**
+ * \brief Erase all sectors, keeping their erase counts, and mount
+ *
+ * \param[in] ftl The FTL
+ *
+ * \return Operation status.
+ */
+int32_t nor_ftl_format(struct nor_ftl *const ftl);
+
+/**
+ * \brief Rebuild the RAM state from flash
+ *
+ * Sectors interrupted by a power failure while being erased or taken into use
+ * are erased again, the erase count lost with an interrupted erase restarts
+ * from the highest one. A slot torn before its tag is skipped.
+ *
+ * \param[in] ftl The FTL
+ *
+ * \return Operation status.
+ */
+int32_t nor_ftl_mount(struct nor_ftl *const ftl);
+
+/**
+ * \brief Read logical bytes
+ *
+ * Never written pages read as 0xFF.
+ *
+ * \param[in] ftl The FTL
+ * \param[in] address Logical address
+ * \param[out] buf The buffer to read to
+ * \param[in] length Number of bytes to read
+ *
+ * \return Operation status.
+ */
+int32_t nor_ftl_read(struct nor_ftl *const ftl, const uint32_t address, uint8_t *const buf, const uint32_t length);
+
+/**
+ * \brief Write logical bytes
+ *
+ * Writes are collected per page in the write-back cache and programmed when
+ * another page is written or on nor_ftl_sync.
+ *
+ * \param[in] ftl The FTL
+ * \param[in] address Logical address
+ * \param[in] buf The buffer to write from
+ * \param[in] length Number of bytes to write
+ *
+ * \return Operation status.
+ */
+int32_t nor_ftl_write(struct nor_ftl *const ftl, const uint32_t address, const uint8_t *const buf,
+                      const uint32_t length);
+
+/**
+ * \brief Program the write-back cache to flash
+ *
+ * \param[in] ftl The FTL
+ *
+ * \return Operation status.
+ */
+int32_t nor_ftl_sync(struct nor_ftl *const ftl);
+
+/**
+ * \brief Run one garbage collection or wear leveling step
+ *
+ * Meant to be called when the system is idle. Erases sectors without valid
+ * data, collects sectors until CONF_NOR_FTL_FREE_SECTORS are free, and moves
+ * cold data when erase counts drift apart more than
+ * CONF_NOR_FTL_WEAR_THRESHOLD.
+ *
+ * \param[in] ftl The FTL
+ *
+ * \return Operation status.
+ * \retval ERR_NONE A step was done
+ * \retval ERR_NO_CHANGE Nothing to do
+ */
+int32_t nor_ftl_maintenance(struct nor_ftl *const ftl);
+
+/**
+ * \brief Get the lowest and highest sector erase count
+ *
+ * \param[in] ftl The FTL
+ * \param[out] min Lowest erase count
+ * \param[out] max Highest erase count
+ */
+void nor_ftl_get_wear(const struct nor_ftl *const ftl, uint32_t *const min, uint32_t *const max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _NOR_FTL_H_INCLUDED */
@@ -0,0 +1,25 @@
+/* Auto-generated config file nor_ftl_config.h */
+#ifndef NOR_FTL_CONFIG_H
+#define NOR_FTL_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+//<o>Free sectors kept by maintenance <2-16>
+//<i>nor_ftl_maintenance collects stale sectors until this many are erased
+//<i>and ready, so writes rarely have to wait for garbage collection
+//<id>conf_free_sectors
+#ifndef CONF_NOR_FTL_FREE_SECTORS
+#define CONF_NOR_FTL_FREE_SECTORS 4
+#endif
+
+//<o>Wear leveling threshold <1-10000>
+//<i>Maximum difference in erase count before maintenance moves cold data
+//<i>out of the least worn sector
+//<id>conf_wear_threshold
+#ifndef CONF_NOR_FTL_WEAR_THRESHOLD
+#define CONF_NOR_FTL_WEAR_THRESHOLD 64
+#endif
+
+// <<< end of configuration section >>>
+
+#endif // NOR_FTL_CONFIG_H
@@ -0,0 +1,694 @@
+/**
+ * \file
+ *
+ * \brief SFDP discovered serial NOR flash implementation.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+/*
+ * Support and FAQ: visit <a href="https://www.microchip.com/support/">Microchip Support</a>
+ */
+
+#include <sfdp_flash.h>
+#include <hal_qspi_sync.h>
+#include <utils_assert.h>
+#include <string.h>
+
+/** Serial NOR flash instructions */
+#define SFDP_FLASH_READ_SFDP 0x5A
+#define SFDP_FLASH_FAST_READ 0x0B
+#define SFDP_FLASH_PAGE_PROGRAM 0x02
+#define SFDP_FLASH_CHIP_ERASE 0xC7
+#define SFDP_FLASH_WRITE_ENABLE 0x06
+#define SFDP_FLASH_READ_SR1 0x05
+#define SFDP_FLASH_READ_SR2 0x35
+#define SFDP_FLASH_WRITE_SR 0x01
+#define SFDP_FLASH_WRITE_SR2 0x31
+#define SFDP_FLASH_READ_SR2_ALT 0x3F
+#define SFDP_FLASH_WRITE_SR2_ALT 0x3E
+
+/** Write in progress bit of status register 1 */
+#define SFDP_FLASH_SR1_WIP 0x01
+
+/** SFDP header signature, "SFDP" */
+#define SFDP_SIGNATURE 0x50444653u
+/** Dummy cycles of the read SFDP instruction */
+#define SFDP_DUMMY_CYCLES 8
+/** Maximum number of parameter headers scanned */
+#define SFDP_MAX_HEADERS 8
+/** Number of basic flash parameter table DWORDs used */
+#define SFDP_BFPT_DWORDS 16
+
+/** Basic flash parameter table DWORD fields, DWORDs numbered from 1 */
+#define BFPT_DW1_ADDR_BYTES(dw) (((dw) >> 17) & 0x3)
+#define BFPT_DW1_ADDR_4BYTE_ONLY 2
+#define BFPT_DW1_FAST_READ_114 (1u << 22)
+#define BFPT_DW1_FAST_READ_144 (1u << 21)
+#define BFPT_DW2_SIZE_POW2 (1u << 31)
+#define BFPT_READ_DUMMY(v) ((v)&0x1F)
+#define BFPT_READ_MODE(v) (((v) >> 5) & 0x7)
+#define BFPT_READ_OPCODE(v) (((v) >> 8) & 0xFF)
+#define BFPT_DW11_PAGE_SHIFT(dw) (((dw) >> 4) & 0xF)
+#define BFPT_DW15_QER(dw) (((dw) >> 20) & 0x7)
+
+/** SFDP flash's interface */
+static const struct spi_nor_flash_interface sfdp_flash_interface = {
+    sfdp_flash_read, sfdp_flash_write, sfdp_flash_erase, sfdp_flash_enable_xip, sfdp_flash_disable_xip};
+
+/**
+ * \brief Run a single line instruction
+ */
+static int32_t sfdp_flash_command(struct sfdp_flash *const flash, const uint8_t opcode, const enum qspi_access type,
+                                  const void *const tx, void *const rx, const size_t length)
+{
+	struct _qspi_command cmd = {0};
+
+	cmd.inst_frame.bits.width    = QSPI_INST1_ADDR1_DATA1;
+	cmd.inst_frame.bits.inst_en  = 1;
+	cmd.inst_frame.bits.data_en  = length ? 1 : 0;
+	cmd.inst_frame.bits.tfr_type = type;
+	cmd.instruction              = opcode;
+	cmd.buf_len                  = length;
+	cmd.tx_buf                   = tx;
+	cmd.rx_buf                   = rx;
+
+	return qspi_sync_serial_run_command((struct qspi_sync_descriptor *)flash->parent.io, &cmd);
+}
+
+/**
+ * \brief Read from the SFDP area
+ */
+static int32_t sfdp_flash_read_sfdp(struct sfdp_flash *const flash, const uint32_t address, void *const buf,
+                                    const size_t length)
+{
+	struct _qspi_command cmd = {0};
+
+	cmd.inst_frame.bits.width        = QSPI_INST1_ADDR1_DATA1;
+	cmd.inst_frame.bits.inst_en      = 1;
+	cmd.inst_frame.bits.addr_en      = 1;
+	cmd.inst_frame.bits.data_en      = 1;
+	cmd.inst_frame.bits.tfr_type     = QSPI_READ_ACCESS;
+	cmd.inst_frame.bits.dummy_cycles = SFDP_DUMMY_CYCLES;
+	cmd.instruction                  = SFDP_FLASH_READ_SFDP;
+	cmd.address                      = address;
+	cmd.buf_len                      = length;
+	cmd.rx_buf                       = buf;
+
+	return qspi_sync_serial_run_command((struct qspi_sync_descriptor *)flash->parent.io, &cmd);
+}
+
+/**
+ * \brief Build the read instruction
+ */
+static void sfdp_flash_read_command(const struct sfdp_flash *const flash, struct _qspi_command *const cmd)
+{
+	memset(cmd, 0, sizeof(*cmd));
+
+	cmd->inst_frame.bits.width        = flash->read_width;
+	cmd->inst_frame.bits.inst_en      = 1;
+	cmd->inst_frame.bits.addr_en      = 1;
+	cmd->inst_frame.bits.opt_en       = flash->read_opt_en;
+	cmd->inst_frame.bits.opt_len      = flash->read_opt_len;
+	cmd->inst_frame.bits.data_en      = 1;
+	cmd->inst_frame.bits.addr_len     = flash->addr_4byte;
+	cmd->inst_frame.bits.tfr_type     = QSPI_READMEM_ACCESS;
+	cmd->inst_frame.bits.dummy_cycles = flash->read_dummy;
+	cmd->instruction                  = flash->read_opcode;
+	/* Mode bits not selecting continuous read */
+	cmd->option = 0xFF;
+}
+
+/**
+ * \brief Wait until the flash has finished programming or erasing
+ */
+static int32_t sfdp_flash_wait_ready(struct sfdp_flash *const flash)
+{
+	uint8_t status;
+	int32_t rc;
+
+	do {
+		rc = sfdp_flash_command(flash, SFDP_FLASH_READ_SR1, QSPI_READ_ACCESS, NULL, &status, 1);
+		if (rc) {
+			return rc;
+		}
+	} while (status & SFDP_FLASH_SR1_WIP);
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Write status register bytes
+ */
+static int32_t sfdp_flash_write_status(struct sfdp_flash *const flash, const uint8_t opcode,
+                                       const uint8_t *const data, const size_t length)
+{
+	int32_t rc = sfdp_flash_command(flash, SFDP_FLASH_WRITE_ENABLE, QSPI_WRITE_ACCESS, NULL, NULL, 0);
+	if (rc) {
+		return rc;
+	}
+	rc = sfdp_flash_command(flash, opcode, QSPI_WRITE_ACCESS, data, NULL, length);
+	if (rc) {
+		return rc;
+	}
+
+	return sfdp_flash_wait_ready(flash);
+}
+
+/**
+ * \brief Set the quad enable bit as described by the quad enable requirements
+ *
+ * \return ERR_NONE if the quad data lines can be used
+ */
+static int32_t sfdp_flash_quad_enable(struct sfdp_flash *const flash, const uint8_t qer)
+{
+	uint8_t sr[2];
+	int32_t rc = ERR_NONE;
+
+	switch (qer) {
+	case 0:
+		/* No quad enable bit, IO2 and IO3 are always data lines */
+		break;
+	case 1:
+		/* Bit 1 of SR2, SR2 cannot be read */
+		rc = sfdp_flash_command(flash, SFDP_FLASH_READ_SR1, QSPI_READ_ACCESS, NULL, &sr[0], 1);
+		sr[1] = 0x02;
+		if (!rc) {
+			rc = sfdp_flash_write_status(flash, SFDP_FLASH_WRITE_SR, sr, 2);
+		}
+		break;
+	case 2:
+		/* Bit 6 of SR1 */
+		rc = sfdp_flash_command(flash, SFDP_FLASH_READ_SR1, QSPI_READ_ACCESS, NULL, &sr[0], 1);
+		sr[0] |= 0x40;
+		if (!rc) {
+			rc = sfdp_flash_write_status(flash, SFDP_FLASH_WRITE_SR, sr, 1);
+		}
+		break;
+	case 3:
+		/* Bit 7 of SR2, separate instructions */
+		rc = sfdp_flash_command(flash, SFDP_FLASH_READ_SR2_ALT, QSPI_READ_ACCESS, NULL, &sr[1], 1);
+		sr[1] |= 0x80;
+		if (!rc) {
+			rc = sfdp_flash_write_status(flash, SFDP_FLASH_WRITE_SR2_ALT, &sr[1], 1);
+		}
+		break;
+	case 4:
+	case 5:
+		/* Bit 1 of SR2, written together with SR1 */
+		rc = sfdp_flash_command(flash, SFDP_FLASH_READ_SR1, QSPI_READ_ACCESS, NULL, &sr[0], 1);
+		if (!rc) {
+			rc = sfdp_flash_command(flash, SFDP_FLASH_READ_SR2, QSPI_READ_ACCESS, NULL, &sr[1], 1);
+		}
+		sr[1] |= 0x02;
+		if (!rc) {
+			rc = sfdp_flash_write_status(flash, SFDP_FLASH_WRITE_SR, sr, 2);
+		}
+		break;
+	case 6:
+		/* Bit 1 of SR2, written on its own */
+		rc = sfdp_flash_command(flash, SFDP_FLASH_READ_SR2, QSPI_READ_ACCESS, NULL, &sr[1], 1);
+		sr[1] |= 0x02;
+		if (!rc) {
+			rc = sfdp_flash_write_status(flash, SFDP_FLASH_WRITE_SR2, &sr[1], 1);
+		}
+		break;
+	default:
+		rc = ERR_UNSUPPORTED_OP;
+		break;
+	}
+
+	return rc;
+}
+
+/**
+ * \brief Select a read instruction from its BFPT description
+ *
+ * Mode clocks are sent as option code 0xFF when they fit an option length,
+ * otherwise they are added to the dummy cycles.
+ */
+static void sfdp_flash_set_read(struct sfdp_flash *const flash, const uint32_t desc, const uint8_t width,
+                                const uint8_t addr_lanes)
+{
+	uint8_t mode_bits = BFPT_READ_MODE(desc) * addr_lanes;
+
+	flash->read_opcode = BFPT_READ_OPCODE(desc);
+	flash->read_width  = width;
+	flash->read_dummy  = BFPT_READ_DUMMY(desc);
+	flash->read_opt_en = true;
+
+	switch (mode_bits) {
+	case 0:
+		flash->read_opt_en = false;
+		break;
+	case 1:
+		flash->read_opt_len = QSPI_OPT_1BIT;
+		break;
+	case 2:
+		flash->read_opt_len = QSPI_OPT_2BIT;
+		break;
+	case 4:
+		flash->read_opt_len = QSPI_OPT_4BIT;
+		break;
+	case 8:
+		flash->read_opt_len = QSPI_OPT_8BIT;
+		break;
+	default:
+		flash->read_opt_en = false;
+		flash->read_dummy += BFPT_READ_MODE(desc);
+		break;
+	}
+}
+
+/**
+ * \brief Parse the basic flash parameter table
+ */
+static int32_t sfdp_flash_parse_bfpt(struct sfdp_flash *const flash, const uint32_t *const dw, const uint8_t dwords)
+{
+	uint8_t  qer   = 0xFF;
+	uint64_t bits  = 0;
+	bool     quad  = false;
+	uint32_t shift = 0;
+
+	/* Size, in bits */
+	if (dw[1] & BFPT_DW2_SIZE_POW2) {
+		shift = dw[1] & ~BFPT_DW2_SIZE_POW2;
+		if (shift > 40) {
+			return ERR_INVALID_DATA;
+		}
+		bits = (uint64_t)1 << shift;
+	} else {
+		bits = (uint64_t)dw[1] + 1;
+	}
+	flash->size = bits / 8 > SFDP_FLASH_AHB_SIZE ? SFDP_FLASH_AHB_SIZE : bits / 8;
+
+	/* Devices up to 16 MiB or with 3-byte mode are used with 3-byte addresses */
+	flash->addr_4byte = BFPT_DW1_ADDR_BYTES(dw[0]) == BFPT_DW1_ADDR_4BYTE_ONLY;
+
+	flash->page_size = 256;
+	if (dwords >= 11) {
+		flash->page_size = 1u << BFPT_DW11_PAGE_SHIFT(dw[10]);
+	}
+
+	for (uint8_t i = 0; i < SFDP_FLASH_ERASE_TYPES; i++) {
+		uint16_t type = dw[7 + i / 2] >> (16 * (i % 2));
+
+		flash->erase[i].size_shift = type & 0xFF;
+		flash->erase[i].opcode     = flash->erase[i].size_shift ? type >> 8 : 0;
+	}
+
+	if (dwords >= 15) {
+		qer = BFPT_DW15_QER(dw[14]);
+	}
+
+	/* Fastest read: 1-4-4, 1-1-4, then single line fast read */
+	if (qer != 0xFF && (dw[0] & (BFPT_DW1_FAST_READ_144 | BFPT_DW1_FAST_READ_114))) {
+		quad = sfdp_flash_quad_enable(flash, qer) == ERR_NONE;
+	}
+	if (quad && (dw[0] & BFPT_DW1_FAST_READ_144)) {
+		sfdp_flash_set_read(flash, dw[2], QSPI_INST1_ADDR4_DATA4, 4);
+	} else if (quad) {
+		sfdp_flash_set_read(flash, dw[2] >> 16, QSPI_INST1_ADDR1_DATA4, 1);
+	} else {
+		flash->read_opcode = SFDP_FLASH_FAST_READ;
+		flash->read_width  = QSPI_INST1_ADDR1_DATA1;
+		flash->read_dummy  = 8;
+		flash->read_opt_en = false;
+	}
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Construct serial NOR flash from its SFDP tables
+ */
+struct spi_nor_flash *sfdp_flash_construct(struct spi_nor_flash *const me, void *const io)
+{
+	struct sfdp_flash *flash = (struct sfdp_flash *)me;
+	uint32_t           header[2];
+	uint32_t           param[2];
+	uint32_t           bfpt[SFDP_BFPT_DWORDS];
+	uint8_t            headers;
+	uint8_t            dwords;
+
+	spi_nor_flash_construct(me, io, &sfdp_flash_interface);
+	flash->xip = false;
+
+	if (sfdp_flash_read_sfdp(flash, 0, header, sizeof(header)) || header[0] != SFDP_SIGNATURE) {
+		return NULL;
+	}
+
+	/* Number of parameter headers is zero based */
+	headers = ((header[1] >> 16) & 0xFF) + 1;
+	if (headers > SFDP_MAX_HEADERS) {
+		headers = SFDP_MAX_HEADERS;
+	}
+
+	/* The basic flash parameter table is always first, later revisions follow it */
+	dwords = 0;
+	for (uint8_t i = 0; i < headers; i++) {
+		if (sfdp_flash_read_sfdp(flash, 8 + 8 * i, param, sizeof(param))) {
+			return NULL;
+		}
+		/* ID LSB in byte 0, ID MSB in byte 7 */
+		if ((param[0] & 0xFF) != 0x00 || (param[1] >> 24) != 0xFF) {
+			continue;
+		}
+		dwords = (param[0] >> 24) & 0xFF;
+		if (dwords > SFDP_BFPT_DWORDS) {
+			dwords = SFDP_BFPT_DWORDS;
+		}
+		memset(bfpt, 0, sizeof(bfpt));
+		if (sfdp_flash_read_sfdp(flash, param[1] & 0xFFFFFF, bfpt, dwords * 4)) {
+			return NULL;
+		}
+	}
+
+	if (dwords < 9 || sfdp_flash_parse_bfpt(flash, bfpt, dwords)) {
+		return NULL;
+	}
+
+	return me;
+}
+
+/**
+ * \brief Read bytes from the given flash
+ */
+int32_t sfdp_flash_read(struct spi_nor_flash *const me, uint8_t *const buf, const uint32_t address,
+                        const uint32_t length)
+{
+	struct sfdp_flash *  flash = (struct sfdp_flash *)me;
+	struct _qspi_command cmd;
+
+	if (address > flash->size || length > flash->size - address) {
+		return ERR_INVALID_ARG;
+	}
+	if (!length) {
+		return ERR_NONE;
+	}
+
+	if (flash->xip) {
+		memcpy(buf, (const uint8_t *)QSPI_AHB + address, length);
+		return ERR_NONE;
+	}
+
+	sfdp_flash_read_command(flash, &cmd);
+	cmd.address = address;
+	cmd.buf_len = length;
+	cmd.rx_buf  = buf;
+
+	return qspi_sync_serial_run_command((struct qspi_sync_descriptor *)me->io, &cmd);
+}
+
+/**
+ * \brief Program one page or less
+ */
+static int32_t sfdp_flash_program(struct sfdp_flash *const flash, const uint8_t *const buf, const uint32_t address,
+                                  const uint32_t length)
+{
+	struct _qspi_command cmd = {0};
+	int32_t              rc;
+
+	rc = sfdp_flash_command(flash, SFDP_FLASH_WRITE_ENABLE, QSPI_WRITE_ACCESS, NULL, NULL, 0);
+	if (rc) {
+		return rc;
+	}
+
+	cmd.inst_frame.bits.width    = QSPI_INST1_ADDR1_DATA1;
+	cmd.inst_frame.bits.inst_en  = 1;
+	cmd.inst_frame.bits.addr_en  = 1;
+	cmd.inst_frame.bits.data_en  = 1;
+	cmd.inst_frame.bits.addr_len = flash->addr_4byte;
+	cmd.inst_frame.bits.tfr_type = QSPI_WRITEMEM_ACCESS;
+	cmd.instruction              = SFDP_FLASH_PAGE_PROGRAM;
+	cmd.address                  = address;
+	cmd.buf_len                  = length;
+	cmd.tx_buf                   = buf;
+
+	rc = qspi_sync_serial_run_command((struct qspi_sync_descriptor *)flash->parent.io, &cmd);
+	if (rc) {
+		return rc;
+	}
+
+	return sfdp_flash_wait_ready(flash);
+}
+
+/**
+ * \brief Program bytes into the given flash
+ */
+int32_t sfdp_flash_write(struct spi_nor_flash *const me, const uint8_t *const buf, const uint32_t address,
+                         const uint32_t length)
+{
+	struct sfdp_flash *flash  = (struct sfdp_flash *)me;
+	uint32_t           offset = 0;
+	bool               xip    = flash->xip;
+	int32_t            rc     = ERR_NONE;
+
+	if (address > flash->size || length > flash->size - address) {
+		return ERR_INVALID_ARG;
+	}
+
+	if (xip) {
+		sfdp_flash_disable_xip(me);
+	}
+
+	while (offset < length && !rc) {
+		uint32_t addr  = address + offset;
+		uint32_t chunk = flash->page_size - (addr & (flash->page_size - 1));
+
+		if (chunk > length - offset) {
+			chunk = length - offset;
+		}
+		rc = sfdp_flash_program(flash, buf + offset, addr, chunk);
+		offset += chunk;
+	}
+
+	if (xip) {
+		sfdp_flash_enable_xip(me);
+	}
+
+	return rc;
+}
+
+/**
+ * \brief Erase one erase unit
+ */
+static int32_t sfdp_flash_erase_unit(struct sfdp_flash *const flash, const uint8_t opcode, const bool addr_en,
+                                     const uint32_t address)
+{
+	struct _qspi_command cmd = {0};
+	int32_t              rc;
+
+	rc = sfdp_flash_command(flash, SFDP_FLASH_WRITE_ENABLE, QSPI_WRITE_ACCESS, NULL, NULL, 0);
+	if (rc) {
+		return rc;
+	}
+
+	cmd.inst_frame.bits.width    = QSPI_INST1_ADDR1_DATA1;
+	cmd.inst_frame.bits.inst_en  = 1;
+	cmd.inst_frame.bits.addr_en  = addr_en;
+	cmd.inst_frame.bits.addr_len = flash->addr_4byte;
+	cmd.inst_frame.bits.tfr_type = QSPI_WRITE_ACCESS;
+	cmd.instruction              = opcode;
+	cmd.address                  = address;
+
+	rc = qspi_sync_serial_run_command((struct qspi_sync_descriptor *)flash->parent.io, &cmd);
+	if (rc) {
+		return rc;
+	}
+
+	return sfdp_flash_wait_ready(flash);
+}
+
+/**
+ * \brief Erase an area of the given flash
+ */
+int32_t sfdp_flash_erase(struct spi_nor_flash *const me, const uint32_t address, const uint32_t length)
+{
+	struct sfdp_flash *flash = (struct sfdp_flash *)me;
+	uint32_t           addr  = address;
+	uint32_t           end   = address + length;
+	bool               xip   = flash->xip;
+	int32_t            rc    = ERR_NONE;
+
+	if (address > flash->size || length > flash->size - address) {
+		return ERR_INVALID_ARG;
+	}
+
+	if (xip) {
+		sfdp_flash_disable_xip(me);
+	}
+
+	if (!address && length == flash->size) {
+		rc = sfdp_flash_erase_unit(flash, SFDP_FLASH_CHIP_ERASE, false, 0);
+		addr = end;
+	}
+
+	while (addr < end && !rc) {
+		const struct sfdp_flash_erase *best = NULL;
+
+		/* Largest erase type aligned to the address and fitting the rest */
+		for (uint8_t i = 0; i < SFDP_FLASH_ERASE_TYPES; i++) {
+			const struct sfdp_flash_erase *type = &flash->erase[i];
+			uint32_t                       size = 1u << (type->size_shift & 0x1F);
+
+			if (!type->opcode || type->size_shift > 31 || (addr & (size - 1)) || size > end - addr) {
+				continue;
+			}
+			if (!best || type->size_shift > best->size_shift) {
+				best = type;
+			}
+		}
+		if (!best) {
+			rc = ERR_INVALID_ARG;
+			break;
+		}
+		rc = sfdp_flash_erase_unit(flash, best->opcode, true, addr);
+		addr += 1u << best->size_shift;
+	}
+
+	if (xip) {
+		sfdp_flash_enable_xip(me);
+	}
+
+	return rc;
+}
+
+/**
+ * \brief Map the given flash into the QSPI AHB window
+ */
+int32_t sfdp_flash_enable_xip(struct spi_nor_flash *const me)
+{
+	struct sfdp_flash *  flash = (struct sfdp_flash *)me;
+	struct _qspi_command cmd;
+	int32_t              rc;
+
+	sfdp_flash_read_command(flash, &cmd);
+	rc = qspi_sync_enable_xip((struct qspi_sync_descriptor *)me->io, &cmd);
+	if (!rc) {
+		flash->xip = true;
+	}
+
+	return rc;
+}
+
+/**
+ * \brief Remove the given flash from the QSPI AHB window
+ */
+int32_t sfdp_flash_disable_xip(struct spi_nor_flash *const me)
+{
+	struct sfdp_flash *flash = (struct sfdp_flash *)me;
+
+	flash->xip = false;
+
+	return qspi_sync_disable_xip((struct qspi_sync_descriptor *)me->io);
+}
+
+/**
+ * \brief Measure the time a read or a program of the given flash takes
+ */
+int32_t sfdp_flash_benchmark(struct spi_nor_flash *const me, const bool program, uint8_t *const buf,
+                             const uint32_t address, const uint32_t length, uint32_t *const cycles)
+{
+	uint32_t demcr = CoreDebug->DEMCR;
+	uint32_t dwt   = DWT->CTRL;
+	uint32_t start;
+	int32_t  rc;
+
+	ASSERT(me && buf && cycles);
+
+	/* Count CPU cycles with the DWT */
+	CoreDebug->DEMCR = demcr | CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL        = dwt | DWT_CTRL_CYCCNTENA_Msk;
+
+	start   = DWT->CYCCNT;
+	rc      = program ? sfdp_flash_write(me, buf, address, length) : sfdp_flash_read(me, buf, address, length);
+	*cycles = DWT->CYCCNT - start;
+
+	DWT->CTRL        = dwt;
+	CoreDebug->DEMCR = demcr;
+
+	return rc;
+}
+
+/**
+ * \brief Convert a measurement to bytes per second
+ */
+static uint32_t sfdp_flash_bytes_per_sec(const uint32_t length, const uint32_t cycles, const uint32_t cpu_freq)
+{
+	return (uint32_t)((uint64_t)length * cpu_freq / (cycles ? cycles : 1));
+}
+
+/**
+ * \brief Measure the read and program throughput for several transfer sizes
+ */
+int32_t sfdp_flash_throughput(struct spi_nor_flash *const me, const uint32_t address, uint8_t *const buf,
+                              const uint32_t cpu_freq, struct sfdp_flash_throughput *const results,
+                              const uint8_t count)
+{
+	struct sfdp_flash *flash = (struct sfdp_flash *)me;
+	uint32_t           unit  = 0;
+	uint32_t           cycles;
+	uint8_t            i;
+	int32_t            rc;
+
+	ASSERT(me && buf && (results || !count));
+
+	/* Smallest erase type, the programmed areas are erased in its units */
+	for (i = 0; i < SFDP_FLASH_ERASE_TYPES; i++) {
+		const struct sfdp_flash_erase *type = &flash->erase[i];
+
+		if (type->opcode && type->size_shift <= 31 && (!unit || (1u << type->size_shift) < unit)) {
+			unit = 1u << type->size_shift;
+		}
+	}
+	if (!unit) {
+		return ERR_UNSUPPORTED_OP;
+	}
+
+	for (i = 0; i < count; i++) {
+		uint32_t length = results[i].length;
+
+		/* Erase outside of the measurement */
+		rc = sfdp_flash_erase(me, address, (length + unit - 1) & ~(unit - 1));
+		if (rc == ERR_NONE) {
+			rc = sfdp_flash_benchmark(me, true, buf, address, length, &cycles);
+		}
+		if (rc != ERR_NONE) {
+			return rc;
+		}
+		results[i].program = sfdp_flash_bytes_per_sec(length, cycles, cpu_freq);
+
+		rc = sfdp_flash_benchmark(me, false, buf, address, length, &cycles);
+		if (rc != ERR_NONE) {
+			return rc;
+		}
+		results[i].read = sfdp_flash_bytes_per_sec(length, cycles, cpu_freq);
+	}
+
+	return ERR_NONE;
+}
@@ -0,0 +1,199 @@
+/**
+ * \file
+ *
+ * \brief SFDP discovered serial NOR flash declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+/*
+ * Support and FAQ: visit <a href="https://www.microchip.com/support/">Microchip Support</a>
+ */
+
+#ifndef _SFDP_FLASH_H_INCLUDED
+#define _SFDP_FLASH_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <spi_nor_flash.h>
+
+/** Size of the QSPI AHB window, the addressable part of the flash */
+#define SFDP_FLASH_AHB_SIZE 0x01000000u
+
+/** Number of erase types described by SFDP */
+#define SFDP_FLASH_ERASE_TYPES 4
+
+/**
+ * \brief Serial NOR flash erase type
+ */
+struct sfdp_flash_erase {
+	/** Erase instruction, 0 when the type is not supported */
+	uint8_t opcode;
+	/** Erase size as power of two */
+	uint8_t size_shift;
+};
+
+/**
+ * \brief Serial NOR flash described by its SFDP tables
+ */
+struct sfdp_flash {
+	/** The parent abstract SPI NOR flash */
+	struct spi_nor_flash parent;
+	/** Usable flash size in bytes */
+	uint32_t size;
+	/** Page program size in bytes */
+	uint32_t page_size;
+	/** Read instruction */
+	uint8_t read_opcode;
+	/** Read instruction width, enum qspi_cmd_width */
+	uint8_t read_width;
+	/** Dummy cycles of the read instruction */
+	uint8_t read_dummy;
+	/** Mode bits length of the read instruction, enum qspi_cmd_opt_len */
+	uint8_t read_opt_len;
+	/** Read instruction has mode bits */
+	bool read_opt_en;
+	/** Flash uses 4-byte addresses */
+	bool addr_4byte;
+	/** Flash is mapped in the QSPI AHB window */
+	bool xip;
+	/** Supported erase types */
+	struct sfdp_flash_erase erase[SFDP_FLASH_ERASE_TYPES];
+};
+
+/**
+ * \brief Read and program throughput of one transfer size
+ */
+struct sfdp_flash_throughput {
+	/** Transfer size in bytes, set by the caller */
+	uint32_t length;
+	/** Read throughput in bytes per second */
+	uint32_t read;
+	/** Program throughput in bytes per second, including the page program time */
+	uint32_t program;
+};
+
+/**
+ * \brief Construct serial NOR flash from its SFDP tables
+ *
+ * Reads the basic flash parameter table to discover size, page size, erase
+ * types and the fastest read instruction. The quad enable bit is set when a
+ * quad read instruction is selected.
+ *
+ * \param[in] me The pointer to SPI NOR flash to initialize
+ * \param[in] io The pointer to the enabled struct qspi_sync_descriptor
+ *
+ * \return pointer to initialized flash, NULL if the flash has no valid SFDP
+ */
+struct spi_nor_flash *sfdp_flash_construct(struct spi_nor_flash *const me, void *const io);
+
+/**
+ * \brief Read bytes from the given flash
+ *
+ * Goes through the AHB window, with quad data lines if the flash supports it.
+ */
+int32_t sfdp_flash_read(struct spi_nor_flash *const me, uint8_t *const buf, const uint32_t address,
+                        const uint32_t length);
+
+/**
+ * \brief Program bytes into the given flash
+ */
+int32_t sfdp_flash_write(struct spi_nor_flash *const me, const uint8_t *const buf, const uint32_t address,
+                         const uint32_t length);
+
+/**
+ * \brief Erase an area of the given flash
+ *
+ * Uses the largest erase types that fit the area. The area must be aligned to
+ * the smallest erase type.
+ */
+int32_t sfdp_flash_erase(struct spi_nor_flash *const me, const uint32_t address, const uint32_t length);
+
+/**
+ * \brief Map the given flash into the QSPI AHB window
+ *
+ * Puts the QSPI in memory mode with the read instruction, so the flash can be
+ * read and executed at QSPI_AHB. Write and erase leave memory mode for the
+ * duration of the operation, so they must not be called while executing from
+ * the flash. Cached copies of the window are not invalidated.
+ */
+int32_t sfdp_flash_enable_xip(struct spi_nor_flash *const me);
+
+/**
+ * \brief Remove the given flash from the QSPI AHB window
+ */
+int32_t sfdp_flash_disable_xip(struct spi_nor_flash *const me);
+
+/**
+ * \brief Measure the time a read or a program of the given flash takes
+ *
+ * Counts the CPU cycles of one sfdp_flash_read or sfdp_flash_write with the
+ * DWT. A program includes the page program time of the flash. Interrupts
+ * taken during the measurement are included.
+ *
+ * \param[in] me The pointer to SPI NOR flash
+ * \param[in] program true to program the buffer, false to read into it
+ * \param[in] buf The buffer, its alignment selects the copy path of the QSPI
+ * \param[in] address The flash address, erased before a program
+ * \param[in] length The number of bytes
+ * \param[out] cycles The number of CPU cycles spent
+ *
+ * \return Operation status.
+ */
+int32_t sfdp_flash_benchmark(struct spi_nor_flash *const me, const bool program, uint8_t *const buf,
+                             const uint32_t address, const uint32_t length, uint32_t *const cycles);
+
+/**
+ * \brief Measure the read and program throughput for several transfer sizes
+ *
+ * For each entry of results, erases the area at address, programs length
+ * bytes of buf into it and reads them back, each measured with
+ * sfdp_flash_benchmark. The erase is not measured. The content of the area
+ * is lost. When the flash is mapped in the AHB window, reads go through the
+ * CMCC, which should be disabled so that they reach the flash.
+ *
+ * \param[in] me The pointer to SPI NOR flash
+ * \param[in] address The area to use, aligned to the smallest erase type
+ * \param[in] buf The buffer, as long as the longest transfer
+ * \param[in] cpu_freq The CPU frequency in Hz, typically CONF_CPU_FREQUENCY
+ * \param[in, out] results The transfer sizes in, the throughputs out
+ * \param[in] count The number of results
+ *
+ * \return Operation status.
+ * \retval ERR_UNSUPPORTED_OP The flash has no erase type
+ */
+int32_t sfdp_flash_throughput(struct spi_nor_flash *const me, const uint32_t address, uint8_t *const buf,
+                              const uint32_t cpu_freq, struct sfdp_flash_throughput *const results,
+                              const uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SFDP_FLASH_H_INCLUDED */
@@ -0,0 +1,142 @@
+/**
+ * \file
+ *
+ * \brief SPI NOR Flash declaration.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+#ifndef _SPI_NOR_FLASH_H_INCLUDED
+#define _SPI_NOR_FLASH_H_INCLUDED
+
+#include <compiler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Forward declaration of SPI NOR flash structure. */
+struct spi_nor_flash;
+
+/**
+ * \brief Interface of abstract SPI NOR flash
+ */
+struct spi_nor_flash_interface {
+	int32_t (*read)(struct spi_nor_flash *const me, uint8_t *const buf, const uint32_t address,
+	                const uint32_t length);
+	int32_t (*write)(struct spi_nor_flash *const me, const uint8_t *const buf, const uint32_t address,
+	                 const uint32_t length);
+	int32_t (*erase)(struct spi_nor_flash *const me, const uint32_t address, const uint32_t length);
+	int32_t (*enable_xip)(struct spi_nor_flash *const me);
+	int32_t (*disable_xip)(struct spi_nor_flash *const me);
+};
+
+/**
+ * \brief Abstract SPI NOR flash
+ */
+struct spi_nor_flash {
+	/** The pointer to interface used to communicate with the flash */
+	void *io;
+	/** The interface of abstract SPI NOR flash */
+	const struct spi_nor_flash_interface *interface;
+};
+
+/**
+ * \brief Construct abstract SPI NOR flash
+ *
+ * \param[in] me The pointer to SPI NOR flash to initialize
+ * \param[in] io The pointer to instance of interface to actual flash
+ * \param[in] interface The pointer to interface of SPI NOR flash
+ *
+ * \return pointer to initialized flash
+ */
+struct spi_nor_flash *spi_nor_flash_construct(struct spi_nor_flash *const me, void *const io,
+                                              const struct spi_nor_flash_interface *const interface);
+
+/**
+ * \brief Read bytes from the given flash
+ *
+ * \param[in] me The pointer to SPI NOR flash
+ * \param[out] buf The buffer to read to
+ * \param[in] address The flash address to read from
+ * \param[in] length The number of bytes to read
+ *
+ * \return Read status.
+ */
+int32_t spi_nor_flash_read(struct spi_nor_flash *const me, uint8_t *const buf, const uint32_t address,
+                           const uint32_t length);
+
+/**
+ * \brief Program bytes into the given flash
+ *
+ * The area must have been erased before.
+ *
+ * \param[in] me The pointer to SPI NOR flash
+ * \param[in] buf The buffer to program from
+ * \param[in] address The flash address to program to
+ * \param[in] length The number of bytes to program
+ *
+ * \return Write status.
+ */
+int32_t spi_nor_flash_write(struct spi_nor_flash *const me, const uint8_t *const buf, const uint32_t address,
+                            const uint32_t length);
+
+/**
+ * \brief Erase an area of the given flash
+ *
+ * \param[in] me The pointer to SPI NOR flash
+ * \param[in] address The start of the area, aligned to the erase granularity
+ * \param[in] length The size of the area, a multiple of the erase granularity
+ *
+ * \return Erase status.
+ */
+int32_t spi_nor_flash_erase(struct spi_nor_flash *const me, const uint32_t address, const uint32_t length);
+
+/**
+ * \brief Map the given flash into the memory space for execute in place
+ *
+ * \param[in] me The pointer to SPI NOR flash
+ *
+ * \return Operation status.
+ */
+int32_t spi_nor_flash_enable_xip(struct spi_nor_flash *const me);
+
+/**
+ * \brief Remove the given flash from the memory space
+ *
+ * \param[in] me The pointer to SPI NOR flash
+ *
+ * \return Operation status.
+ */
+int32_t spi_nor_flash_disable_xip(struct spi_nor_flash *const me);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SPI_NOR_FLASH_H_INCLUDED */
@@ -0,0 +1,369 @@
+/**
+ * \file
+ *
+ * \brief Software model of the SAM AES peripheral for host tests
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+/*
+ * A plain FIPS-197 AES, byte oriented and without tables beyond the S-boxes,
+ * behind the registers of hri_aes_e53.h. Register words hold the bytes in
+ * memory order, little-endian, as hpl_aes.c writes them.
+ */
+
+#include <compiler.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct aes_model aes_model;
+
+static const uint8_t aes_model_sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9,
+    0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0, 0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f,
+    0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15, 0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07,
+    0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75, 0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3,
+    0x29, 0xe3, 0x2f, 0x84, 0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58,
+    0xcf, 0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8, 0x51, 0xa3,
+    0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2, 0xcd, 0x0c, 0x13, 0xec, 0x5f,
+    0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73, 0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88,
+    0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb, 0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac,
+    0x62, 0x91, 0x95, 0xe4, 0x79, 0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a,
+    0xae, 0x08, 0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a, 0x70,
+    0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e, 0xe1, 0xf8, 0x98, 0x11,
+    0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf, 0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42,
+    0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16};
+
+static uint8_t aes_model_inv_sbox[256];
+
+/**
+ * \brief Multiply by x in GF(2^8)
+ */
+static uint8_t aes_model_xtime(const uint8_t a)
+{
+	return (uint8_t)((a << 1) ^ ((a & 0x80) ? 0x1b : 0x00));
+}
+
+static uint8_t aes_model_mul(uint8_t a, uint8_t b)
+{
+	uint8_t p = 0;
+
+	while (b) {
+		if (b & 1) {
+			p ^= a;
+		}
+		a = aes_model_xtime(a);
+		b >>= 1;
+	}
+
+	return p;
+}
+
+/**
+ * \brief Expand the key, 4 * (rounds + 1) words of 4 bytes
+ *
+ * \return The number of rounds
+ */
+static uint8_t aes_model_expand_key(const uint8_t *key, const uint8_t key_words, uint8_t w[240])
+{
+	uint8_t rounds = key_words + 6;
+	uint8_t rcon   = 1;
+	uint8_t t[4], tmp;
+	uint8_t i;
+
+	memcpy(w, key, key_words * 4);
+	for (i = key_words; i < 4 * (rounds + 1); i++) {
+		memcpy(t, &w[(i - 1) * 4], 4);
+		if (!(i % key_words)) {
+			tmp  = t[0];
+			t[0] = aes_model_sbox[t[1]] ^ rcon;
+			t[1] = aes_model_sbox[t[2]];
+			t[2] = aes_model_sbox[t[3]];
+			t[3] = aes_model_sbox[tmp];
+			rcon = aes_model_xtime(rcon);
+		} else if ((key_words > 6) && ((i % key_words) == 4)) {
+			t[0] = aes_model_sbox[t[0]];
+			t[1] = aes_model_sbox[t[1]];
+			t[2] = aes_model_sbox[t[2]];
+			t[3] = aes_model_sbox[t[3]];
+		}
+		w[i * 4 + 0] = w[(i - key_words) * 4 + 0] ^ t[0];
+		w[i * 4 + 1] = w[(i - key_words) * 4 + 1] ^ t[1];
+		w[i * 4 + 2] = w[(i - key_words) * 4 + 2] ^ t[2];
+		w[i * 4 + 3] = w[(i - key_words) * 4 + 3] ^ t[3];
+	}
+
+	return rounds;
+}
+
+static void aes_model_add_round_key(uint8_t s[16], const uint8_t *rk)
+{
+	uint8_t i;
+
+	for (i = 0; i < 16; i++) {
+		s[i] ^= rk[i];
+	}
+}
+
+/**
+ * \brief Rotate row r of the column-major state by r bytes
+ */
+static void aes_model_shift_rows(uint8_t s[16], const bool inverse)
+{
+	uint8_t t[16];
+	uint8_t r, c;
+
+	for (r = 0; r < 4; r++) {
+		for (c = 0; c < 4; c++) {
+			if (inverse) {
+				t[((c + r) % 4) * 4 + r] = s[c * 4 + r];
+			} else {
+				t[c * 4 + r] = s[((c + r) % 4) * 4 + r];
+			}
+		}
+	}
+	memcpy(s, t, 16);
+}
+
+static void aes_model_mix_columns(uint8_t s[16], const bool inverse)
+{
+	const uint8_t m[4] = {2, 3, 1, 1};
+	const uint8_t n[4] = {14, 11, 13, 9};
+	const uint8_t *k   = inverse ? n : m;
+	uint8_t        col[4];
+	uint8_t        c, r;
+
+	for (c = 0; c < 4; c++) {
+		memcpy(col, &s[c * 4], 4);
+		for (r = 0; r < 4; r++) {
+			s[c * 4 + r] = aes_model_mul(col[0], k[(4 - r) % 4]) ^ aes_model_mul(col[1], k[(5 - r) % 4])
+			               ^ aes_model_mul(col[2], k[(6 - r) % 4]) ^ aes_model_mul(col[3], k[(7 - r) % 4]);
+		}
+	}
+}
+
+/**
+ * \brief Encrypt or decrypt one block
+ */
+void aes_model_crypt(const bool encrypt, const uint8_t *key, const uint8_t key_words, const uint8_t in[16],
+                     uint8_t out[16])
+{
+	uint8_t  w[240];
+	uint8_t  s[16];
+	uint8_t  rounds, round, i;
+	uint16_t n;
+
+	for (n = 0; n < 256; n++) {
+		aes_model_inv_sbox[aes_model_sbox[n]] = (uint8_t)n;
+	}
+
+	rounds = aes_model_expand_key(key, key_words, w);
+	memcpy(s, in, 16);
+
+	if (encrypt) {
+		aes_model_add_round_key(s, w);
+		for (round = 1; round <= rounds; round++) {
+			for (i = 0; i < 16; i++) {
+				s[i] = aes_model_sbox[s[i]];
+			}
+			aes_model_shift_rows(s, false);
+			if (round != rounds) {
+				aes_model_mix_columns(s, false);
+			}
+			aes_model_add_round_key(s, &w[round * 16]);
+		}
+	} else {
+		aes_model_add_round_key(s, &w[rounds * 16]);
+		for (round = rounds; round >= 1; round--) {
+			aes_model_shift_rows(s, true);
+			for (i = 0; i < 16; i++) {
+				s[i] = aes_model_inv_sbox[s[i]];
+			}
+			aes_model_add_round_key(s, &w[(round - 1) * 16]);
+			if (round != 1) {
+				aes_model_mix_columns(s, true);
+			}
+		}
+	}
+
+	memcpy(out, s, 16);
+}
+
+static void aes_model_words_to_bytes(const uint32_t *words, uint8_t *bytes, const uint8_t count)
+{
+	uint8_t i;
+
+	for (i = 0; i < count * 4; i++) {
+		bytes[i] = (uint8_t)(words[i / 4] >> (8 * (i % 4)));
+	}
+}
+
+static void aes_model_bytes_to_words(const uint8_t *bytes, uint32_t *words, const uint8_t count)
+{
+	uint8_t i;
+
+	for (i = 0; i < count; i++) {
+		words[i] = bytes[i * 4] | (bytes[i * 4 + 1] << 8) | (bytes[i * 4 + 2] << 16) | ((uint32_t)bytes[i * 4 + 3] << 24);
+	}
+}
+
+/**
+ * \brief X = X * H in GF(2^128), SP 800-38D algorithm 1
+ */
+static void aes_model_gfmul(uint8_t x[16], const uint8_t h[16])
+{
+	uint8_t z[16] = {0};
+	uint8_t v[16];
+	uint8_t carry, lsb;
+	uint8_t i, j;
+
+	memcpy(v, h, 16);
+	for (i = 0; i < 128; i++) {
+		if (x[i / 8] & (0x80 >> (i % 8))) {
+			for (j = 0; j < 16; j++) {
+				z[j] ^= v[j];
+			}
+		}
+		lsb   = v[15] & 1;
+		carry = 0;
+		for (j = 0; j < 16; j++) {
+			const uint8_t b = v[j];
+
+			v[j]  = (b >> 1) | carry;
+			carry = (uint8_t)(b << 7);
+		}
+		if (lsb) {
+			v[0] ^= 0xe1;
+		}
+	}
+	memcpy(x, z, 16);
+}
+
+/**
+ * \brief GHASH = (GHASH ^ block) * HASHKEY
+ */
+static void aes_model_ghash(const uint8_t block[16])
+{
+	uint8_t x[16];
+	uint8_t h[16];
+	uint8_t i;
+
+	aes_model_words_to_bytes(aes_model.ghash, x, 4);
+	aes_model_words_to_bytes(aes_model.hashkey, h, 4);
+	for (i = 0; i < 16; i++) {
+		x[i] ^= block[i];
+	}
+	aes_model_gfmul(x, h);
+	aes_model_bytes_to_words(x, aes_model.ghash, 4);
+}
+
+/**
+ * \brief Process the block in INDATA, as CTRLB.START does
+ *
+ * An ECB encryption also leaves its result in HASHKEY, that is how the hash
+ * subkey H = E(K, 0) is generated for GCM. In GCM mode with GFMUL set, the
+ * block is multiplied into GHASH, otherwise the block is en/decrypted in
+ * counter mode and the ciphertext, cut to CIPLEN, is hashed into GHASH.
+ */
+void aes_model_start(void)
+{
+	uint8_t  key[32];
+	uint8_t  in[16];
+	uint8_t  out[16];
+	uint8_t  key_words = (((aes_model.ctrla & AES_CTRLA_KEYSIZE_Msk) >> AES_CTRLA_KEYSIZE_Pos) + 2) * 2;
+	uint32_t mode      = (aes_model.ctrla & AES_CTRLA_AESMODE_Msk) >> AES_CTRLA_AESMODE_Pos;
+	bool     encrypt   = (aes_model.ctrla & AES_CTRLA_CIPHER) != 0;
+	uint32_t left;
+	uint8_t  i;
+
+	if (!(aes_model.ctrla & AES_CTRLA_ENABLE)
+	    || ((mode != AES_CTRLA_AESMODE_ECB_Val) && (mode != AES_CTRLA_AESMODE_CBC_Val)
+	        && (mode != AES_CTRLA_AESMODE_COUNTER_Val) && (mode != AES_CTRLA_AESMODE_GCM_Val))) {
+		printf("aes_model: started while disabled or in an unmodelled mode\n");
+		exit(1);
+	}
+
+	aes_model_words_to_bytes(aes_model.keyword, key, key_words);
+	aes_model_words_to_bytes(aes_model.indata, in, 4);
+
+	if ((mode == AES_CTRLA_AESMODE_GCM_Val) && (aes_model.ctrlb & AES_CTRLB_GFMUL)) {
+		aes_model_ghash(in);
+		aes_model.intflag |= AES_INTFLAG_GFMCMP;
+		aes_model.blocks++;
+		return;
+	}
+
+	if ((mode != AES_CTRLA_AESMODE_ECB_Val) && aes_model.new_message) {
+		aes_model_words_to_bytes(aes_model.intvectv, aes_model.chain, 4);
+		aes_model.offset      = 0;
+		aes_model.new_message = false;
+	}
+
+	if (mode == AES_CTRLA_AESMODE_ECB_Val) {
+		aes_model_crypt(encrypt, key, key_words, in, out);
+		if (encrypt) {
+			aes_model_bytes_to_words(out, aes_model.hashkey, 4);
+		}
+	} else if ((mode == AES_CTRLA_AESMODE_COUNTER_Val) || (mode == AES_CTRLA_AESMODE_GCM_Val)) {
+		aes_model_crypt(true, key, key_words, aes_model.chain, out);
+		for (i = 0; i < 16; i++) {
+			out[i] ^= in[i];
+		}
+		/* GCM increments the low 32 bits of the counter, CTR all 128 */
+		for (i = 16; i > ((mode == AES_CTRLA_AESMODE_GCM_Val) ? 12 : 0); i--) {
+			if (++aes_model.chain[i - 1]) {
+				break;
+			}
+		}
+		if (mode == AES_CTRLA_AESMODE_GCM_Val) {
+			uint8_t c[16] = {0};
+
+			left = (aes_model.ciplen > aes_model.offset) ? aes_model.ciplen - aes_model.offset : 0;
+			memcpy(c, encrypt ? out : in, (left < 16) ? left : 16);
+			aes_model_ghash(c);
+			aes_model.offset += 16;
+		}
+	} else if (encrypt) {
+		for (i = 0; i < 16; i++) {
+			in[i] ^= aes_model.chain[i];
+		}
+		aes_model_crypt(true, key, key_words, in, out);
+		memcpy(aes_model.chain, out, 16);
+	} else {
+		aes_model_crypt(false, key, key_words, in, out);
+		for (i = 0; i < 16; i++) {
+			out[i] ^= aes_model.chain[i];
+		}
+		memcpy(aes_model.chain, in, 16);
+	}
+
+	aes_model_bytes_to_words(out, aes_model.indata, 4);
+	aes_model.intflag |= AES_INTFLAG_ENCCMP;
+	aes_model.blocks++;
+}
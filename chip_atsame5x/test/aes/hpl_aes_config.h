@@ -0,0 +1,9 @@
+/* Configuration of hpl_aes.c for the host tests, no DMA */
+#ifndef HPL_AES_CONFIG_H
+#define HPL_AES_CONFIG_H
+
+#define CONF_AES_DBGCTRL 0
+
+#define CONF_AES_KEY_SLOTS 2
+
+#endif // HPL_AES_CONFIG_H
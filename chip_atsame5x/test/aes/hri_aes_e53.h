@@ -0,0 +1,347 @@
+/**
+ * \file
+ *
+ * \brief SAM AES register model for host tests
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+/*
+ * Found before hri/hri_aes_e53.h on the include path of the host tests. The
+ * register accessors used by hpl_aes.c operate on aes_model instead of the
+ * peripheral, the hw pointer is ignored. Starting an ECB, CBC, counter or GCM
+ * operation runs the software AES of aes_model.c, other modes fail the test.
+ */
+
+#ifdef _SAME53_AES_COMPONENT_
+#ifndef _HRI_AES_E53_H_INCLUDED_
+#define _HRI_AES_E53_H_INCLUDED_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <string.h>
+
+typedef uint32_t hri_aes_ciplen_reg_t;
+typedef uint32_t hri_aes_ctrla_reg_t;
+typedef uint32_t hri_aes_ghash_reg_t;
+typedef uint32_t hri_aes_hashkey_reg_t;
+typedef uint32_t hri_aes_indata_reg_t;
+typedef uint32_t hri_aes_intvectv_reg_t;
+typedef uint32_t hri_aes_keyword_reg_t;
+typedef uint8_t  hri_aes_ctrlb_reg_t;
+typedef uint8_t  hri_aes_databufptr_reg_t;
+typedef uint8_t  hri_aes_dbgctrl_reg_t;
+
+/**
+ * \brief Registers of the modelled AES peripheral
+ */
+struct aes_model {
+	hri_aes_ctrla_reg_t      ctrla;
+	hri_aes_ctrlb_reg_t      ctrlb;
+	uint8_t                  intflag;
+	hri_aes_databufptr_reg_t databufptr;
+	hri_aes_dbgctrl_reg_t    dbgctrl;
+	hri_aes_keyword_reg_t    keyword[8];
+	hri_aes_indata_reg_t     indata[4];
+	hri_aes_intvectv_reg_t   intvectv[4];
+	hri_aes_hashkey_reg_t    hashkey[4];
+	hri_aes_ghash_reg_t      ghash[4];
+	hri_aes_ciplen_reg_t     ciplen;
+	/** CBC chaining value or counter block */
+	uint8_t chain[16];
+	/** Bytes of the GCM message processed */
+	uint32_t offset;
+	/** The next block starts a new message */
+	bool new_message;
+	/** Number of blocks processed */
+	uint32_t blocks;
+};
+
+extern struct aes_model aes_model;
+
+/**
+ * \brief Process the block in INDATA, as CTRLB.START does
+ */
+void aes_model_start(void);
+
+/**
+ * \brief Encrypt or decrypt one block with a key of 4, 6 or 8 words
+ */
+void aes_model_crypt(const bool encrypt, const uint8_t *key, const uint8_t key_words, const uint8_t in[16],
+                     uint8_t out[16]);
+
+static inline bool hri_aes_get_interrupt_ENCCMP_bit(const void *const hw)
+{
+	(void)hw;
+	return (aes_model.intflag & AES_INTFLAG_ENCCMP) != 0;
+}
+
+static inline void hri_aes_clear_interrupt_ENCCMP_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.intflag &= ~AES_INTFLAG_ENCCMP;
+}
+
+static inline bool hri_aes_get_interrupt_GFMCMP_bit(const void *const hw)
+{
+	(void)hw;
+	return (aes_model.intflag & AES_INTFLAG_GFMCMP) != 0;
+}
+
+static inline void hri_aes_write_CTRLA_reg(const void *const hw, hri_aes_ctrla_reg_t data)
+{
+	(void)hw;
+	aes_model.ctrla = data;
+}
+
+static inline void hri_aes_set_CTRLA_SWRST_bit(const void *const hw)
+{
+	(void)hw;
+	memset(&aes_model, 0, sizeof(aes_model));
+}
+
+static inline void hri_aes_set_CTRLA_ENABLE_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrla |= AES_CTRLA_ENABLE;
+}
+
+static inline void hri_aes_clear_CTRLA_ENABLE_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrla &= ~AES_CTRLA_ENABLE;
+}
+
+static inline void hri_aes_set_CTRLA_CIPHER_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrla |= AES_CTRLA_CIPHER;
+}
+
+static inline void hri_aes_clear_CTRLA_CIPHER_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrla &= ~AES_CTRLA_CIPHER;
+}
+
+static inline void hri_aes_write_CTRLA_CIPHER_bit(const void *const hw, bool value)
+{
+	(void)hw;
+	aes_model.ctrla = (aes_model.ctrla & ~AES_CTRLA_CIPHER) | (value ? AES_CTRLA_CIPHER : 0);
+}
+
+static inline void hri_aes_write_CTRLA_STARTMODE_bit(const void *const hw, bool value)
+{
+	(void)hw;
+	aes_model.ctrla = (aes_model.ctrla & ~AES_CTRLA_STARTMODE) | (value ? AES_CTRLA_STARTMODE : 0);
+}
+
+static inline void hri_aes_set_CTRLA_LOD_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrla |= AES_CTRLA_LOD;
+}
+
+static inline void hri_aes_clear_CTRLA_LOD_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrla &= ~AES_CTRLA_LOD;
+}
+
+static inline void hri_aes_write_CTRLA_AESMODE_bf(const void *const hw, hri_aes_ctrla_reg_t data)
+{
+	(void)hw;
+	aes_model.ctrla = (aes_model.ctrla & ~AES_CTRLA_AESMODE_Msk) | AES_CTRLA_AESMODE(data);
+}
+
+static inline void hri_aes_clear_CTRLA_AESMODE_bf(const void *const hw, hri_aes_ctrla_reg_t mask)
+{
+	(void)hw;
+	aes_model.ctrla &= ~AES_CTRLA_AESMODE(mask);
+}
+
+static inline void hri_aes_write_CTRLA_CFBS_bf(const void *const hw, hri_aes_ctrla_reg_t data)
+{
+	(void)hw;
+	aes_model.ctrla = (aes_model.ctrla & ~AES_CTRLA_CFBS_Msk) | AES_CTRLA_CFBS(data);
+}
+
+static inline void hri_aes_clear_CTRLA_CFBS_bf(const void *const hw, hri_aes_ctrla_reg_t mask)
+{
+	(void)hw;
+	aes_model.ctrla &= ~AES_CTRLA_CFBS(mask);
+}
+
+static inline void hri_aes_write_CTRLA_KEYSIZE_bf(const void *const hw, hri_aes_ctrla_reg_t data)
+{
+	(void)hw;
+	aes_model.ctrla = (aes_model.ctrla & ~AES_CTRLA_KEYSIZE_Msk) | AES_CTRLA_KEYSIZE(data);
+}
+
+static inline void hri_aes_clear_CTRLA_CTYPE_bf(const void *const hw, hri_aes_ctrla_reg_t mask)
+{
+	(void)hw;
+	aes_model.ctrla &= ~AES_CTRLA_CTYPE(mask);
+}
+
+static inline void hri_aes_write_CTRLB_reg(const void *const hw, hri_aes_ctrlb_reg_t data)
+{
+	(void)hw;
+	aes_model.ctrlb = data;
+}
+
+static inline void hri_aes_set_CTRLB_START_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model_start();
+}
+
+static inline void hri_aes_set_CTRLB_NEWMSG_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrlb |= AES_CTRLB_NEWMSG;
+	aes_model.new_message = true;
+}
+
+static inline void hri_aes_clear_CTRLB_NEWMSG_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrlb &= ~AES_CTRLB_NEWMSG;
+}
+
+static inline void hri_aes_set_CTRLB_EOM_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrlb |= AES_CTRLB_EOM;
+}
+
+static inline void hri_aes_clear_CTRLB_EOM_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrlb &= ~AES_CTRLB_EOM;
+}
+
+static inline void hri_aes_set_CTRLB_GFMUL_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrlb |= AES_CTRLB_GFMUL;
+}
+
+static inline void hri_aes_clear_CTRLB_GFMUL_bit(const void *const hw)
+{
+	(void)hw;
+	aes_model.ctrlb &= ~AES_CTRLB_GFMUL;
+}
+
+static inline void hri_aes_write_DATABUFPTR_reg(const void *const hw, hri_aes_databufptr_reg_t data)
+{
+	(void)hw;
+	aes_model.databufptr = data;
+}
+
+static inline void hri_aes_clear_DATABUFPTR_INDATAPTR_bf(const void *const hw, hri_aes_databufptr_reg_t mask)
+{
+	(void)hw;
+	aes_model.databufptr &= ~AES_DATABUFPTR_INDATAPTR(mask);
+}
+
+static inline void hri_aes_write_DBGCTRL_reg(const void *const hw, hri_aes_dbgctrl_reg_t data)
+{
+	(void)hw;
+	aes_model.dbgctrl = data;
+}
+
+static inline void hri_aes_write_KEYWORD_reg(const void *const hw, uint8_t index, hri_aes_keyword_reg_t data)
+{
+	(void)hw;
+	aes_model.keyword[index] = data;
+}
+
+/* INDATA is accessed through DATABUFPTR, which moves to the next word */
+static inline void hri_aes_write_INDATA_reg(const void *const hw, hri_aes_indata_reg_t data)
+{
+	(void)hw;
+	aes_model.indata[aes_model.databufptr & 0x3] = data;
+	aes_model.databufptr                         = (aes_model.databufptr + 1) & 0x3;
+}
+
+static inline hri_aes_indata_reg_t hri_aes_read_INDATA_reg(const void *const hw)
+{
+	hri_aes_indata_reg_t data = aes_model.indata[aes_model.databufptr & 0x3];
+
+	(void)hw;
+	aes_model.databufptr = (aes_model.databufptr + 1) & 0x3;
+
+	return data;
+}
+
+static inline void hri_aes_write_INTVECTV_reg(const void *const hw, uint8_t index, hri_aes_intvectv_reg_t data)
+{
+	(void)hw;
+	aes_model.intvectv[index] = data;
+}
+
+static inline void hri_aes_write_HASHKEY_reg(const void *const hw, uint8_t index, hri_aes_hashkey_reg_t data)
+{
+	(void)hw;
+	aes_model.hashkey[index] = data;
+}
+
+static inline hri_aes_hashkey_reg_t hri_aes_read_HASHKEY_reg(const void *const hw, uint8_t index)
+{
+	(void)hw;
+	return aes_model.hashkey[index];
+}
+
+static inline void hri_aes_write_GHASH_reg(const void *const hw, uint8_t index, hri_aes_ghash_reg_t data)
+{
+	(void)hw;
+	aes_model.ghash[index] = data;
+}
+
+static inline hri_aes_ghash_reg_t hri_aes_read_GHASH_reg(const void *const hw, uint8_t index)
+{
+	(void)hw;
+	return aes_model.ghash[index];
+}
+
+static inline void hri_aes_write_CIPLEN_reg(const void *const hw, hri_aes_ciplen_reg_t data)
+{
+	(void)hw;
+	aes_model.ciplen = data;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HRI_AES_E53_H_INCLUDED_ */
+#endif /* _SAME53_AES_COMPONENT_ */
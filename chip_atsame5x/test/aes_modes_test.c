@@ -0,0 +1,447 @@
+/**
+ * \file
+ *
+ * \brief Host test of the AES-CMAC, AES-XTS, AES key wrap and AES-GCM modes.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+/*
+ * Known answer tests of hal_aes_sync and hpl_aes.c, running on the software
+ * model of the AES peripheral in aes/. The model itself is checked against
+ * the FIPS-197 examples first. Vectors:
+ * - NIST SP 800-38B, appendix D.1 and D.3, AES-CMAC
+ * - RFC 3394, section 4, AES key wrap
+ * - IEEE 1619-2007, appendix B, XTS-AES-128 vectors 1, 2, 15 and 16
+ * - The GCM specification of McGrew and Viega, test cases 2, 4 and 6
+ */
+
+#include "test_common.h"
+#include <hal_aes_sync.h>
+#include <string.h>
+
+static struct aes_sync_descriptor aes;
+
+/**
+ * \brief Convert a hex string, return the number of bytes
+ */
+static uint32_t test_hex(const char *hex, uint8_t *out)
+{
+	uint32_t n = 0;
+	unsigned byte;
+
+	while (*hex && (1 == sscanf(hex, "%2x", &byte))) {
+		out[n++] = (uint8_t)byte;
+		hex += 2;
+	}
+
+	return n;
+}
+
+/**
+ * \brief Compare a buffer with a hex string
+ */
+static bool test_equal(const uint8_t *buf, const char *hex)
+{
+	uint8_t  expected[80];
+	uint32_t n = test_hex(hex, expected);
+
+	return !memcmp(buf, expected, n);
+}
+
+/**
+ * \brief FIPS-197 appendix C, on the model and through the driver
+ */
+static void test_model(void)
+{
+	static const char *const keys[] = {"000102030405060708090a0b0c0d0e0f",
+	                                   "000102030405060708090a0b0c0d0e0f1011121314151617",
+	                                   "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"};
+	static const char *const cts[]  = {"69c4e0d86a7b0430d8cdb78070b4c55a",
+	                                   "dda97ca4864cdfe06eaf70a0ec0d7191",
+	                                   "8ea2b7ca516745bfeafc49904b496089"};
+	uint8_t                  key[32], pt[16], ct[16], out[16];
+	uint32_t                 key_len;
+	uint8_t                  i;
+
+	test_hex("00112233445566778899aabbccddeeff", pt);
+	for (i = 0; i < 3; i++) {
+		key_len = test_hex(keys[i], key);
+		test_hex(cts[i], ct);
+
+		aes_model_crypt(true, key, key_len / 4, pt, out);
+		CHECK(!memcmp(out, ct, 16));
+		aes_model_crypt(false, key, key_len / 4, ct, out);
+		CHECK(!memcmp(out, pt, 16));
+
+		CHECK(ERR_NONE == aes_sync_set_encrypt_key(&aes, key, (enum aes_keysize)i));
+		CHECK(ERR_NONE == aes_sync_ecb_crypt(&aes, AES_ENCRYPT, pt, out));
+		CHECK(!memcmp(out, ct, 16));
+		CHECK(ERR_NONE == aes_sync_ecb_crypt(&aes, AES_DECRYPT, ct, out));
+		CHECK(!memcmp(out, pt, 16));
+	}
+}
+
+/**
+ * \brief SP 800-38B D.1 (AES-128) and D.3 (AES-256), 0, 16, 40 and 64 bytes
+ */
+static void test_cmac(void)
+{
+	static const char *const keys[] = {"2b7e151628aed2a6abf7158809cf4f3c",
+	                                   "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4"};
+	static const char *const macs[2][4]
+	    = {{"bb1d6929e95937287fa37d129b756746",
+	        "070a16b46b4d4144f79bdd9dd04a287c",
+	        "dfa66747de9ae63030ca32611497c827",
+	        "51f0bebf7e3b9d92fc49741779363cfe"},
+	       {"028962f61b7bf89efc6b551f4667d983",
+	        "28a7023f452e8f82bd4bf28d8c37c35c",
+	        "aaf3d8f1de5640c232f5b169b9c911e6",
+	        "e1992190549f6ed5696a2c056c315410"}};
+	static const uint32_t lengths[] = {0, 16, 40, 64};
+	uint8_t               msg[64], key[32], mac[16], expected[16];
+	uint8_t               i, j;
+
+	test_hex("6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+	         "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710",
+	         msg);
+
+	for (i = 0; i < 2; i++) {
+		test_hex(keys[i], key);
+		CHECK(ERR_NONE == aes_sync_set_encrypt_key(&aes, key, i ? AES_KEY_256 : AES_KEY_128));
+		for (j = 0; j < 4; j++) {
+			CHECK(ERR_NONE == aes_sync_cmac(&aes, msg, lengths[j], mac, 16));
+			CHECK(test_equal(mac, macs[i][j]));
+		}
+
+		/* A truncated MAC is the leading part */
+		memset(mac, 0, sizeof(mac));
+		test_hex(macs[i][2], expected);
+		CHECK(ERR_NONE == aes_sync_cmac(&aes, msg, 40, mac, 8));
+		CHECK(!memcmp(mac, expected, 8) && !mac[8] && !mac[15]);
+	}
+}
+
+/**
+ * \brief RFC 3394 4.1, 4.2, 4.3 and 4.6, wrapped and unwrapped in place
+ */
+static void test_kw(void)
+{
+	static const struct {
+		const char *kek;
+		const char *data;
+		const char *wrapped;
+	} vectors[] = {
+	    {"000102030405060708090A0B0C0D0E0F",
+	     "00112233445566778899AABBCCDDEEFF",
+	     "1FA68B0A8112B447AEF34BD8FB5A7B829D3E862371D2CFE5"},
+	    {"000102030405060708090A0B0C0D0E0F1011121314151617",
+	     "00112233445566778899AABBCCDDEEFF",
+	     "96778B25AE6CA435F92B5B97C050AED2468AB8A17AD84E5D"},
+	    {"000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F",
+	     "00112233445566778899AABBCCDDEEFF",
+	     "64E8C3F9CE0F5BA263E9777905818A2A93C8191E7D6E8AE7"},
+	    {"000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F",
+	     "00112233445566778899AABBCCDDEEFF000102030405060708090A0B0C0D0E0F",
+	     "28C9F404C4B810F4CBCCB35CFB87F8263F5786E2D80ED326CBC7F0E71A99F43BFB988B9B7A02DD21"},
+	};
+	uint8_t  kek[32], buf[40], data[32];
+	uint32_t kek_len, len;
+	uint8_t  i;
+
+	for (i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+		kek_len = test_hex(vectors[i].kek, kek);
+		len     = test_hex(vectors[i].data, data);
+		CHECK(ERR_NONE == aes_sync_set_encrypt_key(&aes, kek, (enum aes_keysize)(kek_len / 8 - 2)));
+
+		memcpy(buf, data, len);
+		CHECK(ERR_NONE == aes_sync_kw_wrap(&aes, buf, buf, len));
+		CHECK(test_equal(buf, vectors[i].wrapped));
+
+		CHECK(ERR_NONE == aes_sync_kw_unwrap(&aes, buf, buf, len + 8));
+		CHECK(!memcmp(buf, data, len));
+
+		/* A modified wrapped key fails the integrity check, nothing leaks */
+		test_hex(vectors[i].wrapped, buf);
+		buf[len + 7] ^= 0x01;
+		CHECK(ERR_INVALID_DATA == aes_sync_kw_unwrap(&aes, buf, data, len + 8));
+		for (kek_len = 0; kek_len < len; kek_len++) {
+			CHECK(!data[kek_len]);
+		}
+	}
+
+	CHECK(ERR_INVALID_ARG == aes_sync_kw_wrap(&aes, data, buf, 8));
+	CHECK(ERR_INVALID_ARG == aes_sync_kw_unwrap(&aes, buf, data, 20));
+}
+
+/**
+ * \brief IEEE 1619 vectors 1, 2, 15 and 16, both directions and in place
+ *
+ * Vector 2 runs a second time with the data key in a key slot.
+ */
+static void test_xts(void)
+{
+	static const struct {
+		const char *key1;
+		const char *key2;
+		const char *tweak;
+		const char *pt;
+		const char *ct;
+	} vectors[] = {
+	    {"00000000000000000000000000000000",
+	     "00000000000000000000000000000000",
+	     "00000000000000000000000000000000",
+	     "0000000000000000000000000000000000000000000000000000000000000000",
+	     "917cf69ebd68b2ec9b9fe9a3eadda692cd43d2f59598ed858c02c2652fbf922e"},
+	    {"11111111111111111111111111111111",
+	     "22222222222222222222222222222222",
+	     "33333333330000000000000000000000",
+	     "4444444444444444444444444444444444444444444444444444444444444444",
+	     "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0"},
+	    {"fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0",
+	     "bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0",
+	     "9a785634120000000000000000000000",
+	     "000102030405060708090a0b0c0d0e0f10",
+	     "6c1625db4671522d3d7599601de7ca09ed"},
+	    {"fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0",
+	     "bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0",
+	     "9a785634120000000000000000000000",
+	     "000102030405060708090a0b0c0d0e0f1011",
+	     "d069444b7a7e0cab09e24447d24deb1fedbf"},
+	};
+	uint8_t  key1[16], key2[16], tweak[16], pt[32], buf[32];
+	uint32_t len;
+	uint8_t  i;
+
+	for (i = 0; i < sizeof(vectors) / sizeof(vectors[0]) + 1; i++) {
+		const uint8_t v = (i < 4) ? i : 1;
+
+		test_hex(vectors[v].key1, key1);
+		test_hex(vectors[v].key2, key2);
+		test_hex(vectors[v].tweak, tweak);
+		len = test_hex(vectors[v].pt, pt);
+		if (i < 4) {
+			CHECK(ERR_NONE == aes_sync_set_encrypt_key(&aes, key1, AES_KEY_128));
+		} else {
+			CHECK(ERR_NONE == aes_sync_set_slot_key(&aes, 1, key1, AES_KEY_128));
+		}
+
+		CHECK(ERR_NONE == aes_sync_xts_crypt(&aes, AES_ENCRYPT, key2, pt, buf, len, tweak));
+		CHECK(test_equal(buf, vectors[v].ct));
+		CHECK(ERR_NONE == aes_sync_xts_crypt(&aes, AES_DECRYPT, key2, buf, buf, len, tweak));
+		CHECK(!memcmp(buf, pt, len));
+
+		memcpy(buf, pt, len);
+		CHECK(ERR_NONE == aes_sync_xts_crypt(&aes, AES_ENCRYPT, key2, buf, buf, len, tweak));
+		CHECK(test_equal(buf, vectors[v].ct));
+	}
+
+	/* The slot key is still in use after the tweak key swap */
+	CHECK(ERR_NONE == aes_sync_xts_crypt(&aes, AES_ENCRYPT, key2, pt, buf, len, tweak));
+	CHECK(test_equal(buf, vectors[1].ct));
+	CHECK(ERR_NONE == aes_sync_clear_key_slot(&aes, 1));
+
+	CHECK(ERR_INVALID_ARG == aes_sync_xts_crypt(&aes, AES_ENCRYPT, key2, pt, buf, 15, tweak));
+}
+
+/**
+ * \brief GCM test cases 2, 4 and 6 through the single message API
+ */
+static void test_gcm(void)
+{
+	static const struct {
+		const char *key;
+		const char *iv;
+		const char *aad;
+		const char *pt;
+		const char *ct;
+		const char *tag;
+	} vectors[] = {
+	    {"00000000000000000000000000000000",
+	     "000000000000000000000000",
+	     "",
+	     "00000000000000000000000000000000",
+	     "0388dace60b6a392f328c2b971b2fe78",
+	     "ab6e47d42cec13bdf53a67b21257bddf"},
+	    {"feffe9928665731c6d6a8f9467308308",
+	     "cafebabefacedbaddecaf888",
+	     "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+	     "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+	     "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+	     "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+	     "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+	     "5bc94fbc3221a5db94fae95ae7121a47"},
+	    {"feffe9928665731c6d6a8f9467308308",
+	     "9313225df88406e555909c5aff5269aa6a7a9538534f7da1e4c303d2a318a728"
+	     "c3c0c95156809539fcf0e2429a6b525416aedbf5a0de6a57a637b39b",
+	     "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+	     "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+	     "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+	     "8ce24998625615b603a033aca13fb894be9112a5c3a211a8ba262a3cca7e2ca7"
+	     "01e4a9a4fba43c90ccdcb281d48c7c6fd62875d2aca417034c34aee5",
+	     "619cc5aefffe0bfa462af43c1699d050"},
+	};
+	uint8_t  key[16], iv[60], aad[20], pt[60], buf[60], tag[16];
+	uint32_t iv_len, aad_len, len;
+	uint8_t  i;
+
+	for (i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+		test_hex(vectors[i].key, key);
+		iv_len  = test_hex(vectors[i].iv, iv);
+		aad_len = test_hex(vectors[i].aad, aad);
+		len     = test_hex(vectors[i].pt, pt);
+		CHECK(ERR_NONE == aes_sync_set_encrypt_key(&aes, key, AES_KEY_128));
+
+		CHECK(ERR_NONE
+		      == aes_sync_gcm_crypt_and_tag(&aes, AES_ENCRYPT, pt, buf, len, iv, iv_len, aad, aad_len, tag, 16));
+		CHECK(test_equal(buf, vectors[i].ct));
+		CHECK(test_equal(tag, vectors[i].tag));
+
+		CHECK(ERR_NONE == aes_sync_gcm_auth_decrypt(&aes, buf, buf, len, iv, iv_len, aad, aad_len, tag, 16));
+		CHECK(!memcmp(buf, pt, len));
+	}
+}
+
+/**
+ * \brief A batch gives the ciphertext and tags of one call per message
+ *
+ * The messages mix 96 bit and other IV lengths, with and without AAD, and
+ * empty, short, aligned and unaligned payloads. The first one is test case 4
+ * of test_gcm(). A decrypt with one tampered tag fails that job only.
+ */
+static void test_gcm_batch(void)
+{
+	static const struct {
+		uint32_t iv_len;
+		uint32_t aad_len;
+		uint32_t length;
+		uint32_t tag_len;
+	} shapes[] = {
+	    {12, 20, 60, 16}, {12, 0, 0, 16}, {60, 0, 16, 16}, {8, 33, 15, 12}, {12, 16, 100, 16}, {1, 5, 48, 4}};
+	enum { JOBS = sizeof(shapes) / sizeof(shapes[0]) };
+	struct aes_gcm_job jobs[JOBS];
+	uint8_t            key[16];
+	uint8_t            iv[JOBS][60], aad[JOBS][33], pt[JOBS][100];
+	uint8_t            ct[JOBS][100], out[JOBS][100], single[100];
+	uint8_t            tag[JOBS][16], single_tag[16];
+	uint32_t           i, j;
+
+	test_hex("feffe9928665731c6d6a8f9467308308", key);
+	CHECK(ERR_NONE == aes_sync_set_encrypt_key(&aes, key, AES_KEY_128));
+
+	test_rand_state = 47;
+	for (i = 0; i < JOBS; i++) {
+		for (j = 0; j < sizeof(pt[i]); j++) {
+			iv[i][j % sizeof(iv[i])]   = (uint8_t)test_rand();
+			aad[i][j % sizeof(aad[i])] = (uint8_t)test_rand();
+			pt[i][j]                   = (uint8_t)test_rand();
+		}
+		jobs[i].iv      = iv[i];
+		jobs[i].iv_len  = shapes[i].iv_len;
+		jobs[i].aad     = aad[i];
+		jobs[i].aad_len = shapes[i].aad_len;
+		jobs[i].input   = pt[i];
+		jobs[i].output  = ct[i];
+		jobs[i].length  = shapes[i].length;
+		jobs[i].tag     = tag[i];
+		jobs[i].tag_len = shapes[i].tag_len;
+		jobs[i].status  = ERR_BUSY;
+	}
+	test_hex("cafebabefacedbaddecaf888", iv[0]);
+	test_hex("feedfacedeadbeeffeedfacedeadbeefabaddad2", aad[0]);
+	test_hex("d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+	         "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+	         pt[0]);
+
+	CHECK(ERR_NONE == aes_sync_gcm_crypt_and_tag_batch(&aes, AES_ENCRYPT, jobs, JOBS));
+	CHECK(test_equal(tag[0], "5bc94fbc3221a5db94fae95ae7121a47"));
+	for (i = 0; i < JOBS; i++) {
+		CHECK(ERR_NONE == jobs[i].status);
+		CHECK(ERR_NONE
+		      == aes_sync_gcm_crypt_and_tag(&aes,
+		                                    AES_ENCRYPT,
+		                                    pt[i],
+		                                    single,
+		                                    jobs[i].length,
+		                                    iv[i],
+		                                    jobs[i].iv_len,
+		                                    aad[i],
+		                                    jobs[i].aad_len,
+		                                    single_tag,
+		                                    jobs[i].tag_len));
+		CHECK(!memcmp(ct[i], single, jobs[i].length));
+		CHECK(!memcmp(tag[i], single_tag, jobs[i].tag_len));
+	}
+
+	/* Decrypt the batch back */
+	for (i = 0; i < JOBS; i++) {
+		jobs[i].input  = ct[i];
+		jobs[i].output = out[i];
+		jobs[i].status = ERR_BUSY;
+	}
+	CHECK(ERR_NONE == aes_sync_gcm_crypt_and_tag_batch(&aes, AES_DECRYPT, jobs, JOBS));
+	for (i = 0; i < JOBS; i++) {
+		CHECK(ERR_NONE == jobs[i].status);
+		CHECK(!memcmp(out[i], pt[i], jobs[i].length));
+	}
+
+	/* A tampered tag fails its job, as it fails the single message decrypt */
+	tag[3][jobs[3].tag_len - 1] ^= 0x01;
+	CHECK(ERR_INVALID_DATA == aes_sync_gcm_crypt_and_tag_batch(&aes, AES_DECRYPT, jobs, JOBS));
+	for (i = 0; i < JOBS; i++) {
+		CHECK(jobs[i].status == ((i == 3) ? ERR_INVALID_DATA : ERR_NONE));
+	}
+	CHECK(ERR_INVALID_DATA
+	      == aes_sync_gcm_auth_decrypt(&aes,
+	                                   ct[3],
+	                                   single,
+	                                   jobs[3].length,
+	                                   iv[3],
+	                                   jobs[3].iv_len,
+	                                   aad[3],
+	                                   jobs[3].aad_len,
+	                                   tag[3],
+	                                   jobs[3].tag_len));
+}
+
+int main(void)
+{
+	CHECK(ERR_NONE == aes_sync_init(&aes, &aes_model));
+	CHECK(ERR_NONE == aes_sync_enable(&aes));
+
+	test_model();
+	test_cmac();
+	test_kw();
+	test_xts();
+	test_gcm();
+	test_gcm_batch();
+
+	printf("aes_modes: all tests passed\n");
+
+	return 0;
+}
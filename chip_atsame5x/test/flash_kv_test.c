@@ -0,0 +1,392 @@
+/**
+ * \file
+ *
+ * \brief Host test of the flash key-value store.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+/*
+ * flash_kv runs against a RAM model of the internal flash, which replaces
+ * hal_flash. Programming can only clear bits, like the real flash. Power
+ * failures are injected by cutting a chosen program or erase operation:
+ * - a program keeps the quad words before the cut, the cut quad word is torn,
+ *   only part of its bits are programmed
+ * - an erase erases the pages before the cut, the cut page is left garbled
+ * Every flash operation after the cut fails until the next "power on".
+ */
+
+#include "test_common.h"
+#include <flash_kv.h>
+#include <flash_kv_config.h>
+#include <string.h>
+
+#define TEST_PAGE_SIZE 512
+#define TEST_BLOCK_SIZE 8192
+#define TEST_MAX_BLOCKS 4
+#define TEST_BASE 0x10000
+#define TEST_KEYS 12
+#define TEST_INDEX_SIZE 32
+
+/**
+ * \brief RAM model of the internal flash
+ */
+static struct {
+	uint8_t  mem[TEST_MAX_BLOCKS * TEST_BLOCK_SIZE];
+	uint32_t          size;
+	struct test_power power;
+	uint32_t          erases[TEST_MAX_BLOCKS];
+} nvm;
+
+const uint8_t *flash_get_pointer(struct flash_descriptor *flash, const uint32_t src_addr, const uint32_t length)
+{
+	(void)flash;
+
+	if ((src_addr < TEST_BASE) || (src_addr + length > TEST_BASE + nvm.size)) {
+		return NULL;
+	}
+
+	return &nvm.mem[src_addr - TEST_BASE];
+}
+
+uint32_t flash_get_page_size(struct flash_descriptor *flash)
+{
+	(void)flash;
+
+	return TEST_PAGE_SIZE;
+}
+
+uint32_t flash_get_block_size(struct flash_descriptor *flash)
+{
+	(void)flash;
+
+	return TEST_BLOCK_SIZE;
+}
+
+int32_t flash_append(struct flash_descriptor *flash, uint32_t dst_addr, uint8_t *buffer, uint32_t length)
+{
+	uint32_t offset = dst_addr - TEST_BASE;
+	uint32_t i, torn;
+
+	(void)flash;
+
+	CHECK(!(dst_addr & 0xF) && (offset + length <= nvm.size));
+	CHECK((dst_addr & ~(TEST_PAGE_SIZE - 1)) == ((dst_addr + length - 1) & ~(TEST_PAGE_SIZE - 1)));
+
+	if (nvm.power.power_off) {
+		return ERR_IO;
+	}
+
+	if (test_cut_now(&nvm.power)) {
+		/* Quad words before the torn one are programmed */
+		torn = (test_rand() % ((length + 15) / 16)) * 16;
+		for (i = 0; i < torn; i++) {
+			nvm.mem[offset + i] &= buffer[i];
+		}
+		for (; (i < torn + 16) && (i < length); i++) {
+			nvm.mem[offset + i] &= buffer[i] | (uint8_t)test_rand();
+		}
+		return ERR_IO;
+	}
+
+	for (i = 0; i < length; i++) {
+		nvm.mem[offset + i] &= buffer[i];
+	}
+
+	return ERR_NONE;
+}
+
+int32_t flash_erase(struct flash_descriptor *flash, const uint32_t dst_addr, const uint32_t page_nums)
+{
+	uint32_t offset = dst_addr - TEST_BASE;
+	uint32_t length = page_nums * TEST_PAGE_SIZE;
+	uint32_t i, torn;
+
+	(void)flash;
+
+	CHECK(!(offset & (TEST_BLOCK_SIZE - 1)) && !(length & (TEST_BLOCK_SIZE - 1)) && (offset + length <= nvm.size));
+
+	if (nvm.power.power_off) {
+		return ERR_IO;
+	}
+
+	if (test_cut_now(&nvm.power)) {
+		/* Pages before the torn one are erased */
+		torn = (test_rand() % page_nums) * TEST_PAGE_SIZE;
+		memset(&nvm.mem[offset], 0xFF, torn);
+		for (i = torn; i < torn + TEST_PAGE_SIZE; i++) {
+			nvm.mem[offset + i] |= (uint8_t)test_rand();
+		}
+		return ERR_IO;
+	}
+
+	memset(&nvm.mem[offset], 0xFF, length);
+	nvm.erases[offset / TEST_BLOCK_SIZE]++;
+
+	return ERR_NONE;
+}
+
+/**
+ * \brief Expected content of the store
+ */
+struct test_model {
+	uint16_t length[TEST_KEYS];
+	uint8_t  value[TEST_KEYS][CONF_FLASH_KV_MAX_VALUE_SIZE];
+};
+
+static struct flash_descriptor flash;
+static struct flash_kv_entry   index_mem[TEST_INDEX_SIZE];
+
+static void test_setup(struct flash_kv *const kv, const uint16_t blocks)
+{
+	struct flash_kv_config cfg = {TEST_BASE, blocks, TEST_INDEX_SIZE, index_mem};
+
+	nvm.size = blocks * TEST_BLOCK_SIZE;
+	memset(nvm.mem, 0, sizeof(nvm.mem));
+	memset(nvm.erases, 0, sizeof(nvm.erases));
+	test_power_on(&nvm.power, 0);
+
+	CHECK(ERR_NONE == flash_kv_init(kv, &flash, &cfg));
+	CHECK(ERR_NONE == flash_kv_format(kv));
+}
+
+/**
+ * \brief Initialize and mount with the configuration in use
+ */
+static int32_t test_mount(void *const ctx)
+{
+	struct flash_kv *      kv  = ctx;
+	struct flash_kv_config cfg = kv->cfg;
+	int32_t                rc;
+
+	rc = flash_kv_init(kv, &flash, &cfg);
+	if (rc) {
+		return rc;
+	}
+
+	return flash_kv_mount(kv);
+}
+
+/**
+ * \brief Check that a key holds the value of the model
+ */
+static bool test_matches(struct flash_kv *const kv, const struct test_model *const model, const uint16_t key)
+{
+	uint8_t buf[CONF_FLASH_KV_MAX_VALUE_SIZE];
+	int32_t rc = flash_kv_get(kv, key + 1, buf, sizeof(buf));
+
+	if (!model->length[key]) {
+		return ERR_NOT_FOUND == rc;
+	}
+
+	return (rc == model->length[key]) && !memcmp(buf, model->value[key], rc);
+}
+
+static void test_verify(struct flash_kv *const kv, const struct test_model *const model)
+{
+	uint16_t key;
+
+	for (key = 0; key < TEST_KEYS; key++) {
+		CHECK(test_matches(kv, model, key));
+	}
+}
+
+/**
+ * \brief Set or delete a random key
+ *
+ * \param[out] next The expected content after the operation
+ *
+ * \return The status of the operation
+ */
+static int32_t test_step(struct flash_kv *const kv, const struct test_model *const model, struct test_model *const next,
+                         uint16_t *const key)
+{
+	uint16_t i;
+
+	*next = *model;
+	*key  = test_rand() % TEST_KEYS;
+
+	if ((test_rand() % 5) == 0) {
+		next->length[*key] = 0;
+		return model->length[*key] ? flash_kv_delete(kv, *key + 1) : ERR_NOT_FOUND;
+	}
+
+	next->length[*key] = 1 + test_rand() % CONF_FLASH_KV_MAX_VALUE_SIZE;
+	for (i = 0; i < next->length[*key]; i++) {
+		next->value[*key][i] = (uint8_t)test_rand();
+	}
+
+	return flash_kv_set(kv, *key + 1, next->value[*key], next->length[*key]);
+}
+
+/**
+ * \brief Basic set, get, delete and persistence across a mount
+ */
+static void test_basic(void)
+{
+	struct flash_kv kv;
+	uint8_t         buf[8];
+
+	test_setup(&kv, 3);
+
+	CHECK(ERR_NOT_FOUND == flash_kv_get(&kv, 1, buf, sizeof(buf)));
+	CHECK(ERR_NONE == flash_kv_set(&kv, 1, "one", 3));
+	CHECK(ERR_NONE == flash_kv_set(&kv, 2, "two", 3));
+	CHECK(ERR_NONE == flash_kv_set(&kv, 1, "ONE!", 4));
+	CHECK(4 == flash_kv_get(&kv, 1, buf, sizeof(buf)) && !memcmp(buf, "ONE!", 4));
+	CHECK(ERR_NONE == flash_kv_delete(&kv, 2));
+	CHECK(ERR_NOT_FOUND == flash_kv_delete(&kv, 2));
+
+	test_remount(&nvm.power, test_mount, &kv, 0);
+	CHECK(4 == flash_kv_get(&kv, 1, buf, sizeof(buf)) && !memcmp(buf, "ONE!", 4));
+	CHECK(ERR_NOT_FOUND == flash_kv_get(&kv, 2, buf, sizeof(buf)));
+	CHECK(ERR_INVALID_ARG == flash_kv_set(&kv, FLASH_KV_NO_KEY, "x", 1));
+}
+
+/**
+ * \brief Many updates, every block is collected many times
+ */
+static void test_collect(const uint16_t blocks)
+{
+	struct flash_kv   kv;
+	struct test_model model, next;
+	uint16_t          key, i;
+
+	test_setup(&kv, blocks);
+	memset(&model, 0, sizeof(model));
+	test_rand_state = 7;
+
+	for (i = 0; i < 5000; i++) {
+		int32_t rc = test_step(&kv, &model, &next, &key);
+		CHECK((ERR_NONE == rc) || ((ERR_NOT_FOUND == rc) && !model.length[key]));
+		model = next;
+		if (!(i % 500)) {
+			test_verify(&kv, &model);
+		}
+	}
+	test_verify(&kv, &model);
+
+	test_remount(&nvm.power, test_mount, &kv, 0);
+	test_verify(&kv, &model);
+
+	/* The blocks take turns */
+	for (i = 0; i < blocks; i++) {
+		CHECK(nvm.erases[i] > 5);
+	}
+}
+
+/**
+ * \brief Store and model of a power fail workload
+ */
+struct test_workload_ctx {
+	struct flash_kv   kv;
+	uint16_t          blocks;
+	struct test_model model, next;
+	uint16_t          key;
+};
+
+static void test_workload_setup(void *const ctx)
+{
+	struct test_workload_ctx *w = ctx;
+
+	test_setup(&w->kv, w->blocks);
+	memset(&w->model, 0, sizeof(w->model));
+}
+
+static int32_t test_workload_mount(void *const ctx)
+{
+	return test_mount(&((struct test_workload_ctx *)ctx)->kv);
+}
+
+static bool test_workload_step(void *const ctx)
+{
+	struct test_workload_ctx *w  = ctx;
+	int32_t                   rc = test_step(&w->kv, &w->model, &w->next, &w->key);
+
+	return (ERR_NONE == rc) || ((ERR_NOT_FOUND == rc) && !w->model.length[w->key]);
+}
+
+static void test_workload_apply(void *const ctx)
+{
+	struct test_workload_ctx *w = ctx;
+
+	w->model = w->next;
+}
+
+static void test_workload_resolve(void *const ctx)
+{
+	struct test_workload_ctx *w = ctx;
+
+	if (test_matches(&w->kv, &w->next, w->key)) {
+		w->model = w->next;
+	}
+}
+
+static void test_workload_verify(void *const ctx)
+{
+	struct test_workload_ctx *w = ctx;
+
+	test_verify(&w->kv, &w->model);
+}
+
+/**
+ * \brief Cut the power at every flash operation of a workload
+ *
+ * Every acknowledged value must survive.
+ */
+static void test_power_fail_blocks(const uint16_t blocks)
+{
+	static struct test_workload_ctx ctx;
+	const struct test_workload      w = {&nvm.power,
+	                                &ctx,
+	                                400,
+	                                11,
+	                                test_workload_setup,
+	                                test_workload_mount,
+	                                test_workload_step,
+	                                test_workload_apply,
+	                                test_workload_resolve,
+	                                test_workload_verify};
+
+	ctx.blocks = blocks;
+	test_power_fail(&w);
+}
+
+int main(void)
+{
+	test_basic();
+	test_collect(2);
+	test_collect(3);
+	test_collect(4);
+	test_power_fail_blocks(2);
+	test_power_fail_blocks(3);
+
+	printf("flash_kv: all tests passed\n");
+
+	return 0;
+}
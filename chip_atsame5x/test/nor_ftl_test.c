@@ -0,0 +1,454 @@
+/**
+ * \file
+ *
+ * \brief Host test of the NOR flash translation layer.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+/*
+ * nor_ftl runs against a simulated NOR chip behind the spi_nor_flash
+ * interface. Programming can only clear bits, programming a bit which is not
+ * erased fails the test, and completed erases are counted per sector. Power
+ * failures are injected by cutting a chosen program or erase operation:
+ * - a program keeps the bytes before the cut, the cut byte is torn
+ * - an erase leaves the whole sector partly erased
+ * Every flash operation after the cut fails until the next "power on".
+ */
+
+#include "test_common.h"
+#include <nor_ftl.h>
+#include <nor_ftl_config.h>
+#include <string.h>
+
+#define TEST_PAGE_SIZE 256
+#define TEST_SECTOR_SIZE 4096
+#define TEST_SECTORS 16
+#define TEST_BASE 0x20000
+#define TEST_PAGES 150
+#define TEST_SIZE (TEST_PAGES * TEST_PAGE_SIZE)
+
+/**
+ * \brief Simulated NOR chip
+ */
+static struct {
+	uint8_t           mem[TEST_SECTORS * TEST_SECTOR_SIZE];
+	struct test_power power;
+	/** Completed erases per sector */
+	uint32_t erases[TEST_SECTORS];
+} nor;
+
+static int32_t nor_read(struct spi_nor_flash *const me, uint8_t *const buf, const uint32_t address,
+                        const uint32_t length)
+{
+	(void)me;
+
+	CHECK((address >= TEST_BASE) && (address - TEST_BASE + length <= sizeof(nor.mem)));
+
+	if (nor.power.power_off) {
+		return ERR_IO;
+	}
+	memcpy(buf, &nor.mem[address - TEST_BASE], length);
+
+	return ERR_NONE;
+}
+
+static int32_t nor_write(struct spi_nor_flash *const me, const uint8_t *const buf, const uint32_t address,
+                         const uint32_t length)
+{
+	uint8_t *mem = &nor.mem[address - TEST_BASE];
+	uint32_t i, torn;
+
+	(void)me;
+
+	CHECK((address >= TEST_BASE) && (address - TEST_BASE + length <= sizeof(nor.mem)));
+
+	if (nor.power.power_off) {
+		return ERR_IO;
+	}
+	for (i = 0; i < length; i++) {
+		/* Only erased bits can be programmed */
+		CHECK((mem[i] & buf[i]) == buf[i]);
+	}
+
+	if (test_cut_now(&nor.power)) {
+		torn = test_rand() % length;
+		for (i = 0; i < torn; i++) {
+			mem[i] &= buf[i];
+		}
+		mem[torn] &= buf[torn] | (uint8_t)test_rand();
+		return ERR_IO;
+	}
+
+	for (i = 0; i < length; i++) {
+		mem[i] &= buf[i];
+	}
+
+	return ERR_NONE;
+}
+
+static int32_t nor_erase(struct spi_nor_flash *const me, const uint32_t address, const uint32_t length)
+{
+	uint32_t offset = address - TEST_BASE;
+	uint32_t i;
+
+	(void)me;
+
+	CHECK((address >= TEST_BASE) && !(offset % TEST_SECTOR_SIZE) && !(length % TEST_SECTOR_SIZE)
+	      && (offset + length <= sizeof(nor.mem)));
+
+	if (nor.power.power_off) {
+		return ERR_IO;
+	}
+
+	if (test_cut_now(&nor.power)) {
+		for (i = 0; i < length; i++) {
+			nor.mem[offset + i] |= (uint8_t)test_rand();
+		}
+		return ERR_IO;
+	}
+
+	memset(&nor.mem[offset], 0xFF, length);
+	for (i = 0; i < length / TEST_SECTOR_SIZE; i++) {
+		nor.erases[offset / TEST_SECTOR_SIZE + i]++;
+	}
+
+	return ERR_NONE;
+}
+
+static int32_t nor_no_xip(struct spi_nor_flash *const me)
+{
+	(void)me;
+
+	return ERR_UNSUPPORTED_OP;
+}
+
+static const struct spi_nor_flash_interface nor_interface = {nor_read, nor_write, nor_erase, nor_no_xip, nor_no_xip};
+
+static struct spi_nor_flash   flash;
+static uint16_t               map_mem[TEST_PAGES];
+static struct nor_ftl_sector  sector_mem[TEST_SECTORS];
+static uint8_t                cache_mem[TEST_PAGE_SIZE];
+static uint8_t                scratch_mem[TEST_PAGE_SIZE];
+static uint8_t                model[TEST_SIZE];
+static uint8_t                buf[TEST_SIZE];
+
+static void test_setup(struct nor_ftl *const ftl)
+{
+	struct nor_ftl_config cfg = {TEST_BASE,
+	                             TEST_SECTOR_SIZE,
+	                             TEST_PAGE_SIZE,
+	                             TEST_SECTORS,
+	                             TEST_PAGES,
+	                             map_mem,
+	                             sector_mem,
+	                             cache_mem,
+	                             scratch_mem};
+
+	memset(nor.mem, 0, sizeof(nor.mem));
+	memset(nor.erases, 0, sizeof(nor.erases));
+	memset(model, 0xFF, sizeof(model));
+	spi_nor_flash_construct(&flash, NULL, &nor_interface);
+	test_power_on(&nor.power, 0);
+
+	CHECK(ERR_NONE == nor_ftl_init(ftl, &flash, &cfg));
+	CHECK(ERR_NONE == nor_ftl_format(ftl));
+}
+
+/**
+ * \brief Initialize and mount with the configuration in use
+ */
+static int32_t test_mount(void *const ctx)
+{
+	struct nor_ftl *      ftl = ctx;
+	struct nor_ftl_config cfg = ftl->cfg;
+	int32_t               rc;
+
+	rc = nor_ftl_init(ftl, &flash, &cfg);
+	if (rc) {
+		return rc;
+	}
+
+	return nor_ftl_mount(ftl);
+}
+
+static void test_verify(struct nor_ftl *const ftl)
+{
+	CHECK(ERR_NONE == nor_ftl_read(ftl, 0, buf, TEST_SIZE));
+	CHECK(!memcmp(buf, model, TEST_SIZE));
+}
+
+/**
+ * \brief Write part of a random page and sync, or run a maintenance step
+ *
+ * \param[in] pages Pages written to, counted from 0
+ * \param[out] page The page written, NOR_FTL_UNMAPPED for maintenance
+ * \param[out] next The content of the page after the write
+ *
+ * \return The status of the operation
+ */
+static int32_t test_step(struct nor_ftl *const ftl, const uint16_t pages, uint16_t *const page, uint8_t *const next)
+{
+	uint16_t offset, length, i;
+	int32_t  rc;
+
+	if (!(test_rand() % 8)) {
+		*page = NOR_FTL_UNMAPPED;
+		rc    = nor_ftl_maintenance(ftl);
+		return (ERR_NO_CHANGE == rc) ? ERR_NONE : rc;
+	}
+
+	*page  = test_rand() % pages;
+	offset = test_rand() % TEST_PAGE_SIZE;
+	length = 1 + test_rand() % (TEST_PAGE_SIZE - offset);
+	memcpy(next, &model[*page * TEST_PAGE_SIZE], TEST_PAGE_SIZE);
+	for (i = 0; i < length; i++) {
+		next[offset + i] = (uint8_t)test_rand();
+	}
+
+	rc = nor_ftl_write(ftl, *page * TEST_PAGE_SIZE + offset, &next[offset], length);
+	if (!rc) {
+		rc = nor_ftl_sync(ftl);
+	}
+
+	return rc;
+}
+
+/**
+ * \brief Apply a successful step to the model
+ */
+static void test_apply(const uint16_t page, const uint8_t *const next)
+{
+	if (page != NOR_FTL_UNMAPPED) {
+		memcpy(&model[page * TEST_PAGE_SIZE], next, TEST_PAGE_SIZE);
+	}
+}
+
+/**
+ * \brief The erase counts of the FTL are those of the chip
+ */
+static void test_check_erase_counts(const struct nor_ftl *const ftl)
+{
+	uint16_t i;
+
+	for (i = 0; i < TEST_SECTORS; i++) {
+		CHECK(ftl->cfg.sectors[i].erase_count == nor.erases[i]);
+	}
+}
+
+/**
+ * \brief Reads, unaligned writes through the cache and persistence
+ */
+static void test_basic(void)
+{
+	struct nor_ftl ftl;
+	uint16_t       i;
+
+	test_setup(&ftl);
+	test_verify(&ftl);
+
+	for (i = 0; i < 3 * TEST_PAGE_SIZE; i++) {
+		model[100 + i] = (uint8_t)i;
+	}
+	CHECK(ERR_NONE == nor_ftl_write(&ftl, 100, &model[100], 3 * TEST_PAGE_SIZE));
+	/* The last page is still in the cache */
+	test_verify(&ftl);
+	CHECK(ERR_NONE == nor_ftl_sync(&ftl));
+
+	test_remount(&nor.power, test_mount, &ftl, 0);
+	test_verify(&ftl);
+	test_check_erase_counts(&ftl);
+
+	CHECK(ERR_INVALID_ARG == nor_ftl_write(&ftl, TEST_SIZE - 1, model, 2));
+	CHECK(ERR_INVALID_ARG == nor_ftl_read(&ftl, TEST_SIZE + 1, buf, 0));
+}
+
+/**
+ * \brief Random writes over the whole space, every sector is collected
+ */
+static void test_collect(void)
+{
+	struct nor_ftl ftl;
+	uint8_t        next[TEST_PAGE_SIZE];
+	uint16_t       page, i;
+
+	test_setup(&ftl);
+	test_rand_state = 7;
+
+	for (i = 0; i < 20000; i++) {
+		CHECK(ERR_NONE == test_step(&ftl, TEST_PAGES, &page, next));
+		test_apply(page, next);
+		if (!(i % 1000)) {
+			test_verify(&ftl);
+		}
+	}
+	test_verify(&ftl);
+	test_check_erase_counts(&ftl);
+	for (i = 0; i < TEST_SECTORS; i++) {
+		CHECK(nor.erases[i] > 20);
+	}
+
+	test_remount(&nor.power, test_mount, &ftl, 0);
+	test_verify(&ftl);
+	test_check_erase_counts(&ftl);
+}
+
+/**
+ * \brief Few hot pages over cold data, maintenance keeps the wear even
+ */
+static void test_wear(void)
+{
+	struct nor_ftl ftl;
+	uint8_t        next[TEST_PAGE_SIZE];
+	uint16_t       page, i;
+	uint32_t       min, max;
+
+	test_setup(&ftl);
+	test_rand_state = 9;
+
+	/* Cold data everywhere */
+	for (i = 0; i < TEST_SIZE; i++) {
+		model[i] = (uint8_t)test_rand();
+	}
+	CHECK(ERR_NONE == nor_ftl_write(&ftl, 0, model, TEST_SIZE));
+	CHECK(ERR_NONE == nor_ftl_sync(&ftl));
+
+	for (i = 0; i < 30000; i++) {
+		CHECK(ERR_NONE == test_step(&ftl, 4, &page, next));
+		test_apply(page, next);
+	}
+	test_verify(&ftl);
+	test_check_erase_counts(&ftl);
+
+	nor_ftl_get_wear(&ftl, &min, &max);
+	CHECK(max > 100);
+	CHECK(max - min <= 2 * CONF_NOR_FTL_WEAR_THRESHOLD);
+
+	test_remount(&nor.power, test_mount, &ftl, 0);
+	test_verify(&ftl);
+	test_check_erase_counts(&ftl);
+}
+
+/**
+ * \brief FTL and step of a power fail workload
+ */
+struct test_workload_ctx {
+	struct nor_ftl ftl;
+	uint16_t       page;
+	uint8_t        next[TEST_PAGE_SIZE];
+};
+
+static void test_workload_setup(void *const ctx)
+{
+	test_setup(&((struct test_workload_ctx *)ctx)->ftl);
+}
+
+static int32_t test_workload_mount(void *const ctx)
+{
+	return test_mount(&((struct test_workload_ctx *)ctx)->ftl);
+}
+
+static bool test_workload_step(void *const ctx)
+{
+	struct test_workload_ctx *w = ctx;
+
+	return ERR_NONE == test_step(&w->ftl, TEST_PAGES, &w->page, w->next);
+}
+
+static void test_workload_apply(void *const ctx)
+{
+	struct test_workload_ctx *w = ctx;
+
+	test_apply(w->page, w->next);
+}
+
+static void test_workload_resolve(void *const ctx)
+{
+	struct test_workload_ctx *w = ctx;
+
+	if (w->page != NOR_FTL_UNMAPPED) {
+		CHECK(ERR_NONE == nor_ftl_read(&w->ftl, w->page * TEST_PAGE_SIZE, buf, TEST_PAGE_SIZE));
+		if (!memcmp(buf, w->next, TEST_PAGE_SIZE)) {
+			test_apply(w->page, w->next);
+		}
+	}
+}
+
+/**
+ * \brief Check the content, and the erase counts lost with an interrupted erase
+ */
+static void test_workload_verify(void *const ctx)
+{
+	struct test_workload_ctx *w   = ctx;
+	uint32_t                  max = 0;
+	uint16_t                  i;
+
+	test_verify(&w->ftl);
+
+	for (i = 0; i < TEST_SECTORS; i++) {
+		max = nor.erases[i] > max ? nor.erases[i] : max;
+	}
+	for (i = 0; i < TEST_SECTORS; i++) {
+		/* A lost count restarts from the highest one, not from zero or garbage */
+		CHECK(w->ftl.cfg.sectors[i].erase_count && (w->ftl.cfg.sectors[i].erase_count <= max + 1));
+	}
+}
+
+/**
+ * \brief Cut every flash operation of a workload
+ *
+ * The page being written holds either its old or its new content.
+ */
+static void test_power_fail_pages(void)
+{
+	static struct test_workload_ctx ctx;
+	const struct test_workload      w = {&nor.power,
+	                                &ctx,
+	                                600,
+	                                11,
+	                                test_workload_setup,
+	                                test_workload_mount,
+	                                test_workload_step,
+	                                test_workload_apply,
+	                                test_workload_resolve,
+	                                test_workload_verify};
+
+	test_power_fail(&w);
+}
+
+int main(void)
+{
+	test_basic();
+	test_collect();
+	test_wear();
+	test_power_fail_pages();
+
+	printf("nor_ftl: all tests passed\n");
+
+	return 0;
+}
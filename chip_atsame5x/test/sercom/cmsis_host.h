@@ -0,0 +1,35 @@
+/* Forced in front of the sources built with the CMSIS core header, takes the
+ * place of cmsis_gcc.h: same compiler macros, no Cortex-M instructions */
+#ifndef CMSIS_HOST_H
+#define CMSIS_HOST_H
+
+#define __CMSIS_GCC_H
+
+#include <stdint.h>
+
+#define __ASM __asm
+#define __INLINE inline
+#define __STATIC_INLINE static inline
+#define __STATIC_FORCEINLINE __attribute__((always_inline)) static inline
+#define __NO_RETURN __attribute__((__noreturn__))
+#define __USED __attribute__((used))
+#define __WEAK __attribute__((weak))
+#define __PACKED __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#define __RESTRICT __restrict
+
+#define __NOP()
+#define __WFI()
+#define __WFE()
+#define __SEV()
+#define __ISB()
+#define __DSB()
+#define __DMB()
+#define __enable_irq()
+#define __disable_irq()
+#define __get_PRIMASK() 0U
+#define __set_PRIMASK(x) ((void)(x))
+
+#endif // CMSIS_HOST_H
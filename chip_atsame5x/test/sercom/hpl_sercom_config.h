@@ -0,0 +1,6 @@
+/* Configuration of hpl_sercom.c for the host tests, no SERCOM is set up by
+ * _sercom_init, the tests fill in their devices by hand */
+#ifndef HPL_SERCOM_CONFIG_H
+#define HPL_SERCOM_CONFIG_H
+
+#endif // HPL_SERCOM_CONFIG_H
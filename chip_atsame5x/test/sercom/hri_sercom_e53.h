@@ -0,0 +1,150 @@
+/**
+ * \file
+ *
+ * \brief SAM SERCOM SPI register model for host tests
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+/*
+ * Found before hri/hri_sercom_e53.h on the include path of the host tests.
+ * The real accessors are kept, operating on a Sercom in RAM, except for the
+ * SPI INTFLAG and DATA accessors used by the transfer loops of hpl_sercom.c.
+ * These are renamed out of the way and replaced by spi_model, which shifts
+ * characters in simulated time. Every access advances the time.
+ */
+
+#ifndef _HRI_SERCOM_E53_MODEL_H_INCLUDED_
+#define _HRI_SERCOM_E53_MODEL_H_INCLUDED_
+
+#define hri_sercomspi_get_INTFLAG_reg hri_sercomspi_get_INTFLAG_reg_ram
+#define hri_sercomspi_read_INTFLAG_reg hri_sercomspi_read_INTFLAG_reg_ram
+#define hri_sercomspi_clear_INTFLAG_reg hri_sercomspi_clear_INTFLAG_reg_ram
+#define hri_sercomspi_read_DATA_reg hri_sercomspi_read_DATA_reg_ram
+#define hri_sercomspi_write_DATA_reg hri_sercomspi_write_DATA_reg_ram
+
+#include "../../hri/hri_sercom_e53.h"
+
+#undef hri_sercomspi_get_INTFLAG_reg
+#undef hri_sercomspi_read_INTFLAG_reg
+#undef hri_sercomspi_clear_INTFLAG_reg
+#undef hri_sercomspi_read_DATA_reg
+#undef hri_sercomspi_write_DATA_reg
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief State of the modelled SPI master, MOSI looped back to MISO
+ *
+ * Times are in ticks, the caller chooses the tick rate.
+ */
+struct spi_model {
+	/** Current time */
+	uint64_t now;
+	/** Time to shift one character */
+	uint32_t char_ticks;
+	/** Time of one register access */
+	uint32_t access_ticks;
+	/** Time of the rest of one polling loop iteration, added to INTFLAG reads */
+	uint32_t loop_ticks;
+	/** Register accesses so far */
+	uint32_t accesses;
+	/** Access delayed by stall_ticks, as by an interrupt, 0 for none */
+	uint32_t stall_access;
+	uint32_t stall_ticks;
+	/** TX data buffer */
+	uint32_t tx;
+	bool     tx_full;
+	/** Shift register */
+	uint32_t shift;
+	bool     shifting;
+	uint64_t shift_end;
+	/** Two-level RX buffer */
+	uint32_t rx[2];
+	uint8_t  rx_head;
+	uint8_t  rx_count;
+	/** TXC and ERROR, the other flags follow the buffers */
+	uint8_t intflag;
+	/** Time the shift register was busy */
+	uint64_t busy_ticks;
+	/** Characters lost on a full RX buffer */
+	uint32_t overflows;
+	/** DATA writes to a full TX buffer and reads of an empty RX buffer */
+	uint32_t misuses;
+};
+
+extern struct spi_model spi_model;
+
+/**
+ * \brief Reset the model to idle, with the given timing
+ */
+void spi_model_reset(const uint32_t char_ticks, const uint32_t access_ticks, const uint32_t loop_ticks);
+
+uint8_t  spi_model_read_intflag(void);
+void     spi_model_clear_intflag(const uint8_t mask);
+uint32_t spi_model_read_data(void);
+void     spi_model_write_data(const uint32_t data);
+
+static inline hri_sercomspi_intflag_reg_t hri_sercomspi_get_INTFLAG_reg(const void *const           hw,
+                                                                        hri_sercomspi_intflag_reg_t mask)
+{
+	(void)hw;
+	return spi_model_read_intflag() & mask;
+}
+
+static inline hri_sercomspi_intflag_reg_t hri_sercomspi_read_INTFLAG_reg(const void *const hw)
+{
+	(void)hw;
+	return spi_model_read_intflag();
+}
+
+static inline void hri_sercomspi_clear_INTFLAG_reg(const void *const hw, hri_sercomspi_intflag_reg_t mask)
+{
+	(void)hw;
+	spi_model_clear_intflag(mask);
+}
+
+static inline void hri_sercomspi_write_DATA_reg(const void *const hw, hri_sercomspi_data_reg_t data)
+{
+	(void)hw;
+	spi_model_write_data(data);
+}
+
+static inline hri_sercomspi_data_reg_t hri_sercomspi_read_DATA_reg(const void *const hw)
+{
+	(void)hw;
+	return spi_model_read_data();
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HRI_SERCOM_E53_MODEL_H_INCLUDED_ */
@@ -0,0 +1,146 @@
+/**
+ * \file
+ *
+ * \brief SAM SERCOM SPI master model for host tests
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+/*
+ * The SPI master as seen through INTFLAG and DATA. A written character goes
+ * to the TX buffer and on to the shift register when that is idle, a shifted
+ * character goes to the two-level RX buffer, or is lost with ERROR set when
+ * both levels are full. Time only advances on register accesses, so a
+ * polling loop sees the flags change as it would on the device.
+ */
+
+#include <compiler.h>
+#include <string.h>
+
+struct spi_model spi_model;
+
+/**
+ * \brief Advance the time, shifting the characters due until then
+ */
+static void spi_model_advance(const uint32_t ticks)
+{
+	spi_model.now += ticks;
+	if (++spi_model.accesses == spi_model.stall_access) {
+		spi_model.now += spi_model.stall_ticks;
+	}
+
+	while (spi_model.shifting && spi_model.shift_end <= spi_model.now) {
+		if (spi_model.rx_count == 2) {
+			spi_model.overflows++;
+			spi_model.intflag |= SERCOM_SPI_INTFLAG_ERROR;
+		} else {
+			spi_model.rx[(spi_model.rx_head + spi_model.rx_count) & 1] = spi_model.shift;
+			spi_model.rx_count++;
+		}
+
+		if (spi_model.tx_full) {
+			spi_model.shift   = spi_model.tx;
+			spi_model.tx_full = false;
+			spi_model.shift_end += spi_model.char_ticks;
+			spi_model.busy_ticks += spi_model.char_ticks;
+		} else {
+			spi_model.shifting = false;
+			spi_model.intflag |= SERCOM_SPI_INTFLAG_TXC;
+		}
+	}
+}
+
+void spi_model_reset(const uint32_t char_ticks, const uint32_t access_ticks, const uint32_t loop_ticks)
+{
+	memset(&spi_model, 0, sizeof(spi_model));
+	spi_model.char_ticks   = char_ticks;
+	spi_model.access_ticks = access_ticks;
+	spi_model.loop_ticks   = loop_ticks;
+	spi_model.intflag      = SERCOM_SPI_INTFLAG_TXC;
+}
+
+uint8_t spi_model_read_intflag(void)
+{
+	uint8_t flags;
+
+	spi_model_advance(spi_model.loop_ticks + spi_model.access_ticks);
+
+	flags = spi_model.intflag;
+	if (!spi_model.tx_full) {
+		flags |= SERCOM_SPI_INTFLAG_DRE;
+	}
+	if (spi_model.rx_count) {
+		flags |= SERCOM_SPI_INTFLAG_RXC;
+	}
+
+	return flags;
+}
+
+void spi_model_clear_intflag(const uint8_t mask)
+{
+	spi_model_advance(spi_model.access_ticks);
+	spi_model.intflag &= ~(mask & (SERCOM_SPI_INTFLAG_TXC | SERCOM_SPI_INTFLAG_ERROR));
+}
+
+uint32_t spi_model_read_data(void)
+{
+	uint32_t data;
+
+	spi_model_advance(spi_model.access_ticks);
+
+	if (!spi_model.rx_count) {
+		spi_model.misuses++;
+		return 0;
+	}
+	data              = spi_model.rx[spi_model.rx_head];
+	spi_model.rx_head = (spi_model.rx_head + 1) & 1;
+	spi_model.rx_count--;
+
+	return data;
+}
+
+void spi_model_write_data(const uint32_t data)
+{
+	spi_model_advance(spi_model.access_ticks);
+
+	if (spi_model.tx_full) {
+		spi_model.misuses++;
+		return;
+	}
+	spi_model.intflag &= ~SERCOM_SPI_INTFLAG_TXC;
+
+	if (spi_model.shifting) {
+		spi_model.tx      = data;
+		spi_model.tx_full = true;
+	} else {
+		spi_model.shift     = data;
+		spi_model.shifting  = true;
+		spi_model.shift_end = spi_model.now + spi_model.char_ticks;
+		spi_model.busy_ticks += spi_model.char_ticks;
+	}
+}
@@ -0,0 +1,161 @@
+/**
+ * \file
+ *
+ * \brief Host simulated throughput of the SPI master sync transfer loop.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+/*
+ * _spi_m_sync_trans of hpl_sercom.c runs against spi_model, MOSI looped back
+ * to MISO, and reports the effective throughput with and without pipelining
+ * over a range of baud dividers. The timing of the model:
+ * - CPU at SPI_TEST_CPU_HZ, GCLK_SERCOM_CORE at SPI_TEST_GCLK_HZ
+ * - SCK = GCLK_SERCOM_CORE / (2 * (BAUD + 1)), 8 SCK per character
+ * - SPI_TEST_ACCESS_CYCLES per SERCOM register access through the bridge
+ * - SPI_TEST_LOOP_CYCLES for the rest of one polling loop iteration
+ */
+
+#include "test_common.h"
+#include <hpl_spi_m_sync.h>
+#include <string.h>
+
+#define SPI_TEST_CPU_HZ 120000000
+#define SPI_TEST_GCLK_HZ 48000000
+/* Model time runs at the least common multiple of both clocks */
+#define SPI_TEST_TICK_HZ 240000000
+#define SPI_TEST_CPU_TICKS (SPI_TEST_TICK_HZ / SPI_TEST_CPU_HZ)
+#define SPI_TEST_GCLK_TICKS (SPI_TEST_TICK_HZ / SPI_TEST_GCLK_HZ)
+
+#define SPI_TEST_ACCESS_CYCLES 4
+#define SPI_TEST_LOOP_CYCLES 10
+
+#define SPI_TEST_SIZE 512
+
+static const uint8_t test_bauds[] = {0, 1, 2, 3, 5, 8, 11};
+
+static Sercom                 test_sercom;
+static struct _spi_m_sync_dev test_dev;
+static uint8_t                test_tx[SPI_TEST_SIZE];
+static uint8_t                test_rx[SPI_TEST_SIZE];
+
+static uint32_t test_char_ticks(const uint8_t baud)
+{
+	return 8 * 2 * (baud + 1) * SPI_TEST_GCLK_TICKS;
+}
+
+/**
+ * \brief Exchange SPI_TEST_SIZE characters, return the elapsed model time
+ *
+ * \param[in] stall_access Register access delayed by ten characters, 0 for none
+ */
+static uint64_t test_transfer(const uint8_t baud, const bool pipelined, const uint32_t stall_access)
+{
+	struct spi_msg msg = {test_tx, test_rx, SPI_TEST_SIZE};
+
+	spi_model_reset(test_char_ticks(baud),
+	                SPI_TEST_ACCESS_CYCLES * SPI_TEST_CPU_TICKS,
+	                SPI_TEST_LOOP_CYCLES * SPI_TEST_CPU_TICKS);
+	spi_model.stall_access = stall_access;
+	spi_model.stall_ticks  = 10 * test_char_ticks(baud);
+	memset(test_rx, 0, sizeof(test_rx));
+	test_dev.pipelined = pipelined;
+
+	CHECK(_spi_m_sync_trans(&test_dev, &msg) == SPI_TEST_SIZE);
+	CHECK(spi_model.overflows == 0);
+	CHECK(spi_model.misuses == 0);
+	CHECK(!spi_model.shifting && !spi_model.tx_full && !spi_model.rx_count);
+	CHECK(memcmp(test_rx, test_tx, SPI_TEST_SIZE) == 0);
+	CHECK(spi_model.busy_ticks == (uint64_t)SPI_TEST_SIZE * test_char_ticks(baud));
+
+	return spi_model.now;
+}
+
+static uint32_t test_bytes_per_sec(const uint64_t ticks)
+{
+	return (uint32_t)((uint64_t)SPI_TEST_SIZE * SPI_TEST_TICK_HZ / ticks);
+}
+
+/**
+ * \brief Throughput of both modes, the pipelined one keeps SCK running
+ */
+static void test_throughput(void)
+{
+	uint8_t i;
+
+	printf("BAUD  SCK kHz  line B/s  plain B/s     %%  pipelined B/s     %%\n");
+	for (i = 0; i < ARRAY_SIZE(test_bauds); i++) {
+		uint32_t line  = SPI_TEST_GCLK_HZ / (2 * (test_bauds[i] + 1)) / 8;
+		uint32_t plain = test_bytes_per_sec(test_transfer(test_bauds[i], false, 0));
+		uint32_t piped = test_bytes_per_sec(test_transfer(test_bauds[i], true, 0));
+
+		printf("%4u  %7lu  %8lu   %8lu  %4lu       %8lu  %4lu\n",
+		       test_bauds[i],
+		       (unsigned long)(line * 8 / 1000),
+		       (unsigned long)line,
+		       (unsigned long)plain,
+		       (unsigned long)((uint64_t)plain * 100 / line),
+		       (unsigned long)piped,
+		       (unsigned long)((uint64_t)piped * 100 / line));
+
+		CHECK(piped >= plain);
+		CHECK(piped <= line && plain <= line);
+	}
+}
+
+/**
+ * \brief An interrupt of ten character times at any point loses no character
+ */
+static void test_interrupted(void)
+{
+	uint32_t access;
+
+	for (access = 1; access < 64; access++) {
+		test_transfer(0, false, access);
+		test_transfer(0, true, access);
+	}
+}
+
+int main(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < SPI_TEST_SIZE; i++) {
+		test_tx[i] = (uint8_t)(i * 7 + 3);
+	}
+	hri_sercomspi_write_CTRLA_reg(&test_sercom, SERCOM_SPI_CTRLA_MODE(3) | SERCOM_SPI_CTRLA_ENABLE);
+	test_dev.prvt       = &test_sercom;
+	test_dev.char_size  = 1;
+	test_dev.dummy_byte = 0xFF;
+
+	test_throughput();
+	test_interrupted();
+
+	printf("spi_throughput: all tests passed\n");
+	return 0;
+}
@@ -0,0 +1,210 @@
+/**
+ * \file
+ *
+ * \brief Common helpers of the host tests.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+/*
+ * Checks, a reproducible random generator and power failure injection for
+ * the storage tests. A test keeps a struct test_power in its flash model,
+ * calls test_cut_now for every program and erase, and fails every flash
+ * operation while power_off is set.
+ */
+
+#ifndef TEST_COMMON_H_INCLUDED
+#define TEST_COMMON_H_INCLUDED
+
+#include <compiler.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond)                                                                                                    \
+	do {                                                                                                               \
+		if (!(cond)) {                                                                                                 \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);                                            \
+			exit(1);                                                                                                   \
+		}                                                                                                              \
+	} while (0)
+
+/** State of test_rand, set to replay a sequence */
+static uint32_t test_rand_state = 1;
+
+/**
+ * \brief Next number of a xorshift sequence
+ */
+static inline uint32_t test_rand(void)
+{
+	test_rand_state ^= test_rand_state << 13;
+	test_rand_state ^= test_rand_state >> 17;
+	test_rand_state ^= test_rand_state << 5;
+
+	return test_rand_state;
+}
+
+/**
+ * \brief Power state of a flash model
+ */
+struct test_power {
+	/** Number of program and erase operations since power on */
+	uint32_t ops;
+	/** Operation to cut, 0 for none */
+	uint32_t cut;
+	bool     power_off;
+};
+
+/**
+ * \brief Power on, failing again at the given operation, 0 for never
+ */
+static inline void test_power_on(struct test_power *const power, const uint32_t cut)
+{
+	power->ops       = 0;
+	power->cut       = cut;
+	power->power_off = false;
+}
+
+/**
+ * \brief Count an operation, tell whether power fails during it
+ */
+static inline bool test_cut_now(struct test_power *const power)
+{
+	power->ops++;
+	if (power->cut && (power->ops == power->cut)) {
+		power->power_off = true;
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * \brief Power on and mount, as after a reset
+ *
+ * \param[in] mount Initializes and mounts the store under test
+ * \param[in] ctx The argument of mount
+ * \param[in] cut Operation of the mount to cut, 0 for none. The power then
+ *                comes back and the mount is retried.
+ */
+static inline void test_remount(struct test_power *const power, int32_t (*mount)(void *), void *const ctx,
+                                const uint32_t cut)
+{
+	int32_t rc;
+
+	test_power_on(power, cut);
+	rc = mount(ctx);
+	if (power->power_off) {
+		/* Power fails during the mount, then comes back */
+		CHECK(ERR_NONE != rc);
+		test_power_on(power, 0);
+		rc = mount(ctx);
+	}
+	CHECK(ERR_NONE == rc);
+	power->cut = 0;
+}
+
+/**
+ * \brief A random workload of a store, run by test_power_fail
+ *
+ * The hooks get ctx. The store keeps a model of its expected content, a step
+ * prepares the next content and the model only takes it once applied.
+ */
+struct test_workload {
+	struct test_power *power;
+	void *             ctx;
+	/** Number of steps, during which the cut happens */
+	uint16_t steps;
+	/** test_rand_state at the start of the workload */
+	uint32_t seed;
+	/** Format an empty store and clear the model */
+	void (*setup)(void *ctx);
+	/** Initialize and mount the store, as for test_remount */
+	int32_t (*mount)(void *ctx);
+	/** Run one step, tell whether it had the expected status */
+	bool (*step)(void *ctx);
+	/** Apply the last step to the model */
+	void (*apply)(void *ctx);
+	/** After a cut step, apply it if the store holds its result */
+	void (*resolve)(void *ctx);
+	/** Check the store against the model */
+	void (*verify)(void *ctx);
+};
+
+/**
+ * \brief Cut the power at every flash operation of a workload
+ *
+ * After the cut the store must mount, also when the power fails again during
+ * the mount, and hold the model, the interrupted step being either complete
+ * or not done at all. Then the store must keep working.
+ */
+static inline void test_power_fail(const struct test_workload *const w)
+{
+	uint32_t cut, total;
+	uint16_t i;
+
+	/* Count the operations of the workload */
+	w->setup(w->ctx);
+	test_rand_state = w->seed;
+	test_power_on(w->power, 0);
+	for (i = 0; i < w->steps; i++) {
+		CHECK(w->step(w->ctx));
+		w->apply(w->ctx);
+	}
+	total = w->power->ops;
+	CHECK(total > w->steps / 2);
+
+	for (cut = 1; cut <= total; cut++) {
+		w->setup(w->ctx);
+		test_rand_state = w->seed;
+		test_power_on(w->power, cut);
+
+		for (i = 0; i < w->steps; i++) {
+			w->step(w->ctx);
+			if (w->power->power_off) {
+				break;
+			}
+			w->apply(w->ctx);
+		}
+		CHECK(w->power->power_off);
+
+		/* The power fails again during the first recovery */
+		test_remount(w->power, w->mount, w->ctx, 1 + cut % 3);
+		w->resolve(w->ctx);
+		w->verify(w->ctx);
+
+		/* The store keeps working */
+		for (i = 0; i < 50; i++) {
+			CHECK(w->step(w->ctx));
+			w->apply(w->ctx);
+		}
+		test_remount(w->power, w->mount, w->ctx, 0);
+		w->verify(w->ctx);
+	}
+}
+
+#endif /* TEST_COMMON_H_INCLUDED */
@@ -0,0 +1,131 @@
+/**
+ * \file
+ *
+ * \brief Host test of the table driven CRCs of utils_crc.
+ *
+ * Copyright (c) 2016-2018 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip
+ * software and any derivatives exclusively with Microchip products.
+ * It is your responsibility to comply with third party license terms applicable
+ * to your use of third party software (including open source software) that
+ * may accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES,
+ * WHETHER EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE,
+ * INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY,
+ * AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE
+ * LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL
+ * LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE
+ * SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE
+ * POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT
+ * ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY
+ * RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+ * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * \asf_license_stop
+ *
+ */
+
+/*
+ * Known answers of the check string "123456789", and comparison with a
+ * bitwise computation over random lengths, alignments and splits, which
+ * covers the heads, the 8 byte steps and the tails.
+ */
+
+#include "test_common.h"
+#include <string.h>
+#include <utils_crc.h>
+
+#define TEST_SIZE 1024
+
+static const uint8_t test_check[] = "123456789";
+
+static uint8_t test_buf[TEST_SIZE + 8];
+
+/**
+ * \brief Bitwise reflected 32 bit CRC
+ */
+static uint32_t test_crc32_bitwise(const uint32_t poly, uint32_t crc, const uint8_t *data, uint32_t length)
+{
+	uint8_t i;
+
+	while (length--) {
+		crc ^= *data++;
+		for (i = 0; i < 8; i++) {
+			crc = (crc >> 1) ^ (poly & -(crc & 1));
+		}
+	}
+
+	return crc;
+}
+
+/**
+ * \brief Bitwise CRC-16 CCITT, not reflected
+ */
+static uint16_t test_crc16_bitwise(uint16_t crc, const uint8_t *data, uint32_t length)
+{
+	uint8_t i;
+
+	while (length--) {
+		crc ^= (uint16_t)(*data++ << 8);
+		for (i = 0; i < 8; i++) {
+			crc = (uint16_t)((crc << 1) ^ ((crc & 0x8000) ? 0x1021 : 0));
+		}
+	}
+
+	return crc;
+}
+
+static void test_known_answers(void)
+{
+	CHECK(0xCBF43926 == ~utils_crc32(0xFFFFFFFF, test_check, 9));
+	CHECK(0xE3069283 == ~utils_crc32c(0xFFFFFFFF, test_check, 9));
+	CHECK(0x29B1 == utils_crc16_ccitt(0xFFFF, test_check, 9));
+
+	/* Nothing to add */
+	CHECK(0x12345678 == utils_crc32(0x12345678, test_check, 0));
+	CHECK(0x1234 == utils_crc16_ccitt(0x1234, test_check, 0));
+}
+
+static void test_random(void)
+{
+	uint32_t i, offset, length, split;
+
+	for (i = 0; i < TEST_SIZE + 8; i++) {
+		test_buf[i] = (uint8_t)test_rand();
+	}
+
+	for (i = 0; i < 2000; i++) {
+		const uint8_t *data;
+
+		offset = test_rand() % 8;
+		length = test_rand() % (TEST_SIZE + 1);
+		split  = test_rand() % (length + 1);
+		data   = &test_buf[offset];
+
+		CHECK(utils_crc32(0xFFFFFFFF, data, length) == test_crc32_bitwise(0xEDB88320, 0xFFFFFFFF, data, length));
+		CHECK(utils_crc32c(0xFFFFFFFF, data, length) == test_crc32_bitwise(0x82F63B78, 0xFFFFFFFF, data, length));
+		CHECK(utils_crc16_ccitt(0xFFFF, data, length) == test_crc16_bitwise(0xFFFF, data, length));
+
+		/* Continuing over separate blocks */
+		CHECK(utils_crc32(utils_crc32(0xFFFFFFFF, data, split), data + split, length - split)
+		      == utils_crc32(0xFFFFFFFF, data, length));
+		CHECK(utils_crc16_ccitt(utils_crc16_ccitt(0xFFFF, data, split), data + split, length - split)
+		      == utils_crc16_ccitt(0xFFFF, data, length));
+	}
+}
+
+int main(void)
+{
+	test_known_answers();
+	test_random();
+
+	printf("utils_crc: all tests passed\n");
+
+	return 0;
+}